@@ -56,6 +56,7 @@ foreach(SCRIPT_MODULE ${SCRIPT_MODULE_LIST})
 endforeach()
 
 option(BUILD_TESTING       "Build unit tests"                                            0)
+option(BUILD_BENCHMARKS    "Build benchmarks, needs BUILD_TESTING"                        0)
 option(TOOLS               "Build map/vmap/mmap extraction/assembler tools"              0)
 option(USE_SCRIPTPCH       "Use precompiled headers when compiling scripts"              1)
 option(USE_COREPCH         "Use precompiled headers when compiling servers"              1)
@@ -0,0 +1,6 @@
+INSERT INTO `version_db_world` (`sql_rev`) VALUES ('1792290185886948067');
+
+DELETE FROM `command` WHERE `name` IN ('server mapupdater', 'server mapupdater reset');
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server mapupdater', 3, 'Syntax: .server mapupdater\r\nShows the utilisation and the number of executed and stolen map updates of every map update thread.'),
+('server mapupdater reset', 3, 'Syntax: .server mapupdater reset\r\nResets the map update thread statistics.');
@@ -0,0 +1,7 @@
+INSERT INTO `version_db_world` (`sql_rev`) VALUES ('1792291562739602076');
+
+DELETE FROM `command` WHERE `name` IN ('server opcodecosts', 'server opcodecosts log', 'server opcodecosts reset');
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server opcodecosts', 3, 'Syntax: .server opcodecosts [$count]\r\nShows the calls and the handler time of the $count (default 15) most expensive client opcodes, and the totals of every packet processing thread. Requires Network.OpcodeCosts.'),
+('server opcodecosts log', 3, 'Syntax: .server opcodecosts log\r\nWrites the costs of every client opcode, with the histogram of handler times, to the network.opcode logger.'),
+('server opcodecosts reset', 3, 'Syntax: .server opcodecosts reset\r\nResets the client opcode costs.');
@@ -0,0 +1,6 @@
+INSERT INTO `version_db_world` (`sql_rev`) VALUES ('1792292846513870342');
+
+DELETE FROM `command` WHERE `name` IN ('server pathfinding', 'server pathfinding reset');
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server pathfinding', 3, 'Syntax: .server pathfinding\r\nShows the hit rate of the path cache (MoveMaps.PathCacheSize), and the queue size, the number of searched paths and the latency of the asynchronous pathfinder threads (MoveMaps.AsyncThreads).'),
+('server pathfinding reset', 3, 'Syntax: .server pathfinding reset\r\nResets the path cache and asynchronous pathfinder statistics.');
@@ -0,0 +1,6 @@
+INSERT INTO `version_db_world` (`sql_rev`) VALUES ('1792294107360221584');
+
+DELETE FROM `command` WHERE `name` IN ('server pools', 'server pools reset');
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server pools', 3, 'Syntax: .server pools\r\nShows the live objects, the allocations and the share of allocations reusing a freed block of the spell, aura and target object pools.'),
+('server pools reset', 3, 'Syntax: .server pools reset\r\nResets the object pool allocation counters.');
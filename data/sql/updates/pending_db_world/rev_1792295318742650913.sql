@@ -0,0 +1,6 @@
+INSERT INTO `version_db_world` (`sql_rev`) VALUES ('1792295318742650913');
+
+DELETE FROM `command` WHERE `name` IN ('server auctionlisting', 'server auctionlisting reset');
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server auctionlisting', 3, 'Syntax: .server auctionlisting\r\nShows how many auction house result pages were served from the cached results of a previous search, and the average cpu time of the searches.'),
+('server auctionlisting reset', 3, 'Syntax: .server auctionlisting reset\r\nResets the auction listing statistics.');
@@ -0,0 +1,6 @@
+INSERT INTO `version_db_world` (`sql_rev`) VALUES ('1792296203518475120');
+
+DELETE FROM `command` WHERE `name` IN ('server saves', 'server saves reset');
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server saves', 3, 'Syntax: .server saves\r\nShows how many statements each step of the character saves writes, how often it has nothing to write and the time it takes.'),
+('server saves reset', 3, 'Syntax: .server saves reset\r\nResets the character save statistics.');
@@ -0,0 +1,6 @@
+INSERT INTO `version_db_world` (`sql_rev`) VALUES ('1792297042615830207');
+
+DELETE FROM `command` WHERE `name` IN ('server sqlwait', 'server sqlwait reset');
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server sqlwait', 3, 'Syntax: .server sqlwait\r\nShows how long the world, map and other threads waited for a synchronous database connection, as a histogram per database, and how often they timed out or exceeded the synchronous query budget.'),
+('server sqlwait reset', 3, 'Syntax: .server sqlwait reset\r\nResets the synchronous connection wait statistics.');
@@ -24,6 +24,11 @@
 
 //===========================================================
 
+namespace G3D
+{
+    class Vector3;
+}
+
 /**
 This is the minimum interface to the VMapMamager.
 */
@@ -87,6 +92,11 @@ namespace VMAP
         virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) = 0;
         virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
         /**
+        batch versions of isInLineOfSight and getHeight, the map tree and its settings are looked up once for all the points
+        */
+        virtual void isInLineOfSight(unsigned int pMapId, G3D::Vector3 const* starts, G3D::Vector3 const* ends, bool* results, uint32 count) = 0;
+        virtual void getHeights(unsigned int pMapId, G3D::Vector3 const* points, float* heights, uint32 count, float maxSearchDist) = 0;
+        /**
         test if we hit an object. return true if we hit one. rx, ry, rz will hold the hit position or the dest position, if no intersection was found
         return a position, that is pReduceDist closer to the origin
         */
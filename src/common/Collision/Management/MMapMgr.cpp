@@ -27,6 +27,32 @@ namespace MMAP
     static char const* const MAP_FILE_NAME_FORMAT = "%s/mmaps/%03i.mmap";
     static char const* const TILE_FILE_NAME_FORMAT = "%s/mmaps/%03i%02i%02i.mmtile";
 
+    // tiles around the given one, dtNavMesh::addTile links their polygons to it
+    static std::vector<uint32> GetNeighbourTiles(dtNavMesh const* navMesh, dtTileRef tileRef)
+    {
+        std::vector<uint32> tiles;
+
+        dtMeshTile const* tile = navMesh->getTileByRef(tileRef);
+        if (!tile || !tile->header)
+            return tiles;
+
+        for (int32 dx = -1; dx <= 1; ++dx)
+        {
+            for (int32 dy = -1; dy <= 1; ++dy)
+            {
+                if (!dx && !dy)
+                    continue;
+
+                dtMeshTile const* neighbours[4];
+                int32 count = navMesh->getTilesAt(tile->header->x + dx, tile->header->y + dy, neighbours, 4);
+                for (int32 i = 0; i < count; ++i)
+                    tiles.push_back(PathCache::GetTile(navMesh->getTileRef(neighbours[i])));
+            }
+        }
+
+        return tiles;
+    }
+
     // ######################## MMapMgr ########################
     MMapMgr::~MMapMgr()
     {
@@ -117,6 +143,8 @@ namespace MMAP
 
         // store inside our map list
         MMapData* mmap_data = new MMapData(mesh);
+
+        std::unique_lock<std::shared_mutex> guard(navMeshLock);
         itr->second = mmap_data;
         return true;
     }
@@ -187,11 +215,16 @@ namespace MMAP
 
         dtTileRef tileRef = 0;
 
+        std::unique_lock<std::shared_mutex> guard(navMeshLock);
+
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
         if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
         {
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
             ++loadedTiles;
+
+            // corridors passing next to the new tile may be shorter through it now
+            pathCache.InvalidateTiles(mapId, GetNeighbourTiles(mmap->navMesh, tileRef));
             dtMeshHeader* header = (dtMeshHeader*)data;
             LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
             return true;
@@ -226,6 +259,8 @@ namespace MMAP
 
         dtTileRef tileRef = mmap->loadedTileRefs[packedGridPos];
 
+        std::unique_lock<std::shared_mutex> guard(navMeshLock);
+
         // unload, and mark as non loaded
         if (dtStatusFailed(mmap->navMesh->removeTile(tileRef, nullptr, nullptr)))
         {
@@ -238,6 +273,9 @@ namespace MMAP
 
         mmap->loadedTileRefs.erase(packedGridPos);
         --loadedTiles;
+
+        // the polygon refs of the tile are gone, corridors of the neighbours only lost their links to it
+        pathCache.InvalidateTiles(mapId, { PathCache::GetTile(tileRef) });
         LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile %03i[%02i,%02i] from %03i", mapId, x, y, mapId);
         return true;
     }
@@ -252,6 +290,8 @@ namespace MMAP
             return false;
         }
 
+        std::unique_lock<std::shared_mutex> guard(navMeshLock);
+
         // unload all tiles from given map
         MMapData* mmap = itr->second;
         for (auto i : mmap->loadedTileRefs)
@@ -272,6 +312,7 @@ namespace MMAP
 
         delete mmap;
         itr->second = nullptr;
+        pathCache.InvalidateMap(mapId);
         LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded %03i.mmap", mapId);
 
         return true;
@@ -347,4 +388,38 @@ namespace MMAP
 
         return mmap->navMeshQueries[instanceId];
     }
+
+    dtNavMeshQuery const* MMapMgr::GetWorkerNavMeshQuery(uint32 mapId, uint32 workerId)
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+        {
+            return nullptr;
+        }
+
+        MMapData* mmap = itr->second;
+
+        // workers hold navMeshLock shared only, creating their queries has to be serialized
+        std::lock_guard<std::mutex> guard(mmap->workerNavMeshQueriesLock);
+
+        NavMeshQuerySet::const_iterator queryItr = mmap->workerNavMeshQueries.find(workerId);
+        if (queryItr != mmap->workerNavMeshQueries.end())
+        {
+            return queryItr->second;
+        }
+
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+
+        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            LOG_ERROR("maps", "MMAP:GetWorkerNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u worker %u", mapId, workerId);
+            return nullptr;
+        }
+
+        LOG_DEBUG("maps", "MMAP:GetWorkerNavMeshQuery: created dtNavMeshQuery for mapId %03u worker %u", mapId, workerId);
+        mmap->workerNavMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(workerId, query));
+        return query;
+    }
 }
@@ -22,6 +22,8 @@
 #include "DetourAlloc.h"
 #include "DetourExtended.h"
 #include "DetourNavMesh.h"
+#include "MMapPathCache.h"
+#include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
 #include <vector>
@@ -55,6 +57,11 @@ namespace MMAP
                 dtFreeNavMeshQuery(i->second);
             }
 
+            for (NavMeshQuerySet::iterator i = workerNavMeshQueries.begin(); i != workerNavMeshQueries.end(); ++i)
+            {
+                dtFreeNavMeshQuery(i->second);
+            }
+
             if (navMesh)
             {
                 dtFreeNavMesh(navMesh);
@@ -63,6 +70,8 @@ namespace MMAP
 
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries; // instanceId to query
+        NavMeshQuerySet workerNavMeshQueries; // async pathfinder worker to query
+        std::mutex workerNavMeshQueriesLock;
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs; // maps [map grid coords] to [dtTile]
     };
@@ -87,6 +96,16 @@ namespace MMAP
         dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
         dtNavMesh const* GetNavMesh(uint32 mapId);
 
+        // query owned by one async pathfinder worker, only valid while navMeshLock is held shared
+        dtNavMeshQuery const* GetWorkerNavMeshQuery(uint32 mapId, uint32 workerId);
+
+        // held exclusively while tiles are added to or removed from a navmesh,
+        // threads searching outside of the map updates hold it shared
+        std::shared_mutex& GetNavMeshLock() { return navMeshLock; }
+
+        // corridors of the loaded navmeshes, dropped when a tile of their map is loaded or unloaded
+        PathCache& GetPathCache() { return pathCache; }
+
         uint32 getLoadedTilesCount() const { return loadedTiles; }
         uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
 
@@ -98,6 +117,8 @@ namespace MMAP
         MMapDataSet loadedMMaps;
         uint32 loadedTiles;
         bool thread_safe_environment;
+        std::shared_mutex navMeshLock;
+        PathCache pathCache;
     };
 }
 
@@ -0,0 +1,211 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MMapPathCache.h"
+#include "Errors.h"
+#include <algorithm>
+#include <cstring>
+
+namespace MMAP
+{
+    std::size_t PathCache::KeyHash::operator()(Key const& key) const
+    {
+        uint64 hash = (uint64(key.MapId) << 32) | (uint32(key.IncludeFlags) << 16) | key.ExcludeFlags;
+        hash ^= key.StartPoly + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        hash ^= key.EndPoly + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        return std::size_t(hash);
+    }
+
+    PathCache::PathCache(uint32 shardCount) : capacity(0), shardCapacity(0)
+    {
+        ASSERT(shardCount);
+
+        for (uint32 i = 0; i < shardCount; ++i)
+            shards.push_back(std::make_unique<Shard>());
+    }
+
+    void PathCache::SetCapacity(uint32 newCapacity)
+    {
+        capacity = newCapacity;
+        shardCapacity = (newCapacity + shards.size() - 1) / shards.size();
+
+        for (std::unique_ptr<Shard>& shard : shards)
+        {
+            std::lock_guard<std::mutex> guard(shard->lock);
+            Trim(*shard);
+        }
+    }
+
+    bool PathCache::Find(uint32 mapId, dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags,
+        dtPolyRef* path, uint32& pathLength, uint32 maxPathLength)
+    {
+        Key key = { mapId, includeFlags, excludeFlags, startPoly, endPoly };
+        Shard& shard = GetShard(key);
+
+        std::lock_guard<std::mutex> guard(shard.lock);
+
+        auto itr = shard.index.find(key);
+        if (itr == shard.index.end() || itr->second->Corridor.size() > maxPathLength)
+        {
+            ++shard.misses;
+            return false;
+        }
+
+        ++shard.hits;
+
+        // move to the front of the LRU list
+        shard.entries.splice(shard.entries.begin(), shard.entries, itr->second);
+
+        std::vector<dtPolyRef> const& corridor = itr->second->Corridor;
+        memcpy(path, corridor.data(), corridor.size() * sizeof(dtPolyRef));
+        pathLength = uint32(corridor.size());
+        return true;
+    }
+
+    void PathCache::Store(uint32 mapId, dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags,
+        dtPolyRef const* path, uint32 pathLength)
+    {
+        Key key = { mapId, includeFlags, excludeFlags, startPoly, endPoly };
+
+        // outside of the lock, most corridors only cross a few tiles
+        std::vector<uint32> tiles;
+        for (uint32 i = 0; i < pathLength; ++i)
+            tiles.push_back(GetTile(path[i]));
+
+        std::sort(tiles.begin(), tiles.end());
+        tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+
+        Shard& shard = GetShard(key);
+
+        std::lock_guard<std::mutex> guard(shard.lock);
+
+        if (!shardCapacity)
+            return;
+
+        auto itr = shard.index.find(key);
+        if (itr != shard.index.end())
+        {
+            itr->second->Corridor.assign(path, path + pathLength);
+            itr->second->Tiles = std::move(tiles);
+            shard.entries.splice(shard.entries.begin(), shard.entries, itr->second);
+            return;
+        }
+
+        shard.entries.push_front(Entry());
+        shard.entries.front().CacheKey = key;
+        shard.entries.front().Corridor.assign(path, path + pathLength);
+        shard.entries.front().Tiles = std::move(tiles);
+        shard.index[key] = shard.entries.begin();
+
+        Trim(shard);
+    }
+
+    template<class Predicate>
+    void PathCache::Invalidate(Predicate&& predicate)
+    {
+        // one shard at a time, searches keep using the other ones
+        for (std::unique_ptr<Shard>& shard : shards)
+        {
+            std::lock_guard<std::mutex> guard(shard->lock);
+
+            for (EntryList::iterator itr = shard->entries.begin(); itr != shard->entries.end();)
+            {
+                if (predicate(*itr))
+                {
+                    shard->index.erase(itr->CacheKey);
+                    itr = shard->entries.erase(itr);
+                    ++shard->invalidated;
+                }
+                else
+                    ++itr;
+            }
+        }
+    }
+
+    void PathCache::InvalidateTiles(uint32 mapId, std::vector<uint32> const& tiles)
+    {
+        Invalidate([mapId, &tiles](Entry const& entry)
+        {
+            if (entry.CacheKey.MapId != mapId)
+                return false;
+
+            for (uint32 tile : tiles)
+                if (std::binary_search(entry.Tiles.begin(), entry.Tiles.end(), tile))
+                    return true;
+
+            return false;
+        });
+    }
+
+    void PathCache::InvalidateMap(uint32 mapId)
+    {
+        Invalidate([mapId](Entry const& entry) { return entry.CacheKey.MapId == mapId; });
+    }
+
+    void PathCache::GetStats(PathCacheStats& stats)
+    {
+        stats.Hits = 0;
+        stats.Misses = 0;
+        stats.Invalidated = 0;
+        stats.Size = 0;
+        stats.Capacity = capacity;
+
+        for (std::unique_ptr<Shard>& shard : shards)
+        {
+            std::lock_guard<std::mutex> guard(shard->lock);
+
+            stats.Hits += shard->hits;
+            stats.Misses += shard->misses;
+            stats.Invalidated += shard->invalidated;
+            stats.Size += uint32(shard->entries.size());
+        }
+    }
+
+    void PathCache::ResetStats()
+    {
+        for (std::unique_ptr<Shard>& shard : shards)
+        {
+            std::lock_guard<std::mutex> guard(shard->lock);
+
+            shard->hits = 0;
+            shard->misses = 0;
+            shard->invalidated = 0;
+        }
+    }
+
+    uint32 PathCache::GetTile(dtPolyRef ref)
+    {
+        static_assert(sizeof(dtPolyRef) == sizeof(uint64), "tile bits of 32 bit polygon refs depend on the navmesh");
+
+        return uint32((ref >> DT_POLY_BITS) & ((dtPolyRef(1) << DT_TILE_BITS) - 1));
+    }
+
+    PathCache::Shard& PathCache::GetShard(Key const& key)
+    {
+        // the low bits of the hash mostly come from the polygon refs
+        return *shards[KeyHash()(key) % shards.size()];
+    }
+
+    void PathCache::Trim(Shard& shard)
+    {
+        while (shard.entries.size() > shardCapacity)
+        {
+            shard.index.erase(shard.entries.back().CacheKey);
+            shard.entries.pop_back();
+        }
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MMAP_PATH_CACHE_H
+#define _MMAP_PATH_CACHE_H
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace MMAP
+{
+    struct PathCacheStats
+    {
+        uint64 Hits;
+        uint64 Misses;
+        uint64 Invalidated;     // corridors dropped because a tile they cross (or next to it) was loaded or unloaded
+        uint32 Size;
+        uint32 Capacity;
+
+        [[nodiscard]] float GetHitRate() const { return Hits + Misses ? float(Hits) * 100.0f / float(Hits + Misses) : 0.0f; }
+    };
+
+    // LRU cache of the polygon corridors found between two polygons of a navmesh,
+    // paths between the same polygons only have to be string-pulled again.
+    // The entries are spread over shards with their own lock and LRU list, the pathfinder threads rarely wait
+    // for each other then. The capacity is split evenly between them.
+    class PathCache
+    {
+    public:
+        explicit PathCache(uint32 shardCount = 16);
+
+        // 0 disables the cache
+        void SetCapacity(uint32 newCapacity);
+        [[nodiscard]] bool IsEnabled() const { return capacity.load(std::memory_order_relaxed) != 0; }
+
+        // copies the corridor into path when it is cached and not longer than maxPathLength
+        bool Find(uint32 mapId, dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags,
+            dtPolyRef* path, uint32& pathLength, uint32 maxPathLength);
+        void Store(uint32 mapId, dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags,
+            dtPolyRef const* path, uint32 pathLength);
+
+        // drops the corridors crossing one of the tiles (dtNavMesh::decodePolyIdTile), their polygon refs or links changed
+        void InvalidateTiles(uint32 mapId, std::vector<uint32> const& tiles);
+        // the whole navmesh of the map was unloaded
+        void InvalidateMap(uint32 mapId);
+
+        void GetStats(PathCacheStats& stats);
+        void ResetStats();
+
+        // tile index of a polygon ref, the same as dtNavMesh::decodePolyIdTile() with 64 bit refs
+        static uint32 GetTile(dtPolyRef ref);
+
+    private:
+        struct Key
+        {
+            uint32 MapId;
+            uint16 IncludeFlags;
+            uint16 ExcludeFlags;
+            dtPolyRef StartPoly;
+            dtPolyRef EndPoly;
+
+            bool operator==(Key const& right) const
+            {
+                return MapId == right.MapId && StartPoly == right.StartPoly && EndPoly == right.EndPoly
+                    && IncludeFlags == right.IncludeFlags && ExcludeFlags == right.ExcludeFlags;
+            }
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator()(Key const& key) const;
+        };
+
+        struct Entry
+        {
+            Key CacheKey;
+            std::vector<dtPolyRef> Corridor;
+            std::vector<uint32> Tiles;      // sorted tiles the corridor crosses
+        };
+
+        typedef std::list<Entry> EntryList;
+
+        struct Shard
+        {
+            Shard() : hits(0), misses(0), invalidated(0) { }
+
+            std::mutex lock;
+            EntryList entries;     // most recently used first
+            std::unordered_map<Key, EntryList::iterator, KeyHash> index;
+
+            uint64 hits;
+            uint64 misses;
+            uint64 invalidated;
+        };
+
+        Shard& GetShard(Key const& key);
+        template<class Predicate>
+        void Invalidate(Predicate&& predicate);
+        void Trim(Shard& shard);
+
+        std::vector<std::unique_ptr<Shard>> shards;
+        std::atomic<uint32> capacity;
+        std::atomic<uint32> shardCapacity;
+    };
+}
+
+#endif
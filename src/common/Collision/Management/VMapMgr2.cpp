@@ -23,6 +23,7 @@
 #include "ModelInstance.h"
 #include "WorldModel.h"
 #include <G3D/Vector3.h>
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -195,6 +196,34 @@ namespace VMAP
         return true;
     }
 
+    void VMapMgr2::isInLineOfSight(unsigned int mapId, G3D::Vector3 const* starts, G3D::Vector3 const* ends, bool* results, uint32 count)
+    {
+        std::fill(results, results + count, true);
+
+#if defined(ENABLE_VMAP_CHECKS)
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+        {
+            return;
+        }
+#endif
+
+        InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+        {
+            return;
+        }
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            Vector3 pos1 = convertPositionToInternalRep(starts[i].x, starts[i].y, starts[i].z);
+            Vector3 pos2 = convertPositionToInternalRep(ends[i].x, ends[i].y, ends[i].z);
+            if (pos1 != pos2)
+            {
+                results[i] = instanceTree->second->isInLineOfSight(pos1, pos2);
+            }
+        }
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -254,6 +283,34 @@ namespace VMAP
         return VMAP_INVALID_HEIGHT_VALUE;
     }
 
+    void VMapMgr2::getHeights(unsigned int mapId, G3D::Vector3 const* points, float* heights, uint32 count, float maxSearchDist)
+    {
+        std::fill(heights, heights + count, VMAP_INVALID_HEIGHT_VALUE);
+
+#if defined(ENABLE_VMAP_CHECKS)
+        if (!isHeightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_HEIGHT))
+        {
+            return;
+        }
+#endif
+
+        InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+        {
+            return;
+        }
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            Vector3 pos = convertPositionToInternalRep(points[i].x, points[i].y, points[i].z);
+            float height = instanceTree->second->getHeight(pos, maxSearchDist);
+            if (height < G3D::finf())
+            {
+                heights[i] = height;
+            }
+        }
+    }
+
     bool VMapMgr2::GetAreaInfo(uint32 mapId, float x, float y, float& z, uint32& flags, int32& adtId, int32& rootId, int32& groupId) const
     {
 #if defined(ENABLE_VMAP_CHECKS)
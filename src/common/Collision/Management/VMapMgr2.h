@@ -113,6 +113,8 @@ namespace VMAP
         */
         bool GetObjectHitPos(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist) override;
         float getHeight(unsigned int mapId, float x, float y, float z, float maxSearchDist) override;
+        void isInLineOfSight(unsigned int mapId, G3D::Vector3 const* starts, G3D::Vector3 const* ends, bool* results, uint32 count) override;
+        void getHeights(unsigned int mapId, G3D::Vector3 const* points, float* heights, uint32 count, float maxSearchDist) override;
 
         bool processCommand(char* /*command*/) override { return false; } // for debug and extensions
 
@@ -43,6 +43,10 @@ public:
     static char const* getLogLevelString(LogLevel level);
     virtual void setRealmId(uint32 /*realmId*/) { }
 
+    // Buffered appenders may keep written messages in memory until flush() is called
+    virtual void setBuffered(bool /*buffered*/) { }
+    virtual void flush() { }
+
 private:
     virtual void _write(LogMessage const* /*message*/) = 0;
 
@@ -27,7 +27,8 @@ AppenderFile::AppenderFile(uint8 id, std::string const& name, LogLevel level, Ap
     logfile(nullptr),
     _logDir(sLog->GetLogsDir()),
     _maxFileSize(0),
-    _fileSize(0)
+    _fileSize(0),
+    _buffered(false)
 {
     if (args.size() < 4)
     {
@@ -78,9 +79,36 @@ AppenderFile::AppenderFile(uint8 id, std::string const& name, LogLevel level, Ap
 
 AppenderFile::~AppenderFile()
 {
+    flush();
     CloseFile();
 }
 
+void AppenderFile::setBuffered(bool buffered)
+{
+    if (!buffered)
+    {
+        flush();
+    }
+
+    _buffered = buffered;
+}
+
+void AppenderFile::flush()
+{
+    if (_buffer.empty())
+    {
+        return;
+    }
+
+    if (logfile)
+    {
+        fwrite(_buffer.data(), 1, _buffer.size(), logfile);
+        fflush(logfile);
+    }
+
+    _buffer.clear();
+}
+
 void AppenderFile::_write(LogMessage const* message)
 {
     bool exceedMaxSize = _maxFileSize > 0 && (_fileSize.load() + message->Size()) > _maxFileSize;
@@ -106,6 +134,7 @@ void AppenderFile::_write(LogMessage const* message)
     }
     else if (exceedMaxSize)
     {
+        flush();
         logfile = OpenFile(_fileName, "w", true);
     }
 
@@ -114,6 +143,14 @@ void AppenderFile::_write(LogMessage const* message)
         return;
     }
 
+    // gathered and written once per batch of the async log writer
+    if (_buffered)
+    {
+        _buffer.append(message->prefix).append(message->text).push_back('\n');
+        _fileSize += uint64(message->Size());
+        return;
+    }
+
     fprintf(logfile, "%s%s\n", message->prefix.c_str(), message->text.c_str());
     fflush(logfile);
     _fileSize += uint64(message->Size());
@@ -30,6 +30,8 @@ public:
     ~AppenderFile();
     FILE* OpenFile(std::string const& name, std::string const& mode, bool backup);
     AppenderType getType() const override { return type; }
+    void setBuffered(bool buffered) override;
+    void flush() override;
 
 private:
     void CloseFile();
@@ -41,6 +43,8 @@ private:
     bool _backup;
     uint64 _maxFileSize;
     std::atomic<uint64> _fileSize;
+    bool _buffered;
+    std::string _buffer;
 };
 
 #endif
@@ -0,0 +1,245 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AsyncLogWriter.h"
+#include "LogMessage.h"
+#include "Logger.h"
+#include "StringFormat.h"
+#include "Timer.h"
+#include <chrono>
+
+namespace
+{
+    // messages handed to the appenders before the batch callback flushes them
+    constexpr size_t WRITER_BATCH_SIZE = 256;
+    // upper bound for a lost wake-up and for the latency of the drop report
+    constexpr std::chrono::milliseconds WRITER_IDLE_WAIT(100);
+    constexpr uint32 DROP_REPORT_INTERVAL = 10 * IN_MILLISECONDS;
+
+    uint32 RoundUpToPowerOfTwo(uint32 value)
+    {
+        uint32 result = 2;
+        while (result < value && result < (1u << 30))
+            result <<= 1;
+
+        return result;
+    }
+}
+
+AsyncLogWriter::AsyncLogWriter(uint32 queueSize, LogAsyncOverflowPolicy policy, Logger const* overflowLogger, BatchCallback onBatchEnd) :
+    _policy(policy), _overflowLogger(overflowLogger), _onBatchEnd(std::move(onBatchEnd)), _enqueuePos(0), _dequeuePos(0), _written(0),
+    _dropped(0), _reportedDropped(0), _lastDropReport(0), _stop(false), _sleeping(false)
+{
+    size_t size = RoundUpToPowerOfTwo(queueSize);
+    _slots = std::make_unique<Slot[]>(size);
+    _mask = size - 1;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+        _slots[i].logger = nullptr;
+        _slots[i].message = nullptr;
+    }
+
+    _thread = std::thread(&AsyncLogWriter::WriterThread, this);
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    Stop();
+}
+
+bool AsyncLogWriter::Enqueue(Logger const* logger, std::unique_ptr<LogMessage>&& message, bool forceBlock /*= false*/)
+{
+    Slot* slot = nullptr;
+    size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        slot = &_slots[pos & _mask];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = intptr_t(sequence) - intptr_t(pos);
+
+        if (!diff)
+        {
+            if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            // ring is full
+            if (_policy == LOG_ASYNC_OVERFLOW_DROP && !forceBlock)
+            {
+                ++_dropped;
+                return false;
+            }
+
+            WakeUpWriter();
+            std::this_thread::yield();
+            pos = _enqueuePos.load(std::memory_order_relaxed);
+        }
+        else
+            pos = _enqueuePos.load(std::memory_order_relaxed);
+    }
+
+    slot->logger = logger;
+    slot->message = message.release();
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_sleeping.load(std::memory_order_relaxed))
+        WakeUpWriter();
+
+    return true;
+}
+
+void AsyncLogWriter::Flush()
+{
+    // the writer thread can't wait for itself (an appender logging from inside a write)
+    if (std::this_thread::get_id() == _thread.get_id() || !_thread.joinable())
+        return;
+
+    size_t target = _enqueuePos.load(std::memory_order_acquire);
+
+    WakeUpWriter();
+
+    std::unique_lock<std::mutex> guard(_lock);
+    while (_written.load(std::memory_order_acquire) < target && !_stop)
+        _flushCondition.wait_for(guard, WRITER_IDLE_WAIT);
+}
+
+void AsyncLogWriter::Stop()
+{
+    if (!_thread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _stop = true;
+        _writerCondition.notify_all();
+    }
+
+    _thread.join();
+}
+
+bool AsyncLogWriter::HasPending() const
+{
+    Slot const& slot = _slots[_dequeuePos & _mask];
+    return slot.sequence.load(std::memory_order_acquire) == _dequeuePos + 1;
+}
+
+size_t AsyncLogWriter::Drain()
+{
+    size_t count = 0;
+    while (true)
+    {
+        size_t batch = 0;
+        while (batch < WRITER_BATCH_SIZE && HasPending())
+        {
+            Slot& slot = _slots[_dequeuePos & _mask];
+            std::unique_ptr<LogMessage> message(slot.message);
+            Logger const* logger = slot.logger;
+
+            slot.message = nullptr;
+            slot.logger = nullptr;
+            slot.sequence.store(_dequeuePos + _mask + 1, std::memory_order_release);
+            ++_dequeuePos;
+
+            if (logger)
+                logger->write(message.get());
+
+            ++batch;
+        }
+
+        if (!batch)
+            break;
+
+        if (_onBatchEnd)
+            _onBatchEnd();
+
+        count += batch;
+        _written.store(_dequeuePos, std::memory_order_release);
+    }
+
+    if (count)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _flushCondition.notify_all();
+    }
+
+    return count;
+}
+
+void AsyncLogWriter::WakeUpWriter()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _writerCondition.notify_one();
+}
+
+void AsyncLogWriter::ReportDropped()
+{
+    uint64 dropped = _dropped.load(std::memory_order_relaxed);
+    if (dropped == _reportedDropped || !_overflowLogger)
+        return;
+
+    if (_lastDropReport && getMSTimeDiff(_lastDropReport, getMSTime()) < DROP_REPORT_INTERVAL)
+        return;
+
+    LogMessage message(LOG_LEVEL_WARN, _overflowLogger->getName(), Acore::StringFormat("Log: async queue full, dropped " UI64FMTD " messages (" UI64FMTD " total)",
+        dropped - _reportedDropped, dropped));
+    _overflowLogger->write(&message);
+
+    if (_onBatchEnd)
+        _onBatchEnd();
+
+    _reportedDropped = dropped;
+    _lastDropReport = getMSTime();
+}
+
+void AsyncLogWriter::WriterThread()
+{
+    while (true)
+    {
+        if (Drain())
+        {
+            ReportDropped();
+            continue;
+        }
+
+        ReportDropped();
+
+        std::unique_lock<std::mutex> guard(_lock);
+        if (_stop)
+            break;
+
+        _sleeping = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (!HasPending())
+            _writerCondition.wait_for(guard, WRITER_IDLE_WAIT);
+
+        _sleeping = false;
+    }
+
+    // producers still holding a reserved slot publish it right away, pick up everything
+    Drain();
+    _lastDropReport = 0;
+    ReportDropped();
+
+    std::lock_guard<std::mutex> guard(_lock);
+    _flushCondition.notify_all();
+}
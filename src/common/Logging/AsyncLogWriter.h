@@ -0,0 +1,103 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AsyncLogWriter_h__
+#define AsyncLogWriter_h__
+
+#include "Define.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Logger;
+struct LogMessage;
+
+enum LogAsyncOverflowPolicy : uint8
+{
+    LOG_ASYNC_OVERFLOW_DROP  = 0, // discard the message and count it
+    LOG_ASYNC_OVERFLOW_BLOCK = 1  // wait for the writer thread to free a slot
+};
+
+/*
+ * Moves appender I/O off the logging threads.
+ *
+ * Producers reserve a slot in a bounded lock-free ring (Dmitry Vyukov's bounded queue,
+ * single consumer side) and publish the already formatted message; the writer thread
+ * drains the ring in batches and calls the batch callback once per batch so buffered
+ * appenders hit the disk with one write instead of one per message.
+ */
+class AsyncLogWriter
+{
+public:
+    typedef std::function<void()> BatchCallback;
+
+    AsyncLogWriter(uint32 queueSize, LogAsyncOverflowPolicy policy, Logger const* overflowLogger, BatchCallback onBatchEnd);
+    ~AsyncLogWriter();
+
+    AsyncLogWriter(AsyncLogWriter const&) = delete;
+    AsyncLogWriter& operator=(AsyncLogWriter const&) = delete;
+
+    // Returns false when the message was dropped because the ring is full
+    bool Enqueue(Logger const* logger, std::unique_ptr<LogMessage>&& message, bool forceBlock = false);
+
+    // Blocks until every message enqueued before the call has been written
+    void Flush();
+    void Stop();
+
+    uint64 GetDroppedCount() const { return _dropped; }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        Logger const* logger;
+        LogMessage* message;
+    };
+
+    void WriterThread();
+    bool HasPending() const;
+    size_t Drain();
+    void WakeUpWriter();
+    void ReportDropped();
+
+    std::unique_ptr<Slot[]> _slots;
+    size_t _mask;
+    LogAsyncOverflowPolicy _policy;
+    Logger const* _overflowLogger;
+    BatchCallback _onBatchEnd;
+
+    alignas(64) std::atomic<size_t> _enqueuePos;
+    alignas(64) size_t _dequeuePos;         // only touched by the writer thread
+    std::atomic<size_t> _written;           // ring position up to which messages reached the appenders
+
+    std::atomic<uint64> _dropped;
+    uint64 _reportedDropped;
+    uint32 _lastDropReport;
+
+    std::thread _thread;
+    std::atomic<bool> _stop;
+    std::atomic<bool> _sleeping;
+    std::mutex _lock;
+    std::condition_variable _writerCondition;
+    std::condition_variable _flushCondition;
+};
+
+#endif // AsyncLogWriter_h__
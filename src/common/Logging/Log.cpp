@@ -18,6 +18,7 @@
 #include "Log.h"
 #include "AppenderConsole.h"
 #include "AppenderFile.h"
+#include "AsyncLogWriter.h"
 #include "Config.h"
 #include "Errors.h"
 #include "LogMessage.h"
@@ -26,10 +27,11 @@
 #include "StringConvert.h"
 #include "Tokenize.h"
 #include "Util.h"
+#include <algorithm>
 #include <chrono>
 #include <sstream>
 
-Log::Log() : AppenderId(0), highestLogLevel(LOG_LEVEL_FATAL)
+Log::Log() : AppenderId(0), highestLogLevel(LOG_LEVEL_FATAL), _loggerGeneration(1)
 {
     m_logsTimestamp = "_" + GetTimestampStr();
     RegisterAppender<AppenderConsole>();
@@ -247,6 +249,18 @@ void Log::write(std::unique_ptr<LogMessage>&& msg) const
 {
     Logger const* logger = GetLoggerByType(msg->type);
 
+    if (_asyncWriter)
+    {
+        // fatal errors are usually followed by an abort, they must reach the appenders first
+        bool fatal = msg->level == LOG_LEVEL_FATAL;
+        if (_asyncWriter->Enqueue(logger, std::move(msg), fatal) && fatal)
+        {
+            _asyncWriter->Flush();
+        }
+
+        return;
+    }
+
     logger->write(msg.get());
 }
 
@@ -361,20 +375,72 @@ void Log::SetRealmId(uint32 id)
     }
 }
 
+void Log::Flush()
+{
+    if (_asyncWriter)
+    {
+        _asyncWriter->Flush();
+    }
+}
+
+uint64 Log::GetAsyncDroppedCount() const
+{
+    return _asyncWriter ? _asyncWriter->GetDroppedCount() : 0;
+}
+
+void Log::StartAsyncWriter()
+{
+    if (!sConfigMgr->GetOption<bool>("Log.Async.Enable", false, false))
+    {
+        return;
+    }
+
+    uint32 queueSize = sConfigMgr->GetOption<uint32>("Log.Async.QueueSize", 16384, false);
+    uint32 policy = sConfigMgr->GetOption<uint32>("Log.Async.OverflowPolicy", LOG_ASYNC_OVERFLOW_DROP, false);
+
+    if (policy > LOG_ASYNC_OVERFLOW_BLOCK)
+    {
+        fprintf(stderr, "Log::StartAsyncWriter: Wrong Log.Async.OverflowPolicy %u, using 0 (drop)\n", policy);
+        policy = LOG_ASYNC_OVERFLOW_DROP;
+    }
+
+    for (std::pair<uint8 const, std::unique_ptr<Appender>>& appender : appenders)
+    {
+        appender.second->setBuffered(true);
+    }
+
+    _asyncWriter = std::make_unique<AsyncLogWriter>(std::max<uint32>(queueSize, 64), LogAsyncOverflowPolicy(policy), GetLoggerByType("server"),
+        [this]() { FlushAppenders(); });
+}
+
+void Log::FlushAppenders()
+{
+    for (std::pair<uint8 const, std::unique_ptr<Appender>>& appender : appenders)
+    {
+        appender.second->flush();
+    }
+}
+
 void Log::Close()
 {
+    // let the writer thread empty the ring while loggers and appenders are still alive
+    if (_asyncWriter)
+    {
+        _asyncWriter->Stop();
+        _asyncWriter.reset();
+    }
+
     loggers.clear();
     appenders.clear();
+
+    // cached call site loggers are dangling now
+    ++_loggerGeneration;
 }
 
 bool Log::ShouldLog(std::string const& type, LogLevel level) const
 {
-    // TODO: Use cache to store "Type.sub1.sub2": "Type" equivalence, should
-    // Speed up in cases where requesting "Type.sub1.sub2" but only configured
-    // Logger "Type"
-
     // Don't even look for a logger if the LogLevel is higher than the highest log levels across all loggers
-    if (level > highestLogLevel)
+    if (level > highestLogLevel.load(std::memory_order_relaxed))
     {
         return false;
     }
@@ -385,6 +451,11 @@ bool Log::ShouldLog(std::string const& type, LogLevel level) const
         return false;
     }
 
+    return IsLevelEnabled(logger, level);
+}
+
+bool Log::IsLevelEnabled(Logger const* logger, LogLevel level)
+{
     LogLevel logLevel = logger->getLogLevel();
     return logLevel != LOG_LEVEL_DISABLED && logLevel >= level;
 }
@@ -416,6 +487,8 @@ void Log::LoadFromConfig()
 
     ReadAppendersFromConfig();
     ReadLoggersFromConfig();
+    StartAsyncWriter();
+    ++_loggerGeneration;
 
     _debugLogMask = DebugLogFilters(sConfigMgr->GetOption<uint32>("DebugLogMask", LOG_FILTER_NONE, false));
 }
@@ -21,16 +21,37 @@
 #include "Define.h"
 #include "LogCommon.h"
 #include "StringFormat.h"
+#include <atomic>
 #include <memory>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
 class Appender;
+class AsyncLogWriter;
 class Logger;
 struct LogMessage;
 
 #define LOGGER_ROOT "root"
 
+/*
+ * Logger resolved for one LOG_* call site whose filter is a string literal.
+ * The macros keep one of these in a constant initialized function local static, so once
+ * resolved a disabled call costs a few relaxed loads and no string is hashed or built.
+ * The cache is invalidated through the logger generation whenever loggers are recreated.
+ * Logger and generation are published together under a sequence counter that is odd while
+ * a thread rewrites them, so a reader never pairs a logger with a generation it wasn't resolved for.
+ */
+struct LogFilterCache
+{
+    std::atomic<uint32> sequence{ 0 };
+    std::atomic<Logger const*> logger{ nullptr };
+    std::atomic<uint32> generation{ 0 };
+};
+
+// True when the filter argument of a LOG_* macro is spelled as a string literal
+#define LOG_FILTER_IS_LITERAL(filterType__) ((#filterType__)[0] == '"')
+
 typedef Appender*(*AppenderCreatorFn)(uint8 id, std::string const& name, LogLevel level, AppenderFlags flags, std::vector<std::string_view> const& extraArgs);
 
 template <class AppenderImpl>
@@ -58,6 +79,28 @@ public:
     void LoadFromConfig();
     void Close();
     bool ShouldLog(std::string const& type, LogLevel level) const;
+
+    // Call site cached variant, Literal is set by the LOG_* macros only for filters written as
+    // string literals, anything else (arrays and strings built at runtime) is looked up every call
+    template<bool Literal, typename Type>
+    bool ShouldLog(LogFilterCache& cache, Type const& type, LogLevel level) const
+    {
+        if constexpr (Literal && std::is_array_v<Type>)
+        {
+            if (level > highestLogLevel.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+
+            Logger const* logger = GetCachedLogger(cache, type);
+            return logger && IsLevelEnabled(logger, level);
+        }
+        else
+        {
+            return ShouldLog(type, level);
+        }
+    }
+
     bool SetLogLevel(std::string const& name, int32 level, bool isLogger = true);
 
     template<typename Format, typename... Args>
@@ -67,7 +110,7 @@ public:
     }
 
     template<typename... Args>
-    inline void outMessageFmt(std::string const& filter, LogLevel const level, std::string_view fmt, Args&&... args)
+    inline void outMessageFmt(std::string const& filter, LogLevel const level, fmt::format_string<Args...> fmt, Args&&... args)
     {
         _outMessageFmt(filter, level, fmt::format(fmt, std::forward<Args>(args)...));
     }
@@ -93,6 +136,11 @@ public:
         RegisterAppender(AppenderImpl::type, &CreateAppender<AppenderImpl>);
     }
 
+    // Blocks until the async writer handed every pending message to the appenders
+    void Flush();
+    bool IsAsync() const { return _asyncWriter != nullptr; }
+    uint64 GetAsyncDroppedCount() const;
+
     std::string const& GetLogsDir() const { return m_logsDir; }
     std::string const& GetLogsTimestamp() const { return m_logsTimestamp; }
 
@@ -186,12 +234,44 @@ private:
     void write(std::unique_ptr<LogMessage>&& msg) const;
 
     Logger const* GetLoggerByType(std::string const& type) const;
+    static bool IsLevelEnabled(Logger const* logger, LogLevel level);
+
+    Logger const* GetCachedLogger(LogFilterCache& cache, char const* type) const
+    {
+        uint32 const generation = _loggerGeneration.load(std::memory_order_acquire);
+        uint32 const sequence = cache.sequence.load(std::memory_order_acquire);
+        if (!(sequence & 1) && cache.generation.load(std::memory_order_relaxed) == generation)
+        {
+            Logger const* logger = cache.logger.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (cache.sequence.load(std::memory_order_relaxed) == sequence)
+            {
+                return logger;
+            }
+        }
+
+        Logger const* logger = GetLoggerByType(type);
+
+        // Another thread publishing the same call site wins, this lookup just isn't cached
+        uint32 expected = sequence;
+        if (!(sequence & 1) && cache.sequence.compare_exchange_strong(expected, sequence + 1, std::memory_order_relaxed))
+        {
+            std::atomic_thread_fence(std::memory_order_release);
+            cache.logger.store(logger, std::memory_order_relaxed);
+            cache.generation.store(generation, std::memory_order_relaxed);
+            cache.sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        return logger;
+    }
     Appender* GetAppenderByName(std::string_view name);
     uint8 NextAppenderId();
     void CreateAppenderFromConfig(std::string const& name);
     void CreateLoggerFromConfig(std::string const& name);
     void ReadAppendersFromConfig();
     void ReadLoggersFromConfig();
+    void StartAsyncWriter();
+    void FlushAppenders();
     void RegisterAppender(uint8 index, AppenderCreatorFn appenderCreateFn);
     void outMessage(std::string const& filter, LogLevel level, std::string&& message);
     void _outMessageFmt(std::string const& filter, LogLevel level, std::string&& message);
@@ -201,7 +281,10 @@ private:
     std::unordered_map<uint8, std::unique_ptr<Appender>> appenders;
     std::unordered_map<std::string, std::unique_ptr<Logger>> loggers;
     uint8 AppenderId;
-    LogLevel highestLogLevel;
+    std::atomic<LogLevel> highestLogLevel;
+    std::atomic<uint32> _loggerGeneration;
+
+    std::unique_ptr<AsyncLogWriter> _asyncWriter;
 
     std::string m_logsDir;
     std::string m_logsTimestamp;
@@ -234,7 +317,8 @@ void check_args(std::string const&, ...);
 // This will catch format errors on build time
 #define LOG_MESSAGE_BODY(filterType__, level__, ...)                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
+            static LogFilterCache logFilterCache__;                     \
+            if (sLog->ShouldLog<LOG_FILTER_IS_LITERAL(filterType__)>(logFilterCache__, filterType__, level__)) \
             {                                                           \
                 if (false)                                              \
                     check_args(__VA_ARGS__);                            \
@@ -247,7 +331,8 @@ void check_args(std::string const&, ...);
         __pragma(warning(push))                                         \
         __pragma(warning(disable:4127))                                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
+            static LogFilterCache logFilterCache__;                     \
+            if (sLog->ShouldLog<LOG_FILTER_IS_LITERAL(filterType__)>(logFilterCache__, filterType__, level__)) \
                 LOG_EXCEPTION_FREE(filterType__, level__, __VA_ARGS__); \
         } while (0)                                                     \
         __pragma(warning(pop))
@@ -283,12 +368,12 @@ void check_args(std::string const&, ...);
 #define LOG_GM(accountId__, ...) \
     sLog->outCommand(accountId__, __VA_ARGS__)
 
-// New format logging
+// New format logging, the format string is checked at compile time
 #define FMT_LOG_EXCEPTION_FREE(filterType__, level__, ...) \
     { \
         try \
         { \
-            sLog->outMessageFmt(filterType__, level__, fmt::format(__VA_ARGS__)); \
+            sLog->outMessageFmt(filterType__, level__, __VA_ARGS__); \
         } \
         catch (const std::exception& e) \
         { \
@@ -297,12 +382,17 @@ void check_args(std::string const&, ...);
         } \
     }
 
-#define FMT_LOG_MESSAGE_BODY(filterType__, level__, ...) \
+#ifdef PERFORMANCE_PROFILING
+#define FMT_LOG_MESSAGE_BODY(filterType__, level__, format__, ...) ((void)0)
+#else
+#define FMT_LOG_MESSAGE_BODY(filterType__, level__, format__, ...) \
     do \
     { \
-        if (sLog->ShouldLog(filterType__, level__)) \
-            FMT_LOG_EXCEPTION_FREE(filterType__, level__, __VA_ARGS__); \
+        static LogFilterCache logFilterCache__; \
+        if (sLog->ShouldLog<LOG_FILTER_IS_LITERAL(filterType__)>(logFilterCache__, filterType__, level__)) \
+            FMT_LOG_EXCEPTION_FREE(filterType__, level__, FMT_STRING(format__), ##__VA_ARGS__); \
     } while (0)
+#endif
 
 // Fatal - 1
 #define FMT_LOG_FATAL(filterType__, ...) \
@@ -28,7 +28,7 @@ std::string const& Logger::getName() const
 
 LogLevel Logger::getLogLevel() const
 {
-    return level;
+    return level.load(std::memory_order_relaxed);
 }
 
 void Logger::addAppender(uint8 id, Appender* appender)
@@ -43,12 +43,13 @@ void Logger::delAppender(uint8 id)
 
 void Logger::setLogLevel(LogLevel _level)
 {
-    level = _level;
+    level.store(_level, std::memory_order_relaxed);
 }
 
 void Logger::write(LogMessage* message) const
 {
-    if (!level || level < message->level || message->text.empty())
+    LogLevel logLevel = getLogLevel();
+    if (!logLevel || logLevel < message->level || message->text.empty())
     {
         //fprintf(stderr, "Logger::write: Logger %s, Level %u. Msg %s Level %u WRONG LEVEL MASK OR EMPTY MSG\n", getName().c_str(), getLogLevel(), message.text.c_str(), message.level);
         return;
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "LogCommon.h"
+#include <atomic>
 #include <string>
 #include <unordered_map>
 
@@ -41,7 +42,7 @@ public:
 
 private:
     std::string name;
-    LogLevel level;
+    std::atomic<LogLevel> level;
     std::unordered_map<uint8, Appender*> appenders;
 };
 
@@ -64,6 +64,13 @@ public:
         _queue.insert(_queue.begin(), begin, end);
     }
 
+    //! Exchanges the whole queue with the given storage, drains it while taking the lock only once.
+    void swap(StorageType& storage)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _queue.swap(storage);
+    }
+
     //! Gets the next result in the queue, if any.
     bool next(T& result)
     {
@@ -0,0 +1,170 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INDEXED_PRIORITY_QUEUE_H
+#define _INDEXED_PRIORITY_QUEUE_H
+
+#include "Define.h"
+#include <algorithm>
+#include <vector>
+
+namespace Acore
+{
+    // Binary heap of T* where every element stores its own heap position in the member HeapIndex,
+    // so priority changes and removals of arbitrary elements are O(log n) and the top is O(1).
+    // Compare(a, b) returns true when a must be ordered before b.
+    template<class T, class Compare, uint32 T::* HeapIndex>
+    class IndexedPriorityQueue
+    {
+    public:
+        explicit IndexedPriorityQueue(Compare compare = Compare()) : _compare(compare) { }
+
+        [[nodiscard]] bool empty() const { return _heap.empty(); }
+        [[nodiscard]] std::size_t size() const { return _heap.size(); }
+        [[nodiscard]] T* top() const { return _heap.empty() ? nullptr : _heap.front(); }
+
+        [[nodiscard]] bool contains(T const* element) const
+        {
+            uint32 index = element->*HeapIndex;
+            return index < _heap.size() && _heap[index] == element;
+        }
+
+        void push(T* element)
+        {
+            element->*HeapIndex = uint32(_heap.size());
+            _heap.push_back(element);
+            SiftUp(_heap.size() - 1);
+        }
+
+        void erase(T* element)
+        {
+            if (!contains(element))
+                return;
+
+            std::size_t index = element->*HeapIndex;
+            std::size_t last = _heap.size() - 1;
+            if (index != last)
+            {
+                Place(index, _heap[last]);
+                _heap.pop_back();
+                Restore(index);
+            }
+            else
+                _heap.pop_back();
+        }
+
+        // Must be called after the priority of an element changed
+        void update(T* element)
+        {
+            if (contains(element))
+                Restore(element->*HeapIndex);
+        }
+
+        void clear() { _heap.clear(); }
+
+        // Visits the elements in priority order until the visitor returns true and returns that element (or nullptr).
+        // Only the visited part of the heap is ordered, reaching the k-th element costs O(k log k).
+        template<class Visitor>
+        T* visitOrdered(Visitor&& visitor) const
+        {
+            if (_heap.empty())
+                return nullptr;
+
+            auto candidateOrder = [this](uint32 a, uint32 b) { return _compare(_heap[b], _heap[a]); };
+
+            _candidates.clear();
+            _candidates.push_back(0);
+            while (!_candidates.empty())
+            {
+                std::pop_heap(_candidates.begin(), _candidates.end(), candidateOrder);
+                uint32 index = _candidates.back();
+                _candidates.pop_back();
+
+                if (visitor(_heap[index]))
+                    return _heap[index];
+
+                for (std::size_t child = 2 * std::size_t(index) + 1; child <= 2 * std::size_t(index) + 2 && child < _heap.size(); ++child)
+                {
+                    _candidates.push_back(uint32(child));
+                    std::push_heap(_candidates.begin(), _candidates.end(), candidateOrder);
+                }
+            }
+
+            return nullptr;
+        }
+
+    private:
+        void Place(std::size_t index, T* element)
+        {
+            _heap[index] = element;
+            element->*HeapIndex = uint32(index);
+        }
+
+        void Restore(std::size_t index)
+        {
+            if (!SiftUp(index))
+                SiftDown(index);
+        }
+
+        bool SiftUp(std::size_t index)
+        {
+            T* element = _heap[index];
+            std::size_t start = index;
+            while (index > 0)
+            {
+                std::size_t parent = (index - 1) / 2;
+                if (!_compare(element, _heap[parent]))
+                    break;
+
+                Place(index, _heap[parent]);
+                index = parent;
+            }
+
+            Place(index, element);
+            return index != start;
+        }
+
+        void SiftDown(std::size_t index)
+        {
+            T* element = _heap[index];
+            std::size_t size = _heap.size();
+            while (true)
+            {
+                std::size_t child = 2 * index + 1;
+                if (child >= size)
+                    break;
+
+                if (child + 1 < size && _compare(_heap[child + 1], _heap[child]))
+                    ++child;
+
+                if (!_compare(_heap[child], element))
+                    break;
+
+                Place(index, _heap[child]);
+                index = child;
+            }
+
+            Place(index, element);
+        }
+
+        std::vector<T*> _heap;
+        mutable std::vector<uint32> _candidates;
+        Compare _compare;
+    };
+}
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "MappedFile.h"
+#include <mutex>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    std::mutex MappedFilesLock;
+    std::unordered_map<std::string, std::weak_ptr<MappedFile>> MappedFiles;
+    uint64 MappedSize = 0;
+}
+
+MappedFile::MappedFile(std::string const& path, uint8 const* data, std::size_t size, void* fileHandle, void* mappingHandle)
+    : _path(path), _data(data), _size(size), _fileHandle(fileHandle), _mappingHandle(mappingHandle)
+{
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    UnmapViewOfFile(_data);
+    CloseHandle(_mappingHandle);
+    CloseHandle(_fileHandle);
+#else
+    munmap(const_cast<uint8*>(_data), _size);
+#endif
+
+    std::lock_guard<std::mutex> guard(MappedFilesLock);
+    MappedSize -= _size;
+
+    // the file may have been mapped again since the last reference was dropped
+    auto itr = MappedFiles.find(_path);
+    if (itr != MappedFiles.end() && itr->second.expired())
+        MappedFiles.erase(itr);
+}
+
+std::shared_ptr<MappedFile> MappedFile::Open(std::string const& path)
+{
+    std::lock_guard<std::mutex> guard(MappedFilesLock);
+
+    auto itr = MappedFiles.find(path);
+    if (itr != MappedFiles.end())
+        if (std::shared_ptr<MappedFile> file = itr->second.lock())
+            return file;
+
+    uint8 const* data = nullptr;
+    std::size_t size = 0;
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+
+#ifdef _WIN32
+    HANDLE winFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (winFile == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(winFile, &fileSize) || !fileSize.QuadPart)
+    {
+        CloseHandle(winFile);
+        return nullptr;
+    }
+
+    HANDLE winMapping = CreateFileMappingA(winFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!winMapping)
+    {
+        CloseHandle(winFile);
+        return nullptr;
+    }
+
+    data = static_cast<uint8 const*>(MapViewOfFile(winMapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data)
+    {
+        CloseHandle(winMapping);
+        CloseHandle(winFile);
+        return nullptr;
+    }
+
+    size = std::size_t(fileSize.QuadPart);
+    fileHandle = winFile;
+    mappingHandle = winMapping;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    size = std::size_t(fileStat.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+
+    // the mapping keeps its own reference to the file
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+        return nullptr;
+
+    data = static_cast<uint8 const*>(mapping);
+#endif
+
+    std::shared_ptr<MappedFile> file(new MappedFile(path, data, size, fileHandle, mappingHandle));
+    MappedFiles[path] = file;
+    MappedSize += size;
+    return file;
+}
+
+uint32 MappedFile::GetMappedFileCount()
+{
+    std::lock_guard<std::mutex> guard(MappedFilesLock);
+
+    uint32 count = 0;
+    for (auto const& itr : MappedFiles)
+        if (!itr.second.expired())
+            ++count;
+
+    return count;
+}
+
+uint64 MappedFile::GetMappedSize()
+{
+    std::lock_guard<std::mutex> guard(MappedFilesLock);
+    return MappedSize;
+}
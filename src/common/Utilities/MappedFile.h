@@ -0,0 +1,63 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _MAPPEDFILE_H
+#define _MAPPEDFILE_H
+
+#include "Define.h"
+#include <memory>
+#include <string>
+
+/*
+ * Read-only memory mapping of a whole file.
+ *
+ * Opening a file that is already mapped returns the existing mapping, the pages are read by the
+ * operating system on first access and live in its page cache, shared with every other mapping
+ * of the same file instead of being copied in the process' heap.
+ */
+class AC_COMMON_API MappedFile
+{
+public:
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    // nullptr if the file can't be opened, is empty or can't be mapped
+    static std::shared_ptr<MappedFile> Open(std::string const& path);
+
+    [[nodiscard]] uint8 const* GetData() const { return _data; }
+    [[nodiscard]] std::size_t GetSize() const { return _size; }
+    [[nodiscard]] bool Contains(void const* pointer) const
+    {
+        return pointer >= static_cast<void const*>(_data) && pointer < static_cast<void const*>(_data + _size);
+    }
+
+    // files currently mapped by the process and their total size
+    static uint32 GetMappedFileCount();
+    static uint64 GetMappedSize();
+
+private:
+    MappedFile(std::string const& path, uint8 const* data, std::size_t size, void* fileHandle, void* mappingHandle);
+
+    std::string _path;
+    uint8 const* _data;
+    std::size_t _size;
+    void* _fileHandle;      // windows only
+    void* _mappingHandle;   // windows only
+};
+
+#endif
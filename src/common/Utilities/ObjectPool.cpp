@@ -0,0 +1,266 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ObjectPool.h"
+#include "Errors.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace
+{
+    constexpr std::size_t SizeClassGranularity = 16;
+    constexpr std::size_t MaxPooledSize = 8192;
+    constexpr std::size_t SizeClassCount = MaxPooledSize / SizeClassGranularity;
+    constexpr std::size_t MaxCachedBytesPerClass = 256 * 1024;
+    constexpr uint32 MaxObjectPools = 32;
+
+    struct FreeBlock
+    {
+        FreeBlock* Next;
+    };
+
+    // only written by the owning thread, so a plain load and store is enough and avoids locked instructions
+    struct PoolCounters
+    {
+        std::atomic<uint64> Allocations{0};
+        std::atomic<uint64> Reused{0};
+        std::atomic<uint64> Deallocations{0};
+    };
+
+    void Increment(std::atomic<uint64>& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    struct ThreadCache;
+
+    struct PoolRegistry
+    {
+        std::mutex Lock;
+        std::vector<ObjectPool*> Pools;
+        std::vector<ThreadCache*> Threads;
+        PoolCounters Retired[MaxObjectPools];           // counters of exited threads, updated with atomic adds
+        uint32 NextPoolId = 0;
+    };
+
+    // never destroyed, threads may still exit and pools may still be used during static destruction
+    PoolRegistry& GetRegistry()
+    {
+        static PoolRegistry* registry = new PoolRegistry();
+        return *registry;
+    }
+
+    thread_local bool CacheDestroyed = false;
+
+    struct ThreadCache
+    {
+        FreeBlock* FreeLists[SizeClassCount] = { };
+        uint32 Counts[SizeClassCount] = { };
+        PoolCounters Counters[MaxObjectPools];
+
+        ThreadCache()
+        {
+            PoolRegistry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.Lock);
+            registry.Threads.push_back(this);
+        }
+
+        ~ThreadCache()
+        {
+            CacheDestroyed = true;
+
+            {
+                PoolRegistry& registry = GetRegistry();
+                std::lock_guard<std::mutex> guard(registry.Lock);
+                for (uint32 i = 0; i < MaxObjectPools; ++i)
+                {
+                    registry.Retired[i].Allocations += Counters[i].Allocations.load(std::memory_order_relaxed);
+                    registry.Retired[i].Reused += Counters[i].Reused.load(std::memory_order_relaxed);
+                    registry.Retired[i].Deallocations += Counters[i].Deallocations.load(std::memory_order_relaxed);
+                }
+
+                registry.Threads.erase(std::remove(registry.Threads.begin(), registry.Threads.end(), this), registry.Threads.end());
+            }
+
+            for (std::size_t i = 0; i < SizeClassCount; ++i)
+            {
+                while (FreeBlock* block = FreeLists[i])
+                {
+                    FreeLists[i] = block->Next;
+                    ::operator delete(block);
+                }
+            }
+        }
+    };
+
+    thread_local ThreadCache Cache;
+
+    std::size_t GetSizeClass(std::size_t size)
+    {
+        return (std::max<std::size_t>(size, 1) - 1) / SizeClassGranularity;
+    }
+}
+
+ObjectPool::ObjectPool(char const* name) : _name(name), _allocationsAtReset(0), _reusedAtReset(0)
+{
+    PoolRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.Lock);
+
+    _id = registry.NextPoolId++;
+    ASSERT(_id < MaxObjectPools, "Too many object pools, raise MaxObjectPools");
+    registry.Pools.push_back(this);
+}
+
+ObjectPool::~ObjectPool()
+{
+    PoolRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.Lock);
+    registry.Pools.erase(std::remove(registry.Pools.begin(), registry.Pools.end(), this), registry.Pools.end());
+}
+
+void* ObjectPool::Allocate(std::size_t size)
+{
+    // always allocate the whole size class, the block may end up in the cache of another thread
+    std::size_t sizeClass = GetSizeClass(size);
+    std::size_t blockSize = size > MaxPooledSize ? size : (sizeClass + 1) * SizeClassGranularity;
+
+    if (CacheDestroyed)
+    {
+        GetRegistry().Retired[_id].Allocations.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(blockSize);
+    }
+
+    ThreadCache& cache = Cache;
+    Increment(cache.Counters[_id].Allocations);
+
+    if (size <= MaxPooledSize)
+    {
+        if (FreeBlock* block = cache.FreeLists[sizeClass])
+        {
+            cache.FreeLists[sizeClass] = block->Next;
+            --cache.Counts[sizeClass];
+            Increment(cache.Counters[_id].Reused);
+            return block;
+        }
+    }
+
+    return ::operator new(blockSize);
+}
+
+void ObjectPool::Deallocate(void* ptr, std::size_t size)
+{
+    if (!ptr)
+        return;
+
+    if (CacheDestroyed)
+    {
+        GetRegistry().Retired[_id].Deallocations.fetch_add(1, std::memory_order_relaxed);
+        ::operator delete(ptr);
+        return;
+    }
+
+    ThreadCache& cache = Cache;
+    Increment(cache.Counters[_id].Deallocations);
+
+    std::size_t sizeClass = GetSizeClass(size);
+    if (size > MaxPooledSize || cache.Counts[sizeClass] * (sizeClass + 1) * SizeClassGranularity >= MaxCachedBytesPerClass)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->Next = cache.FreeLists[sizeClass];
+    cache.FreeLists[sizeClass] = block;
+    ++cache.Counts[sizeClass];
+}
+
+// registry lock must be held
+ObjectPoolStats ObjectPool::CollectStats() const
+{
+    PoolRegistry& registry = GetRegistry();
+
+    uint64 allocations = registry.Retired[_id].Allocations.load(std::memory_order_relaxed);
+    uint64 reused = registry.Retired[_id].Reused.load(std::memory_order_relaxed);
+    uint64 deallocations = registry.Retired[_id].Deallocations.load(std::memory_order_relaxed);
+    for (ThreadCache const* cache : registry.Threads)
+    {
+        allocations += cache->Counters[_id].Allocations.load(std::memory_order_relaxed);
+        reused += cache->Counters[_id].Reused.load(std::memory_order_relaxed);
+        deallocations += cache->Counters[_id].Deallocations.load(std::memory_order_relaxed);
+    }
+
+    ObjectPoolStats stats;
+    stats.Name = _name;
+    stats.Allocations = allocations;
+    stats.Reused = reused;
+    stats.Live = int64(allocations - deallocations);
+    return stats;
+}
+
+ObjectPoolStats ObjectPool::GetStats() const
+{
+    std::lock_guard<std::mutex> guard(GetRegistry().Lock);
+
+    ObjectPoolStats stats = CollectStats();
+    stats.Allocations -= _allocationsAtReset;
+    stats.Reused -= _reusedAtReset;
+    return stats;
+}
+
+void ObjectPool::ResetStats()
+{
+    std::lock_guard<std::mutex> guard(GetRegistry().Lock);
+
+    // live blocks are not a statistic, keep counting them
+    ObjectPoolStats stats = CollectStats();
+    _allocationsAtReset = stats.Allocations;
+    _reusedAtReset = stats.Reused;
+}
+
+std::vector<ObjectPoolStats> ObjectPool::GetAllStats()
+{
+    PoolRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.Lock);
+
+    std::vector<ObjectPoolStats> allStats;
+    allStats.reserve(registry.Pools.size());
+    for (ObjectPool const* pool : registry.Pools)
+    {
+        ObjectPoolStats stats = pool->CollectStats();
+        stats.Allocations -= pool->_allocationsAtReset;
+        stats.Reused -= pool->_reusedAtReset;
+        allStats.push_back(stats);
+    }
+
+    return allStats;
+}
+
+void ObjectPool::ResetAllStats()
+{
+    PoolRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.Lock);
+
+    for (ObjectPool* pool : registry.Pools)
+    {
+        ObjectPoolStats stats = pool->CollectStats();
+        pool->_allocationsAtReset = stats.Allocations;
+        pool->_reusedAtReset = stats.Reused;
+    }
+}
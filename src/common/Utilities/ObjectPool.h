@@ -0,0 +1,95 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _OBJECT_POOL_H
+#define _OBJECT_POOL_H
+
+#include "Define.h"
+#include <cstddef>
+#include <vector>
+
+struct ObjectPoolStats
+{
+    char const* Name = "";
+    uint64 Allocations = 0;                             // blocks handed out since the last reset
+    uint64 Reused = 0;                                  // allocations served from a thread cache instead of the heap
+    int64 Live = 0;                                     // blocks currently in use
+
+    [[nodiscard]] float GetReuseRate() const { return Allocations ? float(Reused) * 100.0f / float(Allocations) : 0.0f; }
+};
+
+// Allocation source for frequently created objects, used through class specific operator new/delete.
+// Freed blocks are kept on free lists of the freeing thread (one per 16 byte size class, shared by all pools)
+// and handed out again by the next allocation of that size on that thread, so map threads recycle
+// their own spells and auras without touching the global heap. A block may be freed on another thread
+// than the one that allocated it, it then simply joins the cache of that thread.
+class AC_COMMON_API ObjectPool
+{
+public:
+    explicit ObjectPool(char const* name);
+    ~ObjectPool();
+
+    ObjectPool(ObjectPool const&) = delete;
+    ObjectPool& operator=(ObjectPool const&) = delete;
+
+    void* Allocate(std::size_t size);
+    void Deallocate(void* ptr, std::size_t size);
+
+    [[nodiscard]] ObjectPoolStats GetStats() const;
+    void ResetStats();
+
+    static std::vector<ObjectPoolStats> GetAllStats();
+    static void ResetAllStats();
+
+private:
+    ObjectPoolStats CollectStats() const;
+
+    char const* _name;
+    uint32 _id;                                         // index of the per thread counters of this pool
+    uint64 _allocationsAtReset;
+    uint64 _reusedAtReset;
+};
+
+// Stateless std allocator for node based containers, e.g. std::list<T, ObjectPoolAllocator<T, &GetMyPool>>
+template<class T, ObjectPool& (*GetPool)()>
+class ObjectPoolAllocator
+{
+public:
+    typedef T value_type;
+
+    template<class U>
+    struct rebind
+    {
+        typedef ObjectPoolAllocator<U, GetPool> other;
+    };
+
+    ObjectPoolAllocator() = default;
+
+    template<class U>
+    ObjectPoolAllocator(ObjectPoolAllocator<U, GetPool> const& /*other*/) { }
+
+    T* allocate(std::size_t count) { return static_cast<T*>(GetPool().Allocate(count * sizeof(T))); }
+    void deallocate(T* ptr, std::size_t count) { GetPool().Deallocate(ptr, count * sizeof(T)); }
+
+    template<class U>
+    bool operator==(ObjectPoolAllocator<U, GetPool> const& /*other*/) const { return true; }
+
+    template<class U>
+    bool operator!=(ObjectPoolAllocator<U, GetPool> const& /*other*/) const { return false; }
+};
+
+#endif
@@ -104,7 +104,7 @@ int main(int argc, char** argv)
     Acore::Banner::Show("authserver",
         [](std::string_view text)
         {
-            FMT_LOG_INFO("server.authserver", text);
+            FMT_LOG_INFO("server.authserver", "{}", text);
         },
         []()
         {
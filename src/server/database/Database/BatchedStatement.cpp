@@ -0,0 +1,200 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BatchedStatement.h"
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+#include <regex>
+#include <unordered_map>
+
+namespace
+{
+    std::string Trim(std::string const& sql)
+    {
+        std::size_t begin = sql.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos)
+            return "";
+
+        std::size_t end = sql.find_last_not_of(" \t\r\n;");
+        return sql.substr(begin, end + 1 - begin);
+    }
+
+    // position of the first character after the parenthesized group starting at begin, npos if it isn't closed
+    std::size_t SkipGroup(std::string const& sql, std::size_t begin)
+    {
+        uint32 depth = 0;
+        char quote = 0;
+        for (std::size_t i = begin; i < sql.size(); ++i)
+        {
+            char c = sql[i];
+            if (quote)
+            {
+                if (c == '\\')
+                    ++i;
+                else if (c == quote)
+                    quote = 0;
+            }
+            else if (c == '\'' || c == '"' || c == '`')
+                quote = c;
+            else if (c == '(')
+                ++depth;
+            else if (c == ')' && !--depth)
+                return i + 1;
+        }
+
+        return std::string::npos;
+    }
+
+    // placeholders outside of quoted literals and identifiers
+    uint32 CountPlaceholders(std::string const& sql)
+    {
+        uint32 count = 0;
+        char quote = 0;
+        for (std::size_t i = 0; i < sql.size(); ++i)
+        {
+            char c = sql[i];
+            if (quote)
+            {
+                if (c == '\\')
+                    ++i;
+                else if (c == quote)
+                    quote = 0;
+            }
+            else if (c == '\'' || c == '"' || c == '`')
+                quote = c;
+            else if (c == '?')
+                ++count;
+        }
+
+        return count;
+    }
+}
+
+BatchedStatementTemplate::BatchedStatementTemplate(std::string const& sql) : _rowParameters(0)
+{
+    std::string trimmed = Trim(sql);
+    if (!ParseInsert(trimmed) && !ParseDelete(trimmed))
+    {
+        _prefix.clear();
+        _row.clear();
+        _suffix.clear();
+        _rowParameters = 0;
+    }
+}
+
+std::shared_ptr<BatchedStatementTemplate const> BatchedStatementTemplate::Get(std::string const& sql)
+{
+    static std::mutex lock;
+    static std::unordered_map<std::string, std::shared_ptr<BatchedStatementTemplate const>> templates;
+
+    std::lock_guard<std::mutex> guard(lock);
+    std::shared_ptr<BatchedStatementTemplate const>& batchTemplate = templates[sql];
+    if (!batchTemplate)
+        batchTemplate = std::make_shared<BatchedStatementTemplate const>(sql);
+
+    return batchTemplate;
+}
+
+bool BatchedStatementTemplate::ParseInsert(std::string const& sql)
+{
+    static std::regex const insert(R"(^(INSERT|REPLACE)(\s+IGNORE)?\s+INTO\s+[^(]+(\([^()?]*\))?\s*VALUES\s*)", std::regex::icase);
+
+    std::smatch match;
+    if (!std::regex_search(sql, match, insert))
+        return false;
+
+    std::size_t rowBegin = std::size_t(match.length(0));
+    if (rowBegin >= sql.size() || sql[rowBegin] != '(')
+        return false;
+
+    // the row must end the statement
+    std::size_t rowEnd = SkipGroup(sql, rowBegin);
+    if (rowEnd != sql.size())
+        return false;
+
+    _prefix = sql.substr(0, rowBegin);
+    _row = sql.substr(rowBegin);
+    _rowParameters = CountPlaceholders(_row);
+    return _rowParameters && !CountPlaceholders(_prefix);
+}
+
+bool BatchedStatementTemplate::ParseDelete(std::string const& sql)
+{
+    static std::regex const deleteFrom(R"(^DELETE\s+FROM\s+([`\w.]+)\s+WHERE\s+(.+)$)", std::regex::icase);
+    static std::regex const condition(R"(^\s*([`\w.]+)\s*=\s*\?\s*$)");
+    static std::regex const conjunction(R"(\s+AND\s+)", std::regex::icase);
+
+    std::smatch match;
+    if (!std::regex_match(sql, match, deleteFrom))
+        return false;
+
+    std::string const where = match[2].str();
+    std::string columns;
+    uint32 count = 0;
+    for (std::sregex_token_iterator itr(where.begin(), where.end(), conjunction, -1), end; itr != end; ++itr)
+    {
+        std::string const part = itr->str();
+        std::smatch column;
+        if (!std::regex_match(part, column, condition))
+            return false;
+
+        if (count++)
+            columns += ", ";
+
+        columns += column[1].str();
+    }
+
+    if (!count)
+        return false;
+
+    _prefix = "DELETE FROM " + match[1].str() + " WHERE ";
+    if (count == 1)
+    {
+        _prefix += columns + " IN (";
+        _row = "?";
+    }
+    else
+    {
+        _prefix += "(" + columns + ") IN (";
+        _row = "(?";
+        for (uint32 i = 1; i < count; ++i)
+            _row += ", ?";
+        _row += ")";
+    }
+
+    _suffix = ")";
+    _rowParameters = count;
+    return true;
+}
+
+std::string BatchedStatementTemplate::GetQueryString(uint32 rows) const
+{
+    std::string sql;
+    sql.reserve(_prefix.size() + rows * (_row.size() + 2) + _suffix.size());
+    sql += _prefix;
+    for (uint32 i = 0; i < rows; ++i)
+    {
+        if (i)
+            sql += ", ";
+
+        sql += _row;
+    }
+
+    sql += _suffix;
+    return sql;
+}
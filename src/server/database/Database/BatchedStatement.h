@@ -0,0 +1,60 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BATCHEDSTATEMENT_H
+#define _BATCHEDSTATEMENT_H
+
+#include "Define.h"
+#include <memory>
+#include <string>
+
+/*
+ * Multi-row form of a prepared statement, used to run consecutive executions of the statement
+ * inside a transaction as a single one.
+ *
+ *   INSERT|REPLACE [IGNORE] INTO t (a, b) VALUES (?, ?)   ->  ... VALUES (?, ?), (?, ?), ...
+ *   DELETE FROM t WHERE a = ?                             ->  DELETE FROM t WHERE a IN (?, ?, ...)
+ *   DELETE FROM t WHERE a = ? AND b = ?                   ->  DELETE FROM t WHERE (a, b) IN ((?, ?), (?, ?), ...)
+ *
+ * Statements of any other shape (ON DUPLICATE KEY UPDATE, INSERT ... SELECT, DELETE with LIMIT or
+ * non equality conditions, ...) are not batchable.
+ */
+class AC_DATABASE_API BatchedStatementTemplate
+{
+public:
+    explicit BatchedStatementTemplate(std::string const& sql);
+
+    // every connection of a pool prepares the same statements, each query string is parsed once
+    static std::shared_ptr<BatchedStatementTemplate const> Get(std::string const& sql);
+
+    [[nodiscard]] bool IsBatchable() const { return _rowParameters != 0; }
+    [[nodiscard]] uint32 GetRowParameterCount() const { return _rowParameters; }
+
+    // the statement executing rows executions of the original one
+    [[nodiscard]] std::string GetQueryString(uint32 rows) const;
+
+private:
+    bool ParseInsert(std::string const& sql);
+    bool ParseDelete(std::string const& sql);
+
+    std::string _prefix;
+    std::string _row;
+    std::string _suffix;
+    uint32 _rowParameters;
+};
+
+#endif
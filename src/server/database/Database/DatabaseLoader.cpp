@@ -21,6 +21,8 @@
 #include "DatabaseEnv.h"
 #include "Duration.h"
 #include "Log.h"
+#include "MySQLConnection.h"
+#include "SynchConnectionQueue.h"
 #include <errmsg.h>
 #include <mysqld_error.h>
 #include <thread>
@@ -29,6 +31,9 @@ DatabaseLoader::DatabaseLoader(std::string const& logger, uint32 const defaultUp
     : _logger(logger), _autoSetup(sConfigMgr->GetOption<bool>("Updates.AutoSetup", true)),
     _updateFlags(sConfigMgr->GetOption<uint32>("Updates.EnableDatabases", defaultUpdateMask))
 {
+    MySQLConnection::SetMaxBatchedRows(sConfigMgr->GetOption<uint32>("Database.MaxBatchedRows", 64));
+    SynchConnectionQueue::SetWaitTimeout(Milliseconds(sConfigMgr->GetOption<uint32>("Database.SynchWaitTimeout", 5000)));
+    SynchConnectionQueue::SetQueryBudget(Milliseconds(sConfigMgr->GetOption<uint32>("Database.SynchQueryBudget", 50)));
 }
 
 template <class T>
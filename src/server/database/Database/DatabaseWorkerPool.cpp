@@ -111,6 +111,10 @@ uint32 DatabaseWorkerPool<T>::Open()
 
     if (!error)
     {
+        _synchQueue = std::make_unique<SynchConnectionQueue>(GetDatabaseName());
+        for (auto& connection : _connections[IDX_SYNCH])
+            _synchQueue->AddConnection(connection.get());
+
         LOG_INFO("sql.driver", "DatabasePool '%s' opened successfully. " SZFMTD
                     " total connections running.", GetDatabaseName(),
                     (_connections[IDX_SYNCH].size() + _connections[IDX_ASYNC].size()));
@@ -137,6 +141,9 @@ void DatabaseWorkerPool<T>::Close()
     //! There's no need for locking the connection, because DatabaseWorkerPool<>::Close
     //! should only be called after any other thread tasks in the core have exited,
     //! meaning there can be no concurrent access at this point.
+    if (_synchQueue)
+        _synchQueue->Clear();
+
     _connections[IDX_SYNCH].clear();
 
     LOG_INFO("sql.driver", "All connections on DatabasePool '%s' closed.", GetDatabaseName());
@@ -203,6 +210,28 @@ QueryResult DatabaseWorkerPool<T>::Query(char const* sql, T* connection /*= null
     return QueryResult(result);
 }
 
+template <class T>
+QueryResult DatabaseWorkerPool<T>::StreamQuery(char const* sql)
+{
+    T* connection = GetFreeConnection();
+
+    // the result set unlocks the connection once every row was read
+    ResultSet* result = connection->StreamQuery(sql);
+    if (!result)
+    {
+        connection->Unlock();
+        return QueryResult(nullptr);
+    }
+
+    if (!result->NextRow())
+    {
+        delete result;
+        return QueryResult(nullptr);
+    }
+
+    return QueryResult(result);
+}
+
 template <class T>
 PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement<T>* stmt)
 {
@@ -442,20 +471,9 @@ T* DatabaseWorkerPool<T>::GetFreeConnection()
     }
 #endif
 
-    uint8 i = 0;
-    auto const num_cons = _connections[IDX_SYNCH].size();
-    T* connection = nullptr;
-
-    //! Block forever until a connection is free
-    for (;;)
-    {
-        connection = _connections[IDX_SYNCH][++i % num_cons].get();
-        //! Must be matched with t->Unlock() or you will get deadlocks
-        if (connection->LockIfReady())
-            break;
-    }
-
-    return connection;
+    //! Block until a connection is free, threads are served in arrival order
+    //! Must be matched with t->Unlock() or you will get deadlocks
+    return static_cast<T*>(_synchQueue->Acquire());
 }
 
 template <class T>
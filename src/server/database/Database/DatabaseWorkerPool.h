@@ -21,6 +21,7 @@
 #include "DatabaseEnvFwd.h"
 #include "Define.h"
 #include "StringFormat.h"
+#include "SynchConnectionQueue.h"
 #include <array>
 #include <string>
 #include <vector>
@@ -116,6 +117,13 @@ public:
     //! Returns reference counted auto pointer, no need for manual memory management in upper level code.
     QueryResult Query(char const* sql, T* connection = nullptr);
 
+    //! Directly executes an SQL query in string format, the rows are received from the server while the result is iterated
+    //! instead of being stored first and GetRowCount() returns 0. Meant for bulk loads of big tables.
+    //! The connection stays reserved until the last row was read or the result is released, the result must be iterated
+    //! by the calling thread and no synchronous query of the same database may be made meanwhile.
+    //! The server aborts if the connection fails before the last row was read, the rows would be incomplete.
+    QueryResult StreamQuery(char const* sql);
+
     //! Directly executes an SQL query in string format -with variable args- that will block the calling thread until finished.
     //! Returns reference counted auto pointer, no need for manual memory management in upper level code.
     template<typename Format, typename... Args>
@@ -206,6 +214,23 @@ public:
     //! Keeps all our MySQL connections alive, prevent the server from disconnecting us.
     void KeepAlive();
 
+    //! Number of connections serving synchronous queries, the amount of threads that can query without waiting on each other.
+    std::size_t GetSynchConnectionCount() const
+    {
+        return _connections[IDX_SYNCH].size();
+    }
+
+    //! Time the threads waited for a synchronous connection, by kind of thread
+    void GetSynchWaitStats(std::array<SynchWaitStats, MAX_SYNCH_CALLERS>& stats) const
+    {
+        _synchQueue->GetStats(stats);
+    }
+
+    void ResetSynchWaitStats()
+    {
+        _synchQueue->ResetStats();
+    }
+
     void WarnAboutSyncQueries([[maybe_unused]] bool warn)
     {
 #ifdef ACORE_DEBUG
@@ -220,7 +245,7 @@ private:
 
     void Enqueue(SQLOperation* op);
 
-    //! Gets a free connection in the synchronous connection pool.
+    //! Gets a free connection in the synchronous connection pool, blocks until one is released.
     //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
     T* GetFreeConnection();
 
@@ -228,6 +253,8 @@ private:
 
     //! Queue shared by async worker threads.
     std::unique_ptr<ProducerConsumerQueue<SQLOperation*>> _queue;
+    //! Threads waiting for a synchronous connection, outlives the connections referencing it.
+    std::unique_ptr<SynchConnectionQueue> _synchQueue;
     std::array<std::vector<std::unique_ptr<T>>, IDX_SIZE> _connections;
     std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
     std::vector<uint8> _preparedStatementSize;
@@ -192,6 +192,8 @@ enum CharacterDatabaseStatements : uint32
     CHAR_DEL_EQUIP_SET,
 
     CHAR_INS_AURA,
+    CHAR_REP_AURA,
+    CHAR_DEL_AURA,
 
     CHAR_SEL_ACCOUNT_DATA,
     CHAR_REP_ACCOUNT_DATA,
@@ -24,6 +24,7 @@
 #include "MySQLWorkaround.h"
 #include "PreparedStatement.h"
 #include "QueryResult.h"
+#include "SynchConnectionQueue.h"
 #include "Timer.h"
 #include "Tokenize.h"
 #include "Transaction.h"
@@ -31,6 +32,8 @@
 #include <errmsg.h>
 #include <mysqld_error.h>
 
+uint32 MySQLConnection::s_maxBatchedRows = 64;
+
 MySQLConnectionInfo::MySQLConnectionInfo(std::string const& infoString)
 {
     std::vector<std::string_view> tokens = Acore::Tokenize(infoString, ';', true);
@@ -54,7 +57,8 @@ m_prepareError(false),
 m_queue(nullptr),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
-m_connectionFlags(CONNECTION_SYNCH) { }
+m_connectionFlags(CONNECTION_SYNCH),
+m_synchQueue(nullptr) { }
 
 MySQLConnection::MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
@@ -62,7 +66,8 @@ m_prepareError(false),
 m_queue(queue),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
-m_connectionFlags(CONNECTION_ASYNC)
+m_connectionFlags(CONNECTION_ASYNC),
+m_synchQueue(nullptr)
 {
     m_worker = std::make_unique<DatabaseWorker>(m_queue, this);
 }
@@ -261,6 +266,59 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
     return true;
 }
 
+bool MySQLConnection::Execute(std::vector<PreparedStatementBase*> const& stmts)
+{
+    if (!m_Mysql)
+        return false;
+
+    MySQLPreparedStatement* m_mStmt = GetBatchedStatement(stmts.front()->GetIndex(), uint32(stmts.size()));
+    if (!m_mStmt)
+    {
+        // the multi-row form could not be prepared, execute them one by one
+        for (PreparedStatementBase* stmt : stmts)
+            if (!Execute(stmt))
+                return false;
+
+        return true;
+    }
+
+    m_mStmt->BindParameters(stmts);
+
+    MYSQL_STMT* msql_STMT = m_mStmt->GetSTMT();
+    MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
+
+    uint32 _s = getMSTime();
+
+    if (mysql_stmt_bind_param(msql_STMT, msql_BIND))
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        LOG_ERROR("sql.sql", "SQL(p) %u rows: %s\n [ERROR]: [%u] %s", uint32(stmts.size()), m_mStmt->getQueryString().c_str(), lErrno, mysql_stmt_error(msql_STMT));
+
+        if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
+            return Execute(stmts);      // Try again
+
+        m_mStmt->ClearParameters();
+        return false;
+    }
+
+    if (mysql_stmt_execute(msql_STMT))
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        LOG_ERROR("sql.sql", "SQL(p) %u rows: %s\n [ERROR]: [%u] %s", uint32(stmts.size()), m_mStmt->getQueryString().c_str(), lErrno, mysql_stmt_error(msql_STMT));
+
+        if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
+            return Execute(stmts);      // Try again
+
+        m_mStmt->ClearParameters();
+        return false;
+    }
+
+    LOG_DEBUG("sql.sql", "[%u ms] SQL(p) %u rows: %s", getMSTimeDiff(_s, getMSTime()), uint32(stmts.size()), m_mStmt->getQueryString().c_str());
+
+    m_mStmt->ClearParameters();
+    return true;
+}
+
 bool MySQLConnection::_Query(PreparedStatementBase* stmt, MySQLPreparedStatement** mysqlStmt, MySQLResult** pResult, uint64* pRowCount, uint32* pFieldCount)
 {
     if (!m_Mysql)
@@ -331,7 +389,23 @@ ResultSet* MySQLConnection::Query(char const* sql)
     return new ResultSet(result, fields, rowCount, fieldCount);
 }
 
-bool MySQLConnection::_Query(const char* sql, MySQLResult** pResult, MySQLField** pFields, uint64* pRowCount, uint32* pFieldCount)
+ResultSet* MySQLConnection::StreamQuery(char const* sql)
+{
+    if (!sql)
+        return nullptr;
+
+    MySQLResult* result = nullptr;
+    MySQLField* fields = nullptr;
+    uint64 rowCount = 0;
+    uint32 fieldCount = 0;
+
+    if (!_Query(sql, &result, &fields, &rowCount, &fieldCount, true))
+        return nullptr;
+
+    return new ResultSet(result, fields, 0, fieldCount, this);
+}
+
+bool MySQLConnection::_Query(const char* sql, MySQLResult** pResult, MySQLField** pFields, uint64* pRowCount, uint32* pFieldCount, bool stream /*= false*/)
 {
     if (!m_Mysql)
         return false;
@@ -346,22 +420,23 @@ bool MySQLConnection::_Query(const char* sql, MySQLResult** pResult, MySQLField*
             LOG_ERROR("sql.sql", "[%u] %s", lErrno, mysql_error(m_Mysql));
 
             if (_HandleMySQLErrno(lErrno))      // If it returns true, an error was handled successfully (i.e. reconnection)
-                return _Query(sql, pResult, pFields, pRowCount, pFieldCount);    // We try again
+                return _Query(sql, pResult, pFields, pRowCount, pFieldCount, stream);    // We try again
 
             return false;
         }
         else
             LOG_DEBUG("sql.sql", "[%u ms] SQL: %s", getMSTimeDiff(_s, getMSTime()), sql);
 
-        *pResult = reinterpret_cast<MySQLResult*>(mysql_store_result(m_Mysql));
-        *pRowCount = mysql_affected_rows(m_Mysql);
+        // a streamed result only knows its row count once every row was read
+        *pResult = reinterpret_cast<MySQLResult*>(stream ? mysql_use_result(m_Mysql) : mysql_store_result(m_Mysql));
+        *pRowCount = stream ? 0 : mysql_affected_rows(m_Mysql);
         *pFieldCount = mysql_field_count(m_Mysql);
     }
 
     if (!*pResult )
         return false;
 
-    if (!*pRowCount)
+    if (!stream && !*pRowCount)
     {
         mysql_free_result(*pResult);
         return false;
@@ -395,22 +470,41 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
 
     BeginTransaction();
 
-    for (auto itr = queries.begin(); itr != queries.end(); ++itr)
+    std::vector<PreparedStatementBase*> batch;
+
+    for (std::size_t i = 0; i < queries.size();)
     {
-        SQLElementData const& data = *itr;
-        switch (itr->type)
+        SQLElementData const& data = queries[i];
+        switch (data.type)
         {
             case SQL_ELEMENT_PREPARED:
             {
                 PreparedStatementBase* stmt = data.element.stmt;
                 ASSERT(stmt);
-                if (!Execute(stmt))
+
+                // consecutive executions of the same INSERT, REPLACE or DELETE statement run as one multi-row statement
+                std::size_t rows = GetBatchSize(queries, i);
+                bool executed;
+                if (rows > 1)
+                {
+                    batch.clear();
+                    for (std::size_t row = 0; row < rows; ++row)
+                        batch.push_back(queries[i + row].element.stmt);
+
+                    executed = Execute(batch);
+                }
+                else
+                    executed = Execute(stmt);
+
+                if (!executed)
                 {
                     LOG_WARN("sql.sql", "Transaction aborted. %u queries not executed.", (uint32)queries.size());
                     int errorCode = GetLastError();
                     RollbackTransaction();
                     return errorCode;
                 }
+
+                i += rows;
             }
             break;
             case SQL_ELEMENT_RAW:
@@ -424,6 +518,8 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
                     RollbackTransaction();
                     return errorCode;
                 }
+
+                ++i;
             }
             break;
         }
@@ -460,7 +556,10 @@ bool MySQLConnection::LockIfReady()
 
 void MySQLConnection::Unlock()
 {
-    m_Mutex.unlock();
+    if (m_synchQueue)
+        m_synchQueue->Release(this);
+    else
+        m_Mutex.unlock();
 }
 
 uint32 MySQLConnection::GetServerVersion() const
@@ -480,6 +579,84 @@ MySQLPreparedStatement* MySQLConnection::GetPreparedStatement(uint32 index)
     return ret;
 }
 
+MySQLPreparedStatement* MySQLConnection::GetBatchedStatement(uint32 index, uint32 rows)
+{
+    MySQLPreparedStatement* stmt = GetPreparedStatement(index);
+    if (!stmt)
+        return nullptr;
+
+    auto itr = stmt->m_batches.find(rows);
+    if (itr != stmt->m_batches.end())
+        return itr->second.get();
+
+    std::unique_ptr<MySQLPreparedStatement>& batch = stmt->m_batches[rows];
+    std::string const sql = stmt->m_batchTemplate->GetQueryString(rows);
+
+    MYSQL_STMT* mysqlStmt = mysql_stmt_init(m_Mysql);
+    if (!mysqlStmt)
+    {
+        LOG_ERROR("sql.sql", "In mysql_stmt_init() id: %u, %u rows", index, rows);
+        LOG_ERROR("sql.sql", "%s", mysql_error(m_Mysql));
+        return nullptr;
+    }
+
+    if (mysql_stmt_prepare(mysqlStmt, sql.c_str(), static_cast<unsigned long>(sql.size())))
+    {
+        LOG_ERROR("sql.sql", "In mysql_stmt_prepare() id: %u, %u rows, sql: \"%s\"", index, rows, stmt->m_queryString.c_str());
+        LOG_ERROR("sql.sql", "%s", mysql_stmt_error(mysqlStmt));
+        mysql_stmt_close(mysqlStmt);
+        return nullptr;
+    }
+
+    batch = std::make_unique<MySQLPreparedStatement>(reinterpret_cast<MySQLStmt*>(mysqlStmt), sql);
+    return batch.get();
+}
+
+std::size_t MySQLConnection::GetBatchSize(std::vector<SQLElementData> const& queries, std::size_t first)
+{
+    if (s_maxBatchedRows <= 1)
+        return 1;
+
+    uint32 index = queries[first].element.stmt->GetIndex();
+    MySQLPreparedStatement* stmt = GetPreparedStatement(index);
+    if (!stmt || !stmt->m_batchTemplate || !stmt->m_batchTemplate->IsBatchable())
+        return 1;
+
+    // mysql allows at most 65535 placeholders in a statement
+    std::size_t maxRows = std::min<std::size_t>(s_maxBatchedRows, 65535 / stmt->m_batchTemplate->GetRowParameterCount());
+
+    std::size_t rows = 0;
+    std::size_t size = 0;
+    for (std::size_t i = first; i < queries.size() && rows < maxRows; ++i, ++rows)
+    {
+        SQLElementData const& data = queries[i];
+        if (data.type != SQL_ELEMENT_PREPARED || data.element.stmt->GetIndex() != index)
+            break;
+
+        for (PreparedStatementData const& parameter : data.element.stmt->GetParameters())
+        {
+            size += std::visit([](auto const& value) -> std::size_t
+            {
+                using T = std::decay_t<decltype(value)>;
+                if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::vector<uint8>>)
+                    return value.size();
+                else
+                    return sizeof(uint64);
+            }, parameter.data);
+        }
+
+        if (rows && size > MAX_BATCHED_STATEMENT_SIZE)
+            break;
+    }
+
+    // only power of two row counts are prepared, a connection keeps at most log2(MaxBatchedRows) forms of a statement
+    std::size_t batchRows = 1;
+    while (batchRows * 2 <= rows)
+        batchRows *= 2;
+
+    return batchRows;
+}
+
 void MySQLConnection::PrepareStatement(uint32 index, std::string const& sql, ConnectionFlags flags)
 {
     // Check if specified query should be prepared on this connection
@@ -508,7 +685,10 @@ void MySQLConnection::PrepareStatement(uint32 index, std::string const& sql, Con
             m_prepareError = true;
         }
         else
+        {
             m_stmts[index] = std::make_unique<MySQLPreparedStatement>(reinterpret_cast<MySQLStmt*>(stmt), sql);
+            m_stmts[index]->m_batchTemplate = BatchedStatementTemplate::Get(sql);
+        }
     }
 }
 
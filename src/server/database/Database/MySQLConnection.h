@@ -20,6 +20,7 @@
 
 #include "DatabaseEnvFwd.h"
 #include "Define.h"
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -32,6 +33,11 @@ class ProducerConsumerQueue;
 class DatabaseWorker;
 class MySQLPreparedStatement;
 class SQLOperation;
+class SynchConnectionQueue;
+struct SQLElementData;
+
+//! Upper bound of the parameter payload of a multi-row statement, keeps it far below max_allowed_packet
+#define MAX_BATCHED_STATEMENT_SIZE (1024 * 1024)
 
 enum ConnectionFlags
 {
@@ -56,6 +62,8 @@ class AC_DATABASE_API MySQLConnection
 {
 template <class T> friend class DatabaseWorkerPool;
 friend class PingOperation;
+friend class ResultSet;
+friend class SynchConnectionQueue;
 
 public:
     MySQLConnection(MySQLConnectionInfo& connInfo);                               //! Constructor for synchronous connections.
@@ -69,9 +77,13 @@ public:
 
     bool Execute(char const* sql);
     bool Execute(PreparedStatementBase* stmt);
+    //! Executes consecutive executions of the same statement as one multi-row statement
+    bool Execute(std::vector<PreparedStatementBase*> const& stmts);
     ResultSet* Query(char const* sql);
+    /// The rows are read from the server while the result set is iterated, the connection is unlocked by the result set
+    ResultSet* StreamQuery(char const* sql);
     PreparedResultSet* Query(PreparedStatementBase* stmt);
-    bool _Query(char const* sql, MySQLResult** pResult, MySQLField** pFields, uint64* pRowCount, uint32* pFieldCount);
+    bool _Query(char const* sql, MySQLResult** pResult, MySQLField** pFields, uint64* pRowCount, uint32* pFieldCount, bool stream = false);
     bool _Query(PreparedStatementBase* stmt, MySQLPreparedStatement** mysqlStmt, MySQLResult** pResult, uint64* pRowCount, uint32* pFieldCount);
 
     void BeginTransaction();
@@ -83,16 +95,22 @@ public:
 
     uint32 GetLastError();
 
+    //! Most executions of a statement a transaction coalesces into a multi-row statement, 1 disables it
+    static void SetMaxBatchedRows(uint32 rows) { s_maxBatchedRows = std::max<uint32>(rows, 1); }
+    static uint32 GetMaxBatchedRows() { return s_maxBatchedRows; }
+
 protected:
     /// Tries to acquire lock. If lock is acquired by another thread
     /// the calling parent will just try another connection
     bool LockIfReady();
 
     /// Called by parent databasepool. Will let other threads access this connection
+    /// and hands it to the longest waiting thread of a synchronous connection
     void Unlock();
 
     uint32 GetServerVersion() const;
     MySQLPreparedStatement* GetPreparedStatement(uint32 index);
+    MySQLPreparedStatement* GetBatchedStatement(uint32 index, uint32 rows);
     void PrepareStatement(uint32 index, std::string const& sql, ConnectionFlags flags);
 
     virtual void DoPrepareStatements() = 0;
@@ -105,6 +123,10 @@ protected:
 
 private:
     bool _HandleMySQLErrno(uint32 errNo, uint8 attempts = 5);
+    //! Number of transaction elements starting at first that can run as one multi-row statement
+    std::size_t GetBatchSize(std::vector<SQLElementData> const& queries, std::size_t first);
+
+    static uint32 s_maxBatchedRows;
 
     ProducerConsumerQueue<SQLOperation*>* m_queue;      //! Queue shared with other asynchronous connections.
     std::unique_ptr<DatabaseWorker> m_worker;           //! Core worker task.
@@ -112,6 +134,7 @@ private:
     MySQLConnectionInfo&  m_connectionInfo;             //! Connection info (used for logging)
     ConnectionFlags       m_connectionFlags;            //! Connection flags (for preparing relevant statements)
     std::mutex            m_Mutex;
+    SynchConnectionQueue* m_synchQueue;                 //! Waiting threads of the synchronous connections (nullptr for asynchronous ones)
 
     MySQLConnection(MySQLConnection const& right) = delete;
     MySQLConnection& operator=(MySQLConnection const& right) = delete;
@@ -65,7 +65,7 @@ void MySQLPreparedStatement::BindParameters(PreparedStatementBase* stmt)
 {
     m_stmt = stmt;     // Cross reference them for debug output
 
-    uint8 pos = 0;
+    uint32 pos = 0;
     for (PreparedStatementData const& data : stmt->GetParameters())
     {
         std::visit([&](auto&& param)
@@ -80,6 +80,28 @@ void MySQLPreparedStatement::BindParameters(PreparedStatementBase* stmt)
 #endif
 }
 
+void MySQLPreparedStatement::BindParameters(std::vector<PreparedStatementBase*> const& stmts)
+{
+    m_stmt = stmts.front();     // Cross reference them for debug output
+
+    uint32 pos = 0;
+    for (PreparedStatementBase* stmt : stmts)
+    {
+        for (PreparedStatementData const& data : stmt->GetParameters())
+        {
+            std::visit([&](auto&& param)
+            {
+                SetParameter(pos, param);
+            }, data.data);
+            ++pos;
+        }
+    }
+#ifdef _DEBUG
+    if (pos < m_paramCount)
+        LOG_WARN("sql.sql", "[WARNING]: BindParameters() for %u rows of statement %u did not bind all allocated parameters", uint32(stmts.size()), m_stmt->GetIndex());
+#endif
+}
+
 void MySQLPreparedStatement::ClearParameters()
 {
     for (uint32 i=0; i < m_paramCount; ++i)
@@ -92,14 +114,14 @@ void MySQLPreparedStatement::ClearParameters()
     }
 }
 
-static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint8 index, uint32 paramCount)
+static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint32 index, uint32 paramCount)
 {
     LOG_ERROR("sql.driver", "Attempted to bind parameter %u%s on a PreparedStatement %u (statement has only %u parameters)", uint32(index) + 1, (index == 1 ? "st" : (index == 2 ? "nd" : (index == 3 ? "rd" : "nd"))), stmtIndex, paramCount);
     return false;
 }
 
 //- Bind on mysql level
-void MySQLPreparedStatement::AssertValidIndex(uint8 index)
+void MySQLPreparedStatement::AssertValidIndex(uint32 index)
 {
     ASSERT(index < m_paramCount || ParamenterIndexAssertFail(m_stmt->GetIndex(), index, m_paramCount));
 
@@ -107,7 +129,7 @@ void MySQLPreparedStatement::AssertValidIndex(uint8 index)
         LOG_ERROR("sql.sql", "[ERROR] Prepared Statement (id: %u) trying to bind value on already bound index (%u).", m_stmt->GetIndex(), index);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::nullptr_t)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::nullptr_t)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -121,13 +143,13 @@ void MySQLPreparedStatement::SetParameter(uint8 index, std::nullptr_t)
     param->length = nullptr;
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, bool value)
+void MySQLPreparedStatement::SetParameter(uint32 index, bool value)
 {
     SetParameter(index, uint8(value ? 1 : 0));
 }
 
 template<typename T>
-void MySQLPreparedStatement::SetParameter(uint8 index, T value)
+void MySQLPreparedStatement::SetParameter(uint32 index, T value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -144,7 +166,7 @@ void MySQLPreparedStatement::SetParameter(uint8 index, T value)
     memcpy(param->buffer, &value, len);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::string const& value)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::string const& value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -161,7 +183,7 @@ void MySQLPreparedStatement::SetParameter(uint8 index, std::string const& value)
     memcpy(param->buffer, value.c_str(), len);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::vector<uint8> const& value)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::vector<uint8> const& value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -18,10 +18,13 @@
 #ifndef MySQLPreparedStatement_h__
 #define MySQLPreparedStatement_h__
 
+#include "BatchedStatement.h"
 #include "DatabaseEnvFwd.h"
 #include "Define.h"
 #include "MySQLWorkaround.h"
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class MySQLConnection;
@@ -40,22 +43,24 @@ public:
     ~MySQLPreparedStatement();
 
     void BindParameters(PreparedStatementBase* stmt);
+    // binds the parameters of each statement as one row of the multi-row form of their statement
+    void BindParameters(std::vector<PreparedStatementBase*> const& stmts);
 
     uint32 GetParameterCount() const { return m_paramCount; }
 
 protected:
-    void SetParameter(uint8 index, std::nullptr_t);
-    void SetParameter(uint8 index, bool value);
+    void SetParameter(uint32 index, std::nullptr_t);
+    void SetParameter(uint32 index, bool value);
     template<typename T>
-    void SetParameter(uint8 index, T value);
-    void SetParameter(uint8 index, std::string const& value);
-    void SetParameter(uint8 index, std::vector<uint8> const& value);
+    void SetParameter(uint32 index, T value);
+    void SetParameter(uint32 index, std::string const& value);
+    void SetParameter(uint32 index, std::vector<uint8> const& value);
 
     MySQLStmt* GetSTMT() { return m_Mstmt; }
     MySQLBind* GetBind() { return m_bind; }
     PreparedStatementBase* m_stmt;
     void ClearParameters();
-    void AssertValidIndex(uint8 index);
+    void AssertValidIndex(uint32 index);
     std::string getQueryString() const;
 
 private:
@@ -65,6 +70,11 @@ private:
     MySQLBind* m_bind;
     std::string const m_queryString;
 
+    //! Shared by the connections preparing the same query, nullptr for the multi-row forms
+    std::shared_ptr<BatchedStatementTemplate const> m_batchTemplate;
+    //! Multi-row forms of this statement by row count, prepared on first use (nullptr if that failed)
+    std::unordered_map<uint32, std::unique_ptr<MySQLPreparedStatement>> m_batches;
+
     MySQLPreparedStatement(MySQLPreparedStatement const& right) = delete;
     MySQLPreparedStatement& operator=(MySQLPreparedStatement const& right) = delete;
 };
@@ -19,6 +19,7 @@
 #include "Errors.h"
 #include "Field.h"
 #include "Log.h"
+#include "MySQLConnection.h"
 #include "MySQLHacks.h"
 #include "MySQLWorkaround.h"
 
@@ -164,11 +165,12 @@ void InitializeDatabaseFieldMetadata(QueryResultFieldMetadata* meta, MySQLField
 }
 }
 
-ResultSet::ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount) :
+ResultSet::ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount, MySQLConnection* streamConnection /*= nullptr*/) :
 _rowCount(rowCount),
 _fieldCount(fieldCount),
 _result(result),
-_fields(fields)
+_fields(fields),
+_streamConnection(streamConnection)
 {
     _fieldMetadata.resize(_fieldCount);
     _currentRow = new Field[_fieldCount];
@@ -223,11 +225,12 @@ m_metadataResult(result)
     //- This is where we prepare the buffer based on metadata
     MySQLField* field = reinterpret_cast<MySQLField*>(mysql_fetch_fields(m_metadataResult));
     m_fieldMetadata.resize(m_fieldCount);
-    std::size_t rowSize = 0;
+    std::size_t arenaSize = 0;
     for (uint32 i = 0; i < m_fieldCount; ++i)
     {
         uint32 size = SizeForType(&field[i]);
-        rowSize += size;
+        // every column is stored contiguously and starts aligned for the widest value
+        arenaSize += (std::size_t(size) * m_rowCount + COLUMN_ALIGNMENT - 1) & ~std::size_t(COLUMN_ALIGNMENT - 1);
 
         InitializeDatabaseFieldMetadata(&m_fieldMetadata[i], &field[i], i);
 
@@ -239,11 +242,12 @@ m_metadataResult(result)
         m_rBind[i].is_unsigned = field[i].flags & UNSIGNED_FLAG;
     }
 
-    char* dataBuffer = new char[rowSize * m_rowCount];
-    for (uint32 i = 0, offset = 0; i < m_fieldCount; ++i)
+    // zero filled, the value of a NULL field reads as 0
+    char* dataBuffer = new char[arenaSize]();
+    for (std::size_t i = 0, offset = 0; i < m_fieldCount; ++i)
     {
         m_rBind[i].buffer = dataBuffer + offset;
-        offset += m_rBind[i].buffer_length;
+        offset += (std::size_t(m_rBind[i].buffer_length) * m_rowCount + COLUMN_ALIGNMENT - 1) & ~std::size_t(COLUMN_ALIGNMENT - 1);
     }
 
     //- This is where we bind the bind the buffer to the statement
@@ -254,15 +258,16 @@ m_metadataResult(result)
         CleanUp();
         delete[] m_isNull;
         delete[] m_length;
+        m_rowCount = 0;
         return;
     }
 
-    m_rows.resize(uint32(m_rowCount) * m_fieldCount);
+    m_lengths.resize(std::size_t(m_rowCount) * m_fieldCount);
     while (_NextRow())
     {
         for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
         {
-            m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetMetadata(&m_fieldMetadata[fIndex]);
+            uint32& length = m_lengths[std::size_t(fIndex) * m_rowCount + m_rowPosition];
 
             unsigned long buffer_length = m_rBind[fIndex].buffer_length;
             unsigned long fetched_length = *m_rBind[fIndex].length;
@@ -289,24 +294,30 @@ m_metadataResult(result)
                         break;
                 }
 
-                m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetByteValue(
-                    (char const*)buffer,
-                    fetched_length);
+                length = uint32(fetched_length);
 
-                // move buffer pointer to next part
-                m_stmt->bind[fIndex].buffer = (char*)buffer + rowSize;
+                // move buffer pointer to the value of the next row
+                m_stmt->bind[fIndex].buffer = (char*)buffer + buffer_length;
             }
             else
             {
-                m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetByteValue(
-                    nullptr,
-                    *m_rBind[fIndex].length);
+                length = NULL_VALUE_LENGTH;
+
+                // the value of a NULL field stays empty in the column
+                m_stmt->bind[fIndex].buffer = (char*)m_stmt->bind[fIndex].buffer + buffer_length;
             }
         }
         m_rowPosition++;
     }
     m_rowPosition = 0;
 
+    m_currentRow.resize(m_fieldCount);
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+        m_currentRow[i].SetMetadata(&m_fieldMetadata[i]);
+
+    if (m_rowCount)
+        SetCurrentRow();
+
     /// All data is buffered, let go of mysql c api structures
     mysql_stmt_free_result(m_stmt);
 }
@@ -331,6 +342,12 @@ bool ResultSet::NextRow()
     row = mysql_fetch_row(_result);
     if (!row)
     {
+        // a streamed result also ends when the connection fails while the rows are being read,
+        // only a part of the table was loaded then and the server must not go on with it
+        if (_streamConnection)
+            if (uint32 lErrno = mysql_errno(_streamConnection->m_Mysql))
+                ABORT_MSG("Streamed query failed while reading its rows. Error [%u] %s", lErrno, mysql_error(_streamConnection->m_Mysql));
+
         CleanUp();
         return false;
     }
@@ -362,9 +379,22 @@ bool PreparedResultSet::NextRow()
     if (++m_rowPosition >= m_rowCount)
         return false;
 
+    SetCurrentRow();
     return true;
 }
 
+void PreparedResultSet::SetCurrentRow()
+{
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+    {
+        uint32 length = m_lengths[std::size_t(i) * m_rowCount + m_rowPosition];
+        if (length != NULL_VALUE_LENGTH)
+            m_currentRow[i].SetByteValue(static_cast<char const*>(m_rBind[i].buffer) + m_rowPosition * m_rBind[i].buffer_length, length);
+        else
+            m_currentRow[i].SetByteValue(nullptr, 0);
+    }
+}
+
 bool PreparedResultSet::_NextRow()
 {
     /// Only called in low-level code, namely the constructor
@@ -386,9 +416,16 @@ void ResultSet::CleanUp()
 
     if (_result)
     {
+        // reads and drops the rows of a streamed result that were not iterated
         mysql_free_result(_result);
         _result = nullptr;
     }
+
+    if (_streamConnection)
+    {
+        _streamConnection->Unlock();
+        _streamConnection = nullptr;
+    }
 }
 
 Field const& ResultSet::operator[](std::size_t index) const
@@ -400,14 +437,14 @@ Field const& ResultSet::operator[](std::size_t index) const
 Field* PreparedResultSet::Fetch() const
 {
     ASSERT(m_rowPosition < m_rowCount);
-    return const_cast<Field*>(&m_rows[uint32(m_rowPosition) * m_fieldCount]);
+    return const_cast<Field*>(m_currentRow.data());
 }
 
 Field const& PreparedResultSet::operator[](std::size_t index) const
 {
     ASSERT(m_rowPosition < m_rowCount);
     ASSERT(index < m_fieldCount);
-    return m_rows[uint32(m_rowPosition) * m_fieldCount + index];
+    return m_currentRow[index];
 }
 
 void PreparedResultSet::CleanUp()
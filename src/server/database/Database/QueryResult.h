@@ -20,12 +20,15 @@
 
 #include "DatabaseEnvFwd.h"
 #include "Define.h"
+#include <limits>
 #include <vector>
 
+class MySQLConnection;
+
 class AC_DATABASE_API ResultSet
 {
 public:
-    ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount);
+    ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount, MySQLConnection* streamConnection = nullptr);
     ~ResultSet();
 
     bool NextRow();
@@ -46,11 +49,18 @@ private:
     void CleanUp();
     MySQLResult* _result;
     MySQLField* _fields;
+    MySQLConnection* _streamConnection;     ///< locked while the rows are being read from the server
 
     ResultSet(ResultSet const& right) = delete;
     ResultSet& operator=(ResultSet const& right) = delete;
 };
 
+/**
+    @class PreparedResultSet
+
+    Every row is fetched when the result set is built. The values are stored column after column
+    in a single buffer, Fetch() and operator[] expose the fields of the current row only.
+*/
 class AC_DATABASE_API PreparedResultSet
 {
 public:
@@ -65,8 +75,12 @@ public:
     Field const& operator[](std::size_t index) const;
 
 protected:
+    static constexpr uint32 NULL_VALUE_LENGTH = std::numeric_limits<uint32>::max();
+    static constexpr std::size_t COLUMN_ALIGNMENT = 8;
+
     std::vector<QueryResultFieldMetadata> m_fieldMetadata;
-    std::vector<Field> m_rows;
+    std::vector<Field> m_currentRow;
+    std::vector<uint32> m_lengths;      ///< length of every value, column after column
     uint64 m_rowCount;
     uint64 m_rowPosition;
     uint32 m_fieldCount;
@@ -78,6 +92,7 @@ private:
 
     void CleanUp();
     bool _NextRow();
+    void SetCurrentRow();
 
     PreparedResultSet(PreparedResultSet const& right) = delete;
     PreparedResultSet& operator=(PreparedResultSet const& right) = delete;
@@ -0,0 +1,268 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SynchConnectionQueue.h"
+#include "Log.h"
+#include "MySQLConnection.h"
+#include <algorithm>
+
+Milliseconds SynchConnectionQueue::_waitTimeout = 5s;
+Milliseconds SynchConnectionQueue::_queryBudget = 50ms;
+
+namespace
+{
+    // a thread_local static member of an exported class doesn't build with MSVC (C2492)
+    thread_local SynchQueryCaller CurrentCaller = SYNCH_CALLER_OTHER;
+
+    std::array<uint32, SYNCH_WAIT_BUCKETS - 1> const WaitBucketLimits = { 100, 1000, 5000, 10000, 50000, 100000, 500000, 1000000 };
+
+    void UpdateMax(std::atomic<uint64>& max, uint64 value)
+    {
+        uint64 current = max.load(std::memory_order_relaxed);
+        while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            ;
+    }
+}
+
+SynchConnectionQueue::SynchConnectionQueue(std::string const& database) : _database(database), _next(0)
+{
+    ResetStats();
+}
+
+void SynchConnectionQueue::AddConnection(MySQLConnection* connection)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    Slot slot;
+    slot.Connection = connection;
+    slot.WaitTime = Microseconds::zero();
+    slot.Caller = SYNCH_CALLER_OTHER;
+    slot.Acquired = false;
+    _slots.push_back(slot);
+
+    connection->m_synchQueue = this;
+}
+
+void SynchConnectionQueue::Clear()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    for (Slot& slot : _slots)
+        slot.Connection->m_synchQueue = nullptr;
+
+    _slots.clear();
+    _next = 0;
+}
+
+MySQLConnection* SynchConnectionQueue::Acquire()
+{
+    SynchQueryCaller const caller = CurrentCaller;
+    TimePoint const start = std::chrono::steady_clock::now();
+    bool timedOut = false;
+
+    std::unique_lock<std::mutex> guard(_lock);
+
+    // nobody is waiting, take any free connection
+    Slot* slot = _waiting.empty() ? TryLockAny() : nullptr;
+    if (!slot)
+    {
+        Waiter waiter;
+        _waiting.push_back(&waiter);
+
+        // only the longest waiting thread takes a connection, Release() wakes it up
+        TimePoint const timeout = start + _waitTimeout;
+        while (_waiting.front() != &waiter || !(slot = TryLockAny()))
+        {
+            if (_waitTimeout > Milliseconds::zero() && !timedOut)
+            {
+                if (waiter.Condition.wait_until(guard, timeout) == std::cv_status::timeout)
+                {
+                    timedOut = true;
+                    LOG_WARN("sql.performances", "Waiting for a synchronous connection of database `%s` since %u ms, " SZFMTD " threads waiting for one of " SZFMTD " connections.",
+                        _database.c_str(), uint32(_waitTimeout.count()), _waiting.size(), _slots.size());
+                }
+            }
+            else
+                waiter.Condition.wait(guard);
+        }
+
+        _waiting.pop_front();
+
+        // more than one connection may have been released meanwhile
+        if (!_waiting.empty())
+            _waiting.front()->Condition.notify_one();
+    }
+
+    TimePoint const now = std::chrono::steady_clock::now();
+    Microseconds const wait = std::chrono::duration_cast<Microseconds>(now - start);
+
+    slot->AcquireTime = now;
+    slot->WaitTime = wait;
+    slot->Caller = caller;
+    slot->Acquired = true;
+
+    MySQLConnection* connection = slot->Connection;
+    guard.unlock();
+
+    RecordWait(caller, wait, timedOut);
+    return connection;
+}
+
+void SynchConnectionQueue::Release(MySQLConnection* connection)
+{
+    bool acquired = false;
+    SynchQueryCaller caller = SYNCH_CALLER_OTHER;
+    Microseconds wait = Microseconds::zero();
+    Microseconds held = Microseconds::zero();
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        auto itr = std::find_if(_slots.begin(), _slots.end(), [connection](Slot const& slot) { return slot.Connection == connection; });
+        if (itr != _slots.end() && itr->Acquired)
+        {
+            acquired = true;
+            caller = itr->Caller;
+            wait = itr->WaitTime;
+            held = std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - itr->AcquireTime);
+            itr->Acquired = false;
+        }
+
+        // unlocked while holding _lock, the waiter woken up can't miss the connection
+        connection->m_Mutex.unlock();
+
+        if (!_waiting.empty())
+            _waiting.front()->Condition.notify_one();
+    }
+
+    if (acquired)
+        CheckBudget(caller, wait, held);
+}
+
+std::size_t SynchConnectionQueue::GetWaitingCount() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _waiting.size();
+}
+
+SynchConnectionQueue::Slot* SynchConnectionQueue::TryLockAny()
+{
+    for (std::size_t i = 0; i < _slots.size(); ++i)
+    {
+        std::size_t const index = (_next + i) % _slots.size();
+
+        //! Must be matched with Unlock() or you will get deadlocks
+        if (_slots[index].Connection->LockIfReady())
+        {
+            _next = (index + 1) % _slots.size();
+            return &_slots[index];
+        }
+    }
+
+    return nullptr;
+}
+
+void SynchConnectionQueue::RecordWait(SynchQueryCaller caller, Microseconds wait, bool timedOut)
+{
+    CallerStats& stats = _stats[caller];
+    uint64 const waitTime = uint64(wait.count());
+
+    stats.Acquired.fetch_add(1, std::memory_order_relaxed);
+    stats.TotalWait.fetch_add(waitTime, std::memory_order_relaxed);
+    UpdateMax(stats.MaxWait, waitTime);
+
+    if (timedOut)
+        stats.Timeouts.fetch_add(1, std::memory_order_relaxed);
+
+    std::size_t bucket = std::upper_bound(WaitBucketLimits.begin(), WaitBucketLimits.end(), waitTime) - WaitBucketLimits.begin();
+    stats.Buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void SynchConnectionQueue::CheckBudget(SynchQueryCaller caller, Microseconds wait, Microseconds held)
+{
+    // loading at startup and the other threads are not bound to an update loop
+    if (_queryBudget <= Milliseconds::zero() || caller == SYNCH_CALLER_OTHER)
+        return;
+
+    if (wait + held < _queryBudget)
+        return;
+
+    _stats[caller].OverBudget.fetch_add(1, std::memory_order_relaxed);
+
+    LOG_WARN("sql.performances", "Synchronous query of database `%s` blocked the %s thread for %u ms (%u ms waiting for a connection), the budget is %u ms.",
+        _database.c_str(), GetCallerName(caller), uint32(std::chrono::duration_cast<Milliseconds>(wait + held).count()),
+        uint32(std::chrono::duration_cast<Milliseconds>(wait).count()), uint32(_queryBudget.count()));
+}
+
+void SynchConnectionQueue::GetStats(std::array<SynchWaitStats, MAX_SYNCH_CALLERS>& stats) const
+{
+    for (std::size_t i = 0; i < MAX_SYNCH_CALLERS; ++i)
+    {
+        CallerStats const& counters = _stats[i];
+        stats[i].Acquired = counters.Acquired.load(std::memory_order_relaxed);
+        stats[i].TotalWait = counters.TotalWait.load(std::memory_order_relaxed);
+        stats[i].MaxWait = counters.MaxWait.load(std::memory_order_relaxed);
+        stats[i].Timeouts = counters.Timeouts.load(std::memory_order_relaxed);
+        stats[i].OverBudget = counters.OverBudget.load(std::memory_order_relaxed);
+
+        for (std::size_t bucket = 0; bucket < SYNCH_WAIT_BUCKETS; ++bucket)
+            stats[i].Buckets[bucket] = counters.Buckets[bucket].load(std::memory_order_relaxed);
+    }
+}
+
+void SynchConnectionQueue::ResetStats()
+{
+    for (CallerStats& counters : _stats)
+    {
+        counters.Acquired = 0;
+        counters.TotalWait = 0;
+        counters.MaxWait = 0;
+        counters.Timeouts = 0;
+        counters.OverBudget = 0;
+
+        for (std::atomic<uint64>& bucket : counters.Buckets)
+            bucket = 0;
+    }
+}
+
+void SynchConnectionQueue::SetCaller(SynchQueryCaller caller)
+{
+    CurrentCaller = caller;
+}
+
+SynchQueryCaller SynchConnectionQueue::GetCaller()
+{
+    return CurrentCaller;
+}
+
+char const* SynchConnectionQueue::GetCallerName(SynchQueryCaller caller)
+{
+    switch (caller)
+    {
+        case SYNCH_CALLER_WORLD:
+            return "world";
+        case SYNCH_CALLER_MAP:
+            return "map";
+        default:
+            return "other";
+    }
+}
+
+uint32 SynchConnectionQueue::GetBucketLimit(std::size_t bucket)
+{
+    return bucket < WaitBucketLimits.size() ? WaitBucketLimits[bucket] : 0;
+}
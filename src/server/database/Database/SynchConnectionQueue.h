@@ -0,0 +1,136 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SYNCHCONNECTIONQUEUE_H
+#define _SYNCHCONNECTIONQUEUE_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class MySQLConnection;
+
+//! Kind of thread running a synchronous query, set once by the thread
+enum SynchQueryCaller : uint8
+{
+    SYNCH_CALLER_OTHER,
+    SYNCH_CALLER_WORLD,
+    SYNCH_CALLER_MAP,
+    MAX_SYNCH_CALLERS
+};
+
+#define SYNCH_WAIT_BUCKETS 9
+
+struct SynchWaitStats
+{
+    uint64 Acquired = 0;        // connections handed out
+    uint64 TotalWait = 0;       // microseconds spent waiting for them
+    uint64 MaxWait = 0;
+    uint64 Timeouts = 0;        // waits longer than Database.SynchWaitTimeout
+    uint64 OverBudget = 0;      // queries longer than Database.SynchQueryBudget, waiting included
+    std::array<uint64, SYNCH_WAIT_BUCKETS> Buckets = { };   // wait time histogram, see SynchConnectionQueue::GetBucketLimit
+
+    [[nodiscard]] uint64 GetAverageWait() const { return Acquired ? TotalWait / Acquired : 0; }
+};
+
+/*
+ * Synchronous connections of a database pool. Threads wait blocked for a free connection and are
+ * served in arrival order: a released connection is offered to the thread waiting the longest, threads
+ * arriving meanwhile queue up behind it.
+ */
+class AC_DATABASE_API SynchConnectionQueue
+{
+public:
+    explicit SynchConnectionQueue(std::string const& database);
+
+    void AddConnection(MySQLConnection* connection);
+    void Clear();
+
+    //! Blocks until a connection is free and locks it, the connection must be released with MySQLConnection::Unlock()
+    MySQLConnection* Acquire();
+    //! Called by MySQLConnection::Unlock()
+    void Release(MySQLConnection* connection);
+
+    [[nodiscard]] std::size_t GetWaitingCount() const;
+
+    void GetStats(std::array<SynchWaitStats, MAX_SYNCH_CALLERS>& stats) const;
+    void ResetStats();
+
+    static void SetCaller(SynchQueryCaller caller);
+    static SynchQueryCaller GetCaller();
+    static char const* GetCallerName(SynchQueryCaller caller);
+
+    //! Upper bound in microseconds of a bucket of the wait time histogram, 0 for the last one
+    static uint32 GetBucketLimit(std::size_t bucket);
+
+    static void SetWaitTimeout(Milliseconds timeout) { _waitTimeout = timeout; }
+    static void SetQueryBudget(Milliseconds budget) { _queryBudget = budget; }
+
+private:
+    struct Slot
+    {
+        MySQLConnection* Connection;
+        TimePoint AcquireTime;
+        Microseconds WaitTime;
+        SynchQueryCaller Caller;
+        bool Acquired;
+    };
+
+    struct Waiter
+    {
+        std::condition_variable Condition;
+    };
+
+    struct CallerStats
+    {
+        std::atomic<uint64> Acquired;
+        std::atomic<uint64> TotalWait;
+        std::atomic<uint64> MaxWait;
+        std::atomic<uint64> Timeouts;
+        std::atomic<uint64> OverBudget;
+        std::array<std::atomic<uint64>, SYNCH_WAIT_BUCKETS> Buckets;
+    };
+
+    // must be called with _lock held
+    Slot* TryLockAny();
+
+    void RecordWait(SynchQueryCaller caller, Microseconds wait, bool timedOut);
+    void CheckBudget(SynchQueryCaller caller, Microseconds wait, Microseconds held);
+
+    std::string const _database;
+
+    mutable std::mutex _lock;
+    std::vector<Slot> _slots;
+    std::size_t _next;
+    std::deque<Waiter*> _waiting;
+
+    std::array<CallerStats, MAX_SYNCH_CALLERS> _stats;
+
+    static Milliseconds _waitTimeout;
+    static Milliseconds _queryBudget;
+
+    SynchConnectionQueue(SynchConnectionQueue const& right) = delete;
+    SynchConnectionQueue& operator=(SynchConnectionQueue const& right) = delete;
+};
+
+#endif
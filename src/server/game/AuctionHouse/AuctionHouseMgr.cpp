@@ -442,17 +442,100 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntryFromHouse(uint8 ho
     return (sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_AUCTION)) ? sAuctionHouseStore.LookupEntry(AUCTIONHOUSE_NEUTRAL) : sAuctionHouseStore.LookupEntry(houseId);
 }
 
+namespace
+{
+    // Name an auction is found by: the localized item name followed by the random property suffix (ie: of the Monkey)
+    std::wstring BuildAuctionSearchName(ItemTemplate const* proto, int32 randomPropertyId, LocaleConstant dbLocale, LocaleConstant dbcLocale)
+    {
+        std::string name = proto->Name1;
+        if (name.empty())
+            return std::wstring();
+
+        // local name
+        if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
+            ObjectMgr::GetLocaleString(il->Name, dbLocale, name);
+
+        // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+        //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+        //  used in BuildAuctionInfo() which then causes wrong items to be listed
+        if (randomPropertyId)
+        {
+            // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
+            //  even though the DBC name seems misleading
+            char* const* suffix = nullptr;
+
+            if (randomPropertyId < 0)
+            {
+                if (ItemRandomSuffixEntry const* itemRandEntry = sItemRandomSuffixStore.LookupEntry(-randomPropertyId))
+                    suffix = itemRandEntry->nameSuffix;
+            }
+            else if (ItemRandomPropertiesEntry const* itemRandEntry = sItemRandomPropertiesStore.LookupEntry(randomPropertyId))
+                suffix = itemRandEntry->nameSuffix;
+
+            // Append the suffix (ie: of the Monkey) to the name using localization
+            if (suffix)
+            {
+                name += ' ';
+                name += suffix[dbcLocale];
+            }
+        }
+
+        std::wstring wname;
+        if (!Utf8toWStr(name, wname))
+            return std::wstring();
+
+        wstrToLower(wname);
+        return wname;
+    }
+}
+
+void AuctionListingQuery::Normalize()
+{
+    // the upper level bound is only applied together with the lower one
+    if (!LevelMin)
+        LevelMax = 0;
+
+    // every item has at least poor quality
+    if (!Quality)
+        Quality = 0xffffffff;
+}
+
+bool AuctionListingQuery::IsUnfiltered() const
+{
+    return ItemClass == 0xffffffff && ItemSubClass == 0xffffffff && InventoryType == 0xffffffff && Quality == 0xffffffff &&
+        LevelMin == 0x00 && LevelMax == 0x00 && Usable == 0x00 && SearchedName.empty();
+}
+
+bool AuctionListingQuery::operator==(AuctionListingQuery const& right) const
+{
+    return InventoryType == right.InventoryType && ItemClass == right.ItemClass && ItemSubClass == right.ItemSubClass && Quality == right.Quality &&
+        LevelMin == right.LevelMin && LevelMax == right.LevelMax && Usable == right.Usable && SearchedName == right.SearchedName;
+}
+
+AuctionHouseObject::AuctionHouseObject() : _searchIndex(&BuildAuctionSearchName), _generation(0)
+{
+    next = AuctionsMap.begin();
+}
+
 void AuctionHouseObject::AddAuction(AuctionEntry* auction)
 {
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+    ++_generation;
+
+    // auctions without their item can't be listed, keep them out of the search index
+    if (Item* item = sAuctionMgr->GetAItem(auction->item_guid))
+        _searchIndex.Insert(auction, item->GetTemplate(), item->GetItemRandomPropertyId());
+
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
 {
     bool wasInMap = !!AuctionsMap.erase(auction->Id);
+    _searchIndex.Remove(auction->Id);
+    ++_generation;
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -538,147 +621,96 @@ void AuctionHouseObject::BuildListOwnerItems(WorldPacket& data, Player* player,
     }
 }
 
-bool AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player,
-        std::wstring const& wsearchedname, uint32 listfrom, uint8 levelmin, uint8 levelmax, uint8 usable,
-        uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
-        uint32& count, uint32& totalcount, uint8  /*getAll*/)
+void AuctionHouseObject::BuildListAllAuctionItems(WorldPacket& data, uint32 listfrom, uint32& count, uint32& totalcount)
 {
-    uint32 itrcounter = 0;
-
     // pussywizard: optimization, this is a simplified case
-    if (itemClass == 0xffffffff && itemSubClass == 0xffffffff && inventoryType == 0xffffffff && quality == 0xffffffff && levelmin == 0x00 && levelmax == 0x00 && usable == 0x00 && wsearchedname.empty())
+    totalcount = Getcount();
+    if (listfrom < totalcount)
     {
-        totalcount = Getcount();
-        if (listfrom < totalcount)
+        AuctionEntryMap::iterator itr = AuctionsMap.begin();
+        std::advance(itr, listfrom);
+        for (; itr != AuctionsMap.end(); ++itr)
         {
-            AuctionEntryMap::iterator itr = AuctionsMap.begin();
-            std::advance(itr, listfrom);
-            for (; itr != AuctionsMap.end(); ++itr)
-            {
-                itr->second->BuildAuctionInfo(data);
-                if ((++count) >= 50)
-                    break;
-            }
+            itr->second->BuildAuctionInfo(data);
+            if ((++count) >= 50)
+                break;
         }
-        return true;
     }
+}
 
+bool AuctionHouseObject::SearchListAuctionItems(Player* player, AuctionListingQuery const& query, std::vector<uint32>& auctionIds, time_t& validUntil)
+{
+    uint32 itrcounter = 0;
     time_t curTime = sWorld->GetGameTime();
 
-    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
-    int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
-
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    AuctionSearchFilter filter;
+    filter.ItemClass = query.ItemClass;
+    filter.ItemSubClass = query.ItemSubClass;
+    filter.InventoryType = query.InventoryType;
+    filter.Quality = query.Quality;
+    filter.LevelMin = query.LevelMin;
+    filter.LevelMax = query.LevelMax;
+    filter.Name = query.SearchedName;
+    filter.DbLocale = player->GetSession()->GetSessionDbLocaleIndex();
+    filter.DbcLocale = player->GetSession()->GetSessionDbcLocale();
+
+    auto mustStop = []()
     {
         if (!AsyncAuctionListingMgr::IsAuctionListingAllowed()) // pussywizard: World::Update is waiting for us...
-            if ((itrcounter++) % 100 == 0) // check condition every 100 iterations
-                if (avgDiffTracker.getAverage() >= 30 || getMSTimeDiff(World::GetGameTimeMS(), getMSTime()) >= 10) // pussywizard: stop immediately if diff is high or waiting too long
-                    return false;
-
-        AuctionEntry* Aentry = itr->second;
-        // Skip expired auctions
-        if (Aentry->expire_time < curTime)
-            continue;
+            if (avgDiffTracker.getAverage() >= 30 || getMSTimeDiff(World::GetGameTimeMS(), getMSTime()) >= 10) // pussywizard: stop immediately if diff is high or waiting too long
+                return true;
+        return false;
+    };
 
-        Item* item = sAuctionMgr->GetAItem(Aentry->item_guid);
-        if (!item)
-            continue;
+    // item template and name filters are resolved by the index, in auction id order like AuctionsMap
+    std::vector<AuctionEntry*> auctions;
+    if (!_searchIndex.Search(filter, auctions, mustStop))
+        return false;
 
-        ItemTemplate const* proto = item->GetTemplate();
+    auctionIds.clear();
+    validUntil = std::numeric_limits<time_t>::max();
 
-        if (itemClass != 0xffffffff && proto->Class != itemClass)
-            continue;
+    for (AuctionEntry* Aentry : auctions)
+    {
+        if ((itrcounter++) % 100 == 0 && mustStop()) // check condition every 100 iterations
+            return false;
 
-        if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
+        // Skip expired auctions
+        if (Aentry->expire_time < curTime)
             continue;
 
-        if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
+        if (query.Usable != 0x00)
         {
-            // xinef: exception, robes are counted as chests
-            if (inventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
+            Item* item = sAuctionMgr->GetAItem(Aentry->item_guid);
+            if (!item)
                 continue;
-        }
 
-        if (quality != 0xffffffff && proto->Quality < quality)
-            continue;
-
-        if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-            continue;
-
-        if (usable != 0x00)
-        {
             if (player->CanUseItem(item) != EQUIP_ERR_OK)
                 continue;
 
             // xinef: check already learded recipes and pets
+            ItemTemplate const* proto = item->GetTemplate();
             if (proto->Spells[1].SpellTrigger == ITEM_SPELLTRIGGER_LEARN_SPELL_ID && player->HasSpell(proto->Spells[1].SpellId))
                 continue;
         }
 
-        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-        // No need to do any of this if no search term was entered
-        if (!wsearchedname.empty())
-        {
-            std::string name = proto->Name1;
-            if (name.empty())
-                continue;
-
-            // local name
-            if (loc_idx >= 0)
-                if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
-                    ObjectMgr::GetLocaleString(il->Name, loc_idx, name);
-
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
-
-            if (propRefID)
-            {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
-                //  even though the DBC name seems misleading
-
-                char* const* suffix = nullptr;
-
-                if (propRefID < 0)
-                {
-                    const ItemRandomSuffixEntry* itemRandEntry = sItemRandomSuffixStore.LookupEntry(-item->GetItemRandomPropertyId());
-                    if (itemRandEntry)
-                        suffix = itemRandEntry->nameSuffix;
-                }
-                else
-                {
-                    const ItemRandomPropertiesEntry* itemRandEntry = sItemRandomPropertiesStore.LookupEntry(item->GetItemRandomPropertyId());
-                    if (itemRandEntry)
-                        suffix = itemRandEntry->nameSuffix;
-                }
-
-                // dbc local name
-                if (suffix)
-                {
-                    // Append the suffix (ie: of the Monkey) to the name using localization
-                    // or default enUS if localization is invalid
-                    name += ' ';
-                    name += suffix[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                }
-            }
+        auctionIds.push_back(Aentry->Id);
+        validUntil = std::min(validUntil, Aentry->expire_time);
+    }
 
-            // Perform the search (with or without suffix)
-            if (!Utf8FitTo(name, wsearchedname))
-                continue;
-        }
+    return true;
+}
 
-        // Add the item if no search term or if entered search term was found
-        if (count < 50 && totalcount >= listfrom)
+void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, std::vector<uint32> const& auctionIds, uint32 listfrom, uint32& count) const
+{
+    for (std::size_t i = listfrom; i < auctionIds.size() && count < 50; ++i)
+    {
+        if (AuctionEntry* Aentry = GetAuction(auctionIds[i]))
         {
             ++count;
             Aentry->BuildAuctionInfo(data);
         }
-        ++totalcount;
     }
-
-    return true;
 }
 
 //this function inserts to WorldPacket auction's data
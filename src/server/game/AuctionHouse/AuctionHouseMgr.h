@@ -18,6 +18,7 @@
 #ifndef _AUCTION_HOUSE_MGR_H
 #define _AUCTION_HOUSE_MGR_H
 
+#include "AuctionSearchIndex.h"
 #include "Common.h"
 #include "DatabaseEnv.h"
 #include "DBCStructure.h"
@@ -98,12 +99,32 @@ struct AuctionEntry
     static std::string BuildAuctionMailBody(ObjectGuid guid, uint32 bid, uint32 buyout, uint32 deposit = 0, uint32 cut = 0, uint32 moneyDelay = 0, uint32 eta = 0);
 };
 
+// filters of a CMSG_AUCTION_LIST_ITEMS search, normalized so equal searches compare equal
+struct AuctionListingQuery
+{
+    std::wstring SearchedName;          // lower case
+    uint32 InventoryType = 0xffffffff;
+    uint32 ItemClass = 0xffffffff;
+    uint32 ItemSubClass = 0xffffffff;
+    uint32 Quality = 0xffffffff;
+    uint8 LevelMin = 0;
+    uint8 LevelMax = 0;
+    uint8 Usable = 0;
+
+    void Normalize();
+
+    [[nodiscard]] bool IsUnfiltered() const;
+
+    bool operator==(AuctionListingQuery const& right) const;
+    bool operator!=(AuctionListingQuery const& right) const { return !(*this == right); }
+};
+
 //this class is used as auctionhouse instance
 class AuctionHouseObject
 {
 public:
     // Initialize storage
-    AuctionHouseObject() { next = AuctionsMap.begin(); }
+    AuctionHouseObject();
     ~AuctionHouseObject()
     {
         for (auto & itr : AuctionsMap)
@@ -114,6 +135,9 @@ public:
 
     [[nodiscard]] uint32 Getcount() const { return AuctionsMap.size(); }
 
+    // changes whenever an auction is added or removed
+    [[nodiscard]] uint32 GetGeneration() const { return _generation; }
+
     AuctionEntryMap::iterator GetAuctionsBegin() { return AuctionsMap.begin(); }
     AuctionEntryMap::iterator GetAuctionsEnd() { return AuctionsMap.end(); }
     AuctionEntryMap const& GetAuctions() { return AuctionsMap; }
@@ -132,13 +156,18 @@ public:
 
     void BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
     void BuildListOwnerItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
-    bool BuildListAuctionItems(WorldPacket& data, Player* player,
-                               std::wstring const& searchedname, uint32 listfrom, uint8 levelmin, uint8 levelmax, uint8 usable,
-                               uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
-                               uint32& count, uint32& totalcount, uint8 getAll);
+    // searches without any filter, pages straight through AuctionsMap
+    void BuildListAllAuctionItems(WorldPacket& data, uint32 listfrom, uint32& count, uint32& totalcount);
+    // ids of the auctions matching the query in listing order, validUntil is the game time up to which none of them expires
+    // returns false when the search was interrupted because World::Update is waiting for the listing thread
+    bool SearchListAuctionItems(Player* player, AuctionListingQuery const& query, std::vector<uint32>& auctionIds, time_t& validUntil);
+    // the page of a previous search starting at listfrom
+    void BuildListAuctionItems(WorldPacket& data, std::vector<uint32> const& auctionIds, uint32 listfrom, uint32& count) const;
 
 private:
     AuctionEntryMap AuctionsMap;
+    AuctionSearchIndex _searchIndex;
+    uint32 _generation;
 
     // storage for "next" auction item for next Update()
     AuctionEntryMap::const_iterator next;
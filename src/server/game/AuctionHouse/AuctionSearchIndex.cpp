@@ -0,0 +1,338 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuctionSearchIndex.h"
+#include "AuctionHouseMgr.h"
+#include "ItemTemplate.h"
+#include <algorithm>
+
+namespace
+{
+    // removed ids are pruned from the posting lists once they outnumber the live auctions
+    constexpr std::size_t MinRemovedForCompaction = 1024;
+
+    // names built or auctions verified between two checks whether a search must stop
+    constexpr uint32 StopCheckInterval = 250;
+
+    template<class Map>
+    typename Map::mapped_type const* FindPostings(Map const& map, typename Map::key_type key)
+    {
+        auto itr = map.find(key);
+        return itr != map.end() ? &itr->second : nullptr;
+    }
+}
+
+AuctionSearchIndex::AuctionSearchIndex(NameBuilder nameBuilder) : _nameBuilder(std::move(nameBuilder)), _removedSinceCompaction(0)
+{
+}
+
+void AuctionSearchIndex::AddPosting(PostingList& list, uint32 auctionId)
+{
+    // auction ids are increasing, anything else (loading, reused id) takes the sorted insert
+    if (list.empty() || list.back() < auctionId)
+    {
+        list.push_back(auctionId);
+        return;
+    }
+
+    PostingList::iterator itr = std::lower_bound(list.begin(), list.end(), auctionId);
+    if (itr == list.end() || *itr != auctionId)
+        list.insert(itr, auctionId);
+}
+
+uint64 AuctionSearchIndex::MakeTrigram(std::wstring const& name, std::size_t offset)
+{
+    // code points fit in 21 bits
+    return (uint64(name[offset] & 0x1FFFFF) << 42) | (uint64(name[offset + 1] & 0x1FFFFF) << 21) | uint64(name[offset + 2] & 0x1FFFFF);
+}
+
+void AuctionSearchIndex::Insert(AuctionEntry* auction, ItemTemplate const* proto, int32 randomPropertyId)
+{
+    IndexedAuction& indexed = _auctions[auction->Id];
+    indexed.Auction = auction;
+    indexed.Proto = proto;
+    indexed.RandomPropertyId = randomPropertyId;
+    indexed.ItemClass = proto->Class;
+    indexed.ItemSubClass = proto->SubClass;
+    indexed.InventoryType = proto->InventoryType;
+    indexed.Quality = proto->Quality;
+    indexed.RequiredLevel = proto->RequiredLevel;
+
+    AddPosting(_all, auction->Id);
+    AddPosting(_byClass[indexed.ItemClass], auction->Id);
+    AddPosting(_bySubClass[(indexed.ItemClass << 16) | indexed.ItemSubClass], auction->Id);
+    AddPosting(_byInventoryType[indexed.InventoryType], auction->Id);
+    AddPosting(_byQuality[indexed.Quality], auction->Id);
+    AddPosting(_byLevel[indexed.RequiredLevel], auction->Id);
+
+    // robes are listed as chests
+    if (indexed.InventoryType == INVTYPE_ROBE)
+        AddPosting(_byInventoryType[INVTYPE_CHEST], auction->Id);
+
+    for (auto& itr : _names)
+        AddName(itr.second, auction->Id, _nameBuilder(proto, randomPropertyId, LocaleConstant(itr.first >> 8), LocaleConstant(itr.first & 0xFF)));
+}
+
+void AuctionSearchIndex::Remove(uint32 auctionId)
+{
+    if (!_auctions.erase(auctionId))
+        return;
+
+    for (auto& itr : _names)
+        itr.second.Names.erase(auctionId);
+
+    if (++_removedSinceCompaction >= MinRemovedForCompaction && _removedSinceCompaction > _auctions.size())
+        Compact();
+}
+
+void AuctionSearchIndex::Clear()
+{
+    _auctions.clear();
+    _all.clear();
+    _byClass.clear();
+    _bySubClass.clear();
+    _byInventoryType.clear();
+    _byQuality.clear();
+    _byLevel.clear();
+    _names.clear();
+    _removedSinceCompaction = 0;
+}
+
+void AuctionSearchIndex::Compact()
+{
+    auto prune = [this](PostingList& list)
+    {
+        list.erase(std::remove_if(list.begin(), list.end(), [this](uint32 auctionId) { return !_auctions.count(auctionId); }), list.end());
+    };
+
+    auto pruneMap = [&prune](auto& map)
+    {
+        for (auto itr = map.begin(); itr != map.end();)
+        {
+            prune(itr->second);
+            if (itr->second.empty())
+                itr = map.erase(itr);
+            else
+                ++itr;
+        }
+    };
+
+    prune(_all);
+    pruneMap(_byClass);
+    pruneMap(_bySubClass);
+    pruneMap(_byInventoryType);
+    pruneMap(_byQuality);
+    pruneMap(_byLevel);
+    for (auto& itr : _names)
+        pruneMap(itr.second.Trigrams);
+
+    _removedSinceCompaction = 0;
+}
+
+void AuctionSearchIndex::AddName(NameIndex& index, uint32 auctionId, std::wstring name)
+{
+    if (name.size() >= 3)
+    {
+        std::vector<uint64> trigrams;
+        trigrams.reserve(name.size() - 2);
+        for (std::size_t i = 0; i + 2 < name.size(); ++i)
+            trigrams.push_back(MakeTrigram(name, i));
+
+        std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+        for (uint64 trigram : trigrams)
+            AddPosting(index.Trigrams[trigram], auctionId);
+    }
+
+    index.Names[auctionId] = std::move(name);
+}
+
+AuctionSearchIndex::NameIndex const* AuctionSearchIndex::GetNameIndex(LocaleConstant dbLocale, LocaleConstant dbcLocale, std::function<bool()> const& mustStop)
+{
+    NameIndex& index = _names[(uint32(dbLocale) << 8) | uint32(dbcLocale)];
+    if (index.Complete)
+        return &index;
+
+    // auctions inserted meanwhile already have their name, building it again changes nothing
+    uint32 built = 0;
+    for (PostingList::const_iterator itr = std::lower_bound(_all.begin(), _all.end(), index.NextAuctionId); itr != _all.end(); ++itr)
+    {
+        auto auction = _auctions.find(*itr);
+        if (auction != _auctions.end())
+            AddName(index, *itr, _nameBuilder(auction->second.Proto, auction->second.RandomPropertyId, dbLocale, dbcLocale));
+
+        index.NextAuctionId = *itr + 1;
+        if (++built % StopCheckInterval == 0 && mustStop())
+            return nullptr;
+    }
+
+    index.Complete = true;
+    return &index;
+}
+
+bool AuctionSearchIndex::Matches(IndexedAuction const& auction, AuctionSearchFilter const& filter)
+{
+    if (filter.ItemClass != 0xffffffff && auction.ItemClass != filter.ItemClass)
+        return false;
+
+    if (filter.ItemSubClass != 0xffffffff && auction.ItemSubClass != filter.ItemSubClass)
+        return false;
+
+    if (filter.InventoryType != 0xffffffff && auction.InventoryType != filter.InventoryType)
+    {
+        // xinef: exception, robes are counted as chests
+        if (filter.InventoryType != INVTYPE_CHEST || auction.InventoryType != INVTYPE_ROBE)
+            return false;
+    }
+
+    if (filter.Quality != 0xffffffff && auction.Quality < filter.Quality)
+        return false;
+
+    if (filter.LevelMin != 0x00 && (auction.RequiredLevel < filter.LevelMin || (filter.LevelMax != 0x00 && auction.RequiredLevel > filter.LevelMax)))
+        return false;
+
+    return true;
+}
+
+bool AuctionSearchIndex::Search(AuctionSearchFilter const& filter, std::vector<AuctionEntry*>& auctions, std::function<bool()> const& mustStop)
+{
+    // pick the shortest posting list (or union of lists for range filters) that every match must be part of
+    PostingList const* candidates = &_all;
+    std::vector<PostingList const*> candidateUnion;
+    std::size_t candidateCount = _all.size();
+
+    auto consider = [&](PostingList const* list)
+    {
+        if (list->size() < candidateCount)
+        {
+            candidates = list;
+            candidateUnion.clear();
+            candidateCount = list->size();
+        }
+    };
+
+    auto considerUnion = [&](PostingMap const& map, auto inRange)
+    {
+        std::vector<PostingList const*> lists;
+        std::size_t count = 0;
+        for (auto const& itr : map)
+        {
+            if (inRange(itr.first))
+            {
+                lists.push_back(&itr.second);
+                count += itr.second.size();
+            }
+        }
+
+        if (count < candidateCount)
+        {
+            candidateUnion = std::move(lists);
+            candidateCount = count;
+        }
+
+        return count != 0;
+    };
+
+    if (filter.ItemClass != 0xffffffff)
+    {
+        PostingList const* list = FindPostings(_byClass, filter.ItemClass);
+        if (!list)
+            return true;
+        consider(list);
+
+        if (filter.ItemSubClass != 0xffffffff)
+        {
+            list = FindPostings(_bySubClass, (filter.ItemClass << 16) | filter.ItemSubClass);
+            if (!list)
+                return true;
+            consider(list);
+        }
+    }
+
+    if (filter.InventoryType != 0xffffffff)
+    {
+        PostingList const* list = FindPostings(_byInventoryType, filter.InventoryType);
+        if (!list)
+            return true;
+        consider(list);
+    }
+
+    if (filter.Quality != 0xffffffff)
+        if (!considerUnion(_byQuality, [&](uint32 quality) { return quality >= filter.Quality; }))
+            return true;
+
+    if (filter.LevelMin != 0x00)
+        if (!considerUnion(_byLevel, [&](uint32 level) { return level >= filter.LevelMin && (filter.LevelMax == 0x00 || level <= filter.LevelMax); }))
+            return true;
+
+    NameIndex const* names = nullptr;
+    if (!filter.Name.empty())
+    {
+        names = GetNameIndex(filter.DbLocale, filter.DbcLocale, mustStop);
+        if (!names)
+            return false;
+
+        // every trigram of the searched text must be part of the name, shorter searches only verify the names
+        for (std::size_t i = 0; i + 2 < filter.Name.size(); ++i)
+        {
+            PostingList const* list = FindPostings(names->Trigrams, MakeTrigram(filter.Name, i));
+            if (!list)
+                return true;
+            consider(list);
+        }
+    }
+
+    PostingList merged;
+    if (!candidateUnion.empty())
+    {
+        merged.reserve(candidateCount);
+        for (PostingList const* list : candidateUnion)
+            merged.insert(merged.end(), list->begin(), list->end());
+
+        // a reused id may linger in the list of its previous quality or level
+        std::sort(merged.begin(), merged.end());
+        merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+        candidates = &merged;
+    }
+
+    std::size_t const found = auctions.size();
+    uint32 verified = 0;
+    for (uint32 auctionId : *candidates)
+    {
+        if (++verified % StopCheckInterval == 0 && mustStop())
+        {
+            auctions.resize(found);
+            return false;
+        }
+
+        auto itr = _auctions.find(auctionId);
+        if (itr == _auctions.end() || !Matches(itr->second, filter))
+            continue;
+
+        if (names)
+        {
+            auto name = names->Names.find(auctionId);
+            if (name == names->Names.end() || name->second.find(filter.Name) == std::wstring::npos)
+                continue;
+        }
+
+        auctions.push_back(itr->second.Auction);
+    }
+
+    return true;
+}
@@ -0,0 +1,111 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _AUCTION_SEARCH_INDEX_H
+#define _AUCTION_SEARCH_INDEX_H
+
+#include "Common.h"
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct AuctionEntry;
+struct ItemTemplate;
+
+struct AuctionSearchFilter
+{
+    uint32 ItemClass = 0xffffffff;
+    uint32 ItemSubClass = 0xffffffff;
+    uint32 InventoryType = 0xffffffff;
+    uint32 Quality = 0xffffffff;
+    uint8 LevelMin = 0;
+    uint8 LevelMax = 0;
+    std::wstring Name;                                  // lower case, empty when not searching by name
+    LocaleConstant DbLocale = LOCALE_enUS;              // item_template_locale name
+    LocaleConstant DbcLocale = LOCALE_enUS;             // random property suffix
+};
+
+// Secondary indexes over the auctions of one auction house: posting lists of auction ids per item class,
+// class/subclass, inventory type, quality and required level, and per locale a trigram index of the lower
+// case item names (with random property suffix). A search walks the smallest posting list that applies to
+// the filter and verifies the remaining conditions on the indexed copy of the item template fields.
+// Removed ids stay in the posting lists until enough of them piled up for a compaction.
+class AC_GAME_API AuctionSearchIndex
+{
+public:
+    // returns the name an auction is searched by for the given db and dbc locales, in lower case
+    typedef std::function<std::wstring(ItemTemplate const* proto, int32 randomPropertyId, LocaleConstant dbLocale, LocaleConstant dbcLocale)> NameBuilder;
+
+    explicit AuctionSearchIndex(NameBuilder nameBuilder);
+
+    void Insert(AuctionEntry* auction, ItemTemplate const* proto, int32 randomPropertyId);
+    void Remove(uint32 auctionId);
+    void Clear();
+
+    // Appends the auctions matching the filter in ascending id order, expiration and usability are left to the caller.
+    // mustStop is checked every few hundred auctions verified or names built for the name index of a new locale: when
+    // it tells to stop, false is returned without any auction and the built part of the name index is kept.
+    bool Search(AuctionSearchFilter const& filter, std::vector<AuctionEntry*>& auctions, std::function<bool()> const& mustStop);
+
+    [[nodiscard]] std::size_t GetSize() const { return _auctions.size(); }
+
+private:
+    typedef std::vector<uint32> PostingList;
+    typedef std::unordered_map<uint32, PostingList> PostingMap;
+
+    struct IndexedAuction
+    {
+        AuctionEntry* Auction;
+        ItemTemplate const* Proto;
+        int32 RandomPropertyId;
+        uint32 ItemClass;
+        uint32 ItemSubClass;
+        uint32 InventoryType;
+        uint32 Quality;
+        uint32 RequiredLevel;
+    };
+
+    struct NameIndex
+    {
+        std::unordered_map<uint32, std::wstring> Names;
+        std::unordered_map<uint64, PostingList> Trigrams;
+        uint32 NextAuctionId = 0;                       // the names of the auctions below are built
+        bool Complete = false;
+    };
+
+    static void AddPosting(PostingList& list, uint32 auctionId);
+    static uint64 MakeTrigram(std::wstring const& name, std::size_t offset);
+    static bool Matches(IndexedAuction const& auction, AuctionSearchFilter const& filter);
+
+    NameIndex const* GetNameIndex(LocaleConstant dbLocale, LocaleConstant dbcLocale, std::function<bool()> const& mustStop);
+    void AddName(NameIndex& index, uint32 auctionId, std::wstring name);
+    void Compact();
+
+    NameBuilder _nameBuilder;
+    std::unordered_map<uint32, IndexedAuction> _auctions;
+    PostingList _all;
+    PostingMap _byClass;
+    PostingMap _bySubClass;
+    PostingMap _byInventoryType;
+    PostingMap _byQuality;
+    PostingMap _byLevel;
+    std::unordered_map<uint32, NameIndex> _names;       // by db and dbc locale, built by the first name searches of a locale
+    std::size_t _removedSinceCompaction;
+};
+
+#endif
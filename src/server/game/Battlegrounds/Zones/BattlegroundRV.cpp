@@ -48,7 +48,7 @@ void BattlegroundRV::TeleportUnitToNewZ(Unit* unit, float newZ, bool casting)
     if (!unit->IsAlive())
         return;
     unit->NearTeleportTo(unit->GetPositionX(), unit->GetPositionY(), newZ, unit->GetOrientation(), casting);
-    unit->m_positionZ = newZ;
+    unit->Relocate(unit->GetPositionX(), unit->GetPositionY(), newZ);
 }
 
 void BattlegroundRV::CheckPositionForUnit(Unit* unit)
@@ -95,6 +95,9 @@ HostileReference::HostileReference(Unit* refUnit, ThreatMgr* threatMgr, float th
 {
     iThreat = threat;
     iTempThreatModifier = 0.0f;
+    iHeapIndex = 0;
+    iSortedThreat = 0.0f;
+    iThreatOrder = 0;
     link(refUnit, threatMgr);
     iUnitGuid = refUnit->GetGUID();
     iOnline = true;
@@ -246,6 +249,8 @@ void ThreatContainer::clearReferences()
     }
 
     iThreatList.clear();
+    iThreatHeap.clear();
+    iReferences.clear();
 }
 
 //============================================================
@@ -255,15 +260,41 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim) const
     if (!victim)
         return nullptr;
 
-    ObjectGuid const guid = victim->GetGUID();
-    for (ThreatContainer::StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-    {
-        HostileReference* ref = (*i);
-        if (ref && ref->getUnitGuid() == guid)
-            return ref;
-    }
+    auto itr = iReferences.find(victim->GetGUID());
+    return itr != iReferences.end() ? *itr->second : nullptr;
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileRef)
+{
+    iReferences[hostileRef->getUnitGuid()] = iThreatList.insert(iThreatList.end(), hostileRef);
+    iThreatHeap.push(hostileRef);
+    iDirty = true;
+}
 
-    return nullptr;
+//============================================================
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    auto itr = iReferences.find(hostileRef->getUnitGuid());
+    if (itr == iReferences.end() || *itr->second != hostileRef)
+        return;
+
+    iThreatList.erase(itr->second);
+    iReferences.erase(itr);
+    iThreatHeap.erase(hostileRef);
+}
+
+//============================================================
+
+void ThreatContainer::updateThreat(HostileReference* hostileRef)
+{
+    if (!iThreatHeap.contains(hostileRef))
+        return;
+
+    iThreatHeap.update(hostileRef);
+    iDirty = true;
 }
 
 //============================================================
@@ -288,14 +319,46 @@ void ThreatContainer::modifyThreatPercent(Unit* victim, int32 percent)
 //============================================================
 // Check if the list is dirty and sort if necessary
 
-void ThreatContainer::update()
+void ThreatContainer::update() const
 {
     if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(Acore::ThreatOrderPred());
+        iThreatList.sort(ThreatHeap::Order());
 
     iDirty = false;
 }
 
+//============================================================
+
+namespace
+{
+    // what the victim selection needs to know about the targets of the attacker
+    class VictimChecks
+    {
+    public:
+        explicit VictimChecks(Creature* attacker) : _attacker(attacker) { }
+
+        bool IsSecondChoice(HostileReference* ref) const
+        {
+            Unit* target = ref->getTarget();
+            ASSERT(target); // if the ref has status online the target must be there !
+            return target->IsImmunedToDamageOrSchool(_attacker->GetMeleeDamageSchoolMask()) || target->HasNegativeAuraWithInterruptFlag(AURA_INTERRUPT_FLAG_TAKE_DAMAGE) || target->HasAuraTypeWithCaster(SPELL_AURA_IGNORED, _attacker->GetGUID());
+        }
+
+        bool CanAttack(HostileReference* ref) const
+        {
+            return _attacker->_CanDetectFeignDeathOf(ref->getTarget()) && _attacker->CanCreatureAttack(ref->getTarget());
+        }
+
+        bool IsWithinMeleeRange(HostileReference* ref) const
+        {
+            return _attacker->IsWithinMeleeRange(ref->getTarget());
+        }
+
+    private:
+        Creature* _attacker;
+    };
+}
+
 //============================================================
 // return the next best victim
 // could be the current victim
@@ -304,10 +367,6 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
 {
     // pussywizard: pretty much remade this whole function
 
-    HostileReference* currentRef = nullptr;
-    bool found = false;
-    bool noPriorityTargetFound = false;
-
     // pussywizard: currentVictim is needed to compare if threat was exceeded by 10%/30% for melee/range targets (only then switching current target)
     if (currentVictim)
     {
@@ -318,78 +377,7 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
             currentVictim = nullptr;
     }
 
-    ThreatContainer::StorageType::const_iterator lastRef = iThreatList.end();
-    --lastRef;
-
-    // pussywizard: iterate from highest to lowest threat
-    for (ThreatContainer::StorageType::const_iterator iter = iThreatList.begin(); iter != iThreatList.end() && !found;)
-    {
-        currentRef = (*iter);
-
-        Unit* target = currentRef->getTarget();
-        ASSERT(target); // if the ref has status online the target must be there !
-
-        // pussywizard: don't go to threat comparison if this ref is immune to damage or has aura breakable on damage (second choice target)
-        // pussywizard: if this is the last entry on the threat list, then all targets are second choice, set bool to true and loop threat list again, ignoring this section
-        if (!noPriorityTargetFound && (target->IsImmunedToDamageOrSchool(attacker->GetMeleeDamageSchoolMask()) || target->HasNegativeAuraWithInterruptFlag(AURA_INTERRUPT_FLAG_TAKE_DAMAGE) || target->HasAuraTypeWithCaster(SPELL_AURA_IGNORED, attacker->GetGUID())))
-        {
-            if (iter != lastRef)
-            {
-                ++iter;
-                continue;
-            }
-            else
-            {
-                noPriorityTargetFound = true;
-                iter = iThreatList.begin();
-                continue;
-            }
-        }
-
-        // pussywizard: skip not valid targets
-        if (attacker->_CanDetectFeignDeathOf(target) && attacker->CanCreatureAttack(target))
-        {
-            if (currentVictim) // pussywizard: if not nullptr then target must have 10%/30% more threat
-            {
-                if (currentVictim == currentRef) // pussywizard: nothing found previously was good and enough, currentRef passed all necessary tests, so end now
-                {
-                    found = true;
-                    break;
-                }
-
-                // pussywizard: implement 110% threat rule for targets in melee range and 130% rule for targets in ranged distances
-                if (currentRef->getThreat() > 1.3f * currentVictim->getThreat()) // pussywizard: enough in all cases, end
-                {
-                    found = true;
-                    break;
-                }
-                else if (currentRef->getThreat() > 1.1f * currentVictim->getThreat()) // pussywizard: enought only if target in melee range
-                {
-                    if (attacker->IsWithinMeleeRange(target))
-                    {
-                        found = true;
-                        break;
-                    }
-                }
-                else // pussywizard: nothing found previously was good and enough, this and next entries on the list have less than 110% threat, and currentVictim is present and valid as checked before the loop (otherwise it's nullptr), so end now
-                {
-                    currentRef = currentVictim;
-                    found = true;
-                    break;
-                }
-            }
-            else // pussywizard: no currentVictim, first passing all checks is chosen (highest threat, list is sorted)
-            {
-                found = true;
-                break;
-            }
-        }
-        ++iter;
-    }
-    if (!found)
-        currentRef = nullptr;
-
-    return currentRef;
+    return Acore::SelectNextVictim(iThreatHeap, currentVictim, VictimChecks(attacker));
 }
 
 //============================================================
@@ -468,7 +456,7 @@ void ThreatMgr::modifyThreatPercent(Unit* victim, int32 percent)
 
 Unit* ThreatMgr::getHostilTarget()
 {
-    iThreatContainer.update();
+    iThreatContainer.markSorted();
     HostileReference* nextVictim = iThreatContainer.selectNextVictim(GetOwner()->ToCreature(), getCurrentVictim());
     setCurrentVictim(nextVictim);
     return getCurrentVictim() != nullptr ? getCurrentVictim()->getTarget() : nullptr;
@@ -545,6 +533,8 @@ void ThreatMgr::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStatusCh
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
+            iThreatContainer.updateThreat(hostilRef);
+            iThreatOfflineContainer.updateThreat(hostilRef);
             if ((getCurrentVictim() == hostilRef && threatRefStatusChangeEvent->getFValue() < 0.0f) ||
                     (getCurrentVictim() != hostilRef && threatRefStatusChangeEvent->getFValue() > 0.0f))
                 setDirty(true);                             // the order in the threat list might have changed
@@ -568,8 +558,9 @@ void ThreatMgr::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStatusCh
             {
                 if (getCurrentVictim() && hostilRef->getThreat() > (1.1f * getCurrentVictim()->getThreat()))
                     setDirty(true);
-                iThreatContainer.addReference(hostilRef);
+                // remove first, the heap position of the reference is overwritten when it is added to the other container
                 iThreatOfflineContainer.remove(hostilRef);
+                iThreatContainer.addReference(hostilRef);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
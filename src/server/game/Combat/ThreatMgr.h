@@ -19,10 +19,17 @@
 #define _THREATMANAGER
 
 #include "Common.h"
+#include "IndexedPriorityQueue.h"
 #include "LinkedReference/Reference.h"
+#include "ObjectGuid.h"
 #include "SharedDefines.h"
 #include "UnitEvents.h"
+#include <algorithm>
+#include <limits>
 #include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 //==============================================================
 
@@ -33,6 +40,178 @@ class SpellInfo;
 
 #define THREAT_UPDATE_INTERVAL 2 * IN_MILLISECONDS    // Server should send threat update to client periodically each second
 
+//==============================================================
+
+namespace Acore
+{
+    // References ordered by threat, highest first. Equal threat keeps the order ThreatContainer::update gave the list
+    // when it stable sorted it by threat before each target selection: until the next markSorted() the references tie
+    // by the threat they had at the last sort, then by their position after it, references added since come last.
+    template<class T, uint32 T::* HeapIndex, float T::* SortedThreat, int64 T::* TieOrder>
+    class ThreatHeap
+    {
+    public:
+        struct Order
+        {
+            bool operator()(T const* a, T const* b) const
+            {
+                if (a->getThreat() != b->getThreat())
+                    return a->getThreat() > b->getThreat();
+                if (a->*SortedThreat != b->*SortedThreat)
+                    return a->*SortedThreat > b->*SortedThreat;
+                return a->*TieOrder < b->*TieOrder;
+            }
+        };
+
+        [[nodiscard]] bool empty() const { return _heap.empty(); }
+        [[nodiscard]] std::size_t size() const { return _heap.size(); }
+        [[nodiscard]] T* top() const { return _heap.top(); }
+        [[nodiscard]] bool contains(T const* ref) const { return _heap.contains(ref); }
+
+        void push(T* ref)
+        {
+            ref->*SortedThreat = -std::numeric_limits<float>::infinity();
+            ref->*TieOrder = ++_lastOrder;
+            _heap.push(ref);
+            _changed.push_back(ref);
+        }
+
+        void erase(T* ref)
+        {
+            _heap.erase(ref);
+            _changed.erase(std::remove(_changed.begin(), _changed.end(), ref), _changed.end());
+        }
+
+        // Must be called after the threat of the reference was changed
+        void update(T* ref)
+        {
+            if (!_heap.contains(ref))
+                return;
+
+            if (std::find(_changed.begin(), _changed.end(), ref) == _changed.end())
+                _changed.push_back(ref);
+            _heap.update(ref);
+        }
+
+        // The current order becomes the one ties are kept in, as if the list was sorted now. Only the references changed
+        // since the last call are renumbered: those that lost threat go in front of the references they tie with, the
+        // others behind them, each group in the current order. That keeps the order of the heap, so nothing is moved.
+        void markSorted()
+        {
+            std::sort(_changed.begin(), _changed.end(), [](T const* a, T const* b)
+            {
+                if (a->*SortedThreat != b->*SortedThreat)
+                    return a->*SortedThreat > b->*SortedThreat;
+                return a->*TieOrder < b->*TieOrder;
+            });
+
+            for (auto itr = _changed.rbegin(); itr != _changed.rend(); ++itr)
+                if ((*itr)->getThreat() < (*itr)->*SortedThreat)
+                    (*itr)->*TieOrder = --_firstOrder;
+
+            for (T* ref : _changed)
+            {
+                if (ref->getThreat() > ref->*SortedThreat)
+                    ref->*TieOrder = ++_lastOrder;
+                ref->*SortedThreat = ref->getThreat();
+            }
+
+            _changed.clear();
+        }
+
+        void clear()
+        {
+            _heap.clear();
+            _changed.clear();
+            _firstOrder = 0;
+            _lastOrder = 0;
+        }
+
+        template<class Visitor>
+        T* visitOrdered(Visitor&& visitor) const { return _heap.visitOrdered(std::forward<Visitor>(visitor)); }
+
+    private:
+        IndexedPriorityQueue<T, Order, HeapIndex> _heap;
+        std::vector<T*> _changed;
+        int64 _firstOrder{0};
+        int64 _lastOrder{0};
+    };
+
+    // The target switch rules of ThreatContainer::selectNextVictim. Checks tells IsSecondChoice(ref), CanAttack(ref) and
+    // IsWithinMeleeRange(ref) for the attacker, currentVictim is nullptr unless the attacker may keep attacking it.
+    template<class T, class Heap, class Checks>
+    T* SelectNextVictim(Heap const& heap, T* currentVictim, Checks const& checks)
+    {
+        if (heap.empty())
+            return nullptr;
+
+        T* selectedRef = nullptr;
+        bool noPriorityTargetFound = false;
+        std::size_t visited = 0;
+
+        // pussywizard: iterate from highest to lowest threat
+        auto selectVictim = [&](T* currentRef) -> bool
+        {
+            ++visited;
+
+            // pussywizard: don't go to threat comparison if this ref is immune to damage or has aura breakable on damage (second choice target)
+            // pussywizard: if this is the last entry on the threat list, then all targets are second choice, set bool to true and loop threat list again, ignoring this section
+            if (!noPriorityTargetFound && checks.IsSecondChoice(currentRef))
+            {
+                if (visited == heap.size())
+                    noPriorityTargetFound = true;
+                return false;
+            }
+
+            // pussywizard: skip not valid targets
+            if (!checks.CanAttack(currentRef))
+                return false;
+
+            if (currentVictim) // pussywizard: if not nullptr then target must have 10%/30% more threat
+            {
+                if (currentVictim == currentRef) // pussywizard: nothing found previously was good and enough, currentRef passed all necessary tests, so end now
+                {
+                    selectedRef = currentRef;
+                    return true;
+                }
+
+                // pussywizard: implement 110% threat rule for targets in melee range and 130% rule for targets in ranged distances
+                if (currentRef->getThreat() > 1.3f * currentVictim->getThreat()) // pussywizard: enough in all cases, end
+                {
+                    selectedRef = currentRef;
+                    return true;
+                }
+                else if (currentRef->getThreat() > 1.1f * currentVictim->getThreat()) // pussywizard: enought only if target in melee range
+                {
+                    if (checks.IsWithinMeleeRange(currentRef))
+                    {
+                        selectedRef = currentRef;
+                        return true;
+                    }
+                }
+                else // pussywizard: nothing found previously was good and enough, this and next entries on the list have less than 110% threat, and currentVictim is present and valid as checked before the loop (otherwise it's nullptr), so end now
+                {
+                    selectedRef = currentVictim;
+                    return true;
+                }
+            }
+            else // pussywizard: no currentVictim, first passing all checks is chosen (highest threat)
+            {
+                selectedRef = currentRef;
+                return true;
+            }
+
+            return false;
+        };
+
+        heap.visitOrdered(selectVictim);
+        if (!selectedRef && noPriorityTargetFound)
+            heap.visitOrdered(selectVictim);
+
+        return selectedRef;
+    }
+}
+
 //==============================================================
 // Class to calculate the real threat based
 
@@ -45,6 +224,8 @@ struct ThreatCalcHelper
 //==============================================================
 class HostileReference : public Reference<Unit, ThreatMgr>
 {
+    friend class ThreatContainer;
+
 public:
     HostileReference(Unit* refUnit, ThreatMgr* threatMgr, float threat);
 
@@ -126,6 +307,9 @@ private:
     float iTempThreatModifier;                          // used for taunt
     ObjectGuid iUnitGuid;
     bool iOnline;
+    uint32 iHeapIndex;                                  // position in the threat heap of the owning container
+    float iSortedThreat;                                // threat at the last sort of the owning container
+    int64 iThreatOrder;                                 // breaks threat ties in the owning container
 };
 
 //==============================================================
@@ -135,6 +319,8 @@ class ThreatContainer
 {
     friend class ThreatMgr;
 
+    typedef Acore::ThreatHeap<HostileReference, &HostileReference::iHeapIndex, &HostileReference::iSortedThreat, &HostileReference::iThreatOrder> ThreatHeap;
+
 public:
     typedef std::list<HostileReference*> StorageType;
 
@@ -159,31 +345,38 @@ public:
 
     [[nodiscard]] HostileReference* getMostHated() const
     {
-        return iThreatList.empty() ? nullptr : iThreatList.front();
+        return iThreatHeap.top();
     }
 
     HostileReference* getReferenceByTarget(Unit* victim) const;
 
-    [[nodiscard]] StorageType const& getThreatList() const { return iThreatList; }
-
-private:
-    void remove(HostileReference* hostileRef)
+    // sorted by threat, the order is only restored when the list is requested
+    [[nodiscard]] StorageType const& getThreatList() const
     {
-        iThreatList.remove(hostileRef);
+        update();
+        return iThreatList;
     }
 
-    void addReference(HostileReference* hostileRef)
-    {
-        iThreatList.push_back(hostileRef);
-    }
+private:
+    void remove(HostileReference* hostileRef);
+
+    void addReference(HostileReference* hostileRef);
+
+    // Reposition the reference after its threat was modified
+    void updateThreat(HostileReference* hostileRef);
 
     void clearReferences();
 
+    // The tie order of the threat heap becomes the current order, done where the list used to be sorted
+    void markSorted() { iThreatHeap.markSorted(); }
+
     // Sort the list if necessary
-    void update();
+    void update() const;
 
-    StorageType iThreatList;
-    bool iDirty{false};
+    mutable StorageType iThreatList;
+    ThreatHeap iThreatHeap;
+    std::unordered_map<ObjectGuid, StorageType::iterator> iReferences;
+    mutable bool iDirty{false};
 };
 
 //=================================================
@@ -225,9 +225,12 @@ void Creature::AddToWorld()
         if (GetZoneScript())
             GetZoneScript()->OnCreatureCreate(this);
 
-        GetMap()->GetObjectsStore().Insert<Creature>(GetGUID(), this);
+        GetMap()->AddToObjectsStore<Creature>(GetGUID(), this);
         if (m_spawnId)
+        {
+            auto guard = GetMap()->GetRegionGuard();
             GetMap()->GetCreatureBySpawnIdStore().insert(std::make_pair(m_spawnId, this));
+        }
 
         Unit::AddToWorld();
 
@@ -262,9 +265,12 @@ void Creature::RemoveFromWorld()
         Unit::RemoveFromWorld();
 
         if (m_spawnId)
+        {
+            auto guard = GetMap()->GetRegionGuard();
             Acore::Containers::MultimapErasePair(GetMap()->GetCreatureBySpawnIdStore(), m_spawnId, this);
+        }
 
-        GetMap()->GetObjectsStore().Remove<Creature>(GetGUID());
+        GetMap()->RemoveFromObjectsStore<Creature>(GetGUID());
     }
 }
 
@@ -1026,7 +1032,7 @@ bool Creature::Create(ObjectGuid::LowType guidlow, Map* map, uint32 phaseMask, u
     }
 
     //! Need to be called after LoadCreaturesAddon - MOVEMENTFLAG_HOVER is set there
-    m_positionZ += GetHoverHeight();
+    Relocate(GetPositionX(), GetPositionY(), GetPositionZ() + GetHoverHeight());
 
     LastUsedScriptID = GetCreatureTemplate()->ScriptID;
 
@@ -1898,9 +1904,13 @@ void Creature::Respawn(bool force)
             TriggerJustRespawned = true;//delay event to next tick so all creatures are created on the map before processing
         }
 
+        // the pool may spawn its next member in another region of the map
         uint32 poolid = m_spawnId ? sPoolMgr->IsPartOfAPool<Creature>(m_spawnId) : 0;
         if (poolid)
-            sPoolMgr->UpdatePool<Creature>(poolid, m_spawnId);
+        {
+            ObjectGuid::LowType spawnId = m_spawnId;
+            GetMap()->RunOnMapThread([poolid, spawnId]() { sPoolMgr->UpdatePool<Creature>(poolid, spawnId); });
+        }
 
         //Re-initialize reactstate that could be altered by movementgenerators
         InitializeReactState();
@@ -2157,6 +2167,9 @@ Unit* Creature::SelectNearestTarget(float dist, bool playerOnly /* = false */) c
 
     Acore::NearestHostileUnitCheck u_check(this, dist, playerOnly);
     Acore::UnitLastSearcher<Acore::NearestHostileUnitCheck> searcher(this, target, u_check);
+    // distances are measured between transport offsets when both units are on the same transport
+    if (!GetTransport())
+        searcher.SetRangeFilter(*this, dist);
     Cell::VisitAllObjects(this, searcher, dist);
     return target;
 }
@@ -2172,6 +2185,8 @@ Unit* Creature::SelectNearestTargetInAttackDistance(float dist) const
     Unit* target = nullptr;
     Acore::NearestHostileUnitInAttackDistanceCheck u_check(this, dist);
     Acore::UnitLastSearcher<Acore::NearestHostileUnitInAttackDistanceCheck> searcher(this, target, u_check);
+    if (!GetTransport())
+        searcher.SetRangeFilter(*this, dist);
     Cell::VisitAllObjects(this, searcher, std::max(dist, ATTACK_DISTANCE));
 
     return target;
@@ -2203,6 +2218,8 @@ void Creature::CallAssistance()
 
             Acore::AnyAssistCreatureInRangeCheck u_check(this, GetVictim(), radius);
             Acore::CreatureListSearcher<Acore::AnyAssistCreatureInRangeCheck> searcher(this, assistList, u_check);
+            if (!GetTransport())
+                searcher.SetRangeFilter(*this, radius + GetObjectSize());
             Cell::VisitGridObjects(this, searcher, radius);
 
             if (!assistList.empty())
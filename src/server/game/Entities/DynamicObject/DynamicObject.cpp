@@ -62,7 +62,7 @@ void DynamicObject::AddToWorld()
     ///- Register the dynamicObject for guid lookup and for caster
     if (!IsInWorld())
     {
-        GetMap()->GetObjectsStore().Insert<DynamicObject>(GetGUID(), this);
+        GetMap()->AddToObjectsStore<DynamicObject>(GetGUID(), this);
 
         WorldObject::AddToWorld();
 
@@ -92,7 +92,7 @@ void DynamicObject::RemoveFromWorld()
 
         WorldObject::RemoveFromWorld();
 
-        GetMap()->GetObjectsStore().Remove<DynamicObject>(GetGUID());
+        GetMap()->RemoveFromObjectsStore<DynamicObject>(GetGUID());
     }
 }
 
@@ -146,9 +146,12 @@ void GameObject::AddToWorld()
         if (m_zoneScript)
             m_zoneScript->OnGameObjectCreate(this);
 
-        GetMap()->GetObjectsStore().Insert<GameObject>(GetGUID(), this);
+        GetMap()->AddToObjectsStore<GameObject>(GetGUID(), this);
         if (m_spawnId)
+        {
+            auto guard = GetMap()->GetRegionGuard();
             GetMap()->GetGameObjectBySpawnIdStore().insert(std::make_pair(m_spawnId, this));
+        }
 
         if (m_model)
         {
@@ -188,8 +191,11 @@ void GameObject::RemoveFromWorld()
         WorldObject::RemoveFromWorld();
 
         if (m_spawnId)
+        {
+            auto guard = GetMap()->GetRegionGuard();
             Acore::Containers::MultimapErasePair(GetMap()->GetGameObjectBySpawnIdStore(), m_spawnId, this);
-        GetMap()->GetObjectsStore().Remove<GameObject>(GetGUID());
+        }
+        GetMap()->RemoveFromObjectsStore<GameObject>(GetGUID());
     }
 }
 
@@ -578,7 +584,10 @@ void GameObject::Update(uint32 diff)
                         // respawn timer
                         uint32 poolid = m_spawnId ? sPoolMgr->IsPartOfAPool<GameObject>(m_spawnId) : 0;
                         if (poolid)
-                            sPoolMgr->UpdatePool<GameObject>(poolid, m_spawnId);
+                        {
+                            ObjectGuid::LowType spawnId = m_spawnId;
+                            GetMap()->RunOnMapThread([poolid, spawnId]() { sPoolMgr->UpdatePool<GameObject>(poolid, spawnId); });
+                        }
                         else
                             GetMap()->AddToMap(this);
                     }
@@ -815,9 +824,13 @@ void GameObject::Delete()
     if (GetGOInfo()->type == GAMEOBJECT_TYPE_SUMMONING_RITUAL)
         ClearRitualList();
 
+    // the pool may spawn its next member in another region of the map
     uint32 poolid = m_spawnId ? sPoolMgr->IsPartOfAPool<GameObject>(m_spawnId) : 0;
     if (poolid)
-        sPoolMgr->UpdatePool<GameObject>(poolid, m_spawnId);
+    {
+        ObjectGuid::LowType spawnId = m_spawnId;
+        GetMap()->RunOnMapThread([poolid, spawnId]() { sPoolMgr->UpdatePool<GameObject>(poolid, spawnId); });
+    }
     else
         AddObjectToRemoveList();
 }
@@ -2421,7 +2434,6 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
         return;
 
     bool forcedFlags = GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo()->chest.groupLootRules && HasLootRecipient();
-    bool targetIsGM = target->IsGameMaster() && AccountMgr::IsGMAccount(target->GetSession()->GetSecurity());
 
     ByteBuffer fieldBuffer;
 
@@ -2441,66 +2453,8 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
         {
             updateMask.SetBit(index);
 
-            if (index == GAMEOBJECT_DYNAMIC)
-            {
-                uint16 dynFlags = 0;
-                int16 pathProgress = -1;
-                switch (GetGoType())
-                {
-                    case GAMEOBJECT_TYPE_QUESTGIVER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_CHEST:
-                    case GAMEOBJECT_TYPE_GOOBER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
-                        else if (targetIsGM)
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                    case GAMEOBJECT_TYPE_GENERIC:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_SPARKLE;
-                        break;
-                    case GAMEOBJECT_TYPE_TRANSPORT:
-                        if (const StaticTransport* t = ToStaticTransport())
-                            if (t->GetPauseTime())
-                            {
-                                if (GetGoState() == GO_STATE_READY)
-                                {
-                                    if (t->GetPathProgress() >= t->GetPauseTime()) // if not, send 100% progress
-                                        pathProgress = int16(float(t->GetPathProgress() - t->GetPauseTime()) / float(t->GetPeriod() - t->GetPauseTime()) * 65535.0f);
-                                }
-                                else
-                                {
-                                    if (t->GetPathProgress() <= t->GetPauseTime()) // if not, send 100% progress
-                                        pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPauseTime()) * 65535.0f);
-                                }
-                            }
-                        // else it's ignored
-                        break;
-                    case GAMEOBJECT_TYPE_MO_TRANSPORT:
-                        if (const MotionTransport* t = ToMotionTransport())
-                            pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPeriod()) * 65535.0f);
-                        break;
-                    default:
-                        break;
-                }
-
-                fieldBuffer << uint16(dynFlags);
-                fieldBuffer << int16(pathProgress);
-            }
-            else if (index == GAMEOBJECT_FLAGS)
-            {
-                uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
-                if (GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo() && GetGOInfo()->chest.groupLootRules && !IsLootAllowedFor(target))
-                {
-                    goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
-                }
-
-                fieldBuffer << goFlags;
-            }
+            if (IsUpdateFieldValueViewerDependent(index))
+                BuildViewerDependentUpdateField(updateType, index, fieldBuffer, target);
             else
                 fieldBuffer << m_uint32Values[index];                // other cases
         }
@@ -2511,6 +2465,77 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
     data->append(fieldBuffer);
 }
 
+bool GameObject::IsUpdateFieldValueViewerDependent(uint16 index) const
+{
+    return index == GAMEOBJECT_DYNAMIC || index == GAMEOBJECT_FLAGS;
+}
+
+void GameObject::BuildViewerDependentUpdateField(uint8 /*updateType*/, uint16 index, ByteBuffer& fieldBuffer, Player* target) const
+{
+    bool targetIsGM = target->IsGameMaster() && AccountMgr::IsGMAccount(target->GetSession()->GetSecurity());
+
+    if (index == GAMEOBJECT_DYNAMIC)
+    {
+        uint16 dynFlags = 0;
+        int16 pathProgress = -1;
+        switch (GetGoType())
+        {
+            case GAMEOBJECT_TYPE_QUESTGIVER:
+                if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                break;
+            case GAMEOBJECT_TYPE_CHEST:
+            case GAMEOBJECT_TYPE_GOOBER:
+                if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                else if (targetIsGM)
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                break;
+            case GAMEOBJECT_TYPE_SPELL_FOCUS:
+            case GAMEOBJECT_TYPE_GENERIC:
+                if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_SPARKLE;
+                break;
+            case GAMEOBJECT_TYPE_TRANSPORT:
+                if (const StaticTransport* t = ToStaticTransport())
+                    if (t->GetPauseTime())
+                    {
+                        if (GetGoState() == GO_STATE_READY)
+                        {
+                            if (t->GetPathProgress() >= t->GetPauseTime()) // if not, send 100% progress
+                                pathProgress = int16(float(t->GetPathProgress() - t->GetPauseTime()) / float(t->GetPeriod() - t->GetPauseTime()) * 65535.0f);
+                        }
+                        else
+                        {
+                            if (t->GetPathProgress() <= t->GetPauseTime()) // if not, send 100% progress
+                                pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPauseTime()) * 65535.0f);
+                        }
+                    }
+                // else it's ignored
+                break;
+            case GAMEOBJECT_TYPE_MO_TRANSPORT:
+                if (const MotionTransport* t = ToMotionTransport())
+                    pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPeriod()) * 65535.0f);
+                break;
+            default:
+                break;
+        }
+
+        fieldBuffer << uint16(dynFlags);
+        fieldBuffer << int16(pathProgress);
+    }
+    else if (index == GAMEOBJECT_FLAGS)
+    {
+        uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
+        if (GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo() && GetGOInfo()->chest.groupLootRules && !IsLootAllowedFor(target))
+        {
+            goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
+        }
+
+        fieldBuffer << goFlags;
+    }
+}
+
 void GameObject::GetRespawnPosition(float& x, float& y, float& z, float* ori /* = nullptr*/) const
 {
     if (m_spawnId)
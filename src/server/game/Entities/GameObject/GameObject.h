@@ -744,6 +744,8 @@ public:
     ~GameObject() override;
 
     void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+    [[nodiscard]] bool IsUpdateFieldValueViewerDependent(uint16 index) const override;
+    void BuildViewerDependentUpdateField(uint8 updateType, uint16 index, ByteBuffer& fieldBuffer, Player* target) const override;
 
     void AddToWorld() override;
     void RemoveFromWorld() override;
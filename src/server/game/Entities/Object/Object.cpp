@@ -510,6 +510,87 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
     BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
 }
 
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateBlockCache& cache) const
+{
+    uint32* flags = nullptr;
+    uint32 visibleFlag = GetUpdateFieldData(player, flags);
+
+    auto entry = std::find_if(cache.Entries.begin(), cache.Entries.end(), [visibleFlag](ValuesUpdateBlockCache::Entry const& cached)
+    {
+        return cached.VisibleFlag == visibleFlag;
+    });
+
+    if (entry == cache.Entries.end())
+    {
+        ByteBuffer buf(500);
+        buf << uint8(UPDATETYPE_VALUES);
+        buf << GetPackGUID();
+
+        size_t maskPos = buf.wpos();
+        BuildValuesUpdate(UPDATETYPE_VALUES, &buf, player);
+        data_map[player].AddUpdateBlock(buf);
+        ++cache.Misses;
+
+        // remember where the viewer dependent fields are, every field is a 4 byte value unless a script wrote something else
+        ValuesUpdateBlockCache::Entry newEntry;
+        newEntry.VisibleFlag = visibleFlag;
+
+        uint8 blockCount = buf.read<uint8>(maskPos);
+        size_t fieldPos = maskPos + 1 + blockCount * sizeof(UpdateMask::ClientUpdateMaskType);
+        for (uint8 block = 0; block < blockCount; ++block)
+        {
+            UpdateMask::ClientUpdateMaskType mask = buf.read<UpdateMask::ClientUpdateMaskType>(maskPos + 1 + block * sizeof(UpdateMask::ClientUpdateMaskType));
+            for (uint32 bit = 0; bit < UpdateMask::CLIENT_UPDATE_MASK_BITS; ++bit)
+            {
+                if (!(mask & (1 << bit)))
+                    continue;
+
+                uint16 index = uint16(block * UpdateMask::CLIENT_UPDATE_MASK_BITS + bit);
+                if (IsUpdateFieldValueViewerDependent(index))
+                    newEntry.ViewerFields.emplace_back(index, fieldPos);
+
+                fieldPos += sizeof(uint32);
+            }
+        }
+
+        newEntry.Patchable = fieldPos == buf.wpos();
+        newEntry.Block = std::move(buf);
+        cache.Entries.push_back(std::move(newEntry));
+        return;
+    }
+
+    if (entry->Patchable)
+    {
+        ByteBuffer buf(entry->Block);
+        ByteBuffer fieldBuffer;
+
+        bool patched = true;
+        for (std::pair<uint16, size_t> const& field : entry->ViewerFields)
+        {
+            fieldBuffer.clear();
+            BuildViewerDependentUpdateField(UPDATETYPE_VALUES, field.first, fieldBuffer, player);
+            if (fieldBuffer.size() != sizeof(uint32))
+            {
+                patched = false;
+                break;
+            }
+
+            buf.put<uint32>(field.second, fieldBuffer.read<uint32>(0));
+        }
+
+        if (patched)
+        {
+            data_map[player].AddUpdateBlock(buf);
+            ++cache.Hits;
+            cache.BytesSaved += buf.size() - entry->ViewerFields.size() * sizeof(uint32);
+            return;
+        }
+    }
+
+    ++cache.Misses;
+    BuildFieldsUpdate(player, data_map);
+}
+
 uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
 {
     uint32 visibleFlag = UF_FLAG_PUBLIC;
@@ -689,6 +770,11 @@ void Object::SetFloatValue(uint16 index, float value)
         m_floatValues[index] = value;
         _changesMask.SetBit(index);
 
+        // both feed WorldObject::GetObjectSize, which the grid cell keeps a copy of
+        if (index == OBJECT_FIELD_SCALE_X || (index == UNIT_FIELD_COMBATREACH && isType(TYPEMASK_UNIT)))
+            if (isType(TYPEMASK_WORLDOBJECT))
+                static_cast<WorldObject*>(this)->RefreshGridSlot();
+
         AddToObjectUpdateIfNeeded();
     }
 }
@@ -872,9 +958,7 @@ void Position::RelocatePolarOffset(float angle, float dist, float z /*= 0.0f*/)
 {
     SetOrientation(GetOrientation() + angle);
 
-    m_positionX = GetPositionX() + dist * std::cos(GetOrientation());
-    m_positionY = GetPositionY() + dist * std::sin(GetOrientation());
-    m_positionZ = GetPositionZ() + z;
+    Relocate(GetPositionX() + dist * std::cos(GetOrientation()), GetPositionY() + dist * std::sin(GetOrientation()), GetPositionZ() + z);
 }
 
 bool Position::HasInLine(WorldObject const* target, float width) const
@@ -1299,9 +1383,9 @@ bool WorldObject::IsInRange3d(float x, float y, float z, float minRange, float m
 
 void Position::RelocateOffset(const Position& offset)
 {
-    m_positionX = GetPositionX() + (offset.GetPositionX() * cos(GetOrientation()) + offset.GetPositionY() * sin(GetOrientation() + M_PI));
-    m_positionY = GetPositionY() + (offset.GetPositionY() * cos(GetOrientation()) + offset.GetPositionX() * sin(GetOrientation()));
-    m_positionZ = GetPositionZ() + offset.GetPositionZ();
+    Relocate(GetPositionX() + (offset.GetPositionX() * cos(GetOrientation()) + offset.GetPositionY() * sin(GetOrientation() + M_PI)),
+             GetPositionY() + (offset.GetPositionY() * cos(GetOrientation()) + offset.GetPositionX() * sin(GetOrientation())),
+             GetPositionZ() + offset.GetPositionZ());
     m_orientation = GetOrientation() + offset.GetOrientation();
 }
 
@@ -2750,27 +2834,35 @@ void WorldObject::MovePosition(Position& pos, float dist, float angle)
         return;
     }
 
-    ground = GetMapHeight(destx, desty, MAX_HEIGHT);
-    floor = GetMapHeight(destx, desty, pos.m_positionZ);
-    destz = fabs(ground - pos.m_positionZ) <= fabs(floor - pos.m_positionZ) ? ground : floor;
-
+    // the destination, then the candidates stepping back towards the source
+    static constexpr uint32 Candidates = 10;
     float step = dist / 10.0f;
+    float floorZ = pos.m_positionZ + std::max(GetCollisionHeight(), Z_OFFSET_FIND_HEIGHT);
 
-    for (uint8 j = 0; j < 10; ++j)
+    // ground and floor of each candidate
+    G3D::Vector3 points[Candidates * 2];
+    float heights[Candidates * 2];
+    for (uint32 j = 0; j < Candidates; ++j)
     {
+        points[j * 2] = G3D::Vector3(destx - step * j * cos(angle), desty - step * j * sin(angle), MAX_HEIGHT);
+        points[j * 2 + 1] = G3D::Vector3(points[j * 2].x, points[j * 2].y, floorZ);
+    }
+
+    // most destinations are accepted, the step back candidates are queried together once it is rejected
+    GetMap()->GetHeights(GetPhaseMask(), points, heights, 2);
+    for (uint32 j = 0; j < Candidates; ++j)
+    {
+        if (j == 1)
+            GetMap()->GetHeights(GetPhaseMask(), &points[2], &heights[2], (Candidates - 1) * 2);
+
+        ground = heights[j * 2];
+        floor = heights[j * 2 + 1];
+        destz = fabs(ground - pos.m_positionZ) <= fabs(floor - pos.m_positionZ) ? ground : floor;
+
         // do not allow too big z changes
-        if (fabs(pos.m_positionZ - destz) > 6.0f)
-        {
-            destx -= step * cos(angle);
-            desty -= step * sin(angle);
-            ground = GetMapHeight(destx, desty, MAX_HEIGHT);
-            floor = GetMapHeight(destx, desty, pos.m_positionZ);
-            destz = fabs(ground - pos.m_positionZ) <= fabs(floor - pos.m_positionZ) ? ground : floor;
-        }
-        // we have correct destz now
-        else
+        if (fabs(pos.m_positionZ - destz) <= 6.0f)
         {
-            pos.Relocate(destx, desty, destz);
+            pos.Relocate(points[j * 2].x, points[j * 2].y, destz);
             break;
         }
     }
@@ -2833,11 +2925,38 @@ void WorldObject::MovePositionToFirstCollision(Position& pos, float dist, float
     pos.Relocate(destx, desty, destz);
 }
 
+void WorldObject::RefreshGridSlot()
+{
+    switch (GetTypeId())
+    {
+        case TYPEID_UNIT:
+            ToCreature()->UpdateGridSlot();
+            break;
+        case TYPEID_PLAYER:
+            ToPlayer()->UpdateGridSlot();
+            break;
+        case TYPEID_GAMEOBJECT:
+            ToGameObject()->UpdateGridSlot();
+            break;
+        case TYPEID_DYNAMICOBJECT:
+            ToDynObject()->UpdateGridSlot();
+            break;
+        case TYPEID_CORPSE:
+            ToCorpse()->UpdateGridSlot();
+            break;
+        default:
+            break;
+    }
+}
+
 void WorldObject::SetPhaseMask(uint32 newPhaseMask, bool update)
 {
     sScriptMgr->OnBeforeWorldObjectSetPhaseMask(this, m_phaseMask, newPhaseMask, m_useCombinedPhases, update);
     m_phaseMask = newPhaseMask;
 
+    // keep the phase mask copied in the grid cell up to date for the searchers
+    RefreshGridSlot();
+
     if (update && IsInWorld())
         UpdateObjectVisibility();
 }
@@ -2942,6 +3061,7 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     UpdatePlayerSet& i_playerSet;
     WorldObject& i_object;
+    ValuesUpdateBlockCache i_blockCache;
     WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d, UpdatePlayerSet& p) : i_updateDatas(d), i_playerSet(p), i_object(obj)
     {
         i_playerSet.clear();
@@ -3002,7 +3122,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (i_playerSet.find(player->GetGUID()) == i_playerSet.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, i_blockCache);
             i_playerSet.insert(player->GetGUID());
         }
     }
@@ -3016,6 +3136,8 @@ void WorldObject::BuildUpdate(UpdateDataMapType& data_map, UpdatePlayerSet& play
     //we must build packets for all visible players
     Cell::VisitWorldObjects(this, notifier, GetVisibilityRange());
 
+    GetMap()->AddUpdateBlockCacheStats(notifier.i_blockCache.Hits, notifier.i_blockCache.Misses, notifier.i_blockCache.BytesSaved);
+
     ClearUpdateMask(false);
 }
 
@@ -85,6 +85,25 @@ struct PositionFullTerrainStatus;
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 typedef GuidUnorderedSet UpdatePlayerSet;
 
+// Values update blocks of one object already built for some viewers in the current BuildUpdate call.
+// Viewers with the same visibility flags receive the same block, only the few fields whose value
+// depends on the viewer (npc flags, loot flags, faction...) are patched in the copy.
+struct ValuesUpdateBlockCache
+{
+    struct Entry
+    {
+        uint32 VisibleFlag;
+        bool Patchable;                                         // every field of the block is 4 bytes long
+        ByteBuffer Block;
+        std::vector<std::pair<uint16, size_t>> ViewerFields;    // update field index, position in Block
+    };
+
+    std::vector<Entry> Entries;
+    uint32 Hits = 0;
+    uint32 Misses = 0;
+    uint64 BytesSaved = 0;
+};
+
 class Object
 {
 public:
@@ -273,6 +292,7 @@ public:
     [[nodiscard]] virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
     virtual void BuildUpdate(UpdateDataMapType&, UpdatePlayerSet&) {}
     void BuildFieldsUpdate(Player*, UpdateDataMapType&) const;
+    void BuildFieldsUpdate(Player*, UpdateDataMapType&, ValuesUpdateBlockCache& cache) const;
 
     void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
     void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= ~flag; }
@@ -312,6 +332,10 @@ protected:
     void BuildMovementUpdate(ByteBuffer* data, uint16 flags) const;
     virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
 
+    // Fields whose value sent in a values update depends on the receiving player, not only on its visibility flags
+    [[nodiscard]] virtual bool IsUpdateFieldValueViewerDependent(uint16 /*index*/) const { return false; }
+    virtual void BuildViewerDependentUpdateField(uint8 /*updateType*/, uint16 index, ByteBuffer& fieldBuffer, Player* /*target*/) const { fieldBuffer << m_uint32Values[index]; }
+
     uint16 m_objectType;
 
     TypeID m_objectTypeId;
@@ -353,11 +377,12 @@ struct Position
         : m_positionX(x), m_positionY(y), m_positionZ(z), m_orientation(NormalizeOrientation(o)) { }
 
     Position(Position const& loc) { Relocate(loc); }
+    virtual ~Position() = default;
     /* requried as of C++ 11 */
 #if __cplusplus >= 201103L
     Position(Position&&) = default;
-    Position& operator=(const Position&) = default;
-    Position& operator=(Position&&) = default;
+    Position& operator=(const Position& pos) { Relocate(pos); return *this; }
+    Position& operator=(Position&& pos) { Relocate(pos); return *this; }
 #endif
 
     struct PositionXYStreamer
@@ -399,12 +424,14 @@ struct Position
     {
         m_positionX = x;
         m_positionY = y;
+        OnRelocated();
     }
     void Relocate(float x, float y, float z)
     {
         m_positionX = x;
         m_positionY = y;
         m_positionZ = z;
+        OnRelocated();
     }
     void Relocate(float x, float y, float z, float orientation)
     {
@@ -412,6 +439,7 @@ struct Position
         m_positionY = y;
         m_positionZ = z;
         m_orientation = orientation;
+        OnRelocated();
     }
     void Relocate(const Position& pos)
     {
@@ -419,6 +447,7 @@ struct Position
         m_positionY = pos.m_positionY;
         m_positionZ = pos.m_positionZ;
         m_orientation = pos.m_orientation;
+        OnRelocated();
     }
     void Relocate(const Position* pos)
     {
@@ -426,6 +455,7 @@ struct Position
         m_positionY = pos->m_positionY;
         m_positionZ = pos->m_positionZ;
         m_orientation = pos->m_orientation;
+        OnRelocated();
     }
     void RelocatePolarOffset(float angle, float dist, float z = 0.0f);
     void RelocateOffset(const Position& offset);
@@ -561,6 +591,10 @@ struct Position
         }
         return fmod(o, 2.0f * static_cast<float>(M_PI));
     }
+
+protected:
+    // every write of the coordinates ends here, world objects keep a copy of their position in their grid cell
+    virtual void OnRelocated() { }
 };
 
 #define MAPID_INVALID 0xFFFFFFFF
@@ -721,6 +755,7 @@ public:
     [[nodiscard]] bool IsInGrid() const { return _gridRef.isValid(); }
     void AddToGrid(GridRefMgr<T>& m) { ASSERT(!IsInGrid()); _gridRef.link(&m, (T*)this); }
     void RemoveFromGrid() { ASSERT(IsInGrid()); _gridRef.unlink(); }
+    void UpdateGridSlot() { _gridRef.UpdateSlot(); }
 private:
     GridReference<T> _gridRef;
 };
@@ -840,6 +875,9 @@ public:
         pos.Relocate(x, y, z, GetOrientation());
     }
 
+    // copies the phase mask, position and size to the packed slot of the object's grid cell
+    void RefreshGridSlot();
+
     [[nodiscard]] uint32 GetInstanceId() const { return m_InstanceId; }
 
     virtual void SetPhaseMask(uint32 newPhaseMask, bool update);
@@ -1093,6 +1131,7 @@ protected:
     ZoneScript* m_zoneScript;
 
     virtual void ProcessPositionDataChanged(PositionFullTerrainStatus const& data);
+    void OnRelocated() override { RefreshGridSlot(); }
     uint32 _zoneId;
     uint32 _areaId;
     float _floorZ;
@@ -46,29 +46,80 @@ void UpdateData::AddUpdateBlock(const UpdateData& block)
     m_blockCount += block.m_blockCount;
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+namespace
 {
-    z_stream c_stream;
+    // deflate state is ~256KB, keep one per thread and reset it between packets instead of reallocating it
+    class UpdateCompressor
+    {
+    public:
+        UpdateCompressor() : _initialized(false), _level(0) { }
+
+        ~UpdateCompressor()
+        {
+            if (_initialized)
+                deflateEnd(&_stream);
+        }
+
+        z_stream* GetStream(int level)
+        {
+            if (_initialized && _level != level)
+            {
+                deflateEnd(&_stream);
+                _initialized = false;
+            }
+
+            if (_initialized)
+            {
+                int z_res = deflateReset(&_stream);
+                if (z_res == Z_OK)
+                    return &_stream;
+
+                LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateReset) Error code: %i (%s)", z_res, zError(z_res));
+                deflateEnd(&_stream);
+                _initialized = false;
+            }
+
+            _stream.zalloc = (alloc_func)0;
+            _stream.zfree = (free_func)0;
+            _stream.opaque = (voidpf)0;
+
+            int z_res = deflateInit(&_stream, level);
+            if (z_res != Z_OK)
+            {
+                LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                return nullptr;
+            }
+
+            _initialized = true;
+            _level = level;
+            return &_stream;
+        }
+
+    private:
+        z_stream _stream;
+        bool _initialized;
+        int _level;
+    };
 
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
+    thread_local UpdateCompressor updateCompressor;
+}
 
+void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+{
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld->getIntConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
+    z_stream* c_stream = updateCompressor.GetStream(sWorld->getIntConfig(CONFIG_COMPRESSION));
+    if (!c_stream)
     {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
         *dst_size = 0;
         return;
     }
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+    c_stream->next_out = (Bytef*)dst;
+    c_stream->avail_out = *dst_size;
+    c_stream->next_in = (Bytef*)src;
+    c_stream->avail_in = (uInt)src_size;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
+    int z_res = deflate(c_stream, Z_NO_FLUSH);
     if (z_res != Z_OK)
     {
         LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
@@ -76,14 +127,14 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    if (c_stream.avail_in != 0)
+    if (c_stream->avail_in != 0)
     {
         LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate not greedy)");
         *dst_size = 0;
         return;
     }
 
-    z_res = deflate(&c_stream, Z_FINISH);
+    z_res = deflate(c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)", z_res, zError(z_res));
@@ -91,15 +142,26 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+    *dst_size = c_stream->total_out;
+}
+
+bool UpdateData::CompressPacket(WorldPacket const& packet, WorldPacket& compressed)
+{
+    if (packet.GetOpcode() != SMSG_UPDATE_OBJECT || packet.size() <= UPDATE_DATA_COMPRESSION_THRESHOLD)
+        return false;
 
-    *dst_size = c_stream.total_out;
+    uint32 pSize = packet.size();
+    uint32 destsize = compressBound(pSize);
+
+    compressed.Initialize(SMSG_COMPRESSED_UPDATE_OBJECT, destsize + sizeof(uint32));
+    compressed.resize(destsize + sizeof(uint32));
+    compressed.put<uint32>(0, pSize);
+    Compress(const_cast<uint8*>(compressed.contents()) + sizeof(uint32), &destsize, const_cast<uint8*>(packet.contents()), pSize);
+    if (destsize == 0)
+        return false;                                       // keep sending it uncompressed
+
+    compressed.resize(destsize + sizeof(uint32));
+    return true;
 }
 
 bool UpdateData::BuildPacket(WorldPacket* packet)
@@ -125,7 +187,13 @@ bool UpdateData::BuildPacket(WorldPacket* packet)
 
     size_t pSize = buf.wpos();                              // use real used data size
 
-    if (pSize > 100)                                       // compress large packets
+    // compressed by the network thread that sends it, see WorldSocket::Update
+    if (pSize > UPDATE_DATA_COMPRESSION_THRESHOLD && sWorld->getBoolConfig(CONFIG_COMPRESSION_OFFLOAD))
+    {
+        packet->append(buf);
+        packet->SetOpcode(SMSG_UPDATE_OBJECT);
+    }
+    else if (pSize > UPDATE_DATA_COMPRESSION_THRESHOLD)     // compress large packets
     {
         uint32 destsize = compressBound(pSize);
         packet->resize(destsize + sizeof(uint32));
@@ -23,6 +23,9 @@
 
 class WorldPacket;
 
+// update packets larger than this are sent as SMSG_COMPRESSED_UPDATE_OBJECT
+constexpr uint32 UPDATE_DATA_COMPRESSION_THRESHOLD = 100;
+
 enum OBJECT_UPDATE_TYPE
 {
     UPDATETYPE_VALUES               = 0,
@@ -60,11 +63,14 @@ public:
     [[nodiscard]] bool HasData() const { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
     void Clear();
 
+    // Builds the SMSG_COMPRESSED_UPDATE_OBJECT of an uncompressed SMSG_UPDATE_OBJECT over the threshold
+    static bool CompressPacket(WorldPacket const& packet, WorldPacket& compressed);
+
 protected:
     uint32 m_blockCount;
     GuidVector m_outOfRangeGUIDs;
     ByteBuffer m_data;
 
-    void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+    static void Compress(void* dst, uint32* dst_size, void* src, int src_size);
 };
 #endif
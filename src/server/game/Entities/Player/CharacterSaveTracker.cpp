@@ -0,0 +1,102 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CharacterSaveTracker.h"
+
+namespace
+{
+    char const* const CharacterSaveStepNames[MAX_CHARACTER_SAVE_STEPS] =
+    {
+        "Character",
+        "Mail",
+        "Entry point",
+        "Inventory",
+        "Quests",
+        "Talents",
+        "Spells",
+        "Spell cooldowns",
+        "Actions",
+        "Auras",
+        "Skills",
+        "Achievements",
+        "Reputation",
+        "Equipment sets",
+        "Tutorials",
+        "Glyphs",
+        "Instance times",
+        "Stats"
+    };
+}
+
+CharacterSaveTracker* CharacterSaveTracker::instance()
+{
+    static CharacterSaveTracker instance;
+    return &instance;
+}
+
+void CharacterSaveTracker::Record(Counters& counters, std::size_t statements, uint64 time)
+{
+    counters.Saves.fetch_add(1, std::memory_order_relaxed);
+    if (!statements)
+        counters.Unchanged.fetch_add(1, std::memory_order_relaxed);
+
+    counters.Statements.fetch_add(statements, std::memory_order_relaxed);
+    counters.TotalTime.fetch_add(time, std::memory_order_relaxed);
+
+    uint64 maxStatements = counters.MaxStatements.load(std::memory_order_relaxed);
+    while (statements > maxStatements && !counters.MaxStatements.compare_exchange_weak(maxStatements, statements, std::memory_order_relaxed))
+        ;
+}
+
+void CharacterSaveTracker::GetCounters(Counters const& counters, CharacterSaveStats& stats)
+{
+    stats.Saves = counters.Saves.load(std::memory_order_relaxed);
+    stats.Unchanged = counters.Unchanged.load(std::memory_order_relaxed);
+    stats.Statements = counters.Statements.load(std::memory_order_relaxed);
+    stats.MaxStatements = counters.MaxStatements.load(std::memory_order_relaxed);
+    stats.TotalTime = counters.TotalTime.load(std::memory_order_relaxed);
+}
+
+void CharacterSaveTracker::GetStats(std::vector<CharacterSaveStats>& steps, CharacterSaveStats& total) const
+{
+    steps.resize(MAX_CHARACTER_SAVE_STEPS);
+    for (uint8 i = 0; i < MAX_CHARACTER_SAVE_STEPS; ++i)
+    {
+        steps[i].Name = CharacterSaveStepNames[i];
+        GetCounters(_steps[i], steps[i]);
+    }
+
+    total.Name = "Total";
+    GetCounters(_total, total);
+}
+
+void CharacterSaveTracker::Reset()
+{
+    auto reset = [](Counters& counters)
+    {
+        counters.Saves.store(0, std::memory_order_relaxed);
+        counters.Unchanged.store(0, std::memory_order_relaxed);
+        counters.Statements.store(0, std::memory_order_relaxed);
+        counters.MaxStatements.store(0, std::memory_order_relaxed);
+        counters.TotalTime.store(0, std::memory_order_relaxed);
+    };
+
+    for (Counters& counters : _steps)
+        reset(counters);
+
+    reset(_total);
+}
@@ -0,0 +1,116 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_CHARACTERSAVETRACKER_H
+#define ACORE_CHARACTERSAVETRACKER_H
+
+#include "Define.h"
+#include "Transaction.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+enum CharacterSaveStep : uint8
+{
+    CHARACTER_SAVE_CHARACTER,
+    CHARACTER_SAVE_MAIL,
+    CHARACTER_SAVE_ENTRY_POINT,
+    CHARACTER_SAVE_INVENTORY,
+    CHARACTER_SAVE_QUESTS,              // quest status, daily, weekly, seasonal and monthly quests
+    CHARACTER_SAVE_TALENTS,
+    CHARACTER_SAVE_SPELLS,
+    CHARACTER_SAVE_SPELL_COOLDOWNS,
+    CHARACTER_SAVE_ACTIONS,
+    CHARACTER_SAVE_AURAS,
+    CHARACTER_SAVE_SKILLS,
+    CHARACTER_SAVE_ACHIEVEMENTS,
+    CHARACTER_SAVE_REPUTATION,
+    CHARACTER_SAVE_EQUIPMENT_SETS,
+    CHARACTER_SAVE_TUTORIALS,
+    CHARACTER_SAVE_GLYPHS,
+    CHARACTER_SAVE_INSTANCE_TIMES,
+    CHARACTER_SAVE_STATS,
+
+    MAX_CHARACTER_SAVE_STEPS
+};
+
+struct CharacterSaveStats
+{
+    char const* Name;
+    uint64 Saves;
+    uint64 Unchanged;                   // saves that appended no statement
+    uint64 Statements;
+    uint64 MaxStatements;
+    uint64 TotalTime;                   // microseconds spent building the statements, for the total until the commit finished
+
+    [[nodiscard]] float GetUnchangedRate() const { return Saves ? float(Unchanged) * 100.0f / float(Saves) : 0.0f; }
+    [[nodiscard]] float GetAverageStatements() const { return Saves ? float(Statements) / float(Saves) : 0.0f; }
+    [[nodiscard]] uint64 GetAverageTime() const { return Saves ? TotalTime / Saves : 0; }
+};
+
+/*
+ * Counts the statements each step of Player::SaveToDB appends to the save transaction and the time it takes, and
+ * for the whole save the time until its transaction is committed. Players are saved by the map update threads and
+ * the world thread, the counters are shared atomics.
+ */
+class AC_GAME_API CharacterSaveTracker
+{
+    CharacterSaveTracker() = default;
+    ~CharacterSaveTracker() = default;
+
+public:
+    static CharacterSaveTracker* instance();
+
+    // runs the save step and records what it appended to the transaction
+    template<class SaveStep>
+    void Track(CharacterSaveStep step, TransactionBase const& trans, SaveStep&& save)
+    {
+        std::size_t statements = trans.GetSize();
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+        save();
+
+        Record(_steps[step], trans.GetSize() - statements, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count());
+    }
+
+    // the whole transaction of a save, timed from the start of the save until the commit callback
+    void RecordSave(std::size_t statements, uint64 time) { Record(_total, statements, time); }
+
+    void GetStats(std::vector<CharacterSaveStats>& steps, CharacterSaveStats& total) const;
+    void Reset();
+
+private:
+    struct Counters
+    {
+        std::atomic<uint64> Saves;
+        std::atomic<uint64> Unchanged;
+        std::atomic<uint64> Statements;
+        std::atomic<uint64> MaxStatements;
+        std::atomic<uint64> TotalTime;
+    };
+
+    static void Record(Counters& counters, std::size_t statements, uint64 time);
+    static void GetCounters(Counters const& counters, CharacterSaveStats& stats);
+
+    std::array<Counters, MAX_CHARACTER_SAVE_STEPS> _steps{};
+    Counters _total{};
+};
+
+#define sCharacterSaveTracker CharacterSaveTracker::instance()
+
+#endif
@@ -196,6 +196,7 @@ Player::Player(WorldSession* session): Unit(true), m_mover(this)
     m_nextSave = SavingSystemMgr::IncreaseSavingMaxValue(1);
     m_additionalSaveTimer = 0;
     m_additionalSaveMask = 0;
+    m_savedAuras = std::make_shared<SavedAuraState>();
     m_hostileReferenceCheckTimer = 15000;
 
     clearResurrectRequestData();
@@ -353,6 +354,8 @@ Player::Player(WorldSession* session): Unit(true), m_mover(this)
     m_homebindY = 0;
     m_homebindZ = 0;
 
+    m_fullVisibilityScanTime = 0;
+
     m_contestedPvPTimer = 0;
 
     m_declinedname = nullptr;
@@ -13636,6 +13639,10 @@ void Player::_SaveEntryPoint(CharacterDatabaseTransaction trans)
     if (!mEntry)
         return;
 
+    // the row didn't change since the last save
+    if (m_savedEntryPoint && *m_savedEntryPoint == m_entryPointData)
+        return;
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYER_ENTRY_POINT);
     stmt->setUInt32(0, GetGUID().GetCounter());
     trans->Append(stmt);
@@ -13658,6 +13665,8 @@ void Player::_SaveEntryPoint(CharacterDatabaseTransaction trans)
     stmt->setString(6, ss.str());
     stmt->setUInt32(7, m_entryPointData.mountSpell);
     trans->Append(stmt);
+
+    m_savedEntryPoint = m_entryPointData;
 }
 
 void Player::DeleteEquipmentSet(uint64 setGuid)
@@ -14811,6 +14820,10 @@ void Player::_SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans)
     if (_instanceResetTimes.empty())
         return;
 
+    // the rows didn't change since the last save
+    if (m_savedInstanceResetTimes && *m_savedInstanceResetTimes == _instanceResetTimes)
+        return;
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIMES);
     stmt->setUInt32(0, GetSession()->GetAccountId());
     trans->Append(stmt);
@@ -14823,6 +14836,8 @@ void Player::_SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans)
         stmt->setUInt64(2, itr->second);
         trans->Append(stmt);
     }
+
+    m_savedInstanceResetTimes = _instanceResetTimes;
 }
 
 bool Player::IsInWhisperWhiteList(ObjectGuid guid)
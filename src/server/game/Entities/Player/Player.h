@@ -36,7 +36,10 @@
 #include "TradeData.h"
 #include "Unit.h"
 #include "WorldSession.h"
+#include <map>
+#include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 struct CreatureTemplate;
@@ -1019,6 +1022,50 @@ struct EntryPointData
 
     void ClearTaxiPath()     { taxiPath.clear(); }
     [[nodiscard]] bool HasTaxiPath() const { return !taxiPath.empty(); }
+
+    bool operator==(EntryPointData const& right) const
+    {
+        return mountSpell == right.mountSpell && taxiPath == right.taxiPath && joinPos.GetMapId() == right.joinPos.GetMapId() &&
+            joinPos.GetPositionX() == right.joinPos.GetPositionX() && joinPos.GetPositionY() == right.joinPos.GetPositionY() &&
+            joinPos.GetPositionZ() == right.joinPos.GetPositionZ() && joinPos.GetOrientation() == right.joinPos.GetOrientation();
+    }
+};
+
+// character_aura row written by the last save of an aura
+struct SavedAuraData
+{
+    uint8 recalculateMask;
+    uint8 stackAmount;
+    int32 damage[MAX_SPELL_EFFECTS];
+    int32 baseDamage[MAX_SPELL_EFFECTS];
+    int32 maxDuration;
+    int32 duration;
+    uint32 expireTime;                  // game time in ms, 0 for auras without duration
+    uint8 charges;
+
+    // the saved row is still right: the remaining duration is not compared as it changes with every save, only the
+    // expiry time, which moves by the few ms the map update lags behind the game time
+    bool IsSavedAs(SavedAuraData const& saved) const
+    {
+        return recalculateMask == saved.recalculateMask && stackAmount == saved.stackAmount &&
+            std::equal(std::begin(damage), std::end(damage), std::begin(saved.damage)) &&
+            std::equal(std::begin(baseDamage), std::end(baseDamage), std::begin(saved.baseDamage)) &&
+            maxDuration == saved.maxDuration && charges == saved.charges &&
+            (duration < 0) == (saved.duration < 0) && std::abs(int32(expireTime - saved.expireTime)) < int32(IN_MILLISECONDS);
+    }
+};
+
+// character_aura primary key without the player guid: caster guid, cast item guid, spell id and effect mask
+typedef std::tuple<uint64, uint64, uint32, uint8> SavedAuraKey;
+typedef std::map<SavedAuraKey, SavedAuraData> SavedAuraMap;
+
+// character_aura rows of a player, shared with the commit callbacks of its saves
+struct SavedAuraState
+{
+    SavedAuraMap Committed;             // rows in the database after the last committed save
+    Optional<SavedAuraMap> Pending;     // rows written by the save being built
+    bool Valid = false;                 // false until a full save committed and after a failed commit
+    uint32 SavesInFlight = 0;
 };
 
 class Player : public Unit, public GridObject<Player>
@@ -2338,6 +2385,7 @@ public:
     // currently visible objects at player client
     GuidUnorderedSet m_clientGUIDs;
     std::vector<Unit*> m_newVisible; // pussywizard
+    uint32 m_fullVisibilityScanTime; // getMSTime() of the last relocation pass that re-evaluated every object in range
 
     bool HaveAtClient(WorldObject const* u) const { return u == this || m_clientGUIDs.find(u->GetGUID()) != m_clientGUIDs.end(); }
     [[nodiscard]] bool HaveAtClient(ObjectGuid guid) const { return guid == GetGUID() || m_clientGUIDs.find(guid) != m_clientGUIDs.end(); }
@@ -2710,6 +2758,11 @@ public:
     uint32 m_nextSave; // pussywizard
     uint16 m_additionalSaveTimer; // pussywizard
     uint8 m_additionalSaveMask; // pussywizard
+
+    // rows written by the last saves, the next saves only write the rows that differ
+    std::shared_ptr<SavedAuraState> m_savedAuras;
+    Optional<EntryPointData> m_savedEntryPoint;
+    Optional<InstanceTimeMap> m_savedInstanceResetTimes;
     uint16 m_hostileReferenceCheckTimer; // pussywizard
     time_t m_speakTime;
     uint32 m_speakCount;
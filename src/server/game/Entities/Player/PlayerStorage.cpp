@@ -27,6 +27,7 @@
 #include "CellImpl.h"
 #include "Channel.h"
 #include "CharacterDatabaseCleaner.h"
+#include "CharacterSaveTracker.h"
 #include "Chat.h"
 #include "Config.h"
 #include "Common.h"
@@ -7156,10 +7157,33 @@ bool Player::_LoadHomeBind(PreparedQueryResult result)
 void Player::SaveToDB(bool create, bool logout)
 {
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
 
+    m_savedAuras->Pending.reset();
     SaveToDB(trans, create, logout);
 
-    CharacterDatabase.CommitTransaction(trans);
+    // the saved auras are only trusted once their rows are in the database, the player may be gone by then
+    Optional<SavedAuraMap> auras = std::move(m_savedAuras->Pending);
+    m_savedAuras->Pending.reset();
+    if (auras)
+        ++m_savedAuras->SavesInFlight;
+
+    std::size_t statements = trans->GetSize();
+    GetSession()->AddTransactionCallback(CharacterDatabase.AsyncCommitTransaction(trans)).AfterComplete(
+        [statements, startTime, savedAuras = std::weak_ptr<SavedAuraState>(m_savedAuras), auras = std::move(auras)](bool success) mutable
+    {
+        sCharacterSaveTracker->RecordSave(statements, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count());
+
+        std::shared_ptr<SavedAuraState> state = savedAuras.lock();
+        if (!state || !auras)
+            return;
+
+        --state->SavesInFlight;
+        if (success)
+            state->Committed = std::move(*auras);
+
+        state->Valid = success;
+    });
 }
 
 void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logout)
@@ -7187,35 +7211,40 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     if (!create)
         sScriptMgr->OnPlayerSave(this);
 
-    _SaveCharacter(create, trans);
+    CharacterSaveTracker* tracker = sCharacterSaveTracker;
 
-    if (m_mailsUpdated)                                     //save mails only when needed
-        _SaveMail(trans);
+    tracker->Track(CHARACTER_SAVE_CHARACTER, *trans, [&] { _SaveCharacter(create, trans); });
 
-    _SaveEntryPoint(trans);
-    _SaveInventory(trans);
-    _SaveQuestStatus(trans);
-    _SaveDailyQuestStatus(trans);
-    _SaveWeeklyQuestStatus(trans);
-    _SaveSeasonalQuestStatus(trans);
-    _SaveMonthlyQuestStatus(trans);
-    _SaveTalents(trans);
-    _SaveSpells(trans);
-    _SaveSpellCooldowns(trans, logout);
-    _SaveActions(trans);
-    _SaveAuras(trans, logout);
-    _SaveSkills(trans);
-    m_achievementMgr->SaveToDB(trans);
-    m_reputationMgr->SaveToDB(trans);
-    _SaveEquipmentSets(trans);
-    GetSession()->SaveTutorialsData(trans);                 // changed only while character in game
-    _SaveGlyphs(trans);
-    _SaveInstanceTimeRestrictions(trans);
+    if (m_mailsUpdated)                                     //save mails only when needed
+        tracker->Track(CHARACTER_SAVE_MAIL, *trans, [&] { _SaveMail(trans); });
+
+    tracker->Track(CHARACTER_SAVE_ENTRY_POINT, *trans, [&] { _SaveEntryPoint(trans); });
+    tracker->Track(CHARACTER_SAVE_INVENTORY, *trans, [&] { _SaveInventory(trans); });
+    tracker->Track(CHARACTER_SAVE_QUESTS, *trans, [&]
+    {
+        _SaveQuestStatus(trans);
+        _SaveDailyQuestStatus(trans);
+        _SaveWeeklyQuestStatus(trans);
+        _SaveSeasonalQuestStatus(trans);
+        _SaveMonthlyQuestStatus(trans);
+    });
+    tracker->Track(CHARACTER_SAVE_TALENTS, *trans, [&] { _SaveTalents(trans); });
+    tracker->Track(CHARACTER_SAVE_SPELLS, *trans, [&] { _SaveSpells(trans); });
+    tracker->Track(CHARACTER_SAVE_SPELL_COOLDOWNS, *trans, [&] { _SaveSpellCooldowns(trans, logout); });
+    tracker->Track(CHARACTER_SAVE_ACTIONS, *trans, [&] { _SaveActions(trans); });
+    tracker->Track(CHARACTER_SAVE_AURAS, *trans, [&] { _SaveAuras(trans, logout); });
+    tracker->Track(CHARACTER_SAVE_SKILLS, *trans, [&] { _SaveSkills(trans); });
+    tracker->Track(CHARACTER_SAVE_ACHIEVEMENTS, *trans, [&] { m_achievementMgr->SaveToDB(trans); });
+    tracker->Track(CHARACTER_SAVE_REPUTATION, *trans, [&] { m_reputationMgr->SaveToDB(trans); });
+    tracker->Track(CHARACTER_SAVE_EQUIPMENT_SETS, *trans, [&] { _SaveEquipmentSets(trans); });
+    tracker->Track(CHARACTER_SAVE_TUTORIALS, *trans, [&] { GetSession()->SaveTutorialsData(trans); }); // changed only while character in game
+    tracker->Track(CHARACTER_SAVE_GLYPHS, *trans, [&] { _SaveGlyphs(trans); });
+    tracker->Track(CHARACTER_SAVE_INSTANCE_TIMES, *trans, [&] { _SaveInstanceTimeRestrictions(trans); });
 
     // check if stats should only be saved on logout
     // save stats can be out of transaction
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
-        _SaveStats(trans);
+        tracker->Track(CHARACTER_SAVE_STATS, *trans, [&] { _SaveStats(trans); });
 
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
@@ -7297,9 +7326,7 @@ void Player::_SaveActions(CharacterDatabaseTransaction trans)
 
 void Player::_SaveAuras(CharacterDatabaseTransaction trans, bool logout)
 {
-    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
-    stmt->setUInt32(0, GetGUID().GetCounter());
-    trans->Append(stmt);
+    SavedAuraMap auras;
 
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
@@ -7310,47 +7337,98 @@ void Player::_SaveAuras(CharacterDatabaseTransaction trans, bool logout)
         if( !logout && aura->GetDuration() < 60 * IN_MILLISECONDS )
             continue;
 
-        int32 damage[MAX_SPELL_EFFECTS];
-        int32 baseDamage[MAX_SPELL_EFFECTS];
+        SavedAuraData data;
         uint8 effMask = 0;
-        uint8 recalculateMask = 0;
+        data.recalculateMask = 0;
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
             if (AuraEffect const* effect = aura->GetEffect(i))
             {
-                baseDamage[i] = effect->GetBaseAmount();
-                damage[i] = effect->GetAmount();
+                data.baseDamage[i] = effect->GetBaseAmount();
+                data.damage[i] = effect->GetAmount();
                 effMask |= 1 << i;
                 if (effect->CanBeRecalculated())
-                    recalculateMask |= 1 << i;
+                    data.recalculateMask |= 1 << i;
             }
             else
             {
-                baseDamage[i] = 0;
-                damage[i] = 0;
+                data.baseDamage[i] = 0;
+                data.damage[i] = 0;
+            }
+        }
+
+        data.stackAmount = aura->GetStackAmount();
+        data.maxDuration = aura->GetMaxDuration();
+        data.duration = aura->GetDuration();
+        data.expireTime = data.duration > 0 ? World::GetGameTimeMS() + uint32(data.duration) : 0;
+        data.charges = aura->GetCharges();
+
+        auras[SavedAuraKey(aura->GetCasterGUID().GetRawValue(), aura->GetCastItemGUID().GetRawValue(), aura->GetId(), effMask)] = data;
+    }
+
+    // the first save after loading, the logout save and a save while an earlier one is not committed yet rewrite all rows,
+    // other saves only write the rows that changed since the last committed save
+    bool fullSave = !m_savedAuras->Valid || m_savedAuras->SavesInFlight || logout;
+
+    CharacterDatabasePreparedStatement* stmt = nullptr;
+    if (fullSave)
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
+        stmt->setUInt32(0, GetGUID().GetCounter());
+        trans->Append(stmt);
+    }
+    else
+    {
+        for (SavedAuraMap::value_type const& saved : m_savedAuras->Committed)
+        {
+            if (auras.find(saved.first) != auras.end())
+                continue;
+
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_AURA);
+            stmt->setUInt32(0, GetGUID().GetCounter());
+            stmt->setUInt64(1, std::get<0>(saved.first));
+            stmt->setUInt64(2, std::get<1>(saved.first));
+            stmt->setUInt32(3, std::get<2>(saved.first));
+            stmt->setUInt8(4, std::get<3>(saved.first));
+            trans->Append(stmt);
+        }
+    }
+
+    for (auto& [key, data] : auras)
+    {
+        if (!fullSave)
+        {
+            // keep the row as it is in the database, later saves compare against its expiry time
+            SavedAuraMap::const_iterator saved = m_savedAuras->Committed.find(key);
+            if (saved != m_savedAuras->Committed.end() && data.IsSavedAs(saved->second))
+            {
+                data = saved->second;
+                continue;
             }
         }
 
         uint8 index = 0;
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_AURA);
+        stmt = CharacterDatabase.GetPreparedStatement(fullSave ? CHAR_INS_AURA : CHAR_REP_AURA);
         stmt->setUInt32(index++, GetGUID().GetCounter());
-        stmt->setUInt64(index++, itr->second->GetCasterGUID().GetRawValue());
-        stmt->setUInt64(index++, itr->second->GetCastItemGUID().GetRawValue());
-        stmt->setUInt32(index++, itr->second->GetId());
-        stmt->setUInt8(index++, effMask);
-        stmt->setUInt8(index++, recalculateMask);
-        stmt->setUInt8(index++, itr->second->GetStackAmount());
-        stmt->setInt32(index++, damage[0]);
-        stmt->setInt32(index++, damage[1]);
-        stmt->setInt32(index++, damage[2]);
-        stmt->setInt32(index++, baseDamage[0]);
-        stmt->setInt32(index++, baseDamage[1]);
-        stmt->setInt32(index++, baseDamage[2]);
-        stmt->setInt32(index++, itr->second->GetMaxDuration());
-        stmt->setInt32(index++, itr->second->GetDuration());
-        stmt->setUInt8(index, itr->second->GetCharges());
+        stmt->setUInt64(index++, std::get<0>(key));
+        stmt->setUInt64(index++, std::get<1>(key));
+        stmt->setUInt32(index++, std::get<2>(key));
+        stmt->setUInt8(index++, std::get<3>(key));
+        stmt->setUInt8(index++, data.recalculateMask);
+        stmt->setUInt8(index++, data.stackAmount);
+        stmt->setInt32(index++, data.damage[0]);
+        stmt->setInt32(index++, data.damage[1]);
+        stmt->setInt32(index++, data.damage[2]);
+        stmt->setInt32(index++, data.baseDamage[0]);
+        stmt->setInt32(index++, data.baseDamage[1]);
+        stmt->setInt32(index++, data.baseDamage[2]);
+        stmt->setInt32(index++, data.maxDuration);
+        stmt->setInt32(index++, data.duration);
+        stmt->setUInt8(index, data.charges);
         trans->Append(stmt);
     }
+
+    m_savedAuras->Pending = std::move(auras);
 }
 
 void Player::_SaveInventory(CharacterDatabaseTransaction trans)
@@ -7418,6 +7496,11 @@ void Player::_SaveInventory(CharacterDatabaseTransaction trans)
     if (m_itemUpdateQueue.empty())
         return;
 
+    // the item_instance rows are appended while going through the queue, the character_inventory rows after all of them,
+    // deletes first as a slot may be cleared for another item, so that each statement runs as one multi-row statement
+    std::vector<CharacterDatabasePreparedStatement*> inventoryDeletes;
+    std::vector<CharacterDatabasePreparedStatement*> inventoryReplaces;
+
     ObjectGuid::LowType lowGuid = GetGUID().GetCounter();
     for (size_t i = 0; i < m_itemUpdateQueue.size(); ++i)
     {
@@ -7443,7 +7526,7 @@ void Player::_SaveInventory(CharacterDatabaseTransaction trans)
                 stmt->setUInt32(0, bagTestGUID);
                 stmt->setUInt8(1, item->GetSlot());
                 stmt->setUInt32(2, lowGuid);
-                trans->Append(stmt);
+                inventoryDeletes.push_back(stmt);
 
                 RemoveTradeableItem(item); // pussywizard
                 RemoveEnchantmentDurationsReferences(item); // pussywizard
@@ -7476,12 +7559,12 @@ void Player::_SaveInventory(CharacterDatabaseTransaction trans)
                 stmt->setUInt32(1, bag_guid);
                 stmt->setUInt8 (2, item->GetSlot());
                 stmt->setUInt32(3, item->GetGUID().GetCounter());
-                trans->Append(stmt);
+                inventoryReplaces.push_back(stmt);
                 break;
             case ITEM_REMOVED:
                 stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_INVENTORY_BY_ITEM);
                 stmt->setUInt32(0, item->GetGUID().GetCounter());
-                trans->Append(stmt);
+                inventoryDeletes.push_back(stmt);
             case ITEM_UNCHANGED:
                 break;
         }
@@ -7489,6 +7572,12 @@ void Player::_SaveInventory(CharacterDatabaseTransaction trans)
         item->SaveToDB(trans);                                   // item have unchanged inventory record and can be save standalone
     }
     m_itemUpdateQueue.clear();
+
+    for (CharacterDatabasePreparedStatement* inventoryDelete : inventoryDeletes)
+        trans->Append(inventoryDelete);
+
+    for (CharacterDatabasePreparedStatement* inventoryReplace : inventoryReplaces)
+        trans->Append(inventoryReplace);
 }
 
 void Player::_SaveMail(CharacterDatabaseTransaction trans)
@@ -392,7 +392,7 @@ void Unit::Update(uint32 p_time)
             {
                 m_delayed_unit_relocation_timer = 0;
                 //ExecuteDelayedUnitRelocationEvent();
-                FindMap()->i_objectsForDelayedVisibility.insert(this);
+                FindMap()->AddObjectToDelayedVisibility(this);
             }
             else
                 m_delayed_unit_relocation_timer -= p_time;
@@ -4080,6 +4080,8 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
         m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+
+    m_modAuraAggregates.erase(aurEff->GetAuraType());
 }
 
 // All aura base removes should go threw this function!
@@ -5247,12 +5249,34 @@ int32 Unit::GetTotalAuraModifierAreaExclusive(AuraType auratype) const
     return modifier + areaModifier;
 }
 
+AuraEffectAggregate const* Unit::GetAuraEffectAggregate(AuraType auratype) const
+{
+    // walking a couple of list nodes is cheaper than the lookup
+    static constexpr std::size_t MinCachedEffects = 4;
+
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.size() < MinCachedEffects)
+        return nullptr;
+
+    auto itr = m_modAuraAggregates.find(auratype);
+    if (itr == m_modAuraAggregates.end())
+    {
+        itr = m_modAuraAggregates.emplace(auratype, AuraEffectAggregate()).first;
+        itr->second.Compute(mTotalAuraList);
+    }
+
+    return &itr->second;
+}
+
 int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
     if (mTotalAuraList.empty())
         return 0;
 
+    if (AuraEffectAggregate const* aggregate = GetAuraEffectAggregate(auratype))
+        return aggregate->Total;
+
     int32 modifier = 0;
 
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
@@ -5263,6 +5287,9 @@ int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
+    if (AuraEffectAggregate const* aggregate = GetAuraEffectAggregate(auratype))
+        return aggregate->Multiplier;
+
     float multiplier = 1.0f;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
@@ -5274,6 +5301,9 @@ float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype)
 {
+    if (AuraEffectAggregate const* aggregate = GetAuraEffectAggregate(auratype))
+        return aggregate->MaxPositive;
+
     int32 modifier = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
@@ -5288,6 +5318,9 @@ int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype)
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
+    if (AuraEffectAggregate const* aggregate = GetAuraEffectAggregate(auratype))
+        return aggregate->MinNegative;
+
     int32 modifier = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
@@ -18113,8 +18146,8 @@ void Unit::UpdateObjectVisibility(bool forced, bool /*fromUpdate*/)
     else
     {
         WorldObject::UpdateObjectVisibility(true);
-        Acore::AIRelocationNotifier notifier(*this);
         float radius = 60.0f;
+        Acore::AIRelocationNotifier notifier(*this, radius);
         Cell::VisitAllObjects(this, notifier, radius);
     }
 }
@@ -19462,16 +19495,33 @@ void Unit::ExecuteDelayedUnitRelocationEvent()
             }
         }
 
-        Acore::PlayerRelocationNotifier relocateNoLarge(*player, false); // visit only objects which are not large; default distance
-        Cell::VisitAllObjects(viewPoint, relocateNoLarge, player->GetSightRange() + VISIBILITY_INC_FOR_GOBJECTS);
-        relocateNoLarge.SendToSelf();
-
-        if (!player->GetFarSightDistance())
+        // re-evaluate only what the move may have changed, with a periodic full pass to drop objects which left every visited cell
+        if (sWorld->getBoolConfig(CONFIG_VISIBILITY_INCREMENTAL) && Acore::IncrementalRelocationNotifier::CanHandle(*player) &&
+            getMSTimeDiff(player->m_fullVisibilityScanTime, getMSTime()) < sWorld->getIntConfig(CONFIG_VISIBILITY_FULL_SCAN_INTERVAL))
         {
-            Acore::PlayerRelocationNotifier relocateLarge(*player, true); // visit only large objects; maximum distance
+            Acore::IncrementalRelocationNotifier relocateNoLarge(*player, false);
+            Cell::VisitAllObjects(viewPoint, relocateNoLarge, player->GetSightRange() + VISIBILITY_INC_FOR_GOBJECTS);
+            relocateNoLarge.SendToSelf();
+
+            Acore::IncrementalRelocationNotifier relocateLarge(*player, true);
             Cell::VisitAllObjects(viewPoint, relocateLarge, MAX_VISIBILITY_DISTANCE);
             relocateLarge.SendToSelf();
         }
+        else
+        {
+            player->m_fullVisibilityScanTime = getMSTime();
+
+            Acore::PlayerRelocationNotifier relocateNoLarge(*player, false); // visit only objects which are not large; default distance
+            Cell::VisitAllObjects(viewPoint, relocateNoLarge, player->GetSightRange() + VISIBILITY_INC_FOR_GOBJECTS);
+            relocateNoLarge.SendToSelf();
+
+            if (!player->GetFarSightDistance())
+            {
+                Acore::PlayerRelocationNotifier relocateLarge(*player, true); // visit only large objects; maximum distance
+                Cell::VisitAllObjects(viewPoint, relocateLarge, MAX_VISIBILITY_DISTANCE);
+                relocateLarge.SendToSelf();
+            }
+        }
 
         this->AddToNotify(NOTIFY_AI_RELOCATION);
     }
@@ -19503,8 +19553,8 @@ void Unit::ExecuteDelayedUnitAINotifyEvent()
     if (!this->IsInWorld() || this->IsDuringRemoveFromWorld())
         return;
 
-    Acore::AIRelocationNotifier notifier(*this);
     float radius = 60.0f;
+    Acore::AIRelocationNotifier notifier(*this, radius);
     Cell::VisitAllObjects(this, notifier, radius);
 }
 
@@ -19714,7 +19764,6 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
     if (plr && plr->IsInSameRaidWith(target))
         visibleFlag |= UF_FLAG_PARTY_MEMBER;
 
-    Creature const* creature = ToCreature();
     for (uint16 index = 0; index < m_valuesCount; ++index)
     {
         if (_fieldNotifyFlags & flags[index] ||
@@ -19724,34 +19773,9 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
         {
             updateMask.SetBit(index);
 
-            if (index == UNIT_NPC_FLAGS)
+            if (IsUpdateFieldValueViewerDependent(index))
             {
-                uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
-
-                if (creature)
-                {
-                    if (sWorld->getIntConfig(CONFIG_INSTANT_TAXI) == 2 && appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
-                    {
-                        appendValue |= UNIT_NPC_FLAG_GOSSIP; // flight masters need NPC gossip flag to show instant flight toggle option
-                    }
-
-                    if (!target->CanSeeSpellClickOn(creature))
-                    {
-                        appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
-                    }
-
-                    if (!creature->IsValidTrainerForPlayer(target, &appendValue))
-                    {
-                        appendValue &= ~UNIT_NPC_FLAG_TRAINER;
-                    }
-                }
-
-                fieldBuffer << uint32(appendValue);
-            }
-            else if (index == UNIT_FIELD_AURASTATE)
-            {
-                // Check per caster aura states to not enable using a spell in client if specified aura is not by target
-                fieldBuffer << BuildAuraStateUpdateForTarget(target);
+                BuildViewerDependentUpdateField(updateType, index, fieldBuffer, target);
             }
             // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
             else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
@@ -19767,121 +19791,173 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
             {
                 fieldBuffer << uint32(m_floatValues[index]);
             }
-            // Gamemasters should be always able to select units - remove not selectable flag
-            else if (index == UNIT_FIELD_FLAGS)
-            {
-                uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
-                if (target->IsGameMaster() && AccountMgr::IsGMAccount(target->GetSession()->GetSecurity()))
-                    appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
+            else
+                // send in current format (float as float, uint32 as uint32)
+                fieldBuffer << m_uint32Values[index];
+        }
+    }
 
-                fieldBuffer << uint32(appendValue);
-            }
-            // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
-            else if (index == UNIT_FIELD_DISPLAYID)
-            {
-                uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
-                if (creature)
-                {
-                    CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
+    *data << uint8(updateMask.GetBlockCount());
+    updateMask.AppendToPacket(data);
+    data->append(fieldBuffer);
+}
 
-                    // this also applies for transform auras
-                    if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
-                        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-                            if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
-                                if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
-                                {
-                                    cinfo = transformInfo;
-                                    break;
-                                }
+bool Unit::IsUpdateFieldValueViewerDependent(uint16 index) const
+{
+    switch (index)
+    {
+        case UNIT_NPC_FLAGS:
+        case UNIT_FIELD_AURASTATE:
+        case UNIT_FIELD_FLAGS:
+        case UNIT_FIELD_DISPLAYID:
+        case UNIT_DYNAMIC_FLAGS:
+        case UNIT_FIELD_BYTES_2:
+        case UNIT_FIELD_FACTIONTEMPLATE:
+            return true;
+        default:
+            return false;
+    }
+}
 
-                    if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
-                    {
-                        if (target->IsGameMaster() && AccountMgr::IsGMAccount(target->GetSession()->GetSecurity()))
-                        {
-                            if (cinfo->Modelid1)
-                                displayId = cinfo->Modelid1;    // Modelid1 is a visible model for gms
-                            else
-                                displayId = 17519;              // world visible trigger's model
-                        }
-                        else
-                        {
-                            if (cinfo->Modelid2)
-                                displayId = cinfo->Modelid2;    // Modelid2 is an invisible model for players
-                            else
-                                displayId = 11686;              // world invisible trigger's model
-                        }
-                    }
-                }
+void Unit::BuildViewerDependentUpdateField(uint8 updateType, uint16 index, ByteBuffer& fieldBuffer, Player* target) const
+{
+    Creature const* creature = ToCreature();
+
+    if (index == UNIT_NPC_FLAGS)
+    {
+        uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
 
-                fieldBuffer << uint32(displayId);
+        if (creature)
+        {
+            if (sWorld->getIntConfig(CONFIG_INSTANT_TAXI) == 2 && appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
+            {
+                appendValue |= UNIT_NPC_FLAG_GOSSIP; // flight masters need NPC gossip flag to show instant flight toggle option
             }
-            // hide lootable animation for unallowed players
-            else if (index == UNIT_DYNAMIC_FLAGS)
+
+            if (!target->CanSeeSpellClickOn(creature))
             {
-                uint32 dynamicFlags = m_uint32Values[UNIT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+                appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
+            }
 
-                if (creature)
-                {
-                    if (creature->hasLootRecipient())
-                    {
-                        dynamicFlags |= UNIT_DYNFLAG_TAPPED;
-                        if (creature->isTappedBy(target))
-                            dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
-                    }
+            if (!creature->IsValidTrainerForPlayer(target, &appendValue))
+            {
+                appendValue &= ~UNIT_NPC_FLAG_TRAINER;
+            }
+        }
 
-                    if (!target->isAllowedToLoot(creature))
-                        dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
-                }
+        fieldBuffer << uint32(appendValue);
+    }
+    else if (index == UNIT_FIELD_AURASTATE)
+    {
+        // Check per caster aura states to not enable using a spell in client if specified aura is not by target
+        fieldBuffer << BuildAuraStateUpdateForTarget(target);
+    }
+    // Gamemasters should be always able to select units - remove not selectable flag
+    else if (index == UNIT_FIELD_FLAGS)
+    {
+        uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
+        if (target->IsGameMaster() && AccountMgr::IsGMAccount(target->GetSession()->GetSecurity()))
+            appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
+
+        fieldBuffer << uint32(appendValue);
+    }
+    // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
+    else if (index == UNIT_FIELD_DISPLAYID)
+    {
+        uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
+        if (creature)
+        {
+            CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
 
-                // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
-                if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
-                    if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
-                        dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+            // this also applies for transform auras
+            if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
+                for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+                    if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
+                        if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
+                        {
+                            cinfo = transformInfo;
+                            break;
+                        }
 
-                fieldBuffer << dynamicFlags;
-            }
-            // FG: pretend that OTHER players in own group are friendly ("blue")
-            else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
+            if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
             {
-                if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
+                if (target->IsGameMaster() && AccountMgr::IsGMAccount(target->GetSession()->GetSecurity()))
                 {
-                    FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
-                    FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
-                    if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
-                    {
-                        if (index == UNIT_FIELD_BYTES_2)
-                            // Allow targetting opposite faction in party when enabled in config
-                            fieldBuffer << (m_uint32Values[UNIT_FIELD_BYTES_2] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
-                        else
-                            // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
-                            fieldBuffer << uint32(target->getFaction());
-                    }
+                    if (cinfo->Modelid1)
+                        displayId = cinfo->Modelid1;    // Modelid1 is a visible model for gms
                     else
-                        fieldBuffer << m_uint32Values[index];
-                }// pussywizard / Callmephil
-                else if (target->IsSpectator() && target->FindMap() && target->FindMap()->IsBattleArena() &&
-                         (this->GetTypeId() == TYPEID_PLAYER || this->GetTypeId() == TYPEID_UNIT || this->GetTypeId() == TYPEID_DYNAMICOBJECT))
+                        displayId = 17519;              // world visible trigger's model
+                }
+                else
                 {
-                    if (index == UNIT_FIELD_BYTES_2)
-                        fieldBuffer << (m_uint32Values[index] & 0xFFFFF2FF); // clear UNIT_BYTE2_FLAG_PVP, UNIT_BYTE2_FLAG_FFA_PVP, UNIT_BYTE2_FLAG_SANCTUARY
+                    if (cinfo->Modelid2)
+                        displayId = cinfo->Modelid2;    // Modelid2 is an invisible model for players
                     else
-                        fieldBuffer << (uint32)target->getFaction();
+                        displayId = 11686;              // world invisible trigger's model
                 }
+            }
+        }
+
+        fieldBuffer << uint32(displayId);
+    }
+    // hide lootable animation for unallowed players
+    else if (index == UNIT_DYNAMIC_FLAGS)
+    {
+        uint32 dynamicFlags = m_uint32Values[UNIT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+
+        if (creature)
+        {
+            if (creature->hasLootRecipient())
+            {
+                dynamicFlags |= UNIT_DYNFLAG_TAPPED;
+                if (creature->isTappedBy(target))
+                    dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
+            }
+
+            if (!target->isAllowedToLoot(creature))
+                dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
+        }
+
+        // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
+        if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
+            if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
+                dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+
+        fieldBuffer << dynamicFlags;
+    }
+    // FG: pretend that OTHER players in own group are friendly ("blue")
+    else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
+    {
+        if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
+        {
+            FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
+            FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
+            if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
+            {
+                if (index == UNIT_FIELD_BYTES_2)
+                    // Allow targetting opposite faction in party when enabled in config
+                    fieldBuffer << (m_uint32Values[UNIT_FIELD_BYTES_2] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
                 else
-                    if (!sScriptMgr->IsCustomBuildValuesUpdate(this, updateType, fieldBuffer, target, index))
-                    {
-                        fieldBuffer << m_uint32Values[index];
-                    }
+                    // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
+                    fieldBuffer << uint32(target->getFaction());
             }
             else
-                // send in current format (float as float, uint32 as uint32)
                 fieldBuffer << m_uint32Values[index];
+        }// pussywizard / Callmephil
+        else if (target->IsSpectator() && target->FindMap() && target->FindMap()->IsBattleArena() &&
+                 (this->GetTypeId() == TYPEID_PLAYER || this->GetTypeId() == TYPEID_UNIT || this->GetTypeId() == TYPEID_DYNAMICOBJECT))
+        {
+            if (index == UNIT_FIELD_BYTES_2)
+                fieldBuffer << (m_uint32Values[index] & 0xFFFFF2FF); // clear UNIT_BYTE2_FLAG_PVP, UNIT_BYTE2_FLAG_FFA_PVP, UNIT_BYTE2_FLAG_SANCTUARY
+            else
+                fieldBuffer << (uint32)target->getFaction();
         }
+        else
+            if (!sScriptMgr->IsCustomBuildValuesUpdate(this, updateType, fieldBuffer, target, index))
+            {
+                fieldBuffer << m_uint32Values[index];
+            }
     }
-
-    *data << uint8(updateMask.GetBlockCount());
-    updateMask.AppendToPacket(data);
-    data->append(fieldBuffer);
 }
 
 void Unit::BuildCooldownPacket(WorldPacket& data, uint8 flags, uint32 spellId, uint32 cooldown)
@@ -18,6 +18,7 @@
 #ifndef __UNIT_H
 #define __UNIT_H
 
+#include "AuraEffectAggregate.h"
 #include "EventProcessor.h"
 #include "FollowerReference.h"
 #include "FollowerRefMgr.h"
@@ -1975,6 +1976,8 @@ public:
     void _RemoveNoStackAurasDueToAura(Aura* aura);
     bool _IsNoStackAuraDueToAura(Aura* appliedAura, Aura* existingAura) const;
     void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+    // must be called when the amount of a registered effect changes in place
+    void InvalidateAuraEffectAggregate(AuraType auratype) { m_modAuraAggregates.erase(auratype); }
 
     // m_ownedAuras container management
     AuraMap&       GetOwnedAuras()       { return m_ownedAuras; }
@@ -2503,6 +2506,8 @@ protected:
     explicit Unit (bool isWorldObject);
 
     void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+    [[nodiscard]] bool IsUpdateFieldValueViewerDependent(uint16 index) const override;
+    void BuildViewerDependentUpdateField(uint8 updateType, uint16 index, ByteBuffer& fieldBuffer, Player* target) const override;
 
     UnitAI* i_AI, *i_disabledAI;
 
@@ -2543,6 +2548,7 @@ protected:
     uint32 m_removedAurasCount;
 
     AuraEffectList m_modAuras[TOTAL_AURAS];
+    mutable std::unordered_map<uint32, AuraEffectAggregate> m_modAuraAggregates; // cached amounts of m_modAuras lists, see GetAuraEffectAggregate
     AuraList m_scAuras;                        // casted singlecast auras
     AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
     AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
@@ -2590,6 +2596,9 @@ private:
     bool HandleAuraRaidProcFromChargeWithValue(AuraEffect* triggeredByAura);
     bool HandleAuraRaidProcFromCharge(AuraEffect* triggeredByAura);
 
+    // cached amounts of an effect list, nullptr when the list is too short for the cache to pay off
+    AuraEffectAggregate const* GetAuraEffectAggregate(AuraType auratype) const;
+
     void UpdateSplineMovement(uint32 t_diff);
     void UpdateSplinePosition();
 
@@ -0,0 +1,181 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "GridRangeFilter.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GRID_RANGE_FILTER_SSE2
+#include <emmintrin.h>
+#endif
+
+// AVX2 is compiled per function and selected at runtime, the build itself only requires SSE2
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GRID_RANGE_FILTER_AVX2
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // covers the rounding differences with the distance checks of WorldObject
+    constexpr float RangeTolerance = 0.1f;
+
+    inline bool InPhase(uint32 phaseMask, GridRangeQuery const& query)
+    {
+        return !query.CheckPhase || (phaseMask & query.PhaseMask) || phaseMask == query.PhaseMask;
+    }
+
+    uint32 FilterScalar(GridRangeQuery const& query, float const* x, float const* y, float const* z,
+        float const* sizes, uint32 const* phaseMasks, uint32 begin, uint32 count, uint32* candidates)
+    {
+        float const radius = query.Radius + RangeTolerance;
+        uint32 found = 0;
+
+        for (uint32 i = begin; i < count; ++i)
+        {
+            float dx = x[i] - query.X;
+            float dy = y[i] - query.Y;
+            float distSq = dx * dx + dy * dy;
+            if (query.Is3D)
+            {
+                float dz = z[i] - query.Z;
+                distSq += dz * dz;
+            }
+
+            float maxDist = radius + sizes[i];
+            if (distSq <= maxDist * maxDist && InPhase(phaseMasks[i], query))
+                candidates[found++] = i;
+        }
+
+        return found;
+    }
+
+#ifdef GRID_RANGE_FILTER_SSE2
+    uint32 FilterSSE2(GridRangeQuery const& query, float const* x, float const* y, float const* z,
+        float const* sizes, uint32 const* phaseMasks, uint32 count, uint32* candidates)
+    {
+        __m128 const centerX = _mm_set1_ps(query.X);
+        __m128 const centerY = _mm_set1_ps(query.Y);
+        __m128 const centerZ = _mm_set1_ps(query.Z);
+        __m128 const radius = _mm_set1_ps(query.Radius + RangeTolerance);
+        __m128i const phaseMask = _mm_set1_epi32(int32(query.PhaseMask));
+        __m128i const zero = _mm_setzero_si128();
+
+        uint32 found = 0;
+        uint32 i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), centerX);
+            __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), centerY);
+            __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            if (query.Is3D)
+            {
+                __m128 dz = _mm_sub_ps(_mm_loadu_ps(z + i), centerZ);
+                distSq = _mm_add_ps(distSq, _mm_mul_ps(dz, dz));
+            }
+
+            __m128 maxDist = _mm_add_ps(radius, _mm_loadu_ps(sizes + i));
+            int accepted = _mm_movemask_ps(_mm_cmple_ps(distSq, _mm_mul_ps(maxDist, maxDist)));
+
+            if (accepted && query.CheckPhase)
+            {
+                // rejected when no phase bit is shared and the masks differ
+                __m128i phases = _mm_loadu_si128(reinterpret_cast<__m128i const*>(phaseMasks + i));
+                __m128i noneShared = _mm_cmpeq_epi32(_mm_and_si128(phases, phaseMask), zero);
+                __m128i rejected = _mm_andnot_si128(_mm_cmpeq_epi32(phases, phaseMask), noneShared);
+                accepted &= ~_mm_movemask_ps(_mm_castsi128_ps(rejected));
+            }
+
+            for (uint32 lane = 0; accepted; ++lane, accepted >>= 1)
+                if (accepted & 1)
+                    candidates[found++] = i + lane;
+        }
+
+        return found + FilterScalar(query, x, y, z, sizes, phaseMasks, i, count, candidates + found);
+    }
+#endif
+
+#ifdef GRID_RANGE_FILTER_AVX2
+    __attribute__((target("avx2")))
+    uint32 FilterAVX2(GridRangeQuery const& query, float const* x, float const* y, float const* z,
+        float const* sizes, uint32 const* phaseMasks, uint32 count, uint32* candidates)
+    {
+        __m256 const centerX = _mm256_set1_ps(query.X);
+        __m256 const centerY = _mm256_set1_ps(query.Y);
+        __m256 const centerZ = _mm256_set1_ps(query.Z);
+        __m256 const radius = _mm256_set1_ps(query.Radius + RangeTolerance);
+        __m256i const phaseMask = _mm256_set1_epi32(int32(query.PhaseMask));
+        __m256i const zero = _mm256_setzero_si256();
+
+        uint32 found = 0;
+        uint32 i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), centerX);
+            __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), centerY);
+            __m256 distSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            if (query.Is3D)
+            {
+                __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(z + i), centerZ);
+                distSq = _mm256_add_ps(distSq, _mm256_mul_ps(dz, dz));
+            }
+
+            __m256 maxDist = _mm256_add_ps(radius, _mm256_loadu_ps(sizes + i));
+            int accepted = _mm256_movemask_ps(_mm256_cmp_ps(distSq, _mm256_mul_ps(maxDist, maxDist), _CMP_LE_OQ));
+
+            if (accepted && query.CheckPhase)
+            {
+                __m256i phases = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(phaseMasks + i));
+                __m256i noneShared = _mm256_cmpeq_epi32(_mm256_and_si256(phases, phaseMask), zero);
+                __m256i rejected = _mm256_andnot_si256(_mm256_cmpeq_epi32(phases, phaseMask), noneShared);
+                accepted &= ~_mm256_movemask_ps(_mm256_castsi256_ps(rejected));
+            }
+
+            for (uint32 lane = 0; accepted; ++lane, accepted >>= 1)
+                if (accepted & 1)
+                    candidates[found++] = i + lane;
+        }
+
+        return found + FilterScalar(query, x, y, z, sizes, phaseMasks, i, count, candidates + found);
+    }
+
+    bool HasAVX2()
+    {
+        static bool const hasAVX2 = __builtin_cpu_supports("avx2");
+        return hasAVX2;
+    }
+#endif
+}
+
+uint32 Acore::FilterInRange(GridRangeQuery const& query, float const* x, float const* y, float const* z,
+    float const* sizes, uint32 const* phaseMasks, uint32 count, uint32* candidates)
+{
+#ifdef GRID_RANGE_FILTER_AVX2
+    if (HasAVX2())
+        return FilterAVX2(query, x, y, z, sizes, phaseMasks, count, candidates);
+#endif
+
+#ifdef GRID_RANGE_FILTER_SSE2
+    return FilterSSE2(query, x, y, z, sizes, phaseMasks, count, candidates);
+#else
+    return FilterScalar(query, x, y, z, sizes, phaseMasks, 0, count, candidates);
+#endif
+}
+
+uint32 Acore::FilterInRangeScalar(GridRangeQuery const& query, float const* x, float const* y, float const* z,
+    float const* sizes, uint32 const* phaseMasks, uint32 count, uint32* candidates)
+{
+    return FilterScalar(query, x, y, z, sizes, phaseMasks, 0, count, candidates);
+}
@@ -0,0 +1,56 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ACORE_GRIDRANGEFILTER_H
+#define ACORE_GRIDRANGEFILTER_H
+
+#include "Define.h"
+
+// number of slots filtered at once by the searchers, bounds the candidate buffer they keep on the stack
+#define GRID_RANGE_FILTER_BATCH 64
+
+/*
+ * Coarse range test run on the packed positions of a grid cell before the searcher's check.
+ * An object is a candidate when its distance to the center is within Radius + its object size
+ * (plus a small tolerance, the result must stay a superset of what the exact checks accept)
+ * and, if CheckPhase is set, when it shares a phase with PhaseMask.
+ */
+struct GridRangeQuery
+{
+    GridRangeQuery() : X(0.0f), Y(0.0f), Z(0.0f), Radius(0.0f), Is3D(true), CheckPhase(false), PhaseMask(0) { }
+
+    float X;
+    float Y;
+    float Z;
+    float Radius;
+    bool Is3D;
+    bool CheckPhase;
+    uint32 PhaseMask;
+};
+
+namespace Acore
+{
+    // Writes the index of every candidate among the count packed objects to candidates and returns how many were found.
+    // Uses the widest vector unit of the cpu (AVX2, SSE2) and falls back to FilterInRangeScalar.
+    AC_GAME_API uint32 FilterInRange(GridRangeQuery const& query, float const* x, float const* y, float const* z,
+        float const* sizes, uint32 const* phaseMasks, uint32 count, uint32* candidates);
+
+    // Reference implementation, returns the same candidates as FilterInRange
+    AC_GAME_API uint32 FilterInRangeScalar(GridRangeQuery const& query, float const* x, float const* y, float const* z,
+        float const* sizes, uint32 const* phaseMasks, uint32 count, uint32* candidates);
+}
+
+#endif
@@ -18,16 +18,129 @@
 #ifndef _GRIDREFMANAGER
 #define _GRIDREFMANAGER
 
+#include "Define.h"
+#include "GridRangeFilter.h"
 #include "RefMgr.h"
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 template<class OBJECT>
 class GridReference;
 
+// fields copied in the packed slots, objects without position (the grids themselves) match every phase and range
+template<class OBJECT, class = void>
+struct GridSlotFields
+{
+    static uint32 GetPhaseMask(OBJECT const* /*object*/) { return 0xFFFFFFFF; }
+    static void GetPosition(OBJECT const* /*object*/, float& x, float& y, float& z, float& size) { x = y = z = size = 0.0f; }
+};
+
+template<class OBJECT>
+struct GridSlotFields<OBJECT, std::void_t<decltype(std::declval<OBJECT const&>().GetPhaseMask())>>
+{
+    static uint32 GetPhaseMask(OBJECT const* object) { return object->GetPhaseMask(); }
+
+    static void GetPosition(OBJECT const* object, float& x, float& y, float& z, float& size)
+    {
+        x = object->GetPositionX();
+        y = object->GetPositionY();
+        z = object->GetPositionZ();
+        size = object->GetObjectSize();
+    }
+};
+
+/*
+ * Contiguous copy of a cell's object list, one array per field so the range filter can load
+ * several objects at once. Searchers walk these instead of the linked list, so the objects
+ * rejected on the packed fields are never read.
+ */
+template<class OBJECT>
+struct GridObjectSlots
+{
+    std::vector<OBJECT*> Objects;
+    std::vector<uint32> PhaseMasks;
+    std::vector<float> PositionX;
+    std::vector<float> PositionY;
+    std::vector<float> PositionZ;
+    std::vector<float> Sizes;
+
+    [[nodiscard]] std::size_t size() const { return Objects.size(); }
+
+    void push_back(OBJECT* object)
+    {
+        Objects.push_back(object);
+        PhaseMasks.push_back(0);
+        PositionX.push_back(0.0f);
+        PositionY.push_back(0.0f);
+        PositionZ.push_back(0.0f);
+        Sizes.push_back(0.0f);
+        Refresh(Objects.size() - 1);
+    }
+
+    void Refresh(std::size_t slot)
+    {
+        PhaseMasks[slot] = GridSlotFields<OBJECT>::GetPhaseMask(Objects[slot]);
+        GridSlotFields<OBJECT>::GetPosition(Objects[slot], PositionX[slot], PositionY[slot], PositionZ[slot], Sizes[slot]);
+    }
+
+    // overwrites the slot with the last one and drops the last one
+    void MoveLastTo(std::size_t slot)
+    {
+        Objects[slot] = Objects.back();
+        PhaseMasks[slot] = PhaseMasks.back();
+        PositionX[slot] = PositionX.back();
+        PositionY[slot] = PositionY.back();
+        PositionZ[slot] = PositionZ.back();
+        Sizes[slot] = Sizes.back();
+        pop_back();
+    }
+
+    void pop_back()
+    {
+        Objects.pop_back();
+        PhaseMasks.pop_back();
+        PositionX.pop_back();
+        PositionY.pop_back();
+        PositionZ.pop_back();
+        Sizes.pop_back();
+    }
+};
+
 template<class OBJECT>
 class GridRefMgr : public RefMgr<GridRefMgr<OBJECT>, OBJECT>
 {
+    friend class GridReference<OBJECT>;
+
 public:
     typedef LinkedListHead::Iterator< GridReference<OBJECT> > iterator;
+    typedef GridObjectSlots<OBJECT> SlotContainer;
+
+    // walks the slots by index, so it stays valid if an object enters the cell during the visit
+    class slot_iterator
+    {
+    public:
+        slot_iterator(SlotContainer const* slots, std::size_t index) : _slots(slots), _index(index) { }
+
+        [[nodiscard]] OBJECT* GetSource() const { return _slots->Objects[_index]; }
+
+        // same result as OBJECT::InSamePhase, objects sharing no phase bit are rejected without being read
+        [[nodiscard]] bool InSamePhase(uint32 phaseMask) const
+        {
+            uint32 slotMask = _slots->PhaseMasks[_index];
+            return ((slotMask & phaseMask) || slotMask == phaseMask) && GetSource()->InSamePhase(phaseMask);
+        }
+
+        slot_iterator& operator++() { ++_index; return *this; }
+
+        // the end is the current size of the container
+        bool operator!=(slot_iterator const& /*end*/) const { return _index < _slots->size(); }
+
+    private:
+        SlotContainer const* _slots;
+        std::size_t _index;
+    };
 
     GridReference<OBJECT>* getFirst() { return (GridReference<OBJECT>*)RefMgr<GridRefMgr<OBJECT>, OBJECT>::getFirst(); }
     GridReference<OBJECT>* getLast() { return (GridReference<OBJECT>*)RefMgr<GridRefMgr<OBJECT>, OBJECT>::getLast(); }
@@ -36,5 +149,57 @@ public:
     iterator end() { return iterator(nullptr); }
     iterator rbegin() { return iterator(getLast()); }
     iterator rend() { return iterator(nullptr); }
+
+    slot_iterator slot_begin() const { return slot_iterator(&_slots, 0); }
+    slot_iterator slot_end() const { return slot_iterator(&_slots, _slots.size()); }
+    SlotContainer const& GetSlots() const { return _slots; }
+
+    // calls visitor with every object the range filter keeps, the check of the searcher must still be run on them
+    template<class VISITOR>
+    void VisitSlotsInRange(GridRangeQuery const& query, VISITOR&& visitor) const
+    {
+        uint32 candidates[GRID_RANGE_FILTER_BATCH];
+        for (std::size_t begin = 0; begin < _slots.size(); begin += GRID_RANGE_FILTER_BATCH)
+        {
+            uint32 count = uint32(std::min<std::size_t>(_slots.size() - begin, GRID_RANGE_FILTER_BATCH));
+            uint32 found = Acore::FilterInRange(query, &_slots.PositionX[begin], &_slots.PositionY[begin], &_slots.PositionZ[begin],
+                &_slots.Sizes[begin], &_slots.PhaseMasks[begin], count, candidates);
+
+            for (uint32 i = 0; i < found && begin + candidates[i] < _slots.size(); ++i)
+                visitor(_slots.Objects[begin + candidates[i]]);
+        }
+    }
+
+private:
+    void AddSlot(GridReference<OBJECT>* ref)
+    {
+        ref->_slot = uint32(_slots.size());
+        _slots.push_back(ref->GetSource());
+        _slotRefs.push_back(ref);
+    }
+
+    void RemoveSlot(GridReference<OBJECT>* ref)
+    {
+        // swap with the last slot to keep the array dense
+        uint32 slot = ref->_slot;
+        if (slot + 1 != _slots.size())
+        {
+            _slots.MoveLastTo(slot);
+            _slotRefs[slot] = _slotRefs.back();
+            _slotRefs[slot]->_slot = slot;
+        }
+        else
+            _slots.pop_back();
+
+        _slotRefs.pop_back();
+    }
+
+    void UpdateSlot(GridReference<OBJECT>* ref)
+    {
+        _slots.Refresh(ref->_slot);
+    }
+
+    SlotContainer _slots;
+    std::vector<GridReference<OBJECT>*> _slotRefs;  // owner of every slot, to fix its index when a slot is moved
 };
 #endif
@@ -26,26 +26,43 @@ class GridRefMgr;
 template<class OBJECT>
 class GridReference : public Reference<GridRefMgr<OBJECT>, OBJECT>
 {
+    friend class GridRefMgr<OBJECT>;
+
 protected:
     void targetObjectBuildLink() override
     {
         // called from link()
         this->getTarget()->insertFirst(this);
         this->getTarget()->incSize();
+        this->getTarget()->AddSlot(this);
     }
     void targetObjectDestroyLink() override
     {
         // called from unlink()
-        if (this->isValid()) this->getTarget()->decSize();
+        if (this->isValid())
+        {
+            this->getTarget()->decSize();
+            this->getTarget()->RemoveSlot(this);
+        }
     }
     void sourceObjectDestroyLink() override
     {
-        // called from invalidate()
+        // called from invalidate(), the whole cell is being destroyed so its slots are left alone
         this->getTarget()->decSize();
     }
 public:
-    GridReference() : Reference<GridRefMgr<OBJECT>, OBJECT>() {}
+    GridReference() : Reference<GridRefMgr<OBJECT>, OBJECT>(), _slot(0) {}
     ~GridReference() override { this->unlink(); }
     GridReference* next() { return (GridReference*)Reference<GridRefMgr<OBJECT>, OBJECT>::next(); }
+
+    // refreshes the packed copy of the object's fields after one of them changed
+    void UpdateSlot()
+    {
+        if (this->isValid())
+            this->getTarget()->UpdateSlot(this);
+    }
+
+private:
+    uint32 _slot;   // index of the object in the cell's packed slots
 };
 #endif
@@ -177,6 +177,65 @@ void PlayerRelocationNotifier::Visit(PlayerMapType& m)
     }
 }
 
+IncrementalRelocationNotifier::IncrementalRelocationNotifier(Player& player, bool largeOnly) :
+    i_player(player), i_visibleNow(player.m_newVisible), i_largeOnly(largeOnly)
+{
+    i_visibleNow.clear();
+}
+
+bool IncrementalRelocationNotifier::CanHandle(Player const& player)
+{
+    // everything below makes visibility depend on more than the distance between the viewer and the object
+    return player.m_seer == &player && !player.GetGuidValue(PLAYER_FARSIGHT) && !player.GetFarSightDistance() && player.IsAlive() && !player.GetTransport();
+}
+
+bool IncrementalRelocationNotifier::IsUnchanged(Player const& viewer, WorldObject const* target) const
+{
+    // stealth detection depends on the distance
+    if (target->m_stealth.GetFlags())
+        return false;
+
+    // stricter than the check of CanSeeOrDetect, which also accounts for the size of both objects
+    float sightRange = viewer.GetSightRange(target);
+    if (viewer.GetExactDistSq(target) >= sightRange * sightRange)
+        return false;
+
+    // in range before and after the move: the last result stands
+    return viewer.HaveAtClient(target);
+}
+
+void IncrementalRelocationNotifier::Visit(PlayerMapType& m)
+{
+    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        Player* player = iter->GetSource();
+        if (!IsUnchanged(i_player, player))
+            i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
+
+        // whether the other player still sees us, same conditions from their point of view
+        if (!CanHandle(*player) || !IsUnchanged(*player, &i_player))
+            player->UpdateVisibilityOf(&i_player);
+    }
+}
+
+void IncrementalRelocationNotifier::SendToSelf()
+{
+    if (!i_data.HasData())
+        return;
+
+    WorldPacket packet;
+    i_data.BuildPacket(&packet);
+    i_player.GetSession()->SendPacket(&packet);
+
+    for (std::vector<Unit*>::const_iterator it = i_visibleNow.begin(); it != i_visibleNow.end(); ++it)
+    {
+        if (i_largeOnly != (*it)->IsVisibilityOverridden())
+            continue;
+
+        i_player.GetInitialVisiblePackets(*it);
+    }
+}
+
 void CreatureRelocationNotifier::Visit(PlayerMapType& m)
 {
     for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
@@ -193,20 +252,38 @@ void CreatureRelocationNotifier::Visit(PlayerMapType& m)
     }
 }
 
+AIRelocationNotifier::AIRelocationNotifier(Unit& unit, float radius) : i_unit(unit), isCreature(unit.GetTypeId() == TYPEID_UNIT),
+    i_useRange(!unit.GetTransport()) // distances are measured between transport offsets when both units are on the same transport
+{
+    // the cells are visited in 2d
+    i_range.X = unit.GetPositionX();
+    i_range.Y = unit.GetPositionY();
+    i_range.Z = unit.GetPositionZ();
+    i_range.Radius = radius;
+    i_range.Is3D = false;
+}
+
 void AIRelocationNotifier::Visit(CreatureMapType& m)
 {
     bool self = isCreature && !((Creature*)(&i_unit))->IsMoveInLineOfSightStrictlyDisabled();
-    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    auto relocate = [this, self](Creature* c)
     {
-        Creature* c = iter->GetSource();
-
         // NOTIFY_VISIBILITY_CHANGED | NOTIFY_AI_RELOCATION does not guarantee that unit will do it itself (because distance is also checked), but screw it, it's not that important
         if (!c->isNeedNotify(NOTIFY_VISIBILITY_CHANGED | NOTIFY_AI_RELOCATION) && !c->IsMoveInLineOfSightStrictlyDisabled())
             CreatureUnitRelocationWorker(c, &i_unit);
 
         if (self)
             CreatureUnitRelocationWorker((Creature*)&i_unit, c);
+    };
+
+    if (i_useRange)
+    {
+        m.VisitSlotsInRange(i_range, relocate);
+        return;
     }
+
+    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+        relocate(iter->GetSource());
 }
 
 void MessageDistDeliverer::Visit(PlayerMapType& m)
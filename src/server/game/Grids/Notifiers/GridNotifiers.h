@@ -22,6 +22,7 @@
 #include "CreatureAI.h"
 #include "DynamicObject.h"
 #include "GameObject.h"
+#include "GridRangeFilter.h"
 #include "Object.h"
 #include "ObjectGridLoader.h"
 #include "Optional.h"
@@ -76,6 +77,30 @@ namespace Acore
         void Visit(PlayerMapType&);
     };
 
+    // Relocation pass re-evaluating only the objects whose visibility may have changed by the move.
+    // Objects already at client that are still within sight range keep their state, changes of their
+    // own state are notified by themselves. Objects at client that are no longer in any visited cell
+    // are not cleaned up here, the periodic PlayerRelocationNotifier pass takes care of them.
+    struct IncrementalRelocationNotifier
+    {
+        Player& i_player;
+        std::vector<Unit*>& i_visibleNow;
+        bool i_largeOnly;
+        UpdateData i_data;
+
+        IncrementalRelocationNotifier(Player& player, bool largeOnly);
+
+        template<class T> void Visit(GridRefMgr<T>& m);
+        void Visit(PlayerMapType&);
+        void SendToSelf();
+
+        // whether the player's relocation can be handled by this notifier instead of a full pass
+        static bool CanHandle(Player const& player);
+
+    private:
+        bool IsUnchanged(Player const& viewer, WorldObject const* target) const;
+    };
+
     struct CreatureRelocationNotifier
     {
         Creature& i_creature;
@@ -88,7 +113,11 @@ namespace Acore
     {
         Unit& i_unit;
         bool isCreature;
-        explicit AIRelocationNotifier(Unit& unit) : i_unit(unit), isCreature(unit.GetTypeId() == TYPEID_UNIT)  {}
+        GridRangeQuery i_range;
+        bool i_useRange;
+
+        // creatures farther than radius from the unit are skipped, they are only in the visited cells because cells are coarse
+        AIRelocationNotifier(Unit& unit, float radius);
         template<class T> void Visit(GridRefMgr<T>&) {}
         void Visit(CreatureMapType&);
     };
@@ -97,6 +126,7 @@ namespace Acore
     {
         WorldObject* i_source;
         WorldPacket* i_message;
+        std::shared_ptr<WorldPacket const> i_sharedMessage;
         uint32 i_phaseMask;
         float i_distSq;
         TeamId teamId;
@@ -121,7 +151,11 @@ namespace Acore
             if (!player->HaveAtClient(i_source))
                 return;
 
-            player->GetSession()->SendPacket(i_message);
+            // copied once for the whole broadcast, every recipient's socket queues the same packet
+            if (!i_sharedMessage)
+                i_sharedMessage = std::make_shared<WorldPacket const>(*i_message);
+
+            player->GetSession()->SendPacket(i_sharedMessage);
         }
     };
 
@@ -129,6 +163,7 @@ namespace Acore
     {
         Unit* i_source;
         WorldPacket* i_message;
+        std::shared_ptr<WorldPacket const> i_sharedMessage;
         uint32 i_phaseMask;
         float i_distSq;
         MessageDistDelivererToHostile(Unit* src, WorldPacket* msg, float dist)
@@ -146,7 +181,11 @@ namespace Acore
             if (player == i_source || !player->HaveAtClient(i_source) || player->IsFriendlyTo(i_source))
                 return;
 
-            player->GetSession()->SendPacket(i_message);
+            // copied once for the whole broadcast, every recipient's socket queues the same packet
+            if (!i_sharedMessage)
+                i_sharedMessage = std::make_shared<WorldPacket const>(*i_message);
+
+            player->GetSession()->SendPacket(i_sharedMessage);
         }
     };
 
@@ -211,9 +250,23 @@ namespace Acore
         uint32 i_phaseMask;
         std::list<WorldObject*>& i_objects;
         Check& i_check;
+        GridRangeQuery i_range;
+        bool i_useRange;
 
         WorldObjectListSearcher(WorldObject const* searcher, std::list<WorldObject*>& objects, Check& check, uint32 mapTypeMask = GRID_MAP_TYPE_MASK_ALL)
-            : i_mapTypeMask(mapTypeMask), i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
+            : i_mapTypeMask(mapTypeMask), i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check), i_useRange(false) {}
+
+        // skips the units, corpses and dynamic objects farther than radius + their object size before running the check,
+        // gameobjects are always checked as their range depends on their model
+        void SetRangeFilter(Position const& center, float radius, bool is3D = true)
+        {
+            i_range.X = center.GetPositionX();
+            i_range.Y = center.GetPositionY();
+            i_range.Z = center.GetPositionZ();
+            i_range.Radius = radius;
+            i_range.Is3D = is3D;
+            i_useRange = true;
+        }
 
         void Visit(PlayerMapType& m);
         void Visit(CreatureMapType& m);
@@ -375,9 +428,24 @@ namespace Acore
         uint32 i_phaseMask;
         Unit*& i_object;
         Check& i_check;
+        GridRangeQuery i_range;
+        bool i_useRange;
 
         UnitLastSearcher(WorldObject const* searcher, Unit*& result, Check& check)
-            : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
+            : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check), i_useRange(false) {}
+
+        // skips the units farther than radius + their object size before running the check
+        void SetRangeFilter(Position const& center, float radius, bool is3D = true)
+        {
+            i_range.X = center.GetPositionX();
+            i_range.Y = center.GetPositionY();
+            i_range.Z = center.GetPositionZ();
+            i_range.Radius = radius;
+            i_range.Is3D = is3D;
+            i_range.CheckPhase = true;
+            i_range.PhaseMask = i_phaseMask;
+            i_useRange = true;
+        }
 
         void Visit(CreatureMapType& m);
         void Visit(PlayerMapType& m);
@@ -441,9 +509,24 @@ namespace Acore
         uint32 i_phaseMask;
         std::list<Creature*>& i_objects;
         Check& i_check;
+        GridRangeQuery i_range;
+        bool i_useRange;
 
         CreatureListSearcher(WorldObject const* searcher, std::list<Creature*>& objects, Check& check)
-            : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
+            : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check), i_useRange(false) {}
+
+        // skips the creatures farther than radius + their object size before running the check
+        void SetRangeFilter(Position const& center, float radius, bool is3D = true)
+        {
+            i_range.X = center.GetPositionX();
+            i_range.Y = center.GetPositionY();
+            i_range.Z = center.GetPositionZ();
+            i_range.Radius = radius;
+            i_range.Is3D = is3D;
+            i_range.CheckPhase = true;
+            i_range.PhaseMask = i_phaseMask;
+            i_useRange = true;
+        }
 
         void Visit(CreatureMapType& m);
 
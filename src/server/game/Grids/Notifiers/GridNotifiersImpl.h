@@ -44,6 +44,22 @@ inline void Acore::VisibleNotifier::Visit(GridRefMgr<T>& m)
     }
 }
 
+template<class T>
+inline void Acore::IncrementalRelocationNotifier::Visit(GridRefMgr<T>& m)
+{
+    for (typename GridRefMgr<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        T* target = iter->GetSource();
+        if (i_largeOnly != target->IsVisibilityOverridden())
+            continue;
+
+        if (IsUnchanged(i_player, target))
+            continue;
+
+        i_player.UpdateVisibilityOf(target, i_data, i_visibleNow);
+    }
+}
+
 // SEARCHERS & LIST SEARCHERS & WORKERS
 
 // WorldObject searchers & workers
@@ -58,14 +74,14 @@ void Acore::WorldObjectSearcher<Check>::Visit(GameObjectMapType& m)
     if (i_object)
         return;
 
-    for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (GameObjectMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
+        if (i_check(itr.GetSource()))
         {
-            i_object = itr->GetSource();
+            i_object = itr.GetSource();
             return;
         }
     }
@@ -81,14 +97,14 @@ void Acore::WorldObjectSearcher<Check>::Visit(PlayerMapType& m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (PlayerMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
+        if (i_check(itr.GetSource()))
         {
-            i_object = itr->GetSource();
+            i_object = itr.GetSource();
             return;
         }
     }
@@ -104,14 +120,14 @@ void Acore::WorldObjectSearcher<Check>::Visit(CreatureMapType& m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (CreatureMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
+        if (i_check(itr.GetSource()))
         {
-            i_object = itr->GetSource();
+            i_object = itr.GetSource();
             return;
         }
     }
@@ -127,14 +143,14 @@ void Acore::WorldObjectSearcher<Check>::Visit(CorpseMapType& m)
     if (i_object)
         return;
 
-    for (CorpseMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (CorpseMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
+        if (i_check(itr.GetSource()))
         {
-            i_object = itr->GetSource();
+            i_object = itr.GetSource();
             return;
         }
     }
@@ -150,14 +166,14 @@ void Acore::WorldObjectSearcher<Check>::Visit(DynamicObjectMapType& m)
     if (i_object)
         return;
 
-    for (DynamicObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (DynamicObjectMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
+        if (i_check(itr.GetSource()))
         {
-            i_object = itr->GetSource();
+            i_object = itr.GetSource();
             return;
         }
     }
@@ -169,13 +185,13 @@ void Acore::WorldObjectLastSearcher<Check>::Visit(GameObjectMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_GAMEOBJECT))
         return;
 
-    for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (GameObjectMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
+        if (i_check(itr.GetSource()))
+            i_object = itr.GetSource();
     }
 }
 
@@ -185,13 +201,13 @@ void Acore::WorldObjectLastSearcher<Check>::Visit(PlayerMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_PLAYER))
         return;
 
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (PlayerMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
+        if (i_check(itr.GetSource()))
+            i_object = itr.GetSource();
     }
 }
 
@@ -201,13 +217,13 @@ void Acore::WorldObjectLastSearcher<Check>::Visit(CreatureMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CREATURE))
         return;
 
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (CreatureMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
+        if (i_check(itr.GetSource()))
+            i_object = itr.GetSource();
     }
 }
 
@@ -217,13 +233,13 @@ void Acore::WorldObjectLastSearcher<Check>::Visit(CorpseMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CORPSE))
         return;
 
-    for (CorpseMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (CorpseMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
+        if (i_check(itr.GetSource()))
+            i_object = itr.GetSource();
     }
 }
 
@@ -233,13 +249,13 @@ void Acore::WorldObjectLastSearcher<Check>::Visit(DynamicObjectMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_DYNAMICOBJECT))
         return;
 
-    for (DynamicObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (DynamicObjectMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
+        if (i_check(itr.GetSource()))
+            i_object = itr.GetSource();
     }
 }
 
@@ -249,9 +265,19 @@ void Acore::WorldObjectListSearcher<Check>::Visit(PlayerMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_PLAYER))
         return;
 
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->GetSource()))
-            i_objects.push_back(itr->GetSource());
+    if (i_useRange)
+    {
+        m.VisitSlotsInRange(i_range, [this](Player* object)
+        {
+            if (i_check(object))
+                i_objects.push_back(object);
+        });
+        return;
+    }
+
+    for (PlayerMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
+        if (i_check(itr.GetSource()))
+            i_objects.push_back(itr.GetSource());
 }
 
 template<class Check>
@@ -260,9 +286,19 @@ void Acore::WorldObjectListSearcher<Check>::Visit(CreatureMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CREATURE))
         return;
 
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->GetSource()))
-            i_objects.push_back(itr->GetSource());
+    if (i_useRange)
+    {
+        m.VisitSlotsInRange(i_range, [this](Creature* object)
+        {
+            if (i_check(object))
+                i_objects.push_back(object);
+        });
+        return;
+    }
+
+    for (CreatureMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
+        if (i_check(itr.GetSource()))
+            i_objects.push_back(itr.GetSource());
 }
 
 template<class Check>
@@ -271,9 +307,19 @@ void Acore::WorldObjectListSearcher<Check>::Visit(CorpseMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CORPSE))
         return;
 
-    for (CorpseMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->GetSource()))
-            i_objects.push_back(itr->GetSource());
+    if (i_useRange)
+    {
+        m.VisitSlotsInRange(i_range, [this](Corpse* object)
+        {
+            if (i_check(object))
+                i_objects.push_back(object);
+        });
+        return;
+    }
+
+    for (CorpseMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
+        if (i_check(itr.GetSource()))
+            i_objects.push_back(itr.GetSource());
 }
 
 template<class Check>
@@ -282,9 +328,9 @@ void Acore::WorldObjectListSearcher<Check>::Visit(GameObjectMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_GAMEOBJECT))
         return;
 
-    for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->GetSource()))
-            i_objects.push_back(itr->GetSource());
+    for (GameObjectMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
+        if (i_check(itr.GetSource()))
+            i_objects.push_back(itr.GetSource());
 }
 
 template<class Check>
@@ -293,9 +339,19 @@ void Acore::WorldObjectListSearcher<Check>::Visit(DynamicObjectMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_DYNAMICOBJECT))
         return;
 
-    for (DynamicObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->GetSource()))
-            i_objects.push_back(itr->GetSource());
+    if (i_useRange)
+    {
+        m.VisitSlotsInRange(i_range, [this](DynamicObject* object)
+        {
+            if (i_check(object))
+                i_objects.push_back(object);
+        });
+        return;
+    }
+
+    for (DynamicObjectMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
+        if (i_check(itr.GetSource()))
+            i_objects.push_back(itr.GetSource());
 }
 
 // Gameobject searchers
@@ -307,14 +363,14 @@ void Acore::GameObjectSearcher<Check>::Visit(GameObjectMapType& m)
     if (i_object)
         return;
 
-    for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (GameObjectMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
+        if (i_check(itr.GetSource()))
         {
-            i_object = itr->GetSource();
+            i_object = itr.GetSource();
             return;
         }
     }
@@ -323,23 +379,23 @@ void Acore::GameObjectSearcher<Check>::Visit(GameObjectMapType& m)
 template<class Check>
 void Acore::GameObjectLastSearcher<Check>::Visit(GameObjectMapType& m)
 {
-    for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (GameObjectMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
+        if (i_check(itr.GetSource()))
+            i_object = itr.GetSource();
     }
 }
 
 template<class Check>
 void Acore::GameObjectListSearcher<Check>::Visit(GameObjectMapType& m)
 {
-    for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->GetSource()))
-                i_objects.push_back(itr->GetSource());
+    for (GameObjectMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
+        if (itr.InSamePhase(i_phaseMask))
+            if (i_check(itr.GetSource()))
+                i_objects.push_back(itr.GetSource());
 }
 
 // Unit searchers
@@ -351,14 +407,14 @@ void Acore::UnitSearcher<Check>::Visit(CreatureMapType& m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (CreatureMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
+        if (i_check(itr.GetSource()))
         {
-            i_object = itr->GetSource();
+            i_object = itr.GetSource();
             return;
         }
     }
@@ -371,14 +427,14 @@ void Acore::UnitSearcher<Check>::Visit(PlayerMapType& m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (PlayerMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
+        if (i_check(itr.GetSource()))
         {
-            i_object = itr->GetSource();
+            i_object = itr.GetSource();
             return;
         }
     }
@@ -387,45 +443,65 @@ void Acore::UnitSearcher<Check>::Visit(PlayerMapType& m)
 template<class Check>
 void Acore::UnitLastSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    if (i_useRange)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        m.VisitSlotsInRange(i_range, [this](Creature* unit)
+        {
+            if (unit->InSamePhase(i_phaseMask) && i_check(unit))
+                i_object = unit;
+        });
+        return;
+    }
+
+    for (CreatureMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
+    {
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
+        if (i_check(itr.GetSource()))
+            i_object = itr.GetSource();
     }
 }
 
 template<class Check>
 void Acore::UnitLastSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    if (i_useRange)
+    {
+        m.VisitSlotsInRange(i_range, [this](Player* unit)
+        {
+            if (unit->InSamePhase(i_phaseMask) && i_check(unit))
+                i_object = unit;
+        });
+        return;
+    }
+
+    for (PlayerMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
+        if (i_check(itr.GetSource()))
+            i_object = itr.GetSource();
     }
 }
 
 template<class Check>
 void Acore::UnitListSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->GetSource()))
-                i_objects.push_back(itr->GetSource());
+    for (PlayerMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
+        if (itr.InSamePhase(i_phaseMask))
+            if (i_check(itr.GetSource()))
+                i_objects.push_back(itr.GetSource());
 }
 
 template<class Check>
 void Acore::UnitListSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->GetSource()))
-                i_objects.push_back(itr->GetSource());
+    for (CreatureMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
+        if (itr.InSamePhase(i_phaseMask))
+            if (i_check(itr.GetSource()))
+                i_objects.push_back(itr.GetSource());
 }
 
 // Creature searchers
@@ -437,14 +513,14 @@ void Acore::CreatureSearcher<Check>::Visit(CreatureMapType& m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (CreatureMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
+        if (i_check(itr.GetSource()))
         {
-            i_object = itr->GetSource();
+            i_object = itr.GetSource();
             return;
         }
     }
@@ -453,49 +529,59 @@ void Acore::CreatureSearcher<Check>::Visit(CreatureMapType& m)
 template<class Check>
 void Acore::CreatureLastSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (CreatureMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
+        if (i_check(itr.GetSource()))
+            i_object = itr.GetSource();
     }
 }
 
 template<class Check>
 void Acore::CreatureListSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->GetSource()))
-                i_objects.push_back(itr->GetSource());
+    if (i_useRange)
+    {
+        m.VisitSlotsInRange(i_range, [this](Creature* creature)
+        {
+            if (creature->InSamePhase(i_phaseMask) && i_check(creature))
+                i_objects.push_back(creature);
+        });
+        return;
+    }
+
+    for (CreatureMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
+        if (itr.InSamePhase(i_phaseMask))
+            if (i_check(itr.GetSource()))
+                i_objects.push_back(itr.GetSource());
 }
 
 template<class Check>
 void Acore::PlayerListSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->GetSource()))
-                i_objects.push_back(itr->GetSource());
+    for (PlayerMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
+        if (itr.InSamePhase(i_phaseMask))
+            if (i_check(itr.GetSource()))
+                i_objects.push_back(itr.GetSource());
 }
 
 template<class Check>
 void Acore::PlayerListSearcherWithSharedVision<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->GetSource(), true))
-                i_objects.push_back(itr->GetSource());
+    for (PlayerMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
+        if (itr.InSamePhase(i_phaseMask))
+            if (i_check(itr.GetSource(), true))
+                i_objects.push_back(itr.GetSource());
 }
 
 template<class Check>
 void Acore::PlayerListSearcherWithSharedVision<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask) && itr->GetSource()->HasSharedVision())
-            for (SharedVisionList::const_iterator i = itr->GetSource()->GetSharedVisionList().begin(); i != itr->GetSource()->GetSharedVisionList().end(); ++i)
+    for (CreatureMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
+        if (itr.InSamePhase(i_phaseMask) && itr.GetSource()->HasSharedVision())
+            for (SharedVisionList::const_iterator i = itr.GetSource()->GetSharedVisionList().begin(); i != itr.GetSource()->GetSharedVisionList().end(); ++i)
                 if (i_check(*i, false))
                     i_objects.push_back(*i);
 }
@@ -507,14 +593,14 @@ void Acore::PlayerSearcher<Check>::Visit(PlayerMapType& m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (PlayerMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
+        if (i_check(itr.GetSource()))
         {
-            i_object = itr->GetSource();
+            i_object = itr.GetSource();
             return;
         }
     }
@@ -523,13 +609,13 @@ void Acore::PlayerSearcher<Check>::Visit(PlayerMapType& m)
 template<class Check>
 void Acore::PlayerLastSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (PlayerMapType::slot_iterator itr = m.slot_begin(); itr != m.slot_end(); ++itr)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
+        if (!itr.InSamePhase(i_phaseMask))
             continue;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
+        if (i_check(itr.GetSource()))
+            i_object = itr.GetSource();
     }
 }
 
@@ -28,6 +28,8 @@
 #include "LFGMgr.h"
 #include "Map.h"
 #include "MapInstanced.h"
+#include "MapRegionUpdater.h"
+#include "MappedFile.h"
 #include "Object.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
@@ -37,11 +39,16 @@
 #include "Vehicle.h"
 #include "VMapFactory.h"
 #include "VMapMgr2.h"
+#include <algorithm>
 
 #ifdef ELUNA
 #include "LuaEngine.h"
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
 union u_map_magic
 {
     char asChar[4];
@@ -226,7 +233,8 @@ Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
     i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
     m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
     _instanceResetPeriod(0), m_activeNonPlayersIter(m_activeNonPlayers.end()),
-    _transportsUpdateIter(_transports.end()), i_scriptLock(false), _defaultLight(GetDefaultMapLight(id))
+    _transportsUpdateIter(_transports.end()), i_scriptLock(false), _defaultLight(GetDefaultMapLight(id)), _lastUpdateCost(0),
+    _regionGridSize(0), _collectRegionCells(false), _regionUpdate(false), _regionUpdateStats()
 {
     m_parentMap = (_parent ? _parent : this);
     for (unsigned int idx = 0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
@@ -456,6 +464,15 @@ void Map::EnsureGridCreated_i(const GridCoord& p)
 //Create NGrid and load the object data in it
 bool Map::EnsureGridLoaded(const Cell& cell)
 {
+    // grids are never loaded while several threads update the regions of this map, the loading spawns objects in
+    // every container of the map; defer it to the serial part of Map::Update instead
+    if (_regionUpdate && !IsGridLoaded(GridCoord(cell.GridX(), cell.GridY())))
+    {
+        auto guard = GetRegionGuard();
+        _deferredGridLoads.push_back(cell);
+        return false;
+    }
+
     EnsureGridCreated(GridCoord(cell.GridX(), cell.GridY()));
     NGridType* grid = getNGrid(cell.GridX(), cell.GridY());
 
@@ -677,6 +694,12 @@ void Map::VisitNearbyCellsOfPlayer(Player* player, TypeContainerVisitor<Acore::O
             CellCoord pair(x, y);
             Cell cell(pair);
 
+            if (_collectRegionCells)
+            {
+                CollectRegionCell(cell, false, true);
+                continue;
+            }
+
             Visit(cell, largeGridVisitor);
             Visit(cell, largeWorldVisitor);
         }
@@ -713,6 +736,16 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Acore::Objec
             Cell cell(pair);
             //cell.SetNoCreate(); // in mmaps this is missing
 
+            if (_collectRegionCells)
+            {
+                bool large = !isCellMarkedLarge(cell_id);
+                if (large)
+                    markCellLarge(cell_id);
+
+                CollectRegionCell(cell, true, large);
+                continue;
+            }
+
             Visit(cell, gridVisitor);
             Visit(cell, worldVisitor);
 
@@ -781,6 +814,11 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
     std::vector<Creature*> updateList;
     updateList.reserve(10);
 
+    // continents may only collect the active cells here and update them per region afterwards
+    _collectRegionCells = CanUpdateRegions();
+    if (_collectRegionCells)
+        InitRegionCells(sWorld->getIntConfig(CONFIG_MAPUPDATE_REGIONS_GRID_SIZE));
+
     // non-player active objects, increasing iterator in the loop in case of object removal
     for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
     {
@@ -840,6 +878,12 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
         }
     }
 
+    if (_collectRegionCells)
+    {
+        _collectRegionCells = false;
+        UpdateRegions(t_diff);
+    }
+
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();) // pussywizard: transports updated after VisitNearbyCellsOf, grids around are loaded, everything ok
     {
         MotionTransport* transport = *_transportsUpdateIter;
@@ -870,6 +914,278 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
     sScriptMgr->OnMapUpdate(this, t_diff);
 }
 
+bool Map::CanUpdateRegions() const
+{
+    return sMapRegionUpdater->IsActive() && !Instanceable() && i_mapEntry->IsContinent();
+}
+
+void Map::InitRegionCells(uint32 regionGridSize)
+{
+    _collectRegionCells = true;
+    _regionGridSize = regionGridSize;
+    _regionCells.resize(MapRegionUpdater::GetRegionCount(_regionGridSize));
+}
+
+void Map::CollectRegionCell(Cell const& cell, bool normal, bool large)
+{
+    // same as Visit() would do, grids can only be loaded before the parallel part
+    EnsureGridLoaded(cell);
+
+    uint32 regionId = MapRegionUpdater::GetRegionId(cell.GridX(), cell.GridY(), _regionGridSize);
+
+    RegionCell regionCell;
+    regionCell.Coord = cell.GetCellCoord();
+    regionCell.Normal = normal;
+    regionCell.Large = large;
+    _regionCells[regionId].push_back(regionCell);
+}
+
+void Map::UpdateRegions(uint32 t_diff)
+{
+    using namespace std::chrono;
+
+    MapRegionUpdateStats stats = { };
+    std::vector<uint32> regionTimes(_regionCells.size(), 0);
+    std::vector<uint32> regionIds;
+    std::vector<MapRegionUpdater::Task> tasks;
+    tasks.reserve(_regionCells.size());
+
+    steady_clock::time_point parallelStart = steady_clock::now();
+
+    _regionUpdate = true;
+
+    // regions with the same color are never neighbours, objects near a region border may freely
+    // interact with the objects of the neighbour region as it is not updated at the same time
+    for (uint32 color = 0; color < MapRegionUpdater::REGION_COLORS; ++color)
+    {
+        tasks.clear();
+
+        MapRegionUpdater::GetRegionsOfColor(color, _regionGridSize, regionIds);
+        for (uint32 regionId : regionIds)
+        {
+            std::vector<RegionCell> const& cells = _regionCells[regionId];
+            if (cells.empty())
+                continue;
+
+            ++stats.ActiveRegions;
+            stats.ActiveCells += cells.size();
+
+            uint32* regionTime = &regionTimes[regionId];
+            tasks.emplace_back([this, &cells, regionTime, t_diff]()
+            {
+                steady_clock::time_point regionStart = steady_clock::now();
+                UpdateRegion(cells, t_diff);
+                *regionTime = uint32(duration_cast<microseconds>(steady_clock::now() - regionStart).count());
+            });
+        }
+
+        sMapRegionUpdater->Execute(tasks);
+    }
+
+    _regionUpdate = false;
+
+    stats.ParallelTime = uint32(duration_cast<microseconds>(steady_clock::now() - parallelStart).count());
+
+    for (std::vector<RegionCell>& cells : _regionCells)
+        cells.clear();
+
+    for (uint32 regionTime : regionTimes)
+    {
+        stats.TotalRegionTime += regionTime;
+        stats.SlowestRegionTime = std::max(stats.SlowestRegionTime, regionTime);
+    }
+
+    // grids entered during the parallel part, the move lists can now relocate objects into them
+    for (Cell const& cell : _deferredGridLoads)
+        EnsureGridLoaded(cell);
+
+    _deferredGridLoads.clear();
+
+    // in the order the regions queued them, a task may queue another one which then runs right away
+    std::vector<std::function<void()>> deferredTasks;
+    deferredTasks.swap(_deferredRegionTasks);
+    for (std::function<void()>& task : deferredTasks)
+        task();
+
+    std::lock_guard<std::mutex> guard(_regionUpdateStatsLock);
+    _regionUpdateStats = stats;
+}
+
+void Map::RunOnMapThread(std::function<void()>&& task)
+{
+    if (!_regionUpdate)
+    {
+        task();
+        return;
+    }
+
+    auto guard = GetRegionGuard();
+    _deferredRegionTasks.push_back(std::move(task));
+}
+
+namespace
+{
+    // region guards the current thread holds, on one map at a time
+    struct RegionGuardDepth
+    {
+        Map const* Owner = nullptr;
+        uint32 Exclusive = 0;
+        uint32 Read = 0;
+        uint32 Write = 0;
+    };
+
+    thread_local RegionGuardDepth RegionGuards;
+}
+
+bool Map::LockRegion(RegionGuardMode mode) const
+{
+    if (!_regionUpdate)
+        return false;
+
+    RegionGuardDepth& depth = RegionGuards;
+    if (!depth.Owner)
+        depth.Owner = this;
+
+    // guards of another map are held, this one cannot be nested in them
+    if (depth.Owner != this)
+    {
+        switch (mode)
+        {
+            case REGION_GUARD_EXCLUSIVE:
+                _regionLock.lock();
+                break;
+            case REGION_GUARD_READ:
+                _regionSharedLock.lock_shared();
+                break;
+            case REGION_GUARD_WRITE:
+                _regionSharedLock.lock();
+                break;
+        }
+
+        return true;
+    }
+
+    switch (mode)
+    {
+        case REGION_GUARD_EXCLUSIVE:
+            if (!depth.Exclusive++)
+                _regionLock.lock();
+            break;
+        case REGION_GUARD_READ:
+            // a write guard already excludes every other thread
+            if (!depth.Read++ && !depth.Write)
+                _regionSharedLock.lock_shared();
+            break;
+        case REGION_GUARD_WRITE:
+            // a shared lock cannot be upgraded
+            ASSERT(!depth.Read || depth.Write);
+            if (!depth.Write++)
+                _regionSharedLock.lock();
+            break;
+    }
+
+    return true;
+}
+
+void Map::UnlockRegion(RegionGuardMode mode) const
+{
+    RegionGuardDepth& depth = RegionGuards;
+    if (depth.Owner != this)
+    {
+        switch (mode)
+        {
+            case REGION_GUARD_EXCLUSIVE:
+                _regionLock.unlock();
+                break;
+            case REGION_GUARD_READ:
+                _regionSharedLock.unlock_shared();
+                break;
+            case REGION_GUARD_WRITE:
+                _regionSharedLock.unlock();
+                break;
+        }
+
+        return;
+    }
+
+    switch (mode)
+    {
+        case REGION_GUARD_EXCLUSIVE:
+            if (!--depth.Exclusive)
+                _regionLock.unlock();
+            break;
+        case REGION_GUARD_READ:
+            if (!--depth.Read && !depth.Write)
+                _regionSharedLock.unlock_shared();
+            break;
+        case REGION_GUARD_WRITE:
+            // read guards nested in it are released already
+            if (!--depth.Write)
+                _regionSharedLock.unlock();
+            break;
+    }
+
+    if (!depth.Exclusive && !depth.Read && !depth.Write)
+        depth.Owner = nullptr;
+}
+
+void Map::UpdateRegion(std::vector<RegionCell> const& cells, uint32 t_diff)
+{
+    Acore::ObjectUpdater updater(t_diff, false);
+    TypeContainerVisitor<Acore::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+    TypeContainerVisitor<Acore::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+
+    Acore::ObjectUpdater largeObjectUpdater(t_diff, true);
+    TypeContainerVisitor<Acore::ObjectUpdater, GridTypeMapContainer  > grid_large_object_update(largeObjectUpdater);
+    TypeContainerVisitor<Acore::ObjectUpdater, WorldTypeMapContainer  > world_large_object_update(largeObjectUpdater);
+
+    for (RegionCell const& regionCell : cells)
+    {
+        Cell cell(regionCell.Coord);
+
+        if (regionCell.Normal)
+        {
+            Visit(cell, grid_object_update);
+            Visit(cell, world_object_update);
+        }
+
+        if (regionCell.Large)
+        {
+            Visit(cell, grid_large_object_update);
+            Visit(cell, world_large_object_update);
+        }
+    }
+}
+
+MapRegionUpdateStats Map::GetRegionUpdateStats() const
+{
+    std::lock_guard<std::mutex> guard(_regionUpdateStatsLock);
+    return _regionUpdateStats;
+}
+
+void Map::AddUpdateBlockCacheStats(uint64 hits, uint64 misses, uint64 bytesSaved)
+{
+    _updateBlockCacheStats.Hits.fetch_add(hits, std::memory_order_relaxed);
+    _updateBlockCacheStats.Misses.fetch_add(misses, std::memory_order_relaxed);
+    _updateBlockCacheStats.BytesSaved.fetch_add(bytesSaved, std::memory_order_relaxed);
+}
+
+MapUpdateBlockCacheStats Map::GetUpdateBlockCacheStats() const
+{
+    MapUpdateBlockCacheStats stats;
+    stats.Hits = _updateBlockCacheStats.Hits.load(std::memory_order_relaxed);
+    stats.Misses = _updateBlockCacheStats.Misses.load(std::memory_order_relaxed);
+    stats.BytesSaved = _updateBlockCacheStats.BytesSaved.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void Map::ResetUpdateBlockCacheStats()
+{
+    _updateBlockCacheStats.Hits = 0;
+    _updateBlockCacheStats.Misses = 0;
+    _updateBlockCacheStats.BytesSaved = 0;
+}
+
 void Map::HandleDelayedVisibility()
 {
     if (i_objectsForDelayedVisibility.empty())
@@ -1068,7 +1384,10 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
 void Map::AddCreatureToMoveList(Creature* c)
 {
     if (c->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
+    {
+        auto guard = GetRegionGuard();
         _creaturesToMove.push_back(c);
+    }
     c->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
 }
 
@@ -1081,7 +1400,10 @@ void Map::RemoveCreatureFromMoveList(Creature* c)
 void Map::AddGameObjectToMoveList(GameObject* go)
 {
     if (go->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
+    {
+        auto guard = GetRegionGuard();
         _gameObjectsToMove.push_back(go);
+    }
     go->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
 }
 
@@ -1094,7 +1416,10 @@ void Map::RemoveGameObjectFromMoveList(GameObject* go)
 void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj)
 {
     if (dynObj->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
+    {
+        auto guard = GetRegionGuard();
         _dynamicObjectsToMove.push_back(dynObj);
+    }
     dynObj->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
 }
 
@@ -1333,22 +1658,106 @@ GridMap::~GridMap()
     unloadData();
 }
 
+/*
+ * Source of the sections of a .map file. Arrays are either read in new[] buffers or point
+ * directly into the memory mapping of the file, unless they aren't aligned for their type in
+ * the file, those are copied.
+ */
+class GridMapFileReader
+{
+public:
+    explicit GridMapFileReader(FILE* file) : _file(file), _mapping(nullptr), _offset(0) { }
+    explicit GridMapFileReader(MappedFile const* mapping) : _file(nullptr), _mapping(mapping), _offset(0) { }
+
+    bool Seek(uint32 offset)
+    {
+        if (_file)
+            return fseek(_file, offset, SEEK_SET) == 0;
+
+        _offset = offset;
+        return _offset <= _mapping->GetSize();
+    }
+
+    template<class T>
+    bool Read(T& value)
+    {
+        if (_file)
+            return fread(&value, sizeof(T), 1, _file) == 1;
+
+        if (!HasRemaining(sizeof(T)))
+            return false;
+
+        memcpy(&value, _mapping->GetData() + _offset, sizeof(T));
+        _offset += sizeof(T);
+        return true;
+    }
+
+    template<class T>
+    bool ReadArray(T*& data, uint32 count)
+    {
+        if (_file)
+        {
+            data = new T[count];
+            return fread(data, sizeof(T), count, _file) == count;
+        }
+
+        if (!HasRemaining(std::size_t(count) * sizeof(T)))
+            return false;
+
+        uint8 const* source = _mapping->GetData() + _offset;
+        _offset += count * sizeof(T);
+
+        if (reinterpret_cast<std::uintptr_t>(source) % alignof(T))
+        {
+            data = new T[count];
+            memcpy(data, source, std::size_t(count) * sizeof(T));
+            return true;
+        }
+
+        // the mapping is read-only, GridMap never writes to its arrays once loaded
+        data = const_cast<T*>(reinterpret_cast<T const*>(source));
+        return true;
+    }
+
+private:
+    bool HasRemaining(std::size_t size) const { return _offset <= _mapping->GetSize() && size <= _mapping->GetSize() - _offset; }
+
+    FILE* _file;
+    MappedFile const* _mapping;
+    std::size_t _offset;
+};
+
 bool GridMap::loadData(char* filename)
 {
     // Unload old data if exist
     unloadData();
 
-    map_fileheader header;
+    // falls back to reading the file if it can't be mapped
+    if (sWorld->getBoolConfig(CONFIG_MEMORY_MAPPED_MAP_FILES))
+        _mappedFile = MappedFile::Open(filename);
+
+    if (_mappedFile)
+    {
+        GridMapFileReader in(_mappedFile.get());
+        return loadSections(in, filename);
+    }
+
     // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
+    FILE* file = fopen(filename, "rb");
+    if (!file)
         return true;
 
-    if (fread(&header, sizeof(header), 1, in) != 1)
-    {
-        fclose(in);
+    GridMapFileReader in(file);
+    bool result = loadSections(in, filename);
+    fclose(file);
+    return result;
+}
+
+bool GridMap::loadSections(GridMapFileReader& in, char const* filename)
+{
+    map_fileheader header;
+    if (!in.Read(header))
         return false;
-    }
 
     if (header.mapMagic == MapMagic.asUInt && header.versionMagic == MapVersionMagic)
     {
@@ -1356,85 +1765,82 @@ bool GridMap::loadData(char* filename)
         if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
         {
             LOG_ERROR("maps", "Error loading map area data\n");
-            fclose(in);
             return false;
         }
         // loadup height data
         if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
         {
             LOG_ERROR("maps", "Error loading map height data\n");
-            fclose(in);
             return false;
         }
         // loadup liquid data
         if (header.liquidMapOffset && !loadLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
         {
             LOG_ERROR("maps", "Error loading map liquids data\n");
-            fclose(in);
             return false;
         }
         // loadup holes data (if any. check header.holesOffset)
         if (header.holesSize && !loadHolesData(in, header.holesOffset, header.holesSize))
         {
             LOG_ERROR("maps", "Error loading map holes data\n");
-            fclose(in);
             return false;
         }
-        fclose(in);
         return true;
     }
     LOG_ERROR("maps", "Map file '%s' is from an incompatible clientversion. Please recreate using the mapextractor.", filename);
-    fclose(in);
     return false;
 }
 
+template<class T>
+void GridMap::releaseArray(T*& data)
+{
+    // arrays pointing into the mapping are released with it
+    if (!_mappedFile || !_mappedFile->Contains(data))
+        delete[] data;
+
+    data = nullptr;
+}
+
 void GridMap::unloadData()
 {
-    delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] _maxHeight;
-    delete[] _minHeight;
-    delete[] _liquidEntry;
-    delete[] _liquidFlags;
-    delete[] _liquidMap;
-    delete[] _holes;
-    _areaMap = nullptr;
-    m_V9 = nullptr;
-    m_V8 = nullptr;
-    _maxHeight = nullptr;
-    _minHeight = nullptr;
-    _liquidEntry = nullptr;
-    _liquidFlags = nullptr;
-    _liquidMap  = nullptr;
-    _holes = nullptr;
+    releaseArray(_areaMap);
+    releaseArray(m_V9);
+    releaseArray(m_V8);
+    releaseArray(_maxHeight);
+    releaseArray(_minHeight);
+    releaseArray(_liquidEntry);
+    releaseArray(_liquidFlags);
+    releaseArray(_liquidMap);
+    releaseArray(_holes);
+    _mappedFile.reset();
     _gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadAreaData(GridMapFileReader& in, uint32 offset, uint32 /*size*/)
 {
     map_areaHeader header;
-    fseek(in, offset, SEEK_SET);
+    if (!in.Seek(offset))
+        return false;
 
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapAreaMagic.asUInt)
+    if (!in.Read(header) || header.fourcc != MapAreaMagic.asUInt)
         return false;
 
     _gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        _areaMap = new uint16 [16 * 16];
-        if (fread(_areaMap, sizeof(uint16), 16 * 16, in) != 16 * 16)
+        if (!in.ReadArray(_areaMap, 16 * 16))
             return false;
     }
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(GridMapFileReader& in, uint32 offset, uint32 /*size*/)
 {
     map_heightHeader header;
-    fseek(in, offset, SEEK_SET);
+    if (!in.Seek(offset))
+        return false;
 
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapHeightMagic.asUInt)
+    if (!in.Read(header) || header.fourcc != MapHeightMagic.asUInt)
         return false;
 
     _gridHeight = header.gridHeight;
@@ -1442,30 +1848,24 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129 * 129];
-            m_uint16_V8 = new uint16 [128 * 128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129 * 129, in) != 129 * 129 ||
-                    fread(m_uint16_V8, sizeof(uint16), 128 * 128, in) != 128 * 128)
+            if (!in.ReadArray(m_uint16_V9, 129 * 129) ||
+                    !in.ReadArray(m_uint16_V8, 128 * 128))
                 return false;
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             _gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129 * 129];
-            m_uint8_V8 = new uint8 [128 * 128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129 * 129, in) != 129 * 129 ||
-                    fread(m_uint8_V8, sizeof(uint8), 128 * 128, in) != 128 * 128)
+            if (!in.ReadArray(m_uint8_V9, 129 * 129) ||
+                    !in.ReadArray(m_uint8_V8, 128 * 128))
                 return false;
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             _gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129 * 129];
-            m_V8 = new float [128 * 128];
-            if (fread(m_V9, sizeof(float), 129 * 129, in) != 129 * 129 ||
-                    fread(m_V8, sizeof(float), 128 * 128, in) != 128 * 128)
+            if (!in.ReadArray(m_V9, 129 * 129) ||
+                    !in.ReadArray(m_V8, 128 * 128))
                 return false;
             _gridGetHeight = &GridMap::getHeightFromFloat;
         }
@@ -1475,22 +1875,21 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (header.flags & MAP_HEIGHT_HAS_FLIGHT_BOUNDS)
     {
-        _maxHeight = new int16[3 * 3];
-        _minHeight = new int16[3 * 3];
-        if (fread(_maxHeight, sizeof(int16), 3 * 3, in) != 3 * 3 ||
-                fread(_minHeight, sizeof(int16), 3 * 3, in) != 3 * 3)
+        if (!in.ReadArray(_maxHeight, 3 * 3) ||
+                !in.ReadArray(_minHeight, 3 * 3))
             return false;
     }
 
     return true;
 }
 
-bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadLiquidData(GridMapFileReader& in, uint32 offset, uint32 /*size*/)
 {
     map_liquidHeader header;
-    fseek(in, offset, SEEK_SET);
+    if (!in.Seek(offset))
+        return false;
 
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapLiquidMagic.asUInt)
+    if (!in.Read(header) || header.fourcc != MapLiquidMagic.asUInt)
         return false;
 
     _liquidType   = header.liquidType;
@@ -1502,30 +1901,26 @@ bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        _liquidEntry = new uint16[16 * 16];
-        if (fread(_liquidEntry, sizeof(uint16), 16 * 16, in) != 16 * 16)
+        if (!in.ReadArray(_liquidEntry, 16 * 16))
             return false;
 
-        _liquidFlags = new uint8[16 * 16];
-        if (fread(_liquidFlags, sizeof(uint8), 16 * 16, in) != 16 * 16)
+        if (!in.ReadArray(_liquidFlags, 16 * 16))
             return false;
     }
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        _liquidMap = new float[uint32(_liquidWidth) * uint32(_liquidHeight)];
-        if (fread(_liquidMap, sizeof(float), _liquidWidth * _liquidHeight, in) != (uint32(_liquidWidth) * uint32(_liquidHeight)))
+        if (!in.ReadArray(_liquidMap, uint32(_liquidWidth) * uint32(_liquidHeight)))
             return false;
     }
     return true;
 }
 
-bool GridMap::loadHolesData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHolesData(GridMapFileReader& in, uint32 offset, uint32 /*size*/)
 {
-    if (fseek(in, offset, SEEK_SET) != 0)
+    if (!in.Seek(offset))
         return false;
 
-    _holes = new uint16[16 * 16];
-    if (fread(_holes, sizeof(uint16), 16 * 16, in) != 16 * 16)
+    if (!in.ReadArray(_holes, 16 * 16))
         return false;
 
     return true;
@@ -1773,6 +2168,144 @@ float GridMap::getHeightFromUint16(float x, float y) const
     return (float)((a * x) + (b * y) + c) * _gridIntHeightMultiplier + _gridHeight;
 }
 
+namespace
+{
+    // points interpolated at once by GridMap::getHeights
+    constexpr uint32 GridHeightBatch = 32;
+
+    /*
+     * Height of every point on its triangle of the cell, see GridMap::getHeightFromFloat.
+     * h1-h4 are the corners of the cell, h5 its doubled center and x, y the offsets of the points in it.
+     */
+    void InterpolateGridHeights(float const* x, float const* y, float const* h1, float const* h2, float const* h3, float const* h4,
+        float const* h5, float multiplier, float offset, float* heights, uint32 count)
+    {
+        uint32 i = 0;
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        __m128 const one = _mm_set1_ps(1.0f);
+        __m128 const mult = _mm_set1_ps(multiplier);
+        __m128 const add = _mm_set1_ps(offset);
+
+        auto select = [](__m128 mask, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); };
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 px = _mm_loadu_ps(x + i);
+            __m128 py = _mm_loadu_ps(y + i);
+            __m128 v1 = _mm_loadu_ps(h1 + i);
+            __m128 v2 = _mm_loadu_ps(h2 + i);
+            __m128 v3 = _mm_loadu_ps(h3 + i);
+            __m128 v4 = _mm_loadu_ps(h4 + i);
+            __m128 v5 = _mm_loadu_ps(h5 + i);
+
+            __m128 upper = _mm_cmplt_ps(_mm_add_ps(px, py), one);   // triangles 1 and 2
+            __m128 right = _mm_cmpgt_ps(px, py);                     // triangles 1 and 3
+
+            __m128 a = select(upper,
+                select(right, _mm_sub_ps(v2, v1), _mm_sub_ps(_mm_sub_ps(v5, v1), v3)),
+                select(right, _mm_sub_ps(_mm_add_ps(v2, v4), v5), _mm_sub_ps(v4, v3)));
+            __m128 b = select(upper,
+                select(right, _mm_sub_ps(_mm_sub_ps(v5, v1), v2), _mm_sub_ps(v3, v1)),
+                select(right, _mm_sub_ps(v4, v2), _mm_sub_ps(_mm_add_ps(v3, v4), v5)));
+            __m128 c = select(upper, v1, _mm_sub_ps(v5, v4));
+
+            __m128 height = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, px), _mm_mul_ps(b, py)), c);
+            _mm_storeu_ps(heights + i, _mm_add_ps(_mm_mul_ps(height, mult), add));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            float a, b, c;
+            if (x[i] + y[i] < 1)
+            {
+                if (x[i] > y[i])
+                {
+                    a = h2[i] - h1[i];
+                    b = h5[i] - h1[i] - h2[i];
+                }
+                else
+                {
+                    a = h5[i] - h1[i] - h3[i];
+                    b = h3[i] - h1[i];
+                }
+                c = h1[i];
+            }
+            else
+            {
+                if (x[i] > y[i])
+                {
+                    a = h2[i] + h4[i] - h5[i];
+                    b = h4[i] - h2[i];
+                }
+                else
+                {
+                    a = h4[i] - h3[i];
+                    b = h3[i] + h4[i] - h5[i];
+                }
+                c = h5[i] - h4[i];
+            }
+
+            heights[i] = (a * x[i] + b * y[i] + c) * multiplier + offset;
+        }
+    }
+}
+
+template<class T>
+void GridMap::getHeightsFrom(T const* v9, T const* v8, G3D::Vector3 const* points, float* heights, uint32 count, float multiplier, float offset) const
+{
+    float x[GridHeightBatch], y[GridHeightBatch];
+    float h1[GridHeightBatch], h2[GridHeightBatch], h3[GridHeightBatch], h4[GridHeightBatch], h5[GridHeightBatch];
+    bool hole[GridHeightBatch];
+
+    for (uint32 begin = 0; begin < count; begin += GridHeightBatch)
+    {
+        uint32 batch = std::min(count - begin, GridHeightBatch);
+
+        // gather the cell of every point, the lookups can't be vectorised
+        for (uint32 i = 0; i < batch; ++i)
+        {
+            float px = MAP_RESOLUTION * (32 - points[begin + i].x / SIZE_OF_GRIDS);
+            float py = MAP_RESOLUTION * (32 - points[begin + i].y / SIZE_OF_GRIDS);
+
+            int x_int = (int)px;
+            int y_int = (int)py;
+            x[i] = px - x_int;
+            y[i] = py - y_int;
+            x_int &= (MAP_RESOLUTION - 1);
+            y_int &= (MAP_RESOLUTION - 1);
+
+            hole[i] = isHole(x_int, y_int);
+
+            T const* v9_h1 = &v9[x_int * 129 + y_int];
+            h1[i] = float(v9_h1[0]);
+            h2[i] = float(v9_h1[129]);
+            h3[i] = float(v9_h1[1]);
+            h4[i] = float(v9_h1[130]);
+            h5[i] = 2 * float(v8[x_int * 128 + y_int]);
+        }
+
+        InterpolateGridHeights(x, y, h1, h2, h3, h4, h5, multiplier, offset, heights + begin, batch);
+
+        for (uint32 i = 0; i < batch; ++i)
+            if (hole[i])
+                heights[begin + i] = INVALID_HEIGHT;
+    }
+}
+
+void GridMap::getHeights(G3D::Vector3 const* points, float* heights, uint32 count) const
+{
+    if (_gridGetHeight == &GridMap::getHeightFromFloat && m_V9 && m_V8)
+        getHeightsFrom(m_V9, m_V8, points, heights, count, 1.0f, 0.0f);
+    else if (_gridGetHeight == &GridMap::getHeightFromUint16 && m_uint16_V9 && m_uint16_V8)
+        getHeightsFrom(m_uint16_V9, m_uint16_V8, points, heights, count, _gridIntHeightMultiplier, _gridHeight);
+    else if (_gridGetHeight == &GridMap::getHeightFromUint8 && m_uint8_V9 && m_uint8_V8)
+        getHeightsFrom(m_uint8_V9, m_uint8_V8, points, heights, count, _gridIntHeightMultiplier, _gridHeight);
+    else
+        std::fill(heights, heights + count, _gridHeight);
+}
+
 bool GridMap::isHole(int row, int col) const
 {
     if (!_holes)
@@ -2022,21 +2555,14 @@ Transport* Map::GetTransportForPos(uint32 phase, float x, float y, float z, Worl
     return nullptr;
 }
 
-float Map::GetHeight(float x, float y, float z, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
+// picks the floor under z between the .map surface and the vmap floor
+static float SelectFloorHeight(float z, float gridHeight, float vmapHeight)
 {
     // find raw .map surface under Z coordinates
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;
-    float gridHeight = GetGridHeight(x, y);
     if (G3D::fuzzyGe(z, gridHeight - GROUND_HEIGHT_TOLERANCE))
         mapHeight = gridHeight;
 
-    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;
-    if (checkVMap)
-    {
-        VMAP::IVMapMgr* vmgr = VMAP::VMapFactory::createOrGetVMapMgr();
-        vmapHeight = vmgr->getHeight(GetId(), x, y, z, maxSearchDist);   // look from a bit higher pos to find the floor
-    }
-
     // mapHeight set for any above raw ground Z or <= INVALID_HEIGHT
     // vmapheight set for any under Z value or <= INVALID_HEIGHT
     if (vmapHeight > INVALID_HEIGHT)
@@ -2059,6 +2585,20 @@ float Map::GetHeight(float x, float y, float z, bool checkVMap /*= true*/, float
     return mapHeight;                               // explicitly use map data
 }
 
+float Map::GetHeight(float x, float y, float z, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
+{
+    float gridHeight = GetGridHeight(x, y);
+
+    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;
+    if (checkVMap)
+    {
+        VMAP::IVMapMgr* vmgr = VMAP::VMapFactory::createOrGetVMapMgr();
+        vmapHeight = vmgr->getHeight(GetId(), x, y, z, maxSearchDist);   // look from a bit higher pos to find the floor
+    }
+
+    return SelectFloorHeight(z, gridHeight, vmapHeight);
+}
+
 float Map::GetGridHeight(float x, float y) const
 {
     if (GridMap* gmap = const_cast<Map*>(this)->GetGrid(x, y))
@@ -2067,6 +2607,54 @@ float Map::GetGridHeight(float x, float y) const
     return VMAP_INVALID_HEIGHT_VALUE;
 }
 
+void Map::GetGridHeights(G3D::Vector3 const* points, float* heights, uint32 count) const
+{
+    // query every run of points sharing a grid at once
+    uint32 begin = 0;
+    while (begin < count)
+    {
+        int gx = (int)(32 - points[begin].x / SIZE_OF_GRIDS);
+        int gy = (int)(32 - points[begin].y / SIZE_OF_GRIDS);
+
+        uint32 end = begin + 1;
+        while (end < count && (int)(32 - points[end].x / SIZE_OF_GRIDS) == gx && (int)(32 - points[end].y / SIZE_OF_GRIDS) == gy)
+            ++end;
+
+        if (GridMap* gmap = const_cast<Map*>(this)->GetGrid(points[begin].x, points[begin].y))
+            gmap->getHeights(points + begin, heights + begin, end - begin);
+        else
+            std::fill(heights + begin, heights + end, VMAP_INVALID_HEIGHT_VALUE);
+
+        begin = end;
+    }
+}
+
+void Map::GetHeights(uint32 phasemask, G3D::Vector3 const* points, float* heights, uint32 count, bool vmap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
+{
+    GetGridHeights(points, heights, count);
+
+    VMAP::IVMapMgr* vmgr = VMAP::VMapFactory::createOrGetVMapMgr();
+
+    // vmap heights of the points are kept on the stack, big batches are split
+    float vmapHeights[MAP_HEIGHTS_BATCH];
+    for (uint32 begin = 0; begin < count; begin += MAP_HEIGHTS_BATCH)
+    {
+        uint32 batch = std::min<uint32>(count - begin, MAP_HEIGHTS_BATCH);
+        if (vmap)
+            vmgr->getHeights(GetId(), points + begin, vmapHeights, batch, maxSearchDist);
+        else
+            std::fill(vmapHeights, vmapHeights + batch, VMAP_INVALID_HEIGHT_VALUE);
+
+        auto guard = GetRegionReadGuard();
+        for (uint32 i = 0; i < batch; ++i)
+        {
+            G3D::Vector3 const& point = points[begin + i];
+            float floor = SelectFloorHeight(point.z, heights[begin + i], vmapHeights[i]);
+            heights[begin + i] = std::max<float>(floor, _dynamicTree.getHeight(point.x, point.y, point.z, maxSearchDist, phasemask));
+        }
+    }
+}
+
 float Map::GetMinHeight(float x, float y) const
 {
     if (GridMap const* grid = const_cast<Map*>(this)->GetGrid(x, y))
@@ -2096,7 +2684,11 @@ bool Map::GetAreaInfo(uint32 phaseMask, float x, float y, float z, uint32& flags
     int32 dgroupId;
 
     bool hasVmapAreaInfo = vmgr->GetAreaInfo(GetId(), x, y, vmap_z, vflags, vadtId, vrootId, vgroupId);
-    bool hasDynamicAreaInfo = _dynamicTree.GetAreaInfo(x, y, dynamic_z, phaseMask, dflags, dadtId, drootId, dgroupId);
+    bool hasDynamicAreaInfo;
+    {
+        auto guard = GetRegionReadGuard();
+        hasDynamicAreaInfo = _dynamicTree.GetAreaInfo(x, y, dynamic_z, phaseMask, dflags, dadtId, drootId, dgroupId);
+    }
     auto useVmap = [&]() { check_z = vmap_z; flags = vflags; adtId = vadtId; rootId = vrootId; groupId = vgroupId; };
     auto useDyn = [&]() { check_z = dynamic_z; flags = dflags; adtId = dadtId; rootId = drootId; groupId = dgroupId; };
 
@@ -2425,18 +3017,38 @@ bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, floa
     if ((checks & LINEOFSIGHT_CHECK_VMAP) && !VMAP::VMapFactory::createOrGetVMapMgr()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2))
         return false;
 
-    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT)
-            && !_dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask))
-        return false;
+    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT))
+    {
+        auto guard = GetRegionReadGuard();
+        if (!_dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask))
+            return false;
+    }
     return true;
 }
 
+void Map::AreInLineOfSight(G3D::Vector3 const* starts, G3D::Vector3 const* ends, bool* results, uint32 count, uint32 phasemask, LineOfSightChecks checks) const
+{
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+        VMAP::VMapFactory::createOrGetVMapMgr()->isInLineOfSight(GetId(), starts, ends, results, count);
+    else
+        std::fill(results, results + count, true);
+
+    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT))
+    {
+        auto guard = GetRegionReadGuard();
+        for (uint32 i = 0; i < count; ++i)
+            if (results[i] && !_dynamicTree.isInLineOfSight(starts[i].x, starts[i].y, starts[i].z, ends[i].x, ends[i].y, ends[i].z, phasemask))
+                results[i] = false;
+    }
+}
+
 bool Map::GetObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
 {
     G3D::Vector3 startPos(x1, y1, z1);
     G3D::Vector3 dstPos(x2, y2, z2);
 
     G3D::Vector3 resultPos;
+    auto guard = GetRegionReadGuard();
     bool result = _dynamicTree.GetObjectHitPos(phasemask, startPos, dstPos, resultPos, modifyDist);
 
     rx = resultPos.x;
@@ -2449,7 +3061,7 @@ float Map::GetHeight(uint32 phasemask, float x, float y, float z, bool vmap/*=tr
 {
     float h1, h2;
     h1 = GetHeight(x, y, z, vmap, maxSearchDist);
-    h2 = _dynamicTree.getHeight(x, y, z, maxSearchDist, phasemask);
+    h2 = GetGameObjectFloor(phasemask, x, y, z, maxSearchDist);
     return std::max<float>(h1, h2);
 }
 
@@ -2599,6 +3211,7 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
 
+    auto guard = GetRegionGuard();
     i_objectsToRemove.insert(obj);
     //LOG_DEBUG("maps", "Object (%s) added to removing list.", obj->GetGUID().ToString().c_str());
 }
@@ -2611,6 +3224,7 @@ void Map::AddObjectToSwitchList(WorldObject* obj, bool on)
     if (obj->GetTypeId() != TYPEID_UNIT && obj->GetTypeId() != TYPEID_GAMEOBJECT)
         return;
 
+    auto guard = GetRegionGuard();
     std::map<WorldObject*, bool>::iterator itr = i_objectsToSwitch.find(obj);
     if (itr == i_objectsToSwitch.end())
         i_objectsToSwitch.insert(itr, std::make_pair(obj, on));
@@ -3238,21 +3852,25 @@ void BattlegroundMap::RemoveAllPlayers()
 
 Corpse* Map::GetCorpse(ObjectGuid const guid)
 {
+    auto guard = GetRegionReadGuard();
     return _objectsStore.Find<Corpse>(guid);
 }
 
 Creature* Map::GetCreature(ObjectGuid const guid)
 {
+    auto guard = GetRegionReadGuard();
     return _objectsStore.Find<Creature>(guid);
 }
 
 GameObject* Map::GetGameObject(ObjectGuid const guid)
 {
+    auto guard = GetRegionReadGuard();
     return _objectsStore.Find<GameObject>(guid);
 }
 
 Pet* Map::GetPet(ObjectGuid const guid)
 {
+    auto guard = GetRegionReadGuard();
     return _objectsStore.Find<Pet>(guid);
 }
 
@@ -3267,6 +3885,7 @@ Transport* Map::GetTransport(ObjectGuid guid)
 
 DynamicObject* Map::GetDynamicObject(ObjectGuid guid)
 {
+    auto guard = GetRegionReadGuard();
     return _objectsStore.Find<DynamicObject>(guid);
 }
 
@@ -3289,7 +3908,10 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _creatureRespawnTimes[spawnId] = respawnTime;
+    {
+        auto guard = GetRegionGuard();
+        _creatureRespawnTimes[spawnId] = respawnTime;
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CREATURE_RESPAWN);
     stmt->setUInt32(0, spawnId);
@@ -3301,7 +3923,10 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
 
 void Map::RemoveCreatureRespawnTime(ObjectGuid::LowType spawnId)
 {
-    _creatureRespawnTimes.erase(spawnId);
+    {
+        auto guard = GetRegionGuard();
+        _creatureRespawnTimes.erase(spawnId);
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN);
     stmt->setUInt32(0, spawnId);
@@ -3323,7 +3948,10 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _goRespawnTimes[spawnId] = respawnTime;
+    {
+        auto guard = GetRegionGuard();
+        _goRespawnTimes[spawnId] = respawnTime;
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_GO_RESPAWN);
     stmt->setUInt32(0, spawnId);
@@ -3335,7 +3963,10 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
 
 void Map::RemoveGORespawnTime(ObjectGuid::LowType spawnId)
 {
-    _goRespawnTimes.erase(spawnId);
+    {
+        auto guard = GetRegionGuard();
+        _goRespawnTimes.erase(spawnId);
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN);
     stmt->setUInt32(0, spawnId);
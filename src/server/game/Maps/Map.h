@@ -32,7 +32,9 @@
 #include "PathGenerator.h"
 #include "SharedDefines.h"
 #include "Timer.h"
+#include <atomic>
 #include <bitset>
+#include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -58,6 +60,8 @@ class BattlegroundMap;
 class Transport;
 class StaticTransport;
 class MotionTransport;
+class MappedFile;
+class GridMapFileReader;
 class PathGenerator;
 namespace Acore
 {
@@ -155,6 +159,7 @@ enum LiquidStatus
 #define INVALID_HEIGHT       -100000.0f                     // for check, must be equal to VMAP_INVALID_HEIGHT, real value for unknown height is VMAP_INVALID_HEIGHT_VALUE
 #define MAX_FALL_DISTANCE     250000.0f                     // "unlimited fall" to find VMap ground if it is available, just larger than MAX_HEIGHT - INVALID_HEIGHT
 #define DEFAULT_HEIGHT_SEARCH     50.0f                     // default search distance to find height at nearby locations
+#define MAP_HEIGHTS_BATCH         64                        // points Map::GetHeights queries from the vmaps at once
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
 
 struct LiquidData
@@ -222,10 +227,15 @@ class GridMap
     uint8 _liquidHeight;
     uint16* _holes;
 
-    bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-    bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-    bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
-    bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+    // set when the arrays point into the memory mapped .map file instead of being read into the heap
+    std::shared_ptr<MappedFile> _mappedFile;
+
+    bool loadSections(GridMapFileReader& in, char const* filename);
+    bool loadAreaData(GridMapFileReader& in, uint32 offset, uint32 size);
+    bool loadHeightData(GridMapFileReader& in, uint32 offset, uint32 size);
+    bool loadLiquidData(GridMapFileReader& in, uint32 offset, uint32 size);
+    bool loadHolesData(GridMapFileReader& in, uint32 offset, uint32 size);
+    template<class T> void releaseArray(T*& data);
     bool isHole(int row, int col) const;
 
     // Get height functions and pointers
@@ -235,6 +245,8 @@ class GridMap
     [[nodiscard]] float getHeightFromUint16(float x, float y) const;
     [[nodiscard]] float getHeightFromUint8(float x, float y) const;
     [[nodiscard]] float getHeightFromFlat(float x, float y) const;
+    template<class T>
+    void getHeightsFrom(T const* v9, T const* v8, G3D::Vector3 const* points, float* heights, uint32 count, float multiplier, float offset) const;
 
 public:
     GridMap();
@@ -244,6 +256,8 @@ public:
 
     [[nodiscard]] uint16 getArea(float x, float y) const;
     [[nodiscard]] inline float getHeight(float x, float y) const {return (this->*_gridGetHeight)(x, y);}
+    // same result as getHeight for every point, the height format is resolved once and the interpolation is vectorised
+    void getHeights(G3D::Vector3 const* points, float* heights, uint32 count) const;
     [[nodiscard]] float getMinHeight(float x, float y) const;
     [[nodiscard]] float getLiquidLevel(float x, float y) const;
     LiquidData const GetLiquidData(float x, float y, float z, float collisionHeight, uint8 ReqLiquidType) const;
@@ -263,6 +277,25 @@ struct InstanceTemplate
     bool AllowMount;
 };
 
+// MapUpdate.Regions: statistics of the last parallel update of the regions of a continent, times in microseconds
+struct MapRegionUpdateStats
+{
+    uint32 ActiveRegions;
+    uint32 ActiveCells;
+    uint32 ParallelTime;        // wall time of the parallel phase
+    uint32 TotalRegionTime;     // sum of the update time of every region
+    uint32 SlowestRegionTime;
+};
+
+struct MapUpdateBlockCacheStats
+{
+    uint64 Hits;                // values blocks copied from the block built for another viewer
+    uint64 Misses;              // values blocks serialized for the viewer
+    uint64 BytesSaved;          // bytes copied instead of serialized
+
+    [[nodiscard]] float GetHitRate() const { return Hits + Misses ? float(Hits) * 100.0f / float(Hits + Misses) : 0.0f; }
+};
+
 enum LevelRequirementVsMode
 {
     LEVELREQUIREMENT_HEROIC = 70
@@ -379,6 +412,8 @@ public:
     // can return INVALID_HEIGHT if under z+2 z coord not found height
     [[nodiscard]] float GetHeight(float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
     [[nodiscard]] float GetGridHeight(float x, float y) const;
+    // batch of GetGridHeight, every run of points in the same grid is interpolated at once
+    void GetGridHeights(G3D::Vector3 const* points, float* heights, uint32 count) const;
     [[nodiscard]] float GetMinHeight(float x, float y) const;
     Transport* GetTransportForPos(uint32 phase, float x, float y, float z, WorldObject* worldobject = nullptr);
 
@@ -405,6 +440,10 @@ public:
     [[nodiscard]] uint32 GetInstanceId() const { return i_InstanceId; }
     [[nodiscard]] uint8 GetSpawnMode() const { return (i_spawnMode); }
 
+    // time (in microseconds) spent in the last threaded Update(), used by MapUpdater to schedule heavy maps first
+    [[nodiscard]] uint32 GetLastUpdateCost() const { return _lastUpdateCost; }
+    void SetLastUpdateCost(uint32 cost) { _lastUpdateCost = cost; }
+
     enum EnterState
     {
         CAN_ENTER = 0,
@@ -499,6 +538,20 @@ public:
 
     MapStoredObjectTypesContainer& GetObjectsStore() { return _objectsStore; }
 
+    template<class T>
+    void AddToObjectsStore(ObjectGuid const& guid, T* obj)
+    {
+        auto guard = GetRegionWriteGuard();
+        _objectsStore.Insert<T>(guid, obj);
+    }
+
+    template<class T>
+    void RemoveFromObjectsStore(ObjectGuid const& guid)
+    {
+        auto guard = GetRegionWriteGuard();
+        _objectsStore.Remove<T>(guid);
+    }
+
     typedef std::unordered_multimap<ObjectGuid::LowType, Creature*> CreatureBySpawnIdContainer;
     CreatureBySpawnIdContainer& GetCreatureBySpawnIdStore() { return _creatureBySpawnIdStore; }
 
@@ -535,18 +588,22 @@ public:
     float GetWaterOrGroundLevel(uint32 phasemask, float x, float y, float z, float* ground = nullptr, bool swim = false, float collisionHeight = DEFAULT_COLLISION_HEIGHT) const;
     [[nodiscard]] float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
     [[nodiscard]] bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks) const;
+    // batches of GetHeight and isInLineOfSight, the vmap tree and the dynamic tree lock are looked up once for all the points
+    void GetHeights(uint32 phasemask, G3D::Vector3 const* points, float* heights, uint32 count, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
+    void AreInLineOfSight(G3D::Vector3 const* starts, G3D::Vector3 const* ends, bool* results, uint32 count, uint32 phasemask, LineOfSightChecks checks) const;
     bool CanReachPositionAndGetValidCoords(const WorldObject* source, PathGenerator *path, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CanReachPositionAndGetValidCoords(const WorldObject* source, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CanReachPositionAndGetValidCoords(const WorldObject* source, float startX, float startY, float startZ, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CheckCollisionAndGetValidCoords(const WorldObject* source, float startX, float startY, float startZ, float &destX, float &destY, float &destZ, bool failOnCollision = true) const;
-    void Balance() { _dynamicTree.balance(); }
-    void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); }
-    void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); }
-    [[nodiscard]] bool ContainsGameObjectModel(const GameObjectModel& model) const { return _dynamicTree.contains(model);}
+    void Balance() { auto guard = GetRegionWriteGuard(); _dynamicTree.balance(); }
+    void RemoveGameObjectModel(const GameObjectModel& model) { auto guard = GetRegionWriteGuard(); _dynamicTree.remove(model); }
+    void InsertGameObjectModel(const GameObjectModel& model) { auto guard = GetRegionWriteGuard(); _dynamicTree.insert(model); }
+    [[nodiscard]] bool ContainsGameObjectModel(const GameObjectModel& model) const { auto guard = GetRegionReadGuard(); return _dynamicTree.contains(model);}
     [[nodiscard]] DynamicMapTree const& GetDynamicMapTree() const { return _dynamicTree; }
     bool GetObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist);
     [[nodiscard]] float GetGameObjectFloor(uint32 phasemask, float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const
     {
+        auto guard = GetRegionReadGuard();
         return _dynamicTree.getHeight(x, y, z, maxSearchDist, phasemask);
     }
     /*
@@ -555,6 +612,7 @@ public:
     [[nodiscard]] time_t GetLinkedRespawnTime(ObjectGuid guid) const;
     [[nodiscard]] time_t GetCreatureRespawnTime(ObjectGuid::LowType dbGuid) const
     {
+        auto guard = GetRegionGuard();
         std::unordered_map<ObjectGuid::LowType /*dbGUID*/, time_t>::const_iterator itr = _creatureRespawnTimes.find(dbGuid);
         if (itr != _creatureRespawnTimes.end())
             return itr->second;
@@ -564,6 +622,7 @@ public:
 
     [[nodiscard]] time_t GetGORespawnTime(ObjectGuid::LowType dbGuid) const
     {
+        auto guard = GetRegionGuard();
         std::unordered_map<ObjectGuid::LowType /*dbGUID*/, time_t>::const_iterator itr = _goRespawnTimes.find(dbGuid);
         if (itr != _goRespawnTimes.end())
             return itr->second;
@@ -614,19 +673,75 @@ public:
     inline ObjectGuid::LowType GenerateLowGuid()
     {
         static_assert(ObjectGuidTraits<high>::MapSpecific, "Only map specific guid can be generated in Map context");
+        auto guard = GetRegionGuard();
         return GetGuidSequenceGenerator<high>().Generate();
     }
 
     void AddUpdateObject(Object* obj)
     {
+        auto guard = GetRegionGuard();
         _updateObjects.insert(obj);
     }
 
     void RemoveUpdateObject(Object* obj)
     {
+        auto guard = GetRegionGuard();
         _updateObjects.erase(obj);
     }
 
+    /*
+        PARALLEL REGION UPDATE (MapUpdate.Regions)
+        Active cells of a continent are grouped in regions of NGrids, regions are updated by several threads
+        in four passes so that no two neighbour regions are ever updated at the same time. Containers shared
+        by the whole map are only locked while such a pass is running.
+    */
+    [[nodiscard]] bool IsUpdatingRegions() const { return _regionUpdate; }
+    [[nodiscard]] MapRegionUpdateStats GetRegionUpdateStats() const;
+
+    // the counters are added by the thread updating the map and read by commands of the world thread
+    void AddUpdateBlockCacheStats(uint64 hits, uint64 misses, uint64 bytesSaved);
+    [[nodiscard]] MapUpdateBlockCacheStats GetUpdateBlockCacheStats() const;
+    void ResetUpdateBlockCacheStats();
+
+    enum RegionGuardMode
+    {
+        REGION_GUARD_EXCLUSIVE,     // the containers of the map
+        REGION_GUARD_READ,          // the objects store and the dynamic tree, read only
+        REGION_GUARD_WRITE          // the objects store and the dynamic tree
+    };
+
+    // Held while a container shared by the regions is used, locks nothing unless regions are updated in parallel.
+    // Only the outermost guard of a thread locks, so a guarded helper may call another one. A thread holding a read
+    // guard must not take a write guard.
+    class RegionGuard
+    {
+    public:
+        RegionGuard(Map const* map, RegionGuardMode mode) : _map(map), _mode(mode), _locked(map->LockRegion(mode)) { }
+        ~RegionGuard() { if (_locked) _map->UnlockRegion(_mode); }
+
+        RegionGuard(RegionGuard const&) = delete;
+        RegionGuard& operator=(RegionGuard const&) = delete;
+
+    private:
+        Map const* _map;
+        RegionGuardMode _mode;
+        bool _locked;
+    };
+
+    RegionGuard GetRegionGuard() const { return RegionGuard(this, REGION_GUARD_EXCLUSIVE); }
+    RegionGuard GetRegionReadGuard() const { return RegionGuard(this, REGION_GUARD_READ); }
+    RegionGuard GetRegionWriteGuard() const { return RegionGuard(this, REGION_GUARD_WRITE); }
+
+    // runs the task right away, or on the thread updating the map once the regions are done when called from a
+    // region: anything reaching another region or a global manager (pools, ...) has to be deferred this way
+    void RunOnMapThread(std::function<void()>&& task);
+
+    void AddObjectToDelayedVisibility(Unit* unit)
+    {
+        auto guard = GetRegionGuard();
+        i_objectsForDelayedVisibility.insert(unit);
+    }
+
 private:
     void LoadMapAndVMap(int gx, int gy);
     void LoadVMap(int gx, int gy);
@@ -652,12 +767,6 @@ private:
 
     void buildNGridLinkage(NGridType* pNGridType) { pNGridType->link(this); }
 
-    [[nodiscard]] NGridType* getNGrid(uint32 x, uint32 y) const
-    {
-        ASSERT(x < MAX_NUMBER_OF_GRIDS && y < MAX_NUMBER_OF_GRIDS);
-        return i_grids[x][y];
-    }
-
     bool EnsureGridLoaded(Cell const&);
     [[nodiscard]] bool isGridObjectDataLoaded(uint32 x, uint32 y) const { return getNGrid(x, y)->isGridObjectDataLoaded(); }
     void setGridObjectDataLoaded(bool pLoaded, uint32 x, uint32 y) { getNGrid(x, y)->setGridObjectDataLoaded(pLoaded); }
@@ -667,9 +776,33 @@ private:
 
     void UpdateActiveCells(const float& x, const float& y, const uint32 t_diff);
 
+    struct RegionCell
+    {
+        CellCoord Coord;
+        bool Normal;    // visit with the regular object updaters
+        bool Large;     // visit with the large (visibility overridden) object updaters
+    };
+
+    [[nodiscard]] bool CanUpdateRegions() const;
+    void UpdateRegion(std::vector<RegionCell> const& cells, uint32 t_diff);
+
+    bool LockRegion(RegionGuardMode mode) const;
+    void UnlockRegion(RegionGuardMode mode) const;
+
     void SendObjectUpdates();
 
 protected:
+    [[nodiscard]] NGridType* getNGrid(uint32 x, uint32 y) const
+    {
+        ASSERT(x < MAX_NUMBER_OF_GRIDS && y < MAX_NUMBER_OF_GRIDS);
+        return i_grids[x][y];
+    }
+
+    // the parallel part of Update() on its own: the active cells are collected and then updated per region
+    void InitRegionCells(uint32 regionGridSize);
+    void CollectRegionCell(Cell const& cell, bool normal, bool large);
+    void UpdateRegions(uint32 t_diff);
+
     std::mutex Lock;
     std::mutex GridLock;
     std::shared_mutex MMapLock;
@@ -729,11 +862,14 @@ private:
 
     void AddToActiveHelper(WorldObject* obj)
     {
+        auto guard = GetRegionGuard();
         m_activeNonPlayers.insert(obj);
     }
 
     void RemoveFromActiveHelper(WorldObject* obj)
     {
+        auto guard = GetRegionGuard();
+
         // Map::Update for active object in proccess
         if (m_activeNonPlayersIter != m_activeNonPlayers.end())
         {
@@ -773,6 +909,29 @@ private:
     std::unordered_set<Corpse*> _corpseBones;
 
     std::unordered_set<Object*> _updateObjects;
+
+    uint32 _lastUpdateCost;
+
+    // MapUpdate.Regions
+    std::vector<std::vector<RegionCell>> _regionCells;
+    std::vector<Cell> _deferredGridLoads;
+    std::vector<std::function<void()>> _deferredRegionTasks;
+    uint32 _regionGridSize;
+    bool _collectRegionCells;
+    std::atomic<bool> _regionUpdate;
+    mutable std::mutex _regionLock;
+    mutable std::shared_mutex _regionSharedLock;
+    MapRegionUpdateStats _regionUpdateStats;
+    mutable std::mutex _regionUpdateStatsLock;
+
+    struct UpdateBlockCacheCounters
+    {
+        std::atomic<uint64> Hits{0};
+        std::atomic<uint64> Misses{0};
+        std::atomic<uint64> BytesSaved{0};
+    };
+
+    UpdateBlockCacheCounters _updateBlockCacheStats;
 };
 
 enum InstanceResetMethod
@@ -846,7 +1005,10 @@ inline void Map::Visit(Cell const& cell, TypeContainerVisitor<T, CONTAINER>& vis
     if (!cell.NoCreate() || IsGridLoaded(GridCoord(x, y)))
     {
         EnsureGridLoaded(cell);
-        getNGrid(x, y)->VisitGrid(cell_x, cell_y, visitor);
+
+        // grid loading is deferred while regions are updated in parallel
+        if (NGridType* grid = getNGrid(x, y))
+            grid->VisitGrid(cell_x, cell_y, visitor);
     }
 }
 
@@ -15,6 +15,7 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "AsyncPathfinder.h"
 #include "AvgDiffTracker.h"
 #include "Chat.h"
 #include "DatabaseEnv.h"
@@ -26,6 +27,7 @@
 #include "LFGMgr.h"
 #include "Log.h"
 #include "MapInstanced.h"
+#include "MapRegionUpdater.h"
 #include "MapMgr.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
@@ -64,6 +66,15 @@ void MapMgr::Initialize()
     // Start mtmaps if needed
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    // Threads updating the regions of continents in parallel
+    if (uint32 regionThreads = sWorld->getIntConfig(CONFIG_MAPUPDATE_REGIONS_THREADS))
+        sMapRegionUpdater->Activate(regionThreads);
+
+    // Threads searching the paths of chasing creatures
+    uint32 pathfinderThreads = sWorld->getIntConfig(CONFIG_MMAP_ASYNC_THREADS);
+    if (pathfinderThreads && sWorld->getBoolConfig(CONFIG_ENABLE_MMAPS))
+        sAsyncPathfinder->Activate(pathfinderThreads, sWorld->getIntConfig(CONFIG_MMAP_ASYNC_MAX_QUEUE));
 }
 
 void MapMgr::InitializeVisibilityDistanceInfo()
@@ -340,6 +351,12 @@ void MapMgr::UnloadAll()
 
     if (m_updater.activated())
         m_updater.deactivate();
+
+    if (sMapRegionUpdater->IsActive())
+        sMapRegionUpdater->Deactivate();
+
+    if (sAsyncPathfinder->IsActive())
+        sAsyncPathfinder->Deactivate();
 }
 
 void MapMgr::GetNumInstances(uint32& dungeons, uint32& battlegrounds, uint32& arenas)
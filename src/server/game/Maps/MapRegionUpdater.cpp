@@ -0,0 +1,143 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapRegionUpdater.h"
+#include "GridDefines.h"
+#include "SynchConnectionQueue.h"
+#include <algorithm>
+
+MapRegionUpdater::MapRegionUpdater() : _cancelationToken(false)
+{
+}
+
+MapRegionUpdater::~MapRegionUpdater()
+{
+    Deactivate();
+}
+
+MapRegionUpdater* MapRegionUpdater::instance()
+{
+    static MapRegionUpdater instance;
+    return &instance;
+}
+
+void MapRegionUpdater::Activate(uint32 numThreads)
+{
+    _cancelationToken = false;
+
+    _workerThreads.reserve(numThreads);
+    for (uint32 i = 0; i < numThreads; ++i)
+    {
+        _workerThreads.push_back(std::thread(&MapRegionUpdater::WorkerThread, this));
+    }
+}
+
+void MapRegionUpdater::Deactivate()
+{
+    _cancelationToken = true;
+
+    _queue.Cancel();
+
+    for (auto& thread : _workerThreads)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+
+    _workerThreads.clear();
+}
+
+void MapRegionUpdater::Execute(std::vector<Task> const& tasks)
+{
+    if (tasks.empty())
+        return;
+
+    std::shared_ptr<Batch> batch = std::make_shared<Batch>();
+    batch->tasks = &tasks;
+    batch->size = tasks.size();
+    batch->next = 0;
+    batch->done = 0;
+
+    // the calling thread runs one of the tasks itself, wake up helpers for the rest
+    size_t helpers = std::min(tasks.size() - 1, _workerThreads.size());
+    for (size_t i = 0; i < helpers; ++i)
+        _queue.Push(batch);
+
+    RunTasks(*batch);
+
+    std::unique_lock<std::mutex> guard(batch->lock);
+    while (batch->done < batch->size)
+        batch->condition.wait(guard);
+}
+
+uint32 MapRegionUpdater::GetRegionCount(uint32 regionGridSize)
+{
+    uint32 regionsPerSide = (MAX_NUMBER_OF_GRIDS + regionGridSize - 1) / regionGridSize;
+    return regionsPerSide * regionsPerSide;
+}
+
+uint32 MapRegionUpdater::GetRegionId(uint32 gridX, uint32 gridY, uint32 regionGridSize)
+{
+    uint32 regionsPerSide = (MAX_NUMBER_OF_GRIDS + regionGridSize - 1) / regionGridSize;
+    return (gridX / regionGridSize) * regionsPerSide + gridY / regionGridSize;
+}
+
+void MapRegionUpdater::GetRegionsOfColor(uint32 color, uint32 regionGridSize, std::vector<uint32>& regionIds)
+{
+    uint32 regionsPerSide = (MAX_NUMBER_OF_GRIDS + regionGridSize - 1) / regionGridSize;
+
+    // checkerboard with two colors per axis, neighbours always differ in the parity of x or y
+    regionIds.clear();
+    for (uint32 regionX = (color & 1); regionX < regionsPerSide; regionX += 2)
+        for (uint32 regionY = (color >> 1); regionY < regionsPerSide; regionY += 2)
+            regionIds.push_back(regionX * regionsPerSide + regionY);
+}
+
+void MapRegionUpdater::RunTasks(Batch& batch)
+{
+    // tasks pointer is only dereferenced while some task is unfinished, Execute() is still waiting then
+    for (size_t index = batch.next++; index < batch.size; index = batch.next++)
+    {
+        (*batch.tasks)[index]();
+
+        if (++batch.done == batch.size)
+        {
+            std::lock_guard<std::mutex> guard(batch.lock);
+            batch.condition.notify_all();
+        }
+    }
+}
+
+void MapRegionUpdater::WorkerThread()
+{
+    // regions are part of a map update, their synchronous queries wait like the map thread's
+    SynchConnectionQueue::SetCaller(SYNCH_CALLER_MAP);
+
+    while (1)
+    {
+        std::shared_ptr<Batch> batch;
+
+        _queue.WaitAndPop(batch);
+        if (_cancelationToken)
+            return;
+
+        if (batch)
+            RunTasks(*batch);
+    }
+}
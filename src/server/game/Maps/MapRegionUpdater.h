@@ -0,0 +1,83 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MAP_REGION_UPDATER_H_INCLUDED
+#define _MAP_REGION_UPDATER_H_INCLUDED
+
+#include "Define.h"
+#include "PCQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Thread pool used by Map::Update to update the regions of a continent in parallel
+ * (MapUpdate.Regions). The thread calling Execute() takes part in the work, so
+ * a batch always completes even when every pool thread is busy with another map.
+ */
+class MapRegionUpdater
+{
+public:
+    typedef std::function<void()> Task;
+
+    MapRegionUpdater();
+    ~MapRegionUpdater();
+
+    static MapRegionUpdater* instance();
+
+    void Activate(uint32 numThreads);
+    void Deactivate();
+    [[nodiscard]] bool IsActive() const { return !_workerThreads.empty(); }
+
+    // runs every task exactly once and returns when all of them finished
+    void Execute(std::vector<Task> const& tasks);
+
+    // regions are squares of regionGridSize * regionGridSize grids, ids go from 0 to GetRegionCount() - 1
+    static uint32 GetRegionCount(uint32 regionGridSize);
+    static uint32 GetRegionId(uint32 gridX, uint32 gridY, uint32 regionGridSize);
+
+    // every region has one of REGION_COLORS colors, two regions of the same color never touch each other
+    static constexpr uint32 REGION_COLORS = 4;
+    static void GetRegionsOfColor(uint32 color, uint32 regionGridSize, std::vector<uint32>& regionIds);
+
+private:
+    struct Batch
+    {
+        std::vector<Task> const* tasks;
+        size_t size;
+        std::atomic<size_t> next;
+        std::atomic<size_t> done;
+
+        std::mutex lock;
+        std::condition_variable condition;
+    };
+
+    static void RunTasks(Batch& batch);
+    void WorkerThread();
+
+    ProducerConsumerQueue<std::shared_ptr<Batch>> _queue;
+    std::vector<std::thread> _workerThreads;
+    std::atomic<bool> _cancelationToken;
+};
+
+#define sMapRegionUpdater MapRegionUpdater::instance()
+
+#endif //_MAP_REGION_UPDATER_H_INCLUDED
@@ -17,57 +17,56 @@
 
 #include "AvgDiffTracker.h"
 #include "LFGMgr.h"
+#include "Log.h"
 #include "Map.h"
 #include "MapUpdater.h"
+#include "SynchConnectionQueue.h"
+#include "World.h"
+#include <algorithm>
+#include <chrono>
 
-class UpdateRequest
-{
-public:
-    UpdateRequest() = default;
-    virtual ~UpdateRequest() = default;
-
-    virtual void call() = 0;
-};
+#ifdef _WIN32
+#include <Windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
-class MapUpdateRequest : public UpdateRequest
+namespace
 {
-public:
-    MapUpdateRequest(Map& m, MapUpdater& u, uint32 d, uint32 sd)
-        : m_map(m), m_updater(u), m_diff(d), s_diff(sd)
+    int64 GetSchedulerTime()
     {
+        using namespace std::chrono;
+
+        return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
     }
 
-    void call() override
+    void PinCurrentThread(size_t workerIndex)
     {
-        m_map.Update(m_diff, s_diff);
-        m_updater.update_finished();
-    }
-private:
-    Map& m_map;
-    MapUpdater& m_updater;
-    uint32 m_diff;
-    uint32 s_diff;
-};
+        unsigned int cores = std::thread::hardware_concurrency();
+        if (!cores)
+            return;
 
-class LFGUpdateRequest : public UpdateRequest
-{
-public:
-    LFGUpdateRequest(MapUpdater& u, uint32 d) : m_updater(u), m_diff(d) {}
+        size_t core = workerIndex % cores;
 
-    void call() override
-    {
-        uint32 startTime = getMSTime();
-        sLFGMgr->Update(m_diff, 1);
-        uint32 totalTime = getMSTimeDiff(startTime, getMSTime());
-        lfgDiffTracker.Update(totalTime);
-        m_updater.update_finished();
+#ifdef _WIN32
+        if (!SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core))
+            LOG_ERROR("maps", "MapUpdater: can't pin worker %u to processor %u", uint32(workerIndex), uint32(core));
+#elif defined(__linux__)
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(core, &mask);
+
+        if (pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask))
+            LOG_ERROR("maps", "MapUpdater: can't pin worker %u to processor %u", uint32(workerIndex), uint32(core));
+#else
+        (void)core;
+#endif
     }
-private:
-    MapUpdater& m_updater;
-    uint32 m_diff;
-};
+}
 
-MapUpdater::MapUpdater(): pending_requests(0)
+MapUpdater::MapUpdater() : _cancelationToken(false), _queuedTasks(0), pending_requests(0), _sequence(0), _roundRobin(0),
+    _statsResetTime(0), _useAffinity(true), _useCostOrdering(true), _pinThreads(false)
 {
 }
 
@@ -78,10 +77,25 @@ MapUpdater::~MapUpdater()
 
 void MapUpdater::activate(size_t num_threads)
 {
+    _useAffinity = sWorld->getBoolConfig(CONFIG_MAPUPDATE_AFFINITY);
+    _useCostOrdering = sWorld->getBoolConfig(CONFIG_MAPUPDATE_COST_ORDERING);
+    _pinThreads = sWorld->getBoolConfig(CONFIG_MAPUPDATE_PIN_THREADS);
+
+    _workers.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i)
+    {
+        _workers.push_back(std::make_unique<Worker>());
+        _workers.back()->busyTime = 0;
+        _workers.back()->executed = 0;
+        _workers.back()->stolen = 0;
+    }
+
+    _statsResetTime = GetSchedulerTime();
+
     _workerThreads.reserve(num_threads);
     for (size_t i = 0; i < num_threads; ++i)
     {
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
     }
 }
 
@@ -91,7 +105,10 @@ void MapUpdater::deactivate()
 
     wait();
 
-    _queue.Cancel();
+    {
+        std::lock_guard<std::mutex> guard(_queueLock);
+        _queueCondition.notify_all();
+    }
 
     for (auto& thread : _workerThreads)
     {
@@ -114,20 +131,31 @@ void MapUpdater::wait()
 
 void MapUpdater::schedule_update(Map& map, uint32 diff, uint32 s_diff)
 {
-    std::lock_guard<std::mutex> guard(_lock);
-
     ++pending_requests;
 
-    _queue.Push(new MapUpdateRequest(map, *this, diff, s_diff));
+    UpdateTask task;
+    task.map = &map;
+    task.diff = diff;
+    task.s_diff = s_diff;
+    task.cost = _useCostOrdering ? map.GetLastUpdateCost() : 0;
+    task.sequence = _sequence++;
+
+    PushTask(task, GetWorkerIndexFor(map));
 }
 
 void MapUpdater::schedule_lfg_update(uint32 diff)
 {
-    std::lock_guard<std::mutex> guard(_lock);
-
     ++pending_requests;
 
-    _queue.Push(new LFGUpdateRequest(*this, diff));
+    // LFG matching must start at the very beginning of the tick, give it the highest priority
+    UpdateTask task;
+    task.map = nullptr;
+    task.diff = diff;
+    task.s_diff = 0;
+    task.cost = std::numeric_limits<uint32>::max();
+    task.sequence = _sequence++;
+
+    PushTask(task, _roundRobin++ % _workers.size());
 }
 
 bool MapUpdater::activated()
@@ -137,25 +165,159 @@ bool MapUpdater::activated()
 
 void MapUpdater::update_finished()
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    if (--pending_requests > 0)
+        return;
 
-    --pending_requests;
+    std::lock_guard<std::mutex> lock(_lock);
 
     _condition.notify_all();
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::GetWorkerStats(std::vector<MapUpdaterWorkerStats>& stats) const
+{
+    uint64 wallTime = uint64(GetSchedulerTime() - _statsResetTime);
+
+    stats.clear();
+    stats.reserve(_workers.size());
+    for (std::unique_ptr<Worker> const& worker : _workers)
+    {
+        MapUpdaterWorkerStats workerStats;
+        workerStats.BusyTime = worker->busyTime;
+        workerStats.WallTime = wallTime;
+        workerStats.Executed = worker->executed;
+        workerStats.Stolen = worker->stolen;
+        stats.push_back(workerStats);
+    }
+}
+
+void MapUpdater::ResetWorkerStats()
+{
+    for (std::unique_ptr<Worker>& worker : _workers)
+    {
+        worker->busyTime = 0;
+        worker->executed = 0;
+        worker->stolen = 0;
+    }
+
+    _statsResetTime = GetSchedulerTime();
+}
+
+size_t MapUpdater::GetWorkerIndexFor(Map const& map)
 {
+    if (!_useAffinity)
+        return _roundRobin++ % _workers.size();
+
+    // stable map -> worker mapping so consecutive updates of a map run on the same (pinned) thread
+    uint64 key = (uint64(map.GetId()) << 32) | map.GetInstanceId();
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+
+    return size_t(key % _workers.size());
+}
+
+void MapUpdater::PushTask(UpdateTask const& task, size_t workerIndex)
+{
+    Worker& worker = *_workers[workerIndex];
+    {
+        std::lock_guard<std::mutex> guard(worker.lock);
+        worker.tasks.push_back(task);
+        std::push_heap(worker.tasks.begin(), worker.tasks.end());
+
+        // counted before the lock is released, a thief can only pop it (and decrement) afterwards
+        ++_queuedTasks;
+    }
+
+    // taking the lock guarantees a worker that just found every queue empty is already waiting
+    {
+        std::lock_guard<std::mutex> guard(_queueLock);
+    }
+
+    _queueCondition.notify_one();
+}
+
+bool MapUpdater::PopTaskFrom(Worker& worker, UpdateTask& task)
+{
+    std::lock_guard<std::mutex> guard(worker.lock);
+
+    if (worker.tasks.empty())
+        return false;
+
+    std::pop_heap(worker.tasks.begin(), worker.tasks.end());
+    task = worker.tasks.back();
+    worker.tasks.pop_back();
+
+    --_queuedTasks;
+    return true;
+}
+
+bool MapUpdater::PopTask(size_t workerIndex, UpdateTask& task)
+{
+    if (PopTaskFrom(*_workers[workerIndex], task))
+        return true;
+
+    // own queue is empty, steal the heaviest pending update of another worker
+    for (size_t i = 1; i < _workers.size(); ++i)
+    {
+        size_t victim = (workerIndex + i) % _workers.size();
+        if (PopTaskFrom(*_workers[victim], task))
+        {
+            ++_workers[workerIndex]->stolen;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void MapUpdater::ExecuteTask(UpdateTask const& task)
+{
+    if (!task.map)
+    {
+        uint32 startTime = getMSTime();
+        sLFGMgr->Update(task.diff, 1);
+        uint32 totalTime = getMSTimeDiff(startTime, getMSTime());
+        lfgDiffTracker.Update(totalTime);
+        return;
+    }
+
+    int64 startTime = GetSchedulerTime();
+    task.map->Update(task.diff, task.s_diff);
+    task.map->SetLastUpdateCost(uint32(std::min<int64>(GetSchedulerTime() - startTime, std::numeric_limits<uint32>::max() - 1)));
+}
+
+void MapUpdater::WorkerThread(size_t workerIndex)
+{
+    if (_pinThreads)
+        PinCurrentThread(workerIndex);
+
+    SynchConnectionQueue::SetCaller(SYNCH_CALLER_MAP);
+
+    Worker& worker = *_workers[workerIndex];
+
     while (1)
     {
-        UpdateRequest* request = nullptr;
+        UpdateTask task;
+        if (!PopTask(workerIndex, task))
+        {
+            std::unique_lock<std::mutex> guard(_queueLock);
 
-        _queue.WaitAndPop(request);
-        if (_cancelationToken)
-            return;
+            while (!_queuedTasks && !_cancelationToken)
+                _queueCondition.wait(guard);
+
+            if (_cancelationToken && !_queuedTasks)
+                return;
+
+            continue;
+        }
+
+        int64 startTime = GetSchedulerTime();
+
+        ExecuteTask(task);
 
-        request->call();
+        worker.busyTime += uint64(GetSchedulerTime() - startTime);
+        ++worker.executed;
 
-        delete request;
+        update_finished();
     }
 }
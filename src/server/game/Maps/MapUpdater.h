@@ -19,14 +19,34 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
-#include "PCQueue.h"
+#include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 class Map;
-class UpdateRequest;
 
+struct MapUpdaterWorkerStats
+{
+    uint64 BusyTime;        // microseconds spent executing updates since the last reset
+    uint64 WallTime;        // microseconds elapsed since the last reset
+    uint32 Executed;        // updates executed by this worker
+    uint32 Stolen;          // updates taken from another worker's queue
+
+    [[nodiscard]] float GetUtilisation() const { return WallTime ? float(BusyTime) * 100.0f / float(WallTime) : 0.0f; }
+};
+
+/*
+ * Work-stealing map update scheduler.
+ *
+ * Every worker owns a queue ordered by the cost of the previous update of each map
+ * (heaviest first), maps are routed to the same worker every tick so their data stays
+ * warm in that core's caches, and idle workers steal the heaviest pending update from
+ * the other queues. Completion is tracked with an atomic counter; the lock is only taken
+ * to wake up the thread blocked in wait().
+ */
 class MapUpdater
 {
 public:
@@ -41,17 +61,66 @@ public:
     bool activated();
     void update_finished();
 
+    void GetWorkerStats(std::vector<MapUpdaterWorkerStats>& stats) const;
+    void ResetWorkerStats();
+
 private:
-    void WorkerThread();
+    struct UpdateTask
+    {
+        Map* map;           // nullptr for the LFG update
+        uint32 diff;
+        uint32 s_diff;
+        uint32 cost;
+        uint32 sequence;
 
-    ProducerConsumerQueue<UpdateRequest*> _queue;
+        bool operator<(UpdateTask const& right) const
+        {
+            // max-heap: highest cost first, then FIFO
+            if (cost != right.cost)
+                return cost < right.cost;
 
+            return sequence > right.sequence;
+        }
+    };
+
+    struct Worker
+    {
+        std::mutex lock;
+        std::vector<UpdateTask> tasks;
+
+        std::atomic<uint64> busyTime;
+        std::atomic<uint32> executed;
+        std::atomic<uint32> stolen;
+    };
+
+    void WorkerThread(size_t workerIndex);
+    void PushTask(UpdateTask const& task, size_t workerIndex);
+    bool PopTask(size_t workerIndex, UpdateTask& task);
+    bool PopTaskFrom(Worker& worker, UpdateTask& task);
+    void ExecuteTask(UpdateTask const& task);
+    size_t GetWorkerIndexFor(Map const& map);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
     std::vector<std::thread> _workerThreads;
     std::atomic<bool> _cancelationToken;
 
+    // workers sleep here while no task is queued anywhere
+    std::mutex _queueLock;
+    std::condition_variable _queueCondition;
+    std::atomic<size_t> _queuedTasks;
+
+    // wait() sleeps here until every scheduled task finished
     std::mutex _lock;
     std::condition_variable _condition;
-    size_t pending_requests;
+    std::atomic<size_t> pending_requests;
+
+    std::atomic<uint32> _sequence;
+    std::atomic<size_t> _roundRobin;
+    std::atomic<int64> _statsResetTime;
+
+    bool _useAffinity;
+    bool _useCostOrdering;
+    bool _pinThreads;
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
@@ -22,6 +22,14 @@
 #include "Opcodes.h"
 #include "Player.h"
 #include "SpellAuraEffects.h"
+#include "Timer.h"
+#include "World.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <ctime>
+#endif
 
 uint32 AsyncAuctionListingMgr::auctionListingDiff = 0;
 bool AsyncAuctionListingMgr::auctionListingAllowed = false;
@@ -29,6 +37,126 @@ std::list<AuctionListItemsDelayEvent> AsyncAuctionListingMgr::auctionListingList
 std::list<AuctionListItemsDelayEvent> AsyncAuctionListingMgr::auctionListingListTemp;
 std::mutex AsyncAuctionListingMgr::auctionListingLock;
 std::mutex AsyncAuctionListingMgr::auctionListingTempLock;
+std::unordered_map<ObjectGuid, AuctionListingCursor> AsyncAuctionListingMgr::auctionListingCursors;
+uint32 AsyncAuctionListingMgr::auctionListingCursorPruneTimer = 0;
+std::atomic<uint32> AsyncAuctionListingMgr::auctionListingCursorCount(0);
+std::atomic<uint64> AsyncAuctionListingMgr::auctionListingCacheHits(0);
+std::atomic<uint64> AsyncAuctionListingMgr::auctionListingCacheMisses(0);
+std::atomic<uint64> AsyncAuctionListingMgr::auctionListingUnfiltered(0);
+std::atomic<uint64> AsyncAuctionListingMgr::auctionListingHitTime(0);
+std::atomic<uint64> AsyncAuctionListingMgr::auctionListingMissTime(0);
+std::atomic<uint64> AsyncAuctionListingMgr::auctionListingUnfilteredTime(0);
+std::atomic<uint64> AsyncAuctionListingMgr::auctionListingMaxTime(0);
+
+namespace
+{
+    // microseconds of cpu time used by the calling thread, waiting for World::Update is not counted
+    uint64 GetThreadCpuTime()
+    {
+#ifdef _WIN32
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime))
+            return 0;
+
+        uint64 kernel = (uint64(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime;
+        uint64 user = (uint64(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime;
+        return (kernel + user) / 10;
+#else
+        timespec time;
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time))
+            return 0;
+
+        return uint64(time.tv_sec) * 1000000 + uint64(time.tv_nsec) / 1000;
+#endif
+    }
+}
+
+bool AuctionListingCursor::IsValidFor(AuctionHouseObject const* auctionHouse, AuctionListingQuery const& query) const
+{
+    // any added or removed auction may change the results, bids don't
+    if (AuctionHouse != auctionHouse || Generation != auctionHouse->GetGeneration())
+        return false;
+
+    // the results skip expired auctions
+    if (sWorld->GetGameTime() > ValidUntil)
+        return false;
+
+    // usable items depend on the player, don't keep them for long
+    if (getMSTimeDiff(SearchTime, getMSTime()) >= AUCTION_LISTING_CURSOR_TIME)
+        return false;
+
+    return Query == query;
+}
+
+void AsyncAuctionListingMgr::Update(uint32 diff)
+{
+    auctionListingDiff += diff;
+
+    auctionListingCursorPruneTimer += diff;
+    if (auctionListingCursorPruneTimer < AUCTION_LISTING_CURSOR_TIME)
+        return;
+
+    auctionListingCursorPruneTimer = 0;
+
+    uint32 now = getMSTime();
+    for (auto itr = auctionListingCursors.begin(); itr != auctionListingCursors.end();)
+    {
+        if (getMSTimeDiff(itr->second.SearchTime, now) >= AUCTION_LISTING_CURSOR_TIME)
+            itr = auctionListingCursors.erase(itr);
+        else
+            ++itr;
+    }
+
+    auctionListingCursorCount.store(uint32(auctionListingCursors.size()), std::memory_order_relaxed);
+}
+
+void AsyncAuctionListingMgr::RecordQuery(AuctionListingQueryType type, uint64 cpuTime)
+{
+    switch (type)
+    {
+        case AUCTION_LISTING_QUERY_UNFILTERED:
+            auctionListingUnfiltered.fetch_add(1, std::memory_order_relaxed);
+            auctionListingUnfilteredTime.fetch_add(cpuTime, std::memory_order_relaxed);
+            break;
+        case AUCTION_LISTING_QUERY_CACHE_HIT:
+            auctionListingCacheHits.fetch_add(1, std::memory_order_relaxed);
+            auctionListingHitTime.fetch_add(cpuTime, std::memory_order_relaxed);
+            break;
+        case AUCTION_LISTING_QUERY_CACHE_MISS:
+            auctionListingCacheMisses.fetch_add(1, std::memory_order_relaxed);
+            auctionListingMissTime.fetch_add(cpuTime, std::memory_order_relaxed);
+            break;
+    }
+
+    // only the listing thread records
+    if (cpuTime > auctionListingMaxTime.load(std::memory_order_relaxed))
+        auctionListingMaxTime.store(cpuTime, std::memory_order_relaxed);
+
+    auctionListingCursorCount.store(uint32(auctionListingCursors.size()), std::memory_order_relaxed);
+}
+
+void AsyncAuctionListingMgr::GetStats(AuctionListingStats& stats)
+{
+    stats.CacheHits = auctionListingCacheHits.load(std::memory_order_relaxed);
+    stats.CacheMisses = auctionListingCacheMisses.load(std::memory_order_relaxed);
+    stats.Unfiltered = auctionListingUnfiltered.load(std::memory_order_relaxed);
+    stats.HitTime = auctionListingHitTime.load(std::memory_order_relaxed);
+    stats.MissTime = auctionListingMissTime.load(std::memory_order_relaxed);
+    stats.UnfilteredTime = auctionListingUnfilteredTime.load(std::memory_order_relaxed);
+    stats.MaxTime = auctionListingMaxTime.load(std::memory_order_relaxed);
+    stats.Cursors = auctionListingCursorCount.load(std::memory_order_relaxed);
+}
+
+void AsyncAuctionListingMgr::ResetStats()
+{
+    auctionListingCacheHits.store(0, std::memory_order_relaxed);
+    auctionListingCacheMisses.store(0, std::memory_order_relaxed);
+    auctionListingUnfiltered.store(0, std::memory_order_relaxed);
+    auctionListingHitTime.store(0, std::memory_order_relaxed);
+    auctionListingMissTime.store(0, std::memory_order_relaxed);
+    auctionListingUnfilteredTime.store(0, std::memory_order_relaxed);
+    auctionListingMaxTime.store(0, std::memory_order_relaxed);
+}
 
 bool AuctionListOwnerItemsDelayEvent::Execute(uint64  /*e_time*/, uint32  /*p_time*/)
 {
@@ -49,25 +177,57 @@ bool AuctionListItemsDelayEvent::Execute()
 
     AuctionHouseObject* auctionHouse = sAuctionMgr->GetAuctionsMap(creature->getFaction());
 
+    AuctionListingQuery query;
+    query.InventoryType = _auctionSlotID;
+    query.ItemClass = _auctionMainCategory;
+    query.ItemSubClass = _auctionSubCategory;
+    query.Quality = _quality;
+    query.LevelMin = _levelmin;
+    query.LevelMax = _levelmax;
+    query.Usable = _usable;
+
+    // converting string that we try to find to lower case
+    if (!Utf8toWStr(_searchedname, query.SearchedName))
+        return true;
+
+    wstrToLower(query.SearchedName);
+    query.Normalize();
+
     WorldPacket data(SMSG_AUCTION_LIST_RESULT, (4 + 4 + 4) + 50 * ((16 + MAX_INSPECTED_ENCHANTMENT_SLOT * 3) * 4));
     uint32 count = 0;
     uint32 totalcount = 0;
     data << (uint32) 0;
 
-    // converting string that we try to find to lower case
-    std::wstring wsearchedname;
-    if (!Utf8toWStr(_searchedname, wsearchedname))
-        return true;
+    uint64 startTime = GetThreadCpuTime();
+    AuctionListingQueryType queryType = AUCTION_LISTING_QUERY_UNFILTERED;
 
-    wstrToLower(wsearchedname);
+    if (query.IsUnfiltered())
+        auctionHouse->BuildListAllAuctionItems(data, _listfrom, count, totalcount);
+    else
+    {
+        // following pages of the same search reuse its results
+        AuctionListingCursor& cursor = AsyncAuctionListingMgr::GetCursor(_playerguid);
+        queryType = AUCTION_LISTING_QUERY_CACHE_HIT;
 
-    bool result = auctionHouse->BuildListAuctionItems(data, plr,
-                  wsearchedname, _listfrom, _levelmin, _levelmax, _usable,
-                  _auctionSlotID, _auctionMainCategory, _auctionSubCategory, _quality,
-                  count, totalcount, _getAll);
+        if (!cursor.IsValidFor(auctionHouse, query))
+        {
+            queryType = AUCTION_LISTING_QUERY_CACHE_MISS;
 
-    if (!result)
-        return false;
+            cursor.AuctionHouse = nullptr;
+            if (!auctionHouse->SearchListAuctionItems(plr, query, cursor.AuctionIds, cursor.ValidUntil))
+                return false;
+
+            cursor.AuctionHouse = auctionHouse;
+            cursor.Generation = auctionHouse->GetGeneration();
+            cursor.Query = query;
+            cursor.SearchTime = getMSTime();
+        }
+
+        auctionHouse->BuildListAuctionItems(data, cursor.AuctionIds, _listfrom, count);
+        totalcount = uint32(cursor.AuctionIds.size());
+    }
+
+    AsyncAuctionListingMgr::RecordQuery(queryType, GetThreadCpuTime() - startTime);
 
     data.put<uint32>(0, count);
     data << (uint32) totalcount;
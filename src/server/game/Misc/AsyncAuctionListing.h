@@ -18,11 +18,17 @@
 #ifndef __ASYNCAUCTIONLISTING_H
 #define __ASYNCAUCTIONLISTING_H
 
+#include "AuctionHouseMgr.h"
 #include "Common.h"
 #include "EventProcessor.h"
 #include "WorldPacket.h"
 #include "ObjectGuid.h"
+#include <atomic>
 #include <mutex>
+#include <unordered_map>
+
+// how long the results of a search are reused for the following pages
+#define AUCTION_LISTING_CURSOR_TIME (30 * IN_MILLISECONDS)
 
 class AuctionListOwnerItemsDelayEvent : public BasicEvent
 {
@@ -63,10 +69,44 @@ public:
     uint8 _getAll;
 };
 
+// results of the last filtered search of a player, the client requests them again for every page
+struct AuctionListingCursor
+{
+    AuctionHouseObject const* AuctionHouse = nullptr;
+    uint32 Generation = 0;              // AuctionHouseObject::GetGeneration() when searched
+    AuctionListingQuery Query;
+    std::vector<uint32> AuctionIds;
+    time_t ValidUntil = 0;              // game time up to which none of the auctions expires
+    uint32 SearchTime = 0;              // getMSTime() when searched
+
+    [[nodiscard]] bool IsValidFor(AuctionHouseObject const* auctionHouse, AuctionListingQuery const& query) const;
+};
+
+enum AuctionListingQueryType
+{
+    AUCTION_LISTING_QUERY_UNFILTERED,
+    AUCTION_LISTING_QUERY_CACHE_HIT,
+    AUCTION_LISTING_QUERY_CACHE_MISS
+};
+
+struct AuctionListingStats
+{
+    uint64 CacheHits;                   // pages served from the cursor
+    uint64 CacheMisses;                 // filtered searches
+    uint64 Unfiltered;                  // searches without filter, never cached
+    uint64 HitTime;                     // microseconds of cpu time spent on each kind of query
+    uint64 MissTime;
+    uint64 UnfilteredTime;
+    uint64 MaxTime;
+    uint32 Cursors;
+
+    [[nodiscard]] float GetHitRate() const { return CacheHits + CacheMisses ? float(CacheHits) * 100.0f / float(CacheHits + CacheMisses) : 0.0f; }
+};
+
 class AsyncAuctionListingMgr
 {
 public:
-    static void Update(uint32 diff) { auctionListingDiff += diff; }
+    static void Update(uint32 diff);
     static uint32 GetDiff() { return auctionListingDiff; }
     static void ResetDiff() { auctionListingDiff = 0; }
     static bool IsAuctionListingAllowed() { return auctionListingAllowed; }
@@ -77,6 +117,13 @@ public:
     static std::mutex& GetLock() { return auctionListingLock; }
     static std::mutex& GetTempLock() { return auctionListingTempLock; }
 
+    // only used while holding GetLock()
+    static AuctionListingCursor& GetCursor(ObjectGuid playerGuid) { return auctionListingCursors[playerGuid]; }
+
+    static void RecordQuery(AuctionListingQueryType type, uint64 cpuTime);
+    static void GetStats(AuctionListingStats& stats);
+    static void ResetStats();
+
 private:
     static uint32 auctionListingDiff;
     static bool auctionListingAllowed;
@@ -84,6 +131,16 @@ private:
     static std::list<AuctionListItemsDelayEvent> auctionListingListTemp;
     static std::mutex auctionListingLock;
     static std::mutex auctionListingTempLock;
+    static std::unordered_map<ObjectGuid, AuctionListingCursor> auctionListingCursors;
+    static uint32 auctionListingCursorPruneTimer;
+    static std::atomic<uint32> auctionListingCursorCount;
+    static std::atomic<uint64> auctionListingCacheHits;
+    static std::atomic<uint64> auctionListingCacheMisses;
+    static std::atomic<uint64> auctionListingUnfiltered;
+    static std::atomic<uint64> auctionListingHitTime;
+    static std::atomic<uint64> auctionListingMissTime;
+    static std::atomic<uint64> auctionListingUnfilteredTime;
+    static std::atomic<uint64> auctionListingMaxTime;
 };
 
 #endif
@@ -0,0 +1,174 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AsyncPathfinder.h"
+#include "MMapFactory.h"
+#include "MMapMgr.h"
+#include <chrono>
+#include <shared_mutex>
+
+namespace
+{
+    int64 GetPathfinderTime()
+    {
+        using namespace std::chrono;
+
+        return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+AsyncPathfinder::AsyncPathfinder() : _cancelationToken(false), _maxQueueSize(0), _queueSize(0), _completed(0), _canceled(0),
+    _synchronous(0), _totalLatency(0), _maxLatency(0)
+{
+}
+
+AsyncPathfinder::~AsyncPathfinder()
+{
+    Deactivate();
+}
+
+AsyncPathfinder* AsyncPathfinder::instance()
+{
+    static AsyncPathfinder instance;
+    return &instance;
+}
+
+void AsyncPathfinder::Activate(uint32 numThreads, uint32 maxQueueSize)
+{
+    _cancelationToken = false;
+    _maxQueueSize = maxQueueSize;
+
+    _workerThreads.reserve(numThreads);
+    for (uint32 i = 0; i < numThreads; ++i)
+    {
+        _workerThreads.push_back(std::thread(&AsyncPathfinder::WorkerThread, this, i));
+    }
+}
+
+void AsyncPathfinder::Deactivate()
+{
+    _cancelationToken = true;
+
+    _queue.Cancel();
+
+    for (auto& thread : _workerThreads)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+
+    _workerThreads.clear();
+}
+
+std::shared_ptr<PathRequest> AsyncPathfinder::Enqueue(PathGenerator const& path, uint32 mapId)
+{
+    // reserve the place first, concurrent callers could all pass a check of the size otherwise
+    if (_queueSize.fetch_add(1) >= _maxQueueSize)
+    {
+        --_queueSize;
+        ++_synchronous;
+        return nullptr;
+    }
+
+    std::shared_ptr<PathRequest> request = std::make_shared<PathRequest>();
+    request->Search = std::make_unique<PathGenerator>(path);
+    request->MapId = mapId;
+    request->QueueTime = GetPathfinderTime();
+    request->Done = false;
+    request->Canceled = false;
+
+    // the source may be gone before the search runs, the copy keeps its guid for the logs only
+    request->Search->_source = nullptr;
+
+    _queue.Push(request);
+    return request;
+}
+
+void AsyncPathfinder::GetStats(AsyncPathfinderStats& stats) const
+{
+    stats.QueueSize = _queueSize;
+    stats.Completed = _completed;
+    stats.Canceled = _canceled;
+    stats.Synchronous = _synchronous;
+    stats.TotalLatency = _totalLatency;
+    stats.MaxLatency = _maxLatency;
+}
+
+void AsyncPathfinder::ResetStats()
+{
+    _completed = 0;
+    _canceled = 0;
+    _synchronous = 0;
+    _totalLatency = 0;
+    _maxLatency = 0;
+}
+
+void AsyncPathfinder::Search(PathRequest& request, uint32 workerId)
+{
+    MMAP::MMapMgr* mmap = MMAP::MMapFactory::createOrGetMMapMgr();
+    std::shared_lock<std::shared_mutex> guard(mmap->GetNavMeshLock());
+
+    PathGenerator& search = *request.Search;
+
+    // the map may have lost its mmap since the request was queued
+    dtNavMeshQuery const* query = mmap->GetWorkerNavMeshQuery(request.MapId, workerId);
+    if (!query)
+    {
+        search._searchFailed = true;
+        return;
+    }
+
+    search._navMesh = query->getAttachedNavMesh();
+    search._navMeshQuery = query;
+    search.SearchPolyPath();
+}
+
+void AsyncPathfinder::WorkerThread(uint32 workerId)
+{
+    while (1)
+    {
+        std::shared_ptr<PathRequest> request;
+
+        _queue.WaitAndPop(request);
+        if (_cancelationToken)
+            return;
+
+        if (!request)
+            continue;
+
+        --_queueSize;
+
+        // the generator that requested it was destroyed or asked for another path meanwhile
+        if (request->Canceled.load(std::memory_order_relaxed))
+        {
+            ++_canceled;
+            continue;
+        }
+
+        Search(*request, workerId);
+
+        uint64 latency = uint64(GetPathfinderTime() - request->QueueTime);
+        _totalLatency += latency;
+        for (uint64 maxLatency = _maxLatency; latency > maxLatency && !_maxLatency.compare_exchange_weak(maxLatency, latency);)
+            ;
+
+        ++_completed;
+        request->Done.store(true, std::memory_order_release);
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _ASYNC_PATHFINDER_H
+#define _ASYNC_PATHFINDER_H
+
+#include "Define.h"
+#include "PCQueue.h"
+#include "PathGenerator.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+struct PathRequest
+{
+    std::unique_ptr<PathGenerator> Search;  // copy of the requesting generator, only touched by the pathfinder until Done
+    uint32 MapId;
+    int64 QueueTime;                        // microseconds
+    std::atomic<bool> Done;
+    std::atomic<bool> Canceled;
+};
+
+struct AsyncPathfinderStats
+{
+    uint32 QueueSize;       // requests waiting for a thread
+    uint64 Completed;       // requests searched by the pathfinder threads
+    uint64 Canceled;        // requests dropped before being searched
+    uint64 Synchronous;     // requests searched by the map thread because the queue was full
+    uint64 TotalLatency;    // microseconds from queueing to the end of the search
+    uint64 MaxLatency;
+
+    [[nodiscard]] uint64 GetAverageLatency() const { return Completed ? TotalLatency / Completed : 0; }
+};
+
+/*
+ * Thread pool searching the navmesh for PathGenerator::CalculatePathAsync (MoveMaps.AsyncThreads).
+ *
+ * Every thread owns a dtNavMeshQuery per map and searches a copy of the requesting PathGenerator
+ * while holding the navmesh lock of MMapMgr shared, so tiles can't be added or removed under it.
+ * The map thread finishes the path on one of its next updates, requests over MoveMaps.AsyncMaxQueue
+ * are searched synchronously.
+ */
+class AsyncPathfinder
+{
+public:
+    AsyncPathfinder();
+    ~AsyncPathfinder();
+
+    static AsyncPathfinder* instance();
+
+    void Activate(uint32 numThreads, uint32 maxQueueSize);
+    void Deactivate();
+    [[nodiscard]] bool IsActive() const { return !_workerThreads.empty(); }
+
+    // returns nullptr when the queue is full, the caller has to search the path itself then
+    std::shared_ptr<PathRequest> Enqueue(PathGenerator const& path, uint32 mapId);
+
+    void GetStats(AsyncPathfinderStats& stats) const;
+    void ResetStats();
+
+private:
+    void WorkerThread(uint32 workerId);
+    void Search(PathRequest& request, uint32 workerId);
+
+    ProducerConsumerQueue<std::shared_ptr<PathRequest>> _queue;
+    std::vector<std::thread> _workerThreads;
+    std::atomic<bool> _cancelationToken;
+    uint32 _maxQueueSize;
+
+    std::atomic<uint32> _queueSize;
+    std::atomic<uint64> _completed;
+    std::atomic<uint64> _canceled;
+    std::atomic<uint64> _synchronous;
+    std::atomic<uint64> _totalLatency;
+    std::atomic<uint64> _maxLatency;
+};
+
+#define sAsyncPathfinder AsyncPathfinder::instance()
+
+#endif
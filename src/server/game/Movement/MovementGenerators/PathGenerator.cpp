@@ -15,6 +15,7 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "AsyncPathfinder.h"
 #include "Creature.h"
 #include "DetourCommon.h"
 #include "Geometry.h"
@@ -28,12 +29,14 @@
 PathGenerator::PathGenerator(WorldObject const* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false), _forceDestination(false),
     _slopeCheck(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false),
-    _endPosition(G3D::Vector3::zero()), _source(owner), _navMesh(nullptr),
-    _navMeshQuery(nullptr)
+    _endPosition(G3D::Vector3::zero()), _source(owner), _sourceGuid(owner->GetGUID()), _mapId(owner->GetMapId()), _navMesh(nullptr),
+    _navMeshQuery(nullptr), _search(POLY_SEARCH_NONE), _searchStartPoly(INVALID_POLYREF), _endPoly(INVALID_POLYREF),
+    _prefixPolyLength(0), _startFarFromPoly(false), _endFarFromPoly(false), _searchFailed(false), _suffixSearchFailed(false),
+    _pointCount(0), _pointPathStatus(DT_FAILURE)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
-    uint32 mapId = _source->GetMapId();
+    uint32 mapId = _mapId;
     //if (DisableMgr::IsPathfindingEnabled(_sourceUnit->FindMap()))
     {
         MMAP::MMapMgr* mmap = MMAP::MMapFactory::createOrGetMMapMgr();
@@ -44,8 +47,11 @@ PathGenerator::PathGenerator(WorldObject const* owner) :
     CreateFilter();
 }
 
+PathGenerator::PathGenerator(PathGenerator const& right) = default;
+
 PathGenerator::~PathGenerator()
 {
+    CancelPendingPath();
 }
 
 bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool forceDest)
@@ -58,6 +64,21 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
 
 bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float destY, float destZ, bool forceDest)
 {
+    return StartPath(x, y, z, destX, destY, destZ, forceDest, false);
+}
+
+bool PathGenerator::CalculatePathAsync(float destX, float destY, float destZ, bool forceDest)
+{
+    float x, y, z;
+    _source->GetPosition(x, y, z);
+
+    return StartPath(x, y, z, destX, destY, destZ, forceDest, true);
+}
+
+bool PathGenerator::StartPath(float x, float y, float z, float destX, float destY, float destZ, bool forceDest, bool async)
+{
+    CancelPendingPath();
+
     if (!Acore::IsValidMapCoord(destX, destY, destZ) || !Acore::IsValidMapCoord(x, y, z))
         return false;
 
@@ -82,10 +103,56 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
 
     UpdateFilter();
 
-    BuildPolyPath(start, dest);
+    if (!PreparePolyPath(start, dest))
+        return true;
+
+    // search the navmesh on a pathfinder thread, UpdatePendingPath() finishes the path once it is found
+    // the slope check reads the liquids of the map, such paths are searched right away
+    if (async && !_slopeCheck && sAsyncPathfinder->IsActive())
+    {
+        _pendingRequest = sAsyncPathfinder->Enqueue(*this, _source->GetMapId());
+        if (_pendingRequest)
+            return true;
+    }
+
+    SearchPolyPath();
+    FinishPolyPath();
+    return true;
+}
+
+bool PathGenerator::UpdatePendingPath()
+{
+    if (!_pendingRequest)
+        return true;
+
+    if (!_pendingRequest->Done.load(std::memory_order_acquire))
+        return false;
+
+    // take the search results over from the copy the pathfinder worked on
+    PathGenerator const& search = *_pendingRequest->Search;
+    memcpy(_pathPolyRefs, search._pathPolyRefs, sizeof(_pathPolyRefs));
+    _polyLength = search._polyLength;
+    _searchFailed = search._searchFailed;
+    _suffixSearchFailed = search._suffixSearchFailed;
+    memcpy(_pointPath, search._pointPath, sizeof(_pointPath));
+    _pointCount = search._pointCount;
+    _pointPathStatus = search._pointPathStatus;
+
+    _pendingRequest = nullptr;
+
+    FinishPolyPath();
     return true;
 }
 
+void PathGenerator::CancelPendingPath()
+{
+    if (!_pendingRequest)
+        return;
+
+    _pendingRequest->Canceled.store(true, std::memory_order_relaxed);
+    _pendingRequest = nullptr;
+}
+
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -156,16 +223,23 @@ dtPolyRef PathGenerator::GetPolyByLocation(float const* point, float* distance)
     return INVALID_POLYREF;
 }
 
-void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos)
+bool PathGenerator::PreparePolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos)
 {
+    _search = POLY_SEARCH_NONE;
+    _searchFailed = false;
+    _suffixSearchFailed = false;
+
     // *** getting start/end poly logic ***
 
     float distToStartPoly, distToEndPoly;
-    float startPoint[VERTEX_SIZE] = { startPos.y, startPos.z, startPos.x };
-    float endPoint[VERTEX_SIZE] = { endPos.y, endPos.z, endPos.x };
+    float* startPoint = _startPoint;
+    float* endPoint = _endPoint;
+    dtVset(startPoint, startPos.y, startPos.z, startPos.x);
+    dtVset(endPoint, endPos.y, endPos.z, endPos.x);
 
     dtPolyRef startPoly = GetPolyByLocation(startPoint, &distToStartPoly);
     dtPolyRef endPoly = GetPolyByLocation(endPoint, &distToEndPoly);
+    _endPoly = endPoly;
 
     _type = PathType(PATHFIND_NORMAL);
 
@@ -184,20 +258,22 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         if (path || (waterPath && canSwim))
         {
             _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
-            return;
+            return false;
         }
 
         // raycast doesn't need endPoly to be valid
         if (!_useRaycast)
         {
             _type = PATHFIND_NOPATH;
-            return;
+            return false;
         }
     }
 
     // we may need a better number here
     bool startFarFromPoly = distToStartPoly > 7.0f;
     bool endFarFromPoly = distToEndPoly > 7.0f;
+    _startFarFromPoly = startFarFromPoly;
+    _endFarFromPoly = endFarFromPoly;
 
     // create a shortcut if the path begins or end too far
     // away from the desired path points.
@@ -231,7 +307,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
 
             AddFarFromPolyFlags(startFarFromPoly, endFarFromPoly);
 
-            return;
+            return false;
         }
 
         if (!isFarUnderWater)
@@ -268,8 +344,8 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         else
             _type = PATHFIND_NORMAL;
 
-        BuildPointPath(startPoint, endPoint);
-        return;
+        _search = POLY_SEARCH_POINTS;
+        return true;
     }
 
     // look for startPoly/endPoly in current path
@@ -347,43 +423,23 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                 // suffixStartPoly is still invalid, error state
                 BuildShortcut();
                 _type = PATHFIND_NOPATH;
-                return;
+                return false;
             }
         }
 
-        // generate suffix
-        uint32 suffixPolyLength = 0;
-
-        dtStatus dtResult;
         if (_useRaycast)
         {
             BuildShortcut();
             _type = PATHFIND_NOPATH;
-            return;
-        }
-        else
-        {
-            dtResult = _navMeshQuery->findPath(
-                suffixStartPoly,    // start polygon
-                endPoly,            // end polygon
-                suffixEndPoint,     // start position
-                endPoint,           // end position
-                &_filter,            // polygon search filter
-                _pathPolyRefs + prefixPolyLength - 1,    // [out] path
-                (int*)&suffixPolyLength,
-                MAX_PATH_LENGTH - prefixPolyLength); // max number of polygons in output path
+            return false;
         }
 
-        if (!suffixPolyLength || dtStatusFailed(dtResult))
-        {
-            // this is probably an error state, but we'll leave it
-            // and hopefully recover on the next Update
-            // we still need to copy our preffix
-            LOG_ERROR("movement", "PathGenerator::BuildPolyPath: Path Build failed %s", _source->GetGUID().ToString().c_str());
-        }
-
-        // new path = prefix + suffix - overlap
-        _polyLength = prefixPolyLength + suffixPolyLength - 1;
+        // generate suffix
+        _search = POLY_SEARCH_SUFFIX;
+        _searchStartPoly = suffixStartPoly;
+        dtVcopy(_searchStartPoint, suffixEndPoint);
+        _prefixPolyLength = prefixPolyLength;
+        return true;
     }
     else
     {
@@ -394,14 +450,13 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         // free and invalidate old path data
         Clear();
 
-        dtStatus dtResult;
         if (_useRaycast)
         {
             float hit = 0;
             float hitNormal[3];
             memset(hitNormal, 0, sizeof(hitNormal));
 
-            dtResult = _navMeshQuery->raycast(
+            dtStatus dtResult = _navMeshQuery->raycast(
                 startPoly,
                 startPoint,
                 endPoint,
@@ -417,7 +472,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                 BuildShortcut();
                 _type = PATHFIND_NOPATH;
                 AddFarFromPolyFlags(startFarFromPoly, endFarFromPoly);
-                return;
+                return false;
             }
 
             // raycast() sets hit to FLT_MAX if there is a ray between start and end
@@ -440,7 +495,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                 NormalizePath();
                 _type = PATHFIND_INCOMPLETE;
                 AddFarFromPolyFlags(startFarFromPoly, false);
-                return;
+                return false;
             }
             else
             {
@@ -461,33 +516,88 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                 }
                 else
                     _type = PATHFIND_NORMAL;
-                return;
+                return false;
             }
         }
-        else
-        {
-            dtResult = _navMeshQuery->findPath(
-                startPoly,          // start polygon
-                endPoly,            // end polygon
-                startPoint,         // start position
-                endPoint,           // end position
-                &_filter,           // polygon search filter
-                _pathPolyRefs,     // [out] path
-                (int*)&_polyLength,
-                MAX_PATH_LENGTH);   // max number of polygons in output path
-        }
 
+        _search = POLY_SEARCH_FULL;
+        _searchStartPoly = startPoly;
+        dtVcopy(_searchStartPoint, startPoint);
+        return true;
+    }
+
+    // the whole path is a sub path of the old one, only the points have to be searched
+    _search = POLY_SEARCH_SUBPATH;
+    return true;
+}
+
+void PathGenerator::SearchPolyPath()
+{
+    if (_search == POLY_SEARCH_SUFFIX)
+    {
+        uint32 suffixPolyLength = 0;
+
+        dtStatus dtResult = FindPolyPath(_pathPolyRefs + _prefixPolyLength - 1, suffixPolyLength, MAX_PATH_LENGTH - _prefixPolyLength);
+
+        // this is probably an error state, but we'll leave it
+        // and hopefully recover on the next Update
+        // we still need to copy our preffix
+        _suffixSearchFailed = !suffixPolyLength || dtStatusFailed(dtResult);
+
+        // new path = prefix + suffix - overlap
+        _polyLength = _prefixPolyLength + suffixPolyLength - 1;
+    }
+    else if (_search == POLY_SEARCH_FULL)
+    {
+        dtStatus dtResult = FindPolyPath(_pathPolyRefs, _polyLength, MAX_PATH_LENGTH);
+
+        // only happens if we passed bad data to findPath(), or navmesh is messed up
         if (!_polyLength || dtStatusFailed(dtResult))
         {
-            // only happens if we passed bad data to findPath(), or navmesh is messed up
-            LOG_ERROR("movement", "PathGenerator::BuildPolyPath: %s Path Build failed: 0 length path", _source->GetGUID().ToString().c_str());
-            BuildShortcut();
-            _type = PATHFIND_NOPATH;
+            _searchFailed = true;
             return;
         }
     }
 
     if (!_polyLength)
+    {
+        _searchFailed = true;
+        return;
+    }
+
+    SearchPointPath();
+}
+
+dtStatus PathGenerator::FindPolyPath(dtPolyRef* path, uint32& pathLength, uint32 maxPathLength)
+{
+    MMAP::PathCache& cache = MMAP::MMapFactory::createOrGetMMapMgr()->GetPathCache();
+    bool useCache = cache.IsEnabled();
+    if (useCache && cache.Find(_mapId, _searchStartPoly, _endPoly, _filter.getIncludeFlags(), _filter.getExcludeFlags(), path, pathLength, maxPathLength))
+        return DT_SUCCESS;
+
+    dtStatus dtResult = _navMeshQuery->findPath(
+        _searchStartPoly,   // start polygon
+        _endPoly,           // end polygon
+        _searchStartPoint,  // start position
+        _endPoint,          // end position
+        &_filter,           // polygon search filter
+        path,               // [out] path
+        (int*)&pathLength,
+        maxPathLength);     // max number of polygons in output path
+
+    // partial corridors depend on the search limits, only keep the ones reaching the end polygon
+    if (useCache && dtStatusSucceed(dtResult) && !dtStatusDetail(dtResult, DT_PARTIAL_RESULT) && pathLength && path[pathLength - 1] == _endPoly)
+        cache.Store(_mapId, _searchStartPoly, _endPoly, _filter.getIncludeFlags(), _filter.getExcludeFlags(), path, pathLength);
+
+    return dtResult;
+}
+
+void PathGenerator::FinishPolyPath()
+{
+    if (_suffixSearchFailed)
+        LOG_ERROR("movement", "PathGenerator::BuildPolyPath: Path Build failed %s", _source->GetGUID().ToString().c_str());
+
+    if (_searchFailed)
     {
         LOG_ERROR("movement", "PathGenerator::BuildPolyPath: %s Path Build failed: 0 length path", _source->GetGUID().ToString().c_str());
         BuildShortcut();
@@ -495,27 +605,62 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         return;
     }
 
-    // by now we know what type of path we can get
-    if (_pathPolyRefs[_polyLength - 1] == endPoly && !(_type & PATHFIND_INCOMPLETE))
+    if (_search != POLY_SEARCH_POINTS)
+    {
+        // by now we know what type of path we can get
+        if (_pathPolyRefs[_polyLength - 1] == _endPoly && !(_type & PATHFIND_INCOMPLETE))
+        {
+            _type = PATHFIND_NORMAL;
+        }
+        else
+        {
+            _type = PATHFIND_INCOMPLETE;
+        }
+
+        AddFarFromPolyFlags(_startFarFromPoly, _endFarFromPoly);
+    }
+
+    // generate the point-path out of our up-to-date poly-path
+    BuildPointPath();
+}
+
+void PathGenerator::SearchPointPath()
+{
+    _pointCount = 0;
+    _pointPathStatus = DT_FAILURE;
+
+    // raycast paths never get here, BuildPointPath() reports the misuse
+    if (_useRaycast)
+        return;
+
+    if (_useStraightPath)
     {
-        _type = PATHFIND_NORMAL;
+        _pointPathStatus = _navMeshQuery->findStraightPath(
+            _startPoint,        // start position
+            _endPoint,          // end position
+            _pathPolyRefs,      // current path
+            _polyLength,        // lenth of current path
+            _pointPath,         // [out] path corner points
+            nullptr,            // [out] flags
+            nullptr,            // [out] shortened path
+            (int*)&_pointCount,
+            _pointPathLimit);   // maximum number of points/polygons to use
     }
     else
     {
-        _type = PATHFIND_INCOMPLETE;
+        _pointPathStatus = FindSmoothPath(
+            _startPoint,        // start position
+            _endPoint,          // end position
+            _pathPolyRefs,      // current path
+            _polyLength,        // length of current path
+            _pointPath,         // [out] path corner points
+            (int*)&_pointCount,
+            _pointPathLimit);   // maximum number of points
     }
-
-    AddFarFromPolyFlags(startFarFromPoly, endFarFromPoly);
-
-    // generate the point-path out of our up-to-date poly-path
-    BuildPointPath(startPoint, endPoint);
 }
 
-void PathGenerator::BuildPointPath(const float* startPoint, const float* endPoint)
+void PathGenerator::BuildPointPath()
 {
-    float pathPoints[MAX_POINT_PATH_LENGTH * VERTEX_SIZE];
-    uint32 pointCount = 0;
-    dtStatus dtResult = DT_FAILURE;
     if (_useRaycast)
     {
         // _straightLine uses raycast and it currently doesn't support building a point path, only a 2-point path with start and hitpoint/end is returned
@@ -524,36 +669,17 @@ void PathGenerator::BuildPointPath(const float* startPoint, const float* endPoin
         _type = PATHFIND_NOPATH;
         return;
     }
-    else if (_useStraightPath)
-    {
-        dtResult = _navMeshQuery->findStraightPath(
-            startPoint,         // start position
-            endPoint,           // end position
-            _pathPolyRefs,     // current path
-            _polyLength,       // lenth of current path
-            pathPoints,         // [out] path corner points
-            nullptr,               // [out] flags
-            nullptr,               // [out] shortened path
-            (int*)&pointCount,
-            _pointPathLimit);   // maximum number of points/polygons to use
-    }
-    else
-    {
-        dtResult = FindSmoothPath(
-            startPoint,         // start position
-            endPoint,           // end position
-            _pathPolyRefs,     // current path
-            _polyLength,       // length of current path
-            pathPoints,         // [out] path corner points
-            (int*)&pointCount,
-            _pointPathLimit);    // maximum number of points
-    }
+
+    // the points were searched by SearchPointPath()
+    float* pathPoints = _pointPath;
+    uint32 pointCount = _pointCount;
+    dtStatus dtResult = _pointPathStatus;
 
     // Special case with start and end positions very close to each other
     if (_polyLength == 1 && pointCount == 1)
     {
         // First point is start position, append end position
-        dtVcopy(&pathPoints[1 * VERTEX_SIZE], endPoint);
+        dtVcopy(&pathPoints[1 * VERTEX_SIZE], _endPoint);
         pointCount++;
     }
     else if (pointCount < 2 || dtStatusFailed(dtResult))
@@ -904,7 +1030,7 @@ dtStatus PathGenerator::FindSmoothPath(float const* startPos, float const* endPo
 
         if (dtStatusFailed(_navMeshQuery->getPolyHeight(polys[0], result, &result[1])))
             LOG_DEBUG("maps", "PathGenerator::FindSmoothPath: Cannot find height at position X: %f Y: %f Z: %f for %s",
-                result[2], result[0], result[1], _source->GetGUID().ToString().c_str());
+                result[2], result[0], result[1], _sourceGuid.ToString().c_str());
         result[1] += 0.5f;
         dtVcopy(iterPos, result);
 
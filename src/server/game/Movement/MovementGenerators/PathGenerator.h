@@ -24,11 +24,14 @@
 #include "MMapFactory.h"
 #include "MMapMgr.h"
 #include "MoveSplineInitArgs.h"
+#include "ObjectGuid.h"
 #include "SharedDefines.h"
 #include <G3D/Vector3.h>
+#include <memory>
 
 class Unit;
 class WorldObject;
+struct PathRequest;
 
 // 74*4.0f=296y number_of_points*interval = max_path_len
 // this is way more than actual evade range
@@ -60,12 +63,23 @@ class PathGenerator
 {
     public:
         explicit PathGenerator(WorldObject const* owner);
+        PathGenerator(PathGenerator const& right);
         ~PathGenerator();
 
+        PathGenerator& operator=(PathGenerator const& right) = delete;
+
         // Calculate the path from owner to given destination
         // return: true if new path was calculated, false otherwise (no change needed)
         bool CalculatePath(float destX, float destY, float destZ, bool forceDest = false);
         bool CalculatePath(float x, float y, float z, float destX, float destY, float destZ, bool forceDest);
+
+        // Same as CalculatePath, but the navmesh search may run on an AsyncPathfinder thread.
+        // While HasPendingPath() the result getters are not valid, UpdatePendingPath() completes
+        // the path and returns false as long as the search did not finish.
+        bool CalculatePathAsync(float destX, float destY, float destZ, bool forceDest = false);
+        [[nodiscard]] bool HasPendingPath() const { return _pendingRequest != nullptr; }
+        bool UpdatePendingPath();
+        void CancelPendingPath();
         [[nodiscard]] bool IsInvalidDestinationZ(Unit const* target) const;
         [[nodiscard]] bool IsWalkableClimb(float const* v1, float const* v2) const;
         [[nodiscard]] bool IsWalkableClimb(float x, float y, float z, float destX, float destY, float destZ) const;
@@ -129,6 +143,18 @@ class PathGenerator
         }
 
     private:
+        friend class AsyncPathfinder;
+
+        // navmesh search still to run after PreparePolyPath()
+        enum PolyPathSearch
+        {
+            POLY_SEARCH_NONE,       // the path is already built
+            POLY_SEARCH_POINTS,     // start and end are on the same polygon, only search the points
+            POLY_SEARCH_SUBPATH,    // the path is a sub path of the old one, only search the points
+            POLY_SEARCH_SUFFIX,     // the end moved out of the old path, search a new suffix
+            POLY_SEARCH_FULL        // search a whole new path
+        };
+
         dtPolyRef _pathPolyRefs[MAX_PATH_LENGTH];   // array of detour polygon references
         uint32 _polyLength;                         // number of polygons in the path
 
@@ -145,12 +171,32 @@ class PathGenerator
         G3D::Vector3 _endPosition;          // {x, y, z} of the destination
         G3D::Vector3 _actualEndPosition;    // {x, y, z} of the closest possible point to given destination
 
-        WorldObject const* const _source;       // the object that is moving
+        WorldObject const* _source;             // the object that is moving, nullptr in the copies searched by pathfinder threads
+        ObjectGuid _sourceGuid;                 // guid of the source for the logs of pathfinder threads
+        uint32 _mapId;                          // map of the nav mesh, readable without the source on pathfinder threads
         dtNavMesh const* _navMesh;              // the nav mesh
         dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path
 
         dtQueryFilterExt _filter;  // use single filter for all movements, update it when needed
 
+        // navmesh search state, SearchPolyPath() only reads and writes these and never the world
+        PolyPathSearch _search;
+        float _startPoint[VERTEX_SIZE];
+        float _endPoint[VERTEX_SIZE];
+        dtPolyRef _searchStartPoly;
+        float _searchStartPoint[VERTEX_SIZE];
+        dtPolyRef _endPoly;
+        uint32 _prefixPolyLength;
+        bool _startFarFromPoly;
+        bool _endFarFromPoly;
+        bool _searchFailed;
+        bool _suffixSearchFailed;
+        float _pointPath[MAX_POINT_PATH_LENGTH * VERTEX_SIZE];
+        uint32 _pointCount;
+        dtStatus _pointPathStatus;
+
+        std::shared_ptr<PathRequest> _pendingRequest; // search running on an AsyncPathfinder thread
+
         void SetStartPosition(G3D::Vector3 const& point) { _startPosition = point; }
         void SetEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; _endPosition = point; }
         void SetActualEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; }
@@ -164,8 +210,16 @@ class PathGenerator
         dtPolyRef GetPolyByLocation(float const* Point, float* Distance) const;
         bool HaveTile(G3D::Vector3 const& p) const;
 
-        void BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos);
-        void BuildPointPath(float const* startPoint, float const* endPoint);
+        bool StartPath(float x, float y, float z, float destX, float destY, float destZ, bool forceDest, bool async);
+
+        // building the poly path, only SearchPolyPath() may run on another thread and without _source,
+        // unless _slopeCheck is set (IsSwimmableSegment reads the map)
+        bool PreparePolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos);
+        void SearchPolyPath();
+        dtStatus FindPolyPath(dtPolyRef* path, uint32& pathLength, uint32 maxPathLength);
+        void FinishPolyPath();
+        void SearchPointPath();
+        void BuildPointPath();
         void BuildShortcut();
 
         NavTerrain GetNavTerrain(float x, float y, float z) const;
@@ -25,6 +25,7 @@
 #include "RandomMovementGenerator.h"
 #include "Spell.h"
 #include "Util.h"
+#include <algorithm>
 
 template<class T>
 RandomMovementGenerator<T>::~RandomMovementGenerator() { }
@@ -164,17 +165,25 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
                         _preComputedPaths.erase(pathIdx);
                         return;
                     }
+                }
 
-                    if (!map->isInLineOfSight((*itr).x, (*itr).y, (*itr).z + 2.f, (*itrNext).x, (*itrNext).y, (*itrNext).z + 2.f, creature->GetPhaseMask(), LINEOFSIGHT_ALL_CHECKS))
-                    {
-                        _validPointsVector[_currentPoint].erase(randomIter);
-                        _preComputedPaths.erase(pathIdx);
-                        return;
-                    }
+                // no valid path, the generator never returns more than MAX_POINT_PATH_LENGTH points
+                if (finalPath.size() < 2 || finalPath.size() > MAX_POINT_PATH_LENGTH)
+                {
+                    _validPointsVector[_currentPoint].erase(randomIter);
+                    _preComputedPaths.erase(pathIdx);
+                    return;
                 }
 
-                // no valid path
-                if (finalPath.size() < 2)
+                // every segment must be in los, check them all in one batch
+                G3D::Vector3 raised[MAX_POINT_PATH_LENGTH];
+                bool inLos[MAX_POINT_PATH_LENGTH];
+                uint32 segments = uint32(finalPath.size() - 1);
+                for (uint32 i = 0; i <= segments; ++i)
+                    raised[i] = G3D::Vector3(finalPath[i].x, finalPath[i].y, finalPath[i].z + 2.f);
+
+                map->AreInLineOfSight(raised, raised + 1, inLos, segments, creature->GetPhaseMask(), LINEOFSIGHT_ALL_CHECKS);
+                if (std::find(inLos, inLos + segments, false) != inLos + segments)
                 {
                     _validPointsVector[_currentPoint].erase(randomIter);
                     _preComputedPaths.erase(pathIdx);
@@ -15,6 +15,7 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "AsyncPathfinder.h"
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "MoveSplineInit.h"
@@ -61,6 +62,9 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     {
         owner->StopMoving();
         _lastTargetPosition.reset();
+        if (i_path)
+            i_path->CancelPendingPath();
+
         if (Creature* cOwner2 = owner->ToCreature())
         {
             cOwner2->SetCannotReachTarget(false);
@@ -117,6 +121,15 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
             owner->Attack(this->i_target.getTarget(), true);
     }
 
+    // the path requested by a previous update is still searched asynchronously
+    if (i_path && i_path->HasPendingPath())
+    {
+        if (i_path->UpdatePendingPath())
+            MoveAlongPath(owner, target);
+
+        return true;
+    }
+
     if (_lastTargetPosition && i_target->GetPosition() == _lastTargetPosition.value() && mutualChase == _mutualChase)
         return true;
 
@@ -152,19 +165,18 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
         i_path->Clear();
 
     float x, y, z;
-    bool shortenPath;
     // if we want to move toward the target and there's no fixed angle...
     if (moveToward && !angle)
     {
         // ...we'll pathfind to the center, then shorten the path
         target->GetPosition(x, y, z);
-        shortenPath = true;
+        _shortenPathDistance = maxTarget;
     }
     else
     {
         // otherwise, we fall back to nearpoint finding
         target->GetNearPoint(owner, x, y, z, (moveToward ? maxTarget : minTarget) - hitboxSum, 0, angle ? target->ToAbsoluteAngle(angle->RelativeAngle) : target->GetAngle(owner));
-        shortenPath = false;
+        _shortenPathDistance.reset();
     }
 
     if (owner->IsHovering())
@@ -172,16 +184,36 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
 
     i_recalculateTravel = true;
 
-    bool success = i_path->CalculatePath(x, y, z, forceDest);
-    if (!success || i_path->GetPathType() & PATHFIND_NOPATH)
+    bool success = cOwner ? i_path->CalculatePathAsync(x, y, z, forceDest) : i_path->CalculatePath(x, y, z, forceDest);
+    if (!success)
     {
         if (cOwner)
             cOwner->SetCannotReachTarget(true);
         return true;
     }
 
-    if (shortenPath)
-        i_path->ShortenPathUntilDist(G3D::Vector3(target->GetPositionX(), target->GetPositionY(), target->GetPositionZ()), maxTarget);
+    // moves once a later update gets the path
+    if (i_path->HasPendingPath())
+        return true;
+
+    MoveAlongPath(owner, target);
+    return true;
+}
+
+template<class T>
+void ChaseMovementGenerator<T>::MoveAlongPath(T* owner, Unit* target)
+{
+    Creature* cOwner = owner->ToCreature();
+
+    if (i_path->GetPathType() & PATHFIND_NOPATH)
+    {
+        if (cOwner)
+            cOwner->SetCannotReachTarget(true);
+        return;
+    }
+
+    if (_shortenPathDistance)
+        i_path->ShortenPathUntilDist(G3D::Vector3(target->GetPositionX(), target->GetPositionY(), target->GetPositionZ()), *_shortenPathDistance);
 
     if (cOwner)
         cOwner->SetCannotReachTarget(false);
@@ -199,8 +231,6 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     init.SetFacing(target);
     init.SetWalk(walk);
     init.Launch();
-
-    return true;
 }
 
 //-----------------------------------------------//
@@ -59,9 +59,12 @@ public:
     bool HasLostTarget(Unit* unit) const { return unit->GetVictim() != this->GetTarget(); }
 
 private:
+    void MoveAlongPath(T* owner, Unit* target);
+
     std::unique_ptr<PathGenerator> i_path;
     TimeTrackerSmall i_recheckDistance;
     bool i_recalculateTravel;
+    Optional<float> _shortenPathDistance;   // distance to the target the path is cut at
 
     Optional<Position> _lastTargetPosition;
     Optional<ChaseRange> const _range;
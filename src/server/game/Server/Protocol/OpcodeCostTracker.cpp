@@ -0,0 +1,172 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OpcodeCostTracker.h"
+#include "Log.h"
+#include "Opcodes.h"
+#include <algorithm>
+
+struct OpcodeCostTracker::ThreadCounters
+{
+    uint32 Thread;
+    std::array<Counters, NUM_OPCODE_HANDLERS> Opcodes;
+};
+
+namespace
+{
+    uint32 GetBucket(uint64 time)
+    {
+        uint32 bucket = 0;
+        for (uint64 limit = 10; bucket < OPCODE_COST_BUCKETS - 1 && time >= limit; limit *= 10)
+            ++bucket;
+
+        return bucket;
+    }
+}
+
+OpcodeCostTracker::OpcodeCostTracker() : _enabled(false)
+{
+}
+
+OpcodeCostTracker* OpcodeCostTracker::instance()
+{
+    static OpcodeCostTracker instance;
+    return &instance;
+}
+
+OpcodeCostTracker::ThreadCounters& OpcodeCostTracker::GetThreadCounters()
+{
+    // never freed, the counters of a thread that ended keep being reported
+    thread_local ThreadCounters* counters = nullptr;
+    if (!counters)
+    {
+        std::unique_ptr<ThreadCounters> created = std::make_unique<ThreadCounters>(); // value initialized, all counters are 0
+
+        std::lock_guard<std::mutex> guard(_threadsLock);
+        created->Thread = uint32(_threads.size());
+        counters = created.get();
+        _threads.push_back(std::move(created));
+    }
+
+    return *counters;
+}
+
+void OpcodeCostTracker::Record(uint16 opcode, uint64 time)
+{
+    if (opcode >= NUM_OPCODE_HANDLERS)
+        return;
+
+    Counters& counters = GetThreadCounters().Opcodes[opcode];
+    counters.Count.fetch_add(1, std::memory_order_relaxed);
+    counters.TotalTime.fetch_add(time, std::memory_order_relaxed);
+    counters.Histogram[GetBucket(time)].fetch_add(1, std::memory_order_relaxed);
+
+    // only this thread raises its maximum
+    if (time > counters.MaxTime.load(std::memory_order_relaxed))
+        counters.MaxTime.store(time, std::memory_order_relaxed);
+}
+
+void OpcodeCostTracker::GetStats(std::vector<OpcodeCostStats>& stats) const
+{
+    stats.clear();
+
+    std::lock_guard<std::mutex> guard(_threadsLock);
+    for (uint32 opcode = 0; opcode < NUM_OPCODE_HANDLERS; ++opcode)
+    {
+        OpcodeCostStats opcodeStats = OpcodeCostStats();
+        opcodeStats.Opcode = uint16(opcode);
+
+        for (std::unique_ptr<ThreadCounters> const& thread : _threads)
+        {
+            Counters const& counters = thread->Opcodes[opcode];
+            opcodeStats.Count += counters.Count.load(std::memory_order_relaxed);
+            opcodeStats.TotalTime += counters.TotalTime.load(std::memory_order_relaxed);
+            opcodeStats.MaxTime = std::max(opcodeStats.MaxTime, counters.MaxTime.load(std::memory_order_relaxed));
+            for (uint32 i = 0; i < OPCODE_COST_BUCKETS; ++i)
+                opcodeStats.Histogram[i] += counters.Histogram[i].load(std::memory_order_relaxed);
+        }
+
+        if (opcodeStats.Count)
+            stats.push_back(opcodeStats);
+    }
+
+    std::sort(stats.begin(), stats.end(), [](OpcodeCostStats const& left, OpcodeCostStats const& right)
+    {
+        return left.TotalTime > right.TotalTime;
+    });
+}
+
+void OpcodeCostTracker::GetThreadStats(std::vector<OpcodeCostThreadStats>& stats) const
+{
+    stats.clear();
+
+    std::lock_guard<std::mutex> guard(_threadsLock);
+    stats.reserve(_threads.size());
+    for (std::unique_ptr<ThreadCounters> const& thread : _threads)
+    {
+        OpcodeCostThreadStats threadStats = OpcodeCostThreadStats();
+        threadStats.Thread = thread->Thread;
+
+        for (Counters const& counters : thread->Opcodes)
+        {
+            threadStats.Count += counters.Count.load(std::memory_order_relaxed);
+            threadStats.TotalTime += counters.TotalTime.load(std::memory_order_relaxed);
+        }
+
+        stats.push_back(threadStats);
+    }
+}
+
+void OpcodeCostTracker::Reset()
+{
+    std::lock_guard<std::mutex> guard(_threadsLock);
+    for (std::unique_ptr<ThreadCounters>& thread : _threads)
+    {
+        for (Counters& counters : thread->Opcodes)
+        {
+            counters.Count.store(0, std::memory_order_relaxed);
+            counters.TotalTime.store(0, std::memory_order_relaxed);
+            counters.MaxTime.store(0, std::memory_order_relaxed);
+            for (std::atomic<uint64>& bucket : counters.Histogram)
+                bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void OpcodeCostTracker::LogStats(uint32 limit) const
+{
+    std::vector<OpcodeCostStats> stats;
+    GetStats(stats);
+
+    if (limit && stats.size() > limit)
+        stats.resize(limit);
+
+    LOG_INFO("network.opcode", "Client opcode costs (calls, total ms, avg us, max us, calls <10us/<100us/<1ms/<10ms/<100ms/more):");
+    for (OpcodeCostStats const& opcodeStats : stats)
+    {
+        LOG_INFO("network.opcode", "%s: " UI64FMTD " calls, " UI64FMTD " ms, " UI64FMTD " us avg, " UI64FMTD " us max, " UI64FMTD "/" UI64FMTD "/" UI64FMTD "/" UI64FMTD "/" UI64FMTD "/" UI64FMTD,
+            GetOpcodeNameForLogging(static_cast<OpcodeClient>(opcodeStats.Opcode)).c_str(), opcodeStats.Count, opcodeStats.TotalTime / 1000,
+            opcodeStats.GetAverageTime(), opcodeStats.MaxTime, opcodeStats.Histogram[0], opcodeStats.Histogram[1], opcodeStats.Histogram[2],
+            opcodeStats.Histogram[3], opcodeStats.Histogram[4], opcodeStats.Histogram[5]);
+    }
+
+    std::vector<OpcodeCostThreadStats> threadStats;
+    GetThreadStats(threadStats);
+
+    for (OpcodeCostThreadStats const& thread : threadStats)
+        LOG_INFO("network.opcode", "Packet processing thread %u: " UI64FMTD " calls, " UI64FMTD " ms.", thread.Thread, thread.Count, thread.TotalTime / 1000);
+}
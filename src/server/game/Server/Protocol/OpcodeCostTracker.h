@@ -0,0 +1,96 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_OPCODECOSTTRACKER_H
+#define ACORE_OPCODECOSTTRACKER_H
+
+#include "Define.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// handler time buckets: < 10us, < 100us, < 1ms, < 10ms, < 100ms, >= 100ms
+#define OPCODE_COST_BUCKETS 6
+
+struct OpcodeCostStats
+{
+    uint16 Opcode;
+    uint64 Count;
+    uint64 TotalTime;           // microseconds spent in the handler
+    uint64 MaxTime;             // microseconds of the slowest call
+    std::array<uint64, OPCODE_COST_BUCKETS> Histogram;
+
+    [[nodiscard]] uint64 GetAverageTime() const { return Count ? TotalTime / Count : 0; }
+};
+
+struct OpcodeCostThreadStats
+{
+    uint32 Thread;              // registration order of the thread
+    uint64 Count;
+    uint64 TotalTime;
+};
+
+/*
+ * Counts the calls and the time spent in the handlers of client opcodes.
+ *
+ * Every thread processing packets (world thread and map update threads) records into its own
+ * counters, registered on first use, so recording never takes a lock. Readers aggregate them.
+ */
+class AC_GAME_API OpcodeCostTracker
+{
+    OpcodeCostTracker();
+    ~OpcodeCostTracker() = default;
+
+public:
+    static OpcodeCostTracker* instance();
+
+    void SetEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+    [[nodiscard]] bool IsEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    void Record(uint16 opcode, uint64 time);
+
+    // opcodes called at least once, summed over every thread, most expensive first
+    void GetStats(std::vector<OpcodeCostStats>& stats) const;
+    void GetThreadStats(std::vector<OpcodeCostThreadStats>& stats) const;
+    void Reset();
+
+    // writes the most expensive opcodes to the log, every opcode when limit is 0
+    void LogStats(uint32 limit) const;
+
+private:
+    struct Counters
+    {
+        std::atomic<uint64> Count;
+        std::atomic<uint64> TotalTime;
+        std::atomic<uint64> MaxTime;
+        std::array<std::atomic<uint64>, OPCODE_COST_BUCKETS> Histogram;
+    };
+
+    struct ThreadCounters;
+
+    ThreadCounters& GetThreadCounters();
+
+    mutable std::mutex _threadsLock;
+    std::vector<std::unique_ptr<ThreadCounters>> _threads;
+    std::atomic<bool> _enabled;
+};
+
+#define sOpcodeCostTracker OpcodeCostTracker::instance()
+
+#endif
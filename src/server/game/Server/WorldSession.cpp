@@ -31,6 +31,7 @@
 #include "MapMgr.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
+#include "OpcodeCostTracker.h"
 #include "Opcodes.h"
 #include "OutdoorPvPMgr.h"
 #include "PacketUtilities.h"
@@ -47,6 +48,7 @@
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSocket.h"
+#include <chrono>
 #include <zlib.h>
 
 #ifdef ELUNA
@@ -207,15 +209,32 @@ ObjectGuid::LowType WorldSession::GetGuidLow() const
 
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const* packet)
+{
+    if (!PreparePacketSend(packet))
+        return;
+
+    m_Socket->SendPacket(*packet);
+}
+
+/// Send a packet shared with other sessions, it is not copied
+void WorldSession::SendPacket(std::shared_ptr<WorldPacket const> const& packet)
+{
+    if (!PreparePacketSend(packet.get()))
+        return;
+
+    m_Socket->SendPacket(packet);
+}
+
+bool WorldSession::PreparePacketSend(WorldPacket const* packet)
 {
     if (packet->GetOpcode() == NULL_OPCODE)
     {
         LOG_ERROR("network.opcode", "%s send NULL_OPCODE", GetPlayerInfo().c_str());
-        return;
+        return false;
     }
 
     if (!m_Socket)
-        return;
+        return false;
 
 #if defined(ACORE_DEBUG)
     // Code for network use statistic
@@ -257,11 +276,11 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 
 #ifdef ELUNA
     if (!sEluna->OnPacketSend(this, *packet))
-        return;
+        return false;
 #endif
 
     LOG_TRACE("network.opcode", "S->C: %s %s", GetPlayerInfo().c_str(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())).c_str());
-    m_Socket->SendPacket(*packet);
+    return true;
 }
 
 /// Add an incoming packet to the queue
@@ -312,11 +331,23 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     std::vector<WorldPacket*> requeuePackets;
     uint32 processedPackets = 0;
     time_t currentTime = time(nullptr);
+    bool trackCosts = sOpcodeCostTracker->IsEnabled();
+
+    // take every received packet at once, what this update does not process goes back to the front of the queue
+    if (m_Socket)
+        _recvQueue.swap(_recvBatch);
 
-    while (m_Socket && _recvQueue.next(packet, updater))
+    std::deque<WorldPacket*>::iterator batchItr = _recvBatch.begin();
+    while (m_Socket && batchItr != _recvBatch.end() && updater.Process(*batchItr))
     {
+        packet = *batchItr;
+        ++batchItr;
+
         OpcodeClient opcode = static_cast<OpcodeClient>(packet->GetOpcode());
         ClientOpcodeHandler const* opHandle = opcodeTable[opcode];
+        std::chrono::steady_clock::time_point handlerStart;
+        if (trackCosts)
+            handlerStart = std::chrono::steady_clock::now();
 
         try
         {
@@ -404,6 +435,9 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
             }
         }
 
+        if (trackCosts)
+            sOpcodeCostTracker->Record(opcode, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - handlerStart).count());
+
         if (deletePacket)
             delete packet;
 
@@ -418,6 +452,9 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
             break;
     }
 
+    _recvQueue.readd(batchItr, _recvBatch.end());
+    _recvBatch.clear();
+
     _recvQueue.readd(requeuePackets.begin(), requeuePackets.end());
 
     if (!updater.ProcessUnsafe()) // <=> updater is of type MapSessionFilter
@@ -33,8 +33,10 @@
 #include "Packet.h"
 #include "SharedDefines.h"
 #include "World.h"
-#include <utility>
+#include <deque>
 #include <map>
+#include <memory>
+#include <utility>
 
 class Creature;
 class GameObject;
@@ -255,6 +257,7 @@ public:
     void WriteMovementInfo(WorldPacket* data, MovementInfo* mi);
 
     void SendPacket(WorldPacket const* packet);
+    void SendPacket(std::shared_ptr<WorldPacket const> const& packet);
     void SendNotification(const char* format, ...) ATTR_PRINTF(2, 3);
     void SendNotification(uint32 string_id, ...);
     void SendPetNameInvalid(uint32 error, std::string const& name, DeclinedName* declinedName);
@@ -1030,6 +1033,9 @@ private:
 
     bool recoveryItem(Item* pItem);
 
+    // checks and hooks shared by both SendPacket overloads, false when the packet must not be sent
+    bool PreparePacketSend(WorldPacket const* packet);
+
     // logging helper
     void LogUnexpectedOpcode(WorldPacket* packet, char const* status, const char* reason);
     void LogUnprocessedTail(WorldPacket* packet);
@@ -1076,6 +1082,7 @@ private:
     uint32 recruiterId;
     bool isRecruiter;
     LockedQueue<WorldPacket*> _recvQueue;
+    std::deque<WorldPacket*> _recvBatch;    // packets taken out of _recvQueue by the current Update()
     uint32 m_currentVendorEntry;
     ObjectGuid m_currentBankerGUID;
     time_t timeWhoCommandAllowed;
@@ -28,12 +28,16 @@
 #include "Random.h"
 #include "Realm.h"
 #include "ScriptMgr.h"
+#include "UpdateData.h"
 #include "World.h"
 #include "WorldSession.h"
 #include <memory>
 
 using boost::asio::ip::tcp;
 
+// payloads at least this big are not copied into the send buffer
+static constexpr std::size_t SHARED_PAYLOAD_MIN_SIZE = 512;
+
 WorldSocket::WorldSocket(tcp::socket&& socket)
     : Socket(std::move(socket)), _OverSpeedPings(0), _worldSession(nullptr), _authed(false), _sendBufferSize(4096)
 {
@@ -82,40 +86,66 @@ void WorldSocket::CheckIpCallback(PreparedQueryResult result)
 bool WorldSocket::Update()
 {
     EncryptablePacket* queued;
-    MessageBuffer buffer(_sendBufferSize);
+    MessageBuffer buffer = AcquireSendBuffer(_sendBufferSize);
     while (_bufferQueue.Dequeue(queued))
     {
-        ServerPktHeader header(queued->size() + 2, queued->GetOpcode());
+        std::shared_ptr<WorldPacket const> packet = std::move(queued->Packet);
+
+        // large update packets left uncompressed by the map threads (Compression.Offload)
+        if (packet->GetOpcode() == SMSG_UPDATE_OBJECT && packet->size() > UPDATE_DATA_COMPRESSION_THRESHOLD)
+        {
+            std::shared_ptr<WorldPacket> compressed = std::make_shared<WorldPacket>();
+            if (UpdateData::CompressPacket(*packet, *compressed))
+                packet = std::move(compressed);
+        }
+
+        ServerPktHeader header(packet->size() + 2, packet->GetOpcode());
         if (queued->NeedsEncryption())
             _authCrypt.EncryptSend(header.header, header.getHeaderLength());
 
-        if (buffer.GetRemainingSpace() < queued->size() + header.getHeaderLength())
+        delete queued;
+
+        // big payloads are written straight from the packet, which may be shared with the queues of other sockets
+        bool sharePayload = packet->size() >= SHARED_PAYLOAD_MIN_SIZE;
+        std::size_t bytesToCopy = header.getHeaderLength() + (sharePayload ? 0 : packet->size());
+
+        if (buffer.GetRemainingSpace() < bytesToCopy)
         {
             QueuePacket(std::move(buffer));
-            buffer.Resize(_sendBufferSize);
+            buffer = AcquireSendBuffer(_sendBufferSize);
         }
 
-        if (buffer.GetRemainingSpace() >= queued->size() + header.getHeaderLength())
+        if (buffer.GetRemainingSpace() >= bytesToCopy)
         {
             buffer.Write(header.header, header.getHeaderLength());
-            if (!queued->empty())
-                buffer.Write(queued->contents(), queued->size());
+            if (sharePayload)
+            {
+                // the header ends the current buffer, the payload is written after it and later packets go to a reused buffer
+                QueuePacket(std::move(buffer));
+                buffer = AcquireSendBuffer(_sendBufferSize);
+
+                std::size_t size = packet->size();
+                uint8 const* contents = packet->contents();
+                QueuePacket(std::shared_ptr<uint8 const>(std::move(packet), contents), size);
+            }
+            else if (!packet->empty())
+                buffer.Write(packet->contents(), packet->size());
         }
-        else    // single packet larger than 4096 bytes
+        else    // single packet larger than the send buffer
         {
-            MessageBuffer packetBuffer(queued->size() + header.getHeaderLength());
+            MessageBuffer packetBuffer(packet->size() + header.getHeaderLength());
             packetBuffer.Write(header.header, header.getHeaderLength());
-            if (!queued->empty())
-                packetBuffer.Write(queued->contents(), queued->size());
+            if (!packet->empty())
+                packetBuffer.Write(packet->contents(), packet->size());
 
             QueuePacket(std::move(packetBuffer));
         }
-
-        delete queued;
     }
 
     if (buffer.GetActiveSize() > 0)
         QueuePacket(std::move(buffer));
+    else
+        ReleaseSendBuffer(std::move(buffer));
 
     if (!BaseSocket::Update())
         return false;
@@ -420,6 +450,17 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
 
+    _bufferQueue.Enqueue(new EncryptablePacket(std::make_shared<WorldPacket>(packet), _authCrypt.IsInitialized()));
+}
+
+void WorldSocket::SendPacket(std::shared_ptr<WorldPacket const> const& packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket())
+        sPacketLog->LogPacket(*packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
+
     _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
 }
 
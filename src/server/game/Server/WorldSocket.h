@@ -30,16 +30,19 @@
 
 using boost::asio::ip::tcp;
 
-class EncryptablePacket : public WorldPacket
+class EncryptablePacket
 {
 public:
-    EncryptablePacket(WorldPacket const& packet, bool encrypt) : WorldPacket(packet), _encrypt(encrypt)
+    EncryptablePacket(std::shared_ptr<WorldPacket const> packet, bool encrypt) : Packet(std::move(packet)), _encrypt(encrypt)
     {
         SocketQueueLink.store(nullptr, std::memory_order_relaxed);
     }
 
     bool NeedsEncryption() const { return _encrypt; }
 
+    /// shared with the queues of every other socket the same packet was sent to
+    std::shared_ptr<WorldPacket const> Packet;
+
     std::atomic<EncryptablePacket*> SocketQueueLink;
 
 private:
@@ -80,6 +83,9 @@ public:
 
     void SendPacket(WorldPacket const& packet);
 
+    /// queues the packet without copying it, the packet must not be modified afterwards
+    void SendPacket(std::shared_ptr<WorldPacket const> const& packet);
+
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
 
 protected:
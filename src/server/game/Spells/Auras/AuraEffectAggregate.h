@@ -0,0 +1,56 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_AURAEFFECTAGGREGATE_H
+#define ACORE_AURAEFFECTAGGREGATE_H
+
+#include "Define.h"
+#include "Util.h"
+
+// Aggregated amounts of all aura effects of one AuraType applied to a unit.
+// Units cache one per type and drop it when an effect of that type is registered, unregistered
+// or changes its amount (see Unit::InvalidateAuraEffectAggregate).
+struct AuraEffectAggregate
+{
+    int32 Total = 0;
+    int32 MaxPositive = 0;
+    int32 MinNegative = 0;
+    float Multiplier = 1.0f;
+
+    // Effects must provide GetAmount(), the order matches the unit's effect list so Multiplier equals the uncached product
+    template<class EffectContainer>
+    void Compute(EffectContainer const& effects)
+    {
+        Total = 0;
+        MaxPositive = 0;
+        MinNegative = 0;
+        Multiplier = 1.0f;
+
+        for (auto const* effect : effects)
+        {
+            int32 amount = effect->GetAmount();
+            Total += amount;
+            if (amount > MaxPositive)
+                MaxPositive = amount;
+            if (amount < MinNegative)
+                MinNegative = amount;
+            AddPct(Multiplier, amount);
+        }
+    }
+};
+
+#endif
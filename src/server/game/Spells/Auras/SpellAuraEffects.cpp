@@ -381,7 +381,7 @@ pAuraEffectHandler AuraEffectHandler[TOTAL_AURAS] =
 
 AuraEffect::AuraEffect(Aura* base, uint8 effIndex, int32* baseAmount, Unit* caster):
     m_base(base), m_spellInfo(base->GetSpellInfo()),
-    m_baseAmount(baseAmount ? * baseAmount : m_spellInfo->Effects[effIndex].BasePoints), m_critChance(0),
+    m_baseAmount(baseAmount ? * baseAmount : m_spellInfo->Effects[effIndex].BasePoints), m_amount(0), m_critChance(0),
     m_oldAmount(0), m_isAuraEnabled(true), m_channelData(nullptr), m_spellmod(nullptr), m_periodicTimer(0), m_tickNumber(0), m_effIndex(effIndex),
     m_canBeRecalculated(true), m_isPeriodic(false)
 {
@@ -407,6 +407,25 @@ AuraEffect::~AuraEffect()
     delete m_channelData;
 }
 
+namespace
+{
+    ObjectPool& GetAuraEffectPool()
+    {
+        static ObjectPool pool("AuraEffect");
+        return pool;
+    }
+}
+
+void* AuraEffect::operator new(std::size_t size)
+{
+    return GetAuraEffectPool().Allocate(size);
+}
+
+void AuraEffect::operator delete(void* ptr, std::size_t size)
+{
+    GetAuraEffectPool().Deallocate(ptr, size);
+}
+
 void AuraEffect::GetTargetList(std::list<Unit*>& targetList) const
 {
     Aura::ApplicationMap const& targetMap = GetBase()->GetApplicationMap();
@@ -448,6 +467,33 @@ AuraType AuraEffect::GetAuraType() const
     return (AuraType)m_spellInfo->Effects[m_effIndex].ApplyAuraName;
 }
 
+void AuraEffect::InvalidateAggregates() const
+{
+    // the effect is registered on the targets of the aura applications
+    for (Aura::ApplicationMap::value_type const& application : GetBase()->GetApplicationMap())
+        application.second->GetTarget()->InvalidateAuraEffectAggregate(GetAuraType());
+}
+
+void AuraEffect::SetAmount(int32 amount)
+{
+    if (m_amount != amount)
+    {
+        m_amount = amount;
+        InvalidateAggregates();
+    }
+
+    m_canBeRecalculated = false;
+}
+
+void AuraEffect::SetEnabled(bool enabled)
+{
+    if (m_isAuraEnabled != enabled)
+    {
+        m_isAuraEnabled = enabled;
+        InvalidateAggregates();
+    }
+}
+
 int32 AuraEffect::CalculateAmount(Unit* caster)
 {
     int32 amount;
@@ -730,7 +776,10 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
     if (handleMask & AURA_EFFECT_HANDLE_CHANGE_AMOUNT)
     {
         if (!mark)
+        {
             m_amount = newAmount;
+            InvalidateAggregates();
+        }
         else
             SetAmount(newAmount);
         CalculateSpellMod();
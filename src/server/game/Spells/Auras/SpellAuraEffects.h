@@ -37,6 +37,9 @@ private:
     ~AuraEffect();
     explicit AuraEffect(Aura* base, uint8 effIndex, int32* baseAmount, Unit* caster);
 public:
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     Unit* GetCaster() const { return GetBase()->GetCaster(); }
     ObjectGuid GetCasterGUID() const { return GetBase()->GetCasterGUID(); }
     Aura* GetBase() const { return m_base; }
@@ -55,7 +58,7 @@ public:
     AuraType GetAuraType() const;
     int32 GetAmount() const { return m_isAuraEnabled ? m_amount : 0; }
     int32 GetForcedAmount() const { return m_amount; }
-    void SetAmount(int32 amount) { m_amount = amount; m_canBeRecalculated = false;}
+    void SetAmount(int32 amount);
 
     int32 GetPeriodicTimer() const { return m_periodicTimer; }
     void SetPeriodicTimer(int32 periodicTimer) { m_periodicTimer = periodicTimer; }
@@ -107,9 +110,12 @@ public:
     uint32 GetAuraGroup() const { return m_auraGroup; }
     int32 GetOldAmount() const { return m_oldAmount; }
     void SetOldAmount(int32 amount) { m_oldAmount = amount; }
-    void SetEnabled(bool enabled) { m_isAuraEnabled = enabled; }
+    void SetEnabled(bool enabled);
 
 private:
+    // drops the aggregates the targets cached for the type of the effect, after its amount changed in place
+    void InvalidateAggregates() const;
+
     Aura* const m_base;
 
     SpellInfo const* const m_spellInfo;
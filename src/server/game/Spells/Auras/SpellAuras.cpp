@@ -39,6 +39,31 @@
 // update aura target map every 500 ms instead of every update - reduce amount of grid searcher calls
 static constexpr int32 UPDATE_TARGET_MAP_INTERVAL = 500;
 
+namespace
+{
+    ObjectPool& GetAuraPool()
+    {
+        static ObjectPool pool("Aura");
+        return pool;
+    }
+
+    ObjectPool& GetAuraApplicationPool()
+    {
+        static ObjectPool pool("AuraApplication");
+        return pool;
+    }
+}
+
+void* AuraApplication::operator new(std::size_t size)
+{
+    return GetAuraApplicationPool().Allocate(size);
+}
+
+void AuraApplication::operator delete(void* ptr, std::size_t size)
+{
+    GetAuraApplicationPool().Deallocate(ptr, size);
+}
+
 AuraApplication::AuraApplication(Unit* target, Unit* caster, Aura* aura, uint8 effMask):
     _target(target), _base(aura), _removeMode(AURA_REMOVE_NONE), _slot(MAX_AURAS),
     _flags(AFLAG_NONE), _effectsToApply(effMask), _needClientUpdate(false), _disableMask(0)
@@ -458,6 +483,16 @@ Aura::~Aura()
     _DeleteRemovedApplications();
 }
 
+void* Aura::operator new(std::size_t size)
+{
+    return GetAuraPool().Allocate(size);
+}
+
+void Aura::operator delete(void* ptr, std::size_t size)
+{
+    GetAuraPool().Deallocate(ptr, size);
+}
+
 uint32 Aura::GetId() const
 {
     return GetSpellInfo()->Id;
@@ -18,6 +18,7 @@
 #ifndef ACORE_SPELLAURAS_H
 #define ACORE_SPELLAURAS_H
 
+#include "ObjectPool.h"
 #include "SpellAuraDefines.h"
 #include "Unit.h"
 
@@ -58,6 +59,9 @@ private:
     void _InitFlags(Unit* caster, uint8 effMask);
     void _HandleEffect(uint8 effIndex, bool apply);
 public:
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     Unit* GetTarget() const { return _target; }
     Aura* GetBase() const { return _base; }
 
@@ -97,6 +101,10 @@ public:
     void _InitEffects(uint8 effMask, Unit* caster, int32* baseAmount);
     virtual ~Aura();
 
+    // shared by UnitAura and DynObjAura, the virtual destructor passes the size of the derived type
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     SpellInfo const* GetSpellInfo() const { return m_spellInfo; }
     uint32 GetId() const;
 
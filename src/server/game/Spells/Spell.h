@@ -20,6 +20,7 @@
 
 #include "GridDefines.h"
 #include "ObjectMgr.h"
+#include "ObjectPool.h"
 #include "PathGenerator.h"
 #include "SharedDefines.h"
 #include "SpellInfo.h"
@@ -272,6 +273,13 @@ public:
     Spell(Unit* caster, SpellInfo const* info, TriggerCastFlags triggerFlags, ObjectGuid originalCasterGUID = ObjectGuid::Empty, bool skipCheck = false);
     ~Spell();
 
+    // spells are allocated from a pool, every cast creates and destroys one
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+    static ObjectPool& GetTargetInfoPool();
+
+    typedef std::list<TargetInfo, ObjectPoolAllocator<TargetInfo, &Spell::GetTargetInfoPool>> TargetInfoList;
+
     void EffectNULL(SpellEffIndex effIndex);
     void EffectUnused(SpellEffIndex effIndex);
     void EffectDistract(SpellEffIndex effIndex);
@@ -555,7 +563,7 @@ public:
 
     // xinef: moved to public
     void LoadScripts();
-    std::list<TargetInfo>* GetUniqueTargetInfo() { return &m_UniqueTargetInfo; }
+    TargetInfoList* GetUniqueTargetInfo() { return &m_UniqueTargetInfo; }
 
     [[nodiscard]] uint32 GetTriggeredByAuraTickNumber() const { return m_triggeredByAuraTickNumber; }
 
@@ -644,7 +652,7 @@ public:
     // *****************************************
     // Spell target subsystem
     // *****************************************
-    std::list<TargetInfo> m_UniqueTargetInfo;
+    TargetInfoList m_UniqueTargetInfo;
     uint8 m_channelTargetEffectMask;                        // Mask req. alive targets
 
     struct GOTargetInfo
@@ -856,6 +856,8 @@ SpellInfo::SpellInfo(SpellEntry const* spellEntry)
     ExplicitTargetMask = 0;
 
     // Mine
+    _auraState = AURA_STATE_NONE;
+    _spellSpecific = SPELL_SPECIFIC_NORMAL;
     _isStackableWithRanks = false;
     _isSpellValid = true;
     _isCritCapable = false;
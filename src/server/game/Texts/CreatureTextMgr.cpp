@@ -85,7 +85,11 @@ void CreatureTextMgr::LoadCreatureTexts()
     uint32 oldMSTime = getMSTime();
 
     mTextMap.clear(); // for reload case
-    mTextRepeatMap.clear(); //reset all currently used temp texts
+
+    {
+        std::lock_guard<std::mutex> guard(mTextRepeatLock);
+        mTextRepeatMap.clear(); //reset all currently used temp texts
+    }
 
     WorldDatabasePreparedStatement* stmt = WorldDatabase.GetPreparedStatement(WORLD_SEL_CREATURE_TEXT);
     PreparedQueryResult result = WorldDatabase.Query(stmt);
@@ -229,6 +233,7 @@ uint32 CreatureTextMgr::SendChat(Creature* source, uint8 textGroup, WorldObject
 
     if (tempGroup.empty())
     {
+        std::lock_guard<std::mutex> guard(mTextRepeatLock);
         CreatureTextRepeatMap::iterator mapItr = mTextRepeatMap.find(source->GetGUID());
         if (mapItr != mTextRepeatMap.end())
         {
@@ -419,6 +424,7 @@ void CreatureTextMgr::SetRepeatId(Creature* source, uint8 textGroup, uint8 id)
     if (!source)
         return;
 
+    std::lock_guard<std::mutex> guard(mTextRepeatLock);
     CreatureTextRepeatIds& repeats = mTextRepeatMap[source->GetGUID()][textGroup];
     if (std::find(repeats.begin(), repeats.end(), id) == repeats.end())
         repeats.push_back(id);
@@ -432,6 +438,7 @@ CreatureTextRepeatIds CreatureTextMgr::GetRepeatGroup(Creature* source, uint8 te
     ASSERT(source);//should never happen
     CreatureTextRepeatIds ids;
 
+    std::lock_guard<std::mutex> guard(mTextRepeatLock);
     CreatureTextRepeatMap::const_iterator mapItr = mTextRepeatMap.find(source->GetGUID());
     if (mapItr != mTextRepeatMap.end())
     {
@@ -23,6 +23,7 @@
 #include "ObjectAccessor.h"
 #include "Opcodes.h"
 #include "SharedDefines.h"
+#include <mutex>
 
 enum CreatureTextRange
 {
@@ -112,6 +113,7 @@ private:
 
     CreatureTextMap mTextMap;
     CreatureTextRepeatMap mTextRepeatMap;
+    std::mutex mTextRepeatLock;                 // creatures of every map (and of every region of a continent) talk at once
     LocaleCreatureTextMap mLocaleTextMap;
 };
 
@@ -176,6 +176,13 @@ enum WorldBoolConfigs
     CONFIG_REGEN_HP_CANNOT_REACH_TARGET_IN_RAID,
     CONFIG_SET_BOP_ITEM_TRADEABLE,
     CONFIG_ALLOW_LOGGING_IP_ADDRESSES_IN_DATABASE,
+    CONFIG_MAPUPDATE_AFFINITY,
+    CONFIG_MAPUPDATE_COST_ORDERING,
+    CONFIG_MAPUPDATE_PIN_THREADS,
+    CONFIG_COMPRESSION_OFFLOAD,
+    CONFIG_OPCODE_COSTS,
+    CONFIG_VISIBILITY_INCREMENTAL,
+    CONFIG_MEMORY_MAPPED_MAP_FILES,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -322,6 +329,8 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_MAPUPDATE_REGIONS_THREADS,
+    CONFIG_MAPUPDATE_REGIONS_GRID_SIZE,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_TELEPORT_TIMEOUT_NEAR, // pussywizard
@@ -396,6 +405,12 @@ enum WorldIntConfigs
     CONFIG_NPC_REGEN_TIME_IF_NOT_REACHABLE_IN_RAID,
     CONFIG_FFA_PVP_TIMER,
     CONFIG_LOOT_NEED_BEFORE_GREED_ILVL_RESTRICTION,
+    CONFIG_OPCODE_COSTS_LOG_INTERVAL,
+    CONFIG_WORLD_LOADING_THREADS,
+    CONFIG_VISIBILITY_FULL_SCAN_INTERVAL,
+    CONFIG_MMAP_ASYNC_THREADS,
+    CONFIG_MMAP_ASYNC_MAX_QUEUE,
+    CONFIG_MMAP_PATH_CACHE_SIZE,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -0,0 +1,187 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoadingGraph.h"
+#include "Errors.h"
+#include "Log.h"
+#include "Timer.h"
+#include <algorithm>
+#include <thread>
+
+LoadingGraph::LoadingGraph(std::string name) : _name(std::move(name)), _runStartTime(0), _wallTime(0), _threads(1), _finished(0)
+{
+}
+
+LoadingGraph::TaskId LoadingGraph::Add(std::string name, std::function<void()> loader, std::initializer_list<TaskId> dependencies)
+{
+    TaskId id = TaskId(_tasks.size());
+
+    Task task;
+    task.Name = std::move(name);
+    task.Loader = std::move(loader);
+    task.Dependencies.assign(dependencies.begin(), dependencies.end());
+    task.PendingDependencies = 0;
+    task.StartTime = 0;
+    task.Duration = 0;
+
+    for (TaskId dependency : task.Dependencies)
+    {
+        ASSERT(dependency < id, "LoadingGraph %s: loader %s depends on a loader added after it", _name.c_str(), task.Name.c_str());
+        _tasks[dependency].Dependents.push_back(id);
+    }
+
+    _tasks.push_back(std::move(task));
+    return id;
+}
+
+void LoadingGraph::Run(uint32 threads)
+{
+    _runStartTime = getMSTime();
+    _threads = std::max<uint32>(1, std::min<uint32>(threads, uint32(_tasks.size())));
+
+    if (_threads == 1)
+    {
+        for (TaskId id = 0; id < _tasks.size(); ++id)
+            Execute(id);
+    }
+    else
+    {
+        _finished = 0;
+        _ready.clear();
+
+        for (TaskId id = 0; id < _tasks.size(); ++id)
+        {
+            _tasks[id].PendingDependencies = uint32(_tasks[id].Dependencies.size());
+            if (!_tasks[id].PendingDependencies)
+                _ready.push_back(id);
+        }
+
+        std::vector<std::thread> workers;
+        workers.reserve(_threads - 1);
+        for (uint32 i = 1; i < _threads; ++i)
+            workers.emplace_back(&LoadingGraph::WorkerThread, this);
+
+        WorkerThread();
+
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+    _wallTime = GetMSTimeDiffToNow(_runStartTime);
+}
+
+void LoadingGraph::Execute(TaskId id)
+{
+    Task& task = _tasks[id];
+
+    uint32 startTime = getMSTime();
+    task.Loader();
+
+    task.StartTime = getMSTimeDiff(_runStartTime, startTime);
+    task.Duration = GetMSTimeDiffToNow(startTime);
+}
+
+void LoadingGraph::WorkerThread()
+{
+    std::unique_lock<std::mutex> guard(_lock);
+
+    while (true)
+    {
+        while (_ready.empty() && _finished < _tasks.size())
+            _condition.wait(guard);
+
+        if (_finished == _tasks.size())
+            return;
+
+        TaskId id = _ready.front();
+        _ready.pop_front();
+
+        guard.unlock();
+        Execute(id);
+        guard.lock();
+
+        ++_finished;
+        for (TaskId dependent : _tasks[id].Dependents)
+            if (!--_tasks[dependent].PendingDependencies)
+                _ready.push_back(dependent);
+
+        _condition.notify_all();
+    }
+}
+
+void LoadingGraph::LogReport() const
+{
+    if (_tasks.empty())
+        return;
+
+    // longest chain of dependent loaders, tasks are stored in a valid topological order
+    std::vector<uint32> pathTime(_tasks.size(), 0);
+    std::vector<TaskId> pathPrevious(_tasks.size(), TaskId(-1));
+    TaskId pathEnd = 0;
+    uint32 sumTime = 0;
+
+    for (TaskId id = 0; id < _tasks.size(); ++id)
+    {
+        Task const& task = _tasks[id];
+        for (TaskId dependency : task.Dependencies)
+        {
+            if (pathTime[dependency] >= pathTime[id])
+            {
+                pathTime[id] = pathTime[dependency];
+                pathPrevious[id] = dependency;
+            }
+        }
+
+        pathTime[id] += task.Duration;
+        sumTime += task.Duration;
+
+        if (pathTime[id] > pathTime[pathEnd])
+            pathEnd = id;
+    }
+
+    LOG_INFO("server.loading", ">> %s: %u loaders on %u thread(s) in %u ms (%u ms of loading, critical path %u ms)",
+        _name.c_str(), uint32(_tasks.size()), _threads, _wallTime, sumTime, pathTime[pathEnd]);
+
+    std::vector<Task const*> sorted;
+    sorted.reserve(_tasks.size());
+    for (Task const& task : _tasks)
+        sorted.push_back(&task);
+
+    std::stable_sort(sorted.begin(), sorted.end(), [](Task const* left, Task const* right)
+    {
+        return left->Duration > right->Duration;
+    });
+
+    for (Task const* task : sorted)
+        LOG_INFO("server.loading", "   %-40s %6u ms (started at +%u ms)", task->Name.c_str(), task->Duration, task->StartTime);
+
+    std::vector<TaskId> path;
+    for (TaskId id = pathEnd; id != TaskId(-1); id = pathPrevious[id])
+        path.push_back(id);
+
+    std::string pathStr;
+    for (auto itr = path.rbegin(); itr != path.rend(); ++itr)
+    {
+        if (!pathStr.empty())
+            pathStr += " -> ";
+
+        pathStr += _tasks[*itr].Name;
+    }
+
+    LOG_INFO("server.loading", "   Critical path: %s", pathStr.c_str());
+    LOG_INFO("server.loading", " ");
+}
@@ -0,0 +1,80 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _LOADING_GRAPH_H
+#define _LOADING_GRAPH_H
+
+#include "Define.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * Runs a set of startup loaders respecting the dependencies declared between them.
+ *
+ * Loaders without pending dependencies are executed concurrently by a small pool of
+ * threads (the calling thread takes part too), each loader querying the database through
+ * its own synchronous connection. A dependency must be added before the loaders relying
+ * on it, so the insertion order is always a valid sequential order.
+ */
+class AC_GAME_API LoadingGraph
+{
+public:
+    typedef uint32 TaskId;
+
+    explicit LoadingGraph(std::string name);
+
+    TaskId Add(std::string name, std::function<void()> loader, std::initializer_list<TaskId> dependencies = {});
+
+    // runs every loader and waits for all of them, threads <= 1 loads sequentially in insertion order
+    void Run(uint32 threads);
+
+    // logs the time spent by every loader and the chain of loaders that bounded the total time
+    void LogReport() const;
+
+private:
+    struct Task
+    {
+        std::string Name;
+        std::function<void()> Loader;
+        std::vector<TaskId> Dependencies;
+        std::vector<TaskId> Dependents;
+        uint32 PendingDependencies;
+        uint32 StartTime;       // ms since the start of Run()
+        uint32 Duration;        // ms
+    };
+
+    void Execute(TaskId id);
+    void WorkerThread();
+
+    std::string _name;
+    std::vector<Task> _tasks;
+    uint32 _runStartTime;
+    uint32 _wallTime;
+    uint32 _threads;
+
+    std::mutex _lock;
+    std::condition_variable _condition;
+    std::deque<TaskId> _ready;
+    uint32 _finished;
+};
+
+#endif
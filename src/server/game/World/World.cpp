@@ -55,12 +55,14 @@
 #include "ItemEnchantmentMgr.h"
 #include "LFGMgr.h"
 #include "Language.h"
+#include "LoadingGraph.h"
 #include "Log.h"
 #include "LootItemStorage.h"
 #include "LootMgr.h"
 #include "MMapFactory.h"
 #include "MapMgr.h"
 #include "ObjectMgr.h"
+#include "OpcodeCostTracker.h"
 #include "Opcodes.h"
 #include "OutdoorPvPMgr.h"
 #include "PetitionMgr.h"
@@ -651,6 +653,17 @@ void World::LoadConfigSettings(bool reload)
         LOG_ERROR("server.loading", "Compression level (%u) must be in range 1..9. Using default compression level (1).", m_int_configs[CONFIG_COMPRESSION]);
         m_int_configs[CONFIG_COMPRESSION] = 1;
     }
+
+    m_bool_configs[CONFIG_COMPRESSION_OFFLOAD] = sConfigMgr->GetOption<bool>("Compression.Offload", false);
+
+    m_bool_configs[CONFIG_OPCODE_COSTS] = sConfigMgr->GetOption<bool>("Network.OpcodeCosts", false);
+    sOpcodeCostTracker->SetEnabled(m_bool_configs[CONFIG_OPCODE_COSTS]);
+    m_int_configs[CONFIG_OPCODE_COSTS_LOG_INTERVAL] = sConfigMgr->GetOption<int32>("Network.OpcodeCosts.LogInterval", 0);
+    if (reload)
+    {
+        m_timers[WUPDATE_OPCODE_COSTS].SetInterval(m_int_configs[CONFIG_OPCODE_COSTS_LOG_INTERVAL] * MINUTE * IN_MILLISECONDS);
+        m_timers[WUPDATE_OPCODE_COSTS].Reset();
+    }
     m_bool_configs[CONFIG_ADDON_CHANNEL]                   = sConfigMgr->GetOption<bool>("AddonChannel", true);
     m_bool_configs[CONFIG_CLEAN_CHARACTER_DB]              = sConfigMgr->GetOption<bool>("CleanCharacterDB", false);
     m_int_configs[CONFIG_PERSISTENT_CHARACTER_CLEAN_FLAGS] = sConfigMgr->GetOption<int32>("PersistentCharacterCleanFlags", 0);
@@ -1233,6 +1246,9 @@ void World::LoadConfigSettings(bool reload)
         m_MaxVisibleDistanceInBGArenas = MAX_VISIBILITY_DISTANCE;
     }
 
+    m_bool_configs[CONFIG_VISIBILITY_INCREMENTAL] = sConfigMgr->GetOption<bool>("Visibility.Incremental", false);
+    m_int_configs[CONFIG_VISIBILITY_FULL_SCAN_INTERVAL] = sConfigMgr->GetOption<int32>("Visibility.Incremental.FullScanInterval", 5000);
+
     ///- Load the CharDelete related config options
     m_int_configs[CONFIG_CHARDELETE_METHOD]    = sConfigMgr->GetOption<int32>("CharDelete.Method", 0);
     m_int_configs[CONFIG_CHARDELETE_MIN_LEVEL] = sConfigMgr->GetOption<int32>("CharDelete.MinLevel", 0);
@@ -1307,6 +1323,17 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE]         = sConfigMgr->GetOption<int32>("RecordUpdateTimeDiffInterval", 300000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE]              = sConfigMgr->GetOption<int32>("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS]                  = sConfigMgr->GetOption<int32>("MapUpdate.Threads", 1);
+    m_bool_configs[CONFIG_MAPUPDATE_AFFINITY]         = sConfigMgr->GetOption<bool>("MapUpdate.Affinity", true);
+    m_bool_configs[CONFIG_MAPUPDATE_COST_ORDERING]    = sConfigMgr->GetOption<bool>("MapUpdate.CostOrdering", true);
+    m_bool_configs[CONFIG_MAPUPDATE_PIN_THREADS]      = sConfigMgr->GetOption<bool>("MapUpdate.PinThreads", false);
+    m_int_configs[CONFIG_MAPUPDATE_REGIONS_THREADS]   = sConfigMgr->GetOption<int32>("MapUpdate.Regions.Threads", 0);
+    m_int_configs[CONFIG_MAPUPDATE_REGIONS_GRID_SIZE] = sConfigMgr->GetOption<int32>("MapUpdate.Regions.GridSize", 8);
+    if (m_int_configs[CONFIG_MAPUPDATE_REGIONS_GRID_SIZE] < 2 || m_int_configs[CONFIG_MAPUPDATE_REGIONS_GRID_SIZE] > MAX_NUMBER_OF_GRIDS)
+    {
+        LOG_ERROR("server.loading", "MapUpdate.Regions.GridSize (%u) must be in range 2..%u. Set to 8.", m_int_configs[CONFIG_MAPUPDATE_REGIONS_GRID_SIZE], MAX_NUMBER_OF_GRIDS);
+        m_int_configs[CONFIG_MAPUPDATE_REGIONS_GRID_SIZE] = 8;
+    }
+    m_int_configs[CONFIG_WORLD_LOADING_THREADS]       = sConfigMgr->GetOption<int32>("WorldLoading.Threads", 1);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetOption<int32>("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1342,6 +1369,9 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_PDUMP_NO_PATHS]     = sConfigMgr->GetOption<bool>("PlayerDump.DisallowPaths", true);
     m_bool_configs[CONFIG_PDUMP_NO_OVERWRITE] = sConfigMgr->GetOption<bool>("PlayerDump.DisallowOverwrite", true);
     m_bool_configs[CONFIG_ENABLE_MMAPS]       = sConfigMgr->GetOption<bool>("MoveMaps.Enable", true);
+    m_int_configs[CONFIG_MMAP_ASYNC_THREADS]   = sConfigMgr->GetOption<int32>("MoveMaps.AsyncThreads", 0);
+    m_int_configs[CONFIG_MMAP_ASYNC_MAX_QUEUE] = sConfigMgr->GetOption<int32>("MoveMaps.AsyncMaxQueue", 1000);
+    m_int_configs[CONFIG_MMAP_PATH_CACHE_SIZE] = sConfigMgr->GetOption<int32>("MoveMaps.PathCacheSize", 0);
     MMAP::MMapFactory::InitializeDisabledMaps();
 
     // Wintergrasp
@@ -1376,6 +1406,9 @@ void World::LoadConfigSettings(bool reload)
     // Preload all grids of all non-instanced maps
     m_bool_configs[CONFIG_PRELOAD_ALL_NON_INSTANCED_MAP_GRIDS] = sConfigMgr->GetOption<bool>("PreloadAllNonInstancedMapGrids", false);
 
+    // Reference the terrain of the .map files from a shared memory mapping instead of reading it
+    m_bool_configs[CONFIG_MEMORY_MAPPED_MAP_FILES] = sConfigMgr->GetOption<bool>("MemoryMappedMapFiles", false);
+
     // ICC buff override
     m_int_configs[CONFIG_ICC_BUFF_HORDE] = sConfigMgr->GetOption<int32>("ICC.Buff.Horde", 73822);
     m_int_configs[CONFIG_ICC_BUFF_ALLIANCE] = sConfigMgr->GetOption<int32>("ICC.Buff.Alliance", 73828);
@@ -1446,6 +1479,15 @@ void World::SetInitialWorldSettings()
     ///- Initialize config settings
     LoadConfigSettings();
 
+    ///- Every concurrent loader needs its own synchronous world database connection
+    uint32 loadingThreads = std::max<uint32>(1, getIntConfig(CONFIG_WORLD_LOADING_THREADS));
+    if (loadingThreads > WorldDatabase.GetSynchConnectionCount())
+    {
+        LOG_WARN("server.loading", "WorldLoading.Threads (%u) is higher than WorldDatabase.SynchThreads (%u), using %u loading threads. Raise WorldDatabase.SynchThreads to load faster.",
+            loadingThreads, uint32(WorldDatabase.GetSynchConnectionCount()), uint32(WorldDatabase.GetSynchConnectionCount()));
+        loadingThreads = uint32(WorldDatabase.GetSynchConnectionCount());
+    }
+
     ///- Initialize Allowed Security Level
     LoadDBAllowedSecurityLevel();
 
@@ -1516,6 +1558,7 @@ void World::SetInitialWorldSettings()
 
     MMAP::MMapMgr* mmmgr = MMAP::MMapFactory::createOrGetMMapMgr();
     mmmgr->InitializeThreadUnsafe(mapIds);
+    mmmgr->GetPathCache().SetCapacity(getIntConfig(CONFIG_MMAP_PATH_CACHE_SIZE));
 
     LOG_INFO("server.loading", "Loading Game Graveyard...");
     sGraveyard->LoadGraveyardFromDB();
@@ -1561,17 +1604,23 @@ void World::SetInitialWorldSettings()
 
     LOG_INFO("server.loading", "Loading Localization strings...");
     uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadItemLocales();
-    sObjectMgr->LoadItemSetNameLocales();
-    sObjectMgr->LoadQuestLocales();
-    sObjectMgr->LoadQuestOfferRewardLocale();
-    sObjectMgr->LoadQuestRequestItemsLocale();
-    sObjectMgr->LoadNpcTextLocales();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
+    {
+        // every locale loader fills its own store
+        LoadingGraph localesGraph("Localization strings");
+        localesGraph.Add("creature_template_locale", [] { sObjectMgr->LoadCreatureLocales(); });
+        localesGraph.Add("gameobject_template_locale", [] { sObjectMgr->LoadGameObjectLocales(); });
+        localesGraph.Add("item_template_locale", [] { sObjectMgr->LoadItemLocales(); });
+        localesGraph.Add("item_set_names_locale", [] { sObjectMgr->LoadItemSetNameLocales(); });
+        localesGraph.Add("quest_template_locale", [] { sObjectMgr->LoadQuestLocales(); });
+        localesGraph.Add("quest_offer_reward_locale", [] { sObjectMgr->LoadQuestOfferRewardLocale(); });
+        localesGraph.Add("quest_request_items_locale", [] { sObjectMgr->LoadQuestRequestItemsLocale(); });
+        localesGraph.Add("npc_text_locale", [] { sObjectMgr->LoadNpcTextLocales(); });
+        localesGraph.Add("page_text_locale", [] { sObjectMgr->LoadPageTextLocales(); });
+        localesGraph.Add("gossip_menu_option_locale", [] { sObjectMgr->LoadGossipMenuItemsLocales(); });
+        localesGraph.Add("points_of_interest_locale", [] { sObjectMgr->LoadPointOfInterestLocales(); });
+        localesGraph.Run(loadingThreads);
+        localesGraph.LogReport();
+    }
 
     sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
     LOG_INFO("server.loading", ">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
@@ -1787,33 +1836,87 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server.loading", "Loading Player level dependent mail rewards...");
     sObjectMgr->LoadMailLevelRewards();
 
-    // Loot tables
-    LoadLootTables();
+    {
+        LoadingGraph lootGraph("Loot, skill and achievement tables");
+
+        // Loot tables, the reference templates check the references made by all the other stores
+        LoadingGraph::TaskId lootCreature = lootGraph.Add("creature_loot_template", [] { LoadLootTemplates_Creature(); });
+        LoadingGraph::TaskId lootFishing = lootGraph.Add("fishing_loot_template", [] { LoadLootTemplates_Fishing(); });
+        LoadingGraph::TaskId lootGameobject = lootGraph.Add("gameobject_loot_template", [] { LoadLootTemplates_Gameobject(); });
+        LoadingGraph::TaskId lootItem = lootGraph.Add("item_loot_template", [] { LoadLootTemplates_Item(); });
+        LoadingGraph::TaskId lootMail = lootGraph.Add("mail_loot_template", [] { LoadLootTemplates_Mail(); });
+        LoadingGraph::TaskId lootMilling = lootGraph.Add("milling_loot_template", [] { LoadLootTemplates_Milling(); });
+        LoadingGraph::TaskId lootPickpocketing = lootGraph.Add("pickpocketing_loot_template", [] { LoadLootTemplates_Pickpocketing(); });
+        LoadingGraph::TaskId lootSkinning = lootGraph.Add("skinning_loot_template", [] { LoadLootTemplates_Skinning(); });
+        LoadingGraph::TaskId lootDisenchant = lootGraph.Add("disenchant_loot_template", [] { LoadLootTemplates_Disenchant(); });
+        LoadingGraph::TaskId lootProspecting = lootGraph.Add("prospecting_loot_template", [] { LoadLootTemplates_Prospecting(); });
+        LoadingGraph::TaskId lootSpell = lootGraph.Add("spell_loot_template", [] { LoadLootTemplates_Spell(); });
+        lootGraph.Add("reference_loot_template", [] { LoadLootTemplates_Reference(); },
+            { lootCreature, lootFishing, lootGameobject, lootItem, lootMail, lootMilling, lootPickpocketing, lootSkinning, lootDisenchant, lootProspecting, lootSpell });
+
+        lootGraph.Add("skill_discovery_template", []
+        {
+            LOG_INFO("server.loading", "Loading Skill Discovery Table...");
+            LoadSkillDiscoveryTable();
+        });
+
+        lootGraph.Add("skill_extra_item_template", []
+        {
+            LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
+            LoadSkillExtraItemTable();
+        });
+
+        lootGraph.Add("skill_perfect_item_template", []
+        {
+            LOG_INFO("server.loading", "Loading Skill Perfection Data Table...");
+            LoadSkillPerfectItemTable();
+        });
+
+        lootGraph.Add("skill_fishing_base_level", []
+        {
+            LOG_INFO("server.loading", "Loading Skill Fishing base level requirements...");
+            sObjectMgr->LoadFishingBaseSkillLevel();
+        });
+
+        lootGraph.Add("achievement references", []
+        {
+            LOG_INFO("server.loading", "Loading Achievements...");
+            sAchievementMgr->LoadAchievementReferenceList();
+        });
+
+        LoadingGraph::TaskId criteriaList = lootGraph.Add("achievement criteria", []
+        {
+            LOG_INFO("server.loading", "Loading Achievement Criteria Lists...");
+            sAchievementMgr->LoadAchievementCriteriaList();
+        });
 
-    LOG_INFO("server.loading", "Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
+        lootGraph.Add("achievement_criteria_data", []
+        {
+            LOG_INFO("server.loading", "Loading Achievement Criteria Data...");
+            sAchievementMgr->LoadAchievementCriteriaData();
+        }, { criteriaList });
 
-    LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
+        LoadingGraph::TaskId rewards = lootGraph.Add("achievement_reward", []
+        {
+            LOG_INFO("server.loading", "Loading Achievement Rewards...");
+            sAchievementMgr->LoadRewards();
+        });
 
-    LOG_INFO("server.loading", "Loading Skill Perfection Data Table...");
-    LoadSkillPerfectItemTable();
+        lootGraph.Add("achievement_reward_locale", []
+        {
+            LOG_INFO("server.loading", "Loading Achievement Reward Locales...");
+            sAchievementMgr->LoadRewardLocales();
+        }, { rewards });
 
-    LOG_INFO("server.loading", "Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
+        lootGraph.Add("character_achievement", []
+        {
+            LOG_INFO("server.loading", "Loading Completed Achievements...");
+            sAchievementMgr->LoadCompletedAchievements();
+        });
 
-    LOG_INFO("server.loading", "Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    LOG_INFO("server.loading", "Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    LOG_INFO("server.loading", "Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    LOG_INFO("server.loading", "Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    LOG_INFO("server.loading", "Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    LOG_INFO("server.loading", "Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+        lootGraph.Run(loadingThreads);
+        lootGraph.LogReport();
+    }
 
     ///- Load dynamic data tables from the database
     LOG_INFO("server.loading", "Loading Item Auctions...");
@@ -1841,26 +1944,54 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server.loading", "Loading GameTeleports...");
     sObjectMgr->LoadGameTele();
 
-    LOG_INFO("server.loading", "Loading Gossip menu...");
-    sObjectMgr->LoadGossipMenu();
+    {
+        LoadingGraph npcGraph("Gossip, vendor, trainer and waypoint tables");
+
+        LoadingGraph::TaskId gossipMenu = npcGraph.Add("gossip_menu", []
+        {
+            LOG_INFO("server.loading", "Loading Gossip menu...");
+            sObjectMgr->LoadGossipMenu();
+        });
+
+        npcGraph.Add("gossip_menu_option", []
+        {
+            LOG_INFO("server.loading", "Loading Gossip menu options...");
+            sObjectMgr->LoadGossipMenuItems();
+        }, { gossipMenu });
 
-    LOG_INFO("server.loading", "Loading Gossip menu options...");
-    sObjectMgr->LoadGossipMenuItems();
+        npcGraph.Add("npc_vendor", []
+        {
+            LOG_INFO("server.loading", "Loading Vendors...");
+            sObjectMgr->LoadVendors();                           // must be after load CreatureTemplate and ItemTemplate
+        });
 
-    LOG_INFO("server.loading", "Loading Vendors...");
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
+        npcGraph.Add("npc_trainer", []
+        {
+            LOG_INFO("server.loading", "Loading Trainers...");
+            sObjectMgr->LoadTrainerSpell();                      // must be after load CreatureTemplate
+        });
 
-    LOG_INFO("server.loading", "Loading Trainers...");
-    sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
+        npcGraph.Add("waypoint_data", []
+        {
+            LOG_INFO("server.loading", "Loading Waypoints...");
+            sWaypointMgr->Load();
+        });
 
-    LOG_INFO("server.loading", "Loading Waypoints...");
-    sWaypointMgr->Load();
+        npcGraph.Add("waypoints", []
+        {
+            LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
+            sSmartWaypointMgr->LoadFromDB();
+        });
 
-    LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
+        npcGraph.Add("creature_formations", []
+        {
+            LOG_INFO("server.loading", "Loading Creature Formations...");
+            sFormationMgr->LoadCreatureFormations();
+        });
 
-    LOG_INFO("server.loading", "Loading Creature Formations...");
-    sFormationMgr->LoadCreatureFormations();
+        npcGraph.Run(loadingThreads);
+        npcGraph.LogReport();
+    }
 
     LOG_INFO("server.loading", "Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
     LoadWorldStates();
@@ -1967,6 +2098,8 @@ void World::SetInitialWorldSettings()
     // our speed up
     m_timers[WUPDATE_5_SECS].SetInterval(5 * IN_MILLISECONDS);
 
+    m_timers[WUPDATE_OPCODE_COSTS].SetInterval(getIntConfig(CONFIG_OPCODE_COSTS_LOG_INTERVAL) * MINUTE * IN_MILLISECONDS);
+
     mail_expire_check_timer = time(nullptr) + 6 * 3600;
 
     ///- Initilize static helper structures
@@ -2361,6 +2494,14 @@ void World::Update(uint32 diff)
         WorldDatabase.KeepAlive();
     }
 
+    ///- Dump the cost of the client opcodes handled since the server started
+    if (getIntConfig(CONFIG_OPCODE_COSTS_LOG_INTERVAL) && m_timers[WUPDATE_OPCODE_COSTS].Passed())
+    {
+        m_timers[WUPDATE_OPCODE_COSTS].Reset();
+        if (sOpcodeCostTracker->IsEnabled())
+            sOpcodeCostTracker->LogStats(0);
+    }
+
     // update the instance reset times
     sInstanceSaveMgr->Update();
 
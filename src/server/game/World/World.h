@@ -69,6 +69,7 @@ enum WorldTimers
     WUPDATE_MAILBOXQUEUE,
     WUPDATE_PINGDB,
     WUPDATE_5_SECS,
+    WUPDATE_OPCODE_COSTS,
     WUPDATE_COUNT
 };
 
@@ -22,12 +22,22 @@ Comment: All server related commands
 Category: commandscripts
 EndScriptData */
 
+#include "AsyncAuctionListing.h"
+#include "AsyncPathfinder.h"
 #include "AvgDiffTracker.h"
+#include "CharacterSaveTracker.h"
 #include "Chat.h"
 #include "Config.h"
+#include "DatabaseEnv.h"
 #include "GitRevision.h"
 #include "Language.h"
+#include "MMapFactory.h"
+#include "MapMgr.h"
+#include "MappedFile.h"
 #include "MySQLThreading.h"
+#include "ObjectPool.h"
+#include "OpcodeCostTracker.h"
+#include "Opcodes.h"
 #include "Player.h"
 #include "Realm.h"
 #include "ScriptMgr.h"
@@ -48,6 +58,12 @@ public:
 
     std::vector<ChatCommand> GetCommands() const override
     {
+        static std::vector<ChatCommand> serverAuctionListingCommandTable =
+        {
+            { "reset",          SEC_ADMINISTRATOR,  true,  &HandleServerAuctionListingResetCommand, "" },
+            { "",               SEC_ADMINISTRATOR,  true,  &HandleServerAuctionListingCommand,      "" }
+        };
+
         static std::vector<ChatCommand> serverIdleRestartCommandTable =
         {
             { "cancel",         SEC_ADMINISTRATOR,  true,  &HandleServerShutDownCancelCommand,      "" },
@@ -80,17 +96,61 @@ public:
             { "closed",         SEC_CONSOLE,        true,  &HandleServerSetClosedCommand,           "" }
         };
 
+        static std::vector<ChatCommand> serverMapUpdaterCommandTable =
+        {
+            { "reset",          SEC_ADMINISTRATOR,  true,  &HandleServerMapUpdaterResetCommand,     "" },
+            { "",               SEC_ADMINISTRATOR,  true,  &HandleServerMapUpdaterCommand,          "" }
+        };
+
+        static std::vector<ChatCommand> serverOpcodeCostsCommandTable =
+        {
+            { "log",            SEC_ADMINISTRATOR,  true,  &HandleServerOpcodeCostsLogCommand,      "" },
+            { "reset",          SEC_ADMINISTRATOR,  true,  &HandleServerOpcodeCostsResetCommand,    "" },
+            { "",               SEC_ADMINISTRATOR,  true,  &HandleServerOpcodeCostsCommand,         "" }
+        };
+
+        static std::vector<ChatCommand> serverPathfindingCommandTable =
+        {
+            { "reset",          SEC_ADMINISTRATOR,  true,  &HandleServerPathfindingResetCommand,    "" },
+            { "",               SEC_ADMINISTRATOR,  true,  &HandleServerPathfindingCommand,         "" }
+        };
+
+        static std::vector<ChatCommand> serverPoolsCommandTable =
+        {
+            { "reset",          SEC_ADMINISTRATOR,  true,  &HandleServerPoolsResetCommand,          "" },
+            { "",               SEC_ADMINISTRATOR,  true,  &HandleServerPoolsCommand,               "" }
+        };
+
+        static std::vector<ChatCommand> serverSavesCommandTable =
+        {
+            { "reset",          SEC_ADMINISTRATOR,  true,  &HandleServerSavesResetCommand,          "" },
+            { "",               SEC_ADMINISTRATOR,  true,  &HandleServerSavesCommand,               "" }
+        };
+
+        static std::vector<ChatCommand> serverSqlWaitCommandTable =
+        {
+            { "reset",          SEC_ADMINISTRATOR,  true,  &HandleServerSqlWaitResetCommand,        "" },
+            { "",               SEC_ADMINISTRATOR,  true,  &HandleServerSqlWaitCommand,             "" }
+        };
+
         static std::vector<ChatCommand> serverCommandTable =
         {
+            { "auctionlisting", SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverAuctionListingCommandTable },
             { "corpses",        SEC_GAMEMASTER,     true,  &HandleServerCorpsesCommand,             "" },
             { "debug",          SEC_ADMINISTRATOR,  true,  &HandleServerDebugCommand,               "" },
             { "exit",           SEC_CONSOLE,        true,  &HandleServerExitCommand,                "" },
             { "idlerestart",    SEC_CONSOLE,        true,  nullptr,                                 "", serverIdleRestartCommandTable },
             { "idleshutdown",   SEC_CONSOLE,        true,  nullptr,                                 "", serverIdleShutdownCommandTable },
             { "info",           SEC_PLAYER,         true,  &HandleServerInfoCommand,                "" },
+            { "mapupdater",     SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverMapUpdaterCommandTable },
             { "motd",           SEC_PLAYER,         true,  &HandleServerMotdCommand,                "" },
+            { "opcodecosts",    SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverOpcodeCostsCommandTable },
+            { "pathfinding",    SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverPathfindingCommandTable },
+            { "pools",          SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverPoolsCommandTable },
             { "restart",        SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverRestartCommandTable },
+            { "saves",          SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverSavesCommandTable },
             { "shutdown",       SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverShutdownCommandTable },
+            { "sqlwait",        SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverSqlWaitCommandTable },
             { "set",            SEC_ADMINISTRATOR,  true,  nullptr,                                 "", serverSetCommandTable }
         };
 
@@ -161,6 +221,11 @@ public:
         else
             handler->SendSysMessage("MMAPs status: Disabled");
 
+        if (sWorld->getBoolConfig(CONFIG_MEMORY_MAPPED_MAP_FILES))
+            handler->PSendSysMessage("Memory mapped map files: Enabled. Mapped files: %u, size: %" PRIu64 " MB", MappedFile::GetMappedFileCount(), MappedFile::GetMappedSize() / 1024 / 1024);
+        else
+            handler->SendSysMessage("Memory mapped map files: Disabled");
+
         for (std::string const& subDir : subDirs)
         {
             std::filesystem::path mapPath(dataDir);
@@ -247,6 +312,266 @@ public:
 
         return true;
     }
+    // Display per thread utilisation of the map update scheduler
+    static bool HandleServerMapUpdaterCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        MapUpdateBlockCacheStats cacheStats = MapUpdateBlockCacheStats();
+        sMapMgr->DoForAllMaps([&cacheStats](Map* map)
+        {
+            MapUpdateBlockCacheStats mapStats = map->GetUpdateBlockCacheStats();
+            cacheStats.Hits += mapStats.Hits;
+            cacheStats.Misses += mapStats.Misses;
+            cacheStats.BytesSaved += mapStats.BytesSaved;
+        });
+
+        handler->PSendSysMessage("Values update blocks: " UI64FMTD " shared, " UI64FMTD " built (%.1f%% hit rate), " UI64FMTD " KB not serialized.",
+            cacheStats.Hits, cacheStats.Misses, cacheStats.GetHitRate(), cacheStats.BytesSaved / 1024);
+
+        MapUpdater* updater = sMapMgr->GetMapUpdater();
+        if (!updater->activated())
+        {
+            handler->SendSysMessage("Map updates are not multithreaded (MapUpdate.Threads = 0).");
+            return true;
+        }
+
+        std::vector<MapUpdaterWorkerStats> stats;
+        updater->GetWorkerStats(stats);
+
+        for (size_t i = 0; i < stats.size(); ++i)
+        {
+            MapUpdaterWorkerStats const& workerStats = stats[i];
+            handler->PSendSysMessage("Map update thread %u: utilisation %.1f%%, busy %ums, updates %u (stolen %u).",
+                uint32(i), workerStats.GetUtilisation(), uint32(workerStats.BusyTime / 1000), workerStats.Executed, workerStats.Stolen);
+        }
+
+        if (sWorld->getIntConfig(CONFIG_MAPUPDATE_REGIONS_THREADS))
+        {
+            sMapMgr->DoForAllMaps([handler](Map* map)
+            {
+                if (!map->GetEntry()->IsContinent())
+                    return;
+
+                MapRegionUpdateStats regionStats = map->GetRegionUpdateStats();
+                handler->PSendSysMessage("Map %u regions: %u active (%u cells), parallel %uus, slowest region %uus, all regions %uus.",
+                    map->GetId(), regionStats.ActiveRegions, regionStats.ActiveCells, regionStats.ParallelTime, regionStats.SlowestRegionTime, regionStats.TotalRegionTime);
+            });
+        }
+
+        return true;
+    }
+
+    static bool HandleServerMapUpdaterResetCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sMapMgr->GetMapUpdater()->ResetWorkerStats();
+        sMapMgr->DoForAllMaps([](Map* map)
+        {
+            map->ResetUpdateBlockCacheStats();
+        });
+
+        handler->SendSysMessage("Map update thread statistics reset.");
+        return true;
+    }
+
+    static bool HandleServerOpcodeCostsCommand(ChatHandler* handler, char const* args)
+    {
+        if (!sOpcodeCostTracker->IsEnabled())
+        {
+            handler->SendSysMessage("Opcode costs are not tracked (Network.OpcodeCosts = 0).");
+            return true;
+        }
+
+        uint32 limit = 15;
+        if (*args)
+        {
+            Optional<uint32> value = Acore::StringTo<uint32>(args);
+            if (!value || !*value)
+            {
+                handler->SendSysMessage(LANG_BAD_VALUE);
+                handler->SetSentErrorMessage(true);
+                return false;
+            }
+
+            limit = *value;
+        }
+
+        std::vector<OpcodeCostStats> stats;
+        sOpcodeCostTracker->GetStats(stats);
+
+        for (size_t i = 0; i < stats.size() && i < limit; ++i)
+        {
+            OpcodeCostStats const& opcodeStats = stats[i];
+            handler->PSendSysMessage("%s: " UI64FMTD " calls, " UI64FMTD " ms total, " UI64FMTD " us avg, " UI64FMTD " us max.",
+                GetOpcodeNameForLogging(static_cast<OpcodeClient>(opcodeStats.Opcode)).c_str(), opcodeStats.Count, opcodeStats.TotalTime / 1000,
+                opcodeStats.GetAverageTime(), opcodeStats.MaxTime);
+        }
+
+        std::vector<OpcodeCostThreadStats> threadStats;
+        sOpcodeCostTracker->GetThreadStats(threadStats);
+
+        for (OpcodeCostThreadStats const& thread : threadStats)
+            handler->PSendSysMessage("Packet processing thread %u: " UI64FMTD " calls, " UI64FMTD " ms.", thread.Thread, thread.Count, thread.TotalTime / 1000);
+
+        return true;
+    }
+
+    static bool HandleServerOpcodeCostsLogCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sOpcodeCostTracker->LogStats(0);
+        handler->SendSysMessage("Opcode costs written to the network.opcode logger.");
+        return true;
+    }
+
+    static bool HandleServerOpcodeCostsResetCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sOpcodeCostTracker->Reset();
+        handler->SendSysMessage("Opcode costs reset.");
+        return true;
+    }
+
+    static bool HandleServerAuctionListingCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        AuctionListingStats stats;
+        AsyncAuctionListingMgr::GetStats(stats);
+
+        auto average = [](uint64 time, uint64 count) { return count ? time / count : 0; };
+
+        handler->PSendSysMessage("Auction searches: " UI64FMTD " pages from cursors, " UI64FMTD " searched (%.1f%% hit rate), " UI64FMTD " unfiltered. %u cursors.",
+            stats.CacheHits, stats.CacheMisses, stats.GetHitRate(), stats.Unfiltered, stats.Cursors);
+        handler->PSendSysMessage("Auction search cpu time: average " UI64FMTD "us from cursors, " UI64FMTD "us searched, " UI64FMTD "us unfiltered, max " UI64FMTD "us.",
+            average(stats.HitTime, stats.CacheHits), average(stats.MissTime, stats.CacheMisses), average(stats.UnfilteredTime, stats.Unfiltered), stats.MaxTime);
+        return true;
+    }
+
+    static bool HandleServerAuctionListingResetCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        AsyncAuctionListingMgr::ResetStats();
+        handler->SendSysMessage("Auction listing statistics reset.");
+        return true;
+    }
+
+    static bool HandleServerPathfindingCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        MMAP::PathCacheStats cacheStats;
+        MMAP::MMapFactory::createOrGetMMapMgr()->GetPathCache().GetStats(cacheStats);
+        if (cacheStats.Capacity)
+            handler->PSendSysMessage("Path cache: %u/%u corridors, " UI64FMTD " hits, " UI64FMTD " misses (%.1f%% hit rate), " UI64FMTD " invalidated.",
+                cacheStats.Size, cacheStats.Capacity, cacheStats.Hits, cacheStats.Misses, cacheStats.GetHitRate(), cacheStats.Invalidated);
+
+        if (!sAsyncPathfinder->IsActive())
+        {
+            handler->SendSysMessage("Paths are searched by the map updates (MoveMaps.AsyncThreads = 0).");
+            return true;
+        }
+
+        AsyncPathfinderStats stats;
+        sAsyncPathfinder->GetStats(stats);
+
+        handler->PSendSysMessage("Pathfinder queue: %u paths. Searched: " UI64FMTD ", canceled: " UI64FMTD ", searched by the map update (queue full): " UI64FMTD ".",
+            stats.QueueSize, stats.Completed, stats.Canceled, stats.Synchronous);
+        handler->PSendSysMessage("Pathfinder latency: average " UI64FMTD "us, max " UI64FMTD "us.", stats.GetAverageLatency(), stats.MaxLatency);
+        return true;
+    }
+
+    static bool HandleServerPathfindingResetCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sAsyncPathfinder->ResetStats();
+        MMAP::MMapFactory::createOrGetMMapMgr()->GetPathCache().ResetStats();
+        handler->SendSysMessage("Pathfinder statistics reset.");
+        return true;
+    }
+
+    static bool HandleServerPoolsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        for (ObjectPoolStats const& stats : ObjectPool::GetAllStats())
+            handler->PSendSysMessage("%s: " SI64FMTD " live, " UI64FMTD " allocations, " UI64FMTD " reused (%.1f%%).",
+                stats.Name, stats.Live, stats.Allocations, stats.Reused, stats.GetReuseRate());
+        return true;
+    }
+
+    static bool HandleServerPoolsResetCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        ObjectPool::ResetAllStats();
+        handler->SendSysMessage("Object pool statistics reset.");
+        return true;
+    }
+
+    static bool HandleServerSavesCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        std::vector<CharacterSaveStats> steps;
+        CharacterSaveStats total;
+        sCharacterSaveTracker->GetStats(steps, total);
+
+        handler->PSendSysMessage("Character saves: " UI64FMTD ", average %.1f statements (max " UI64FMTD "), average " UI64FMTD "us.",
+            total.Saves, total.GetAverageStatements(), total.MaxStatements, total.GetAverageTime());
+
+        for (CharacterSaveStats const& step : steps)
+            if (step.Saves)
+                handler->PSendSysMessage("%s: %.1f%% unchanged, average %.2f statements (max " UI64FMTD "), average " UI64FMTD "us.",
+                    step.Name, step.GetUnchangedRate(), step.GetAverageStatements(), step.MaxStatements, step.GetAverageTime());
+
+        return true;
+    }
+
+    static bool HandleServerSavesResetCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sCharacterSaveTracker->Reset();
+        handler->SendSysMessage("Character save statistics reset.");
+        return true;
+    }
+
+    static void SendSynchWaitStats(ChatHandler* handler, char const* database, std::array<SynchWaitStats, MAX_SYNCH_CALLERS> const& stats)
+    {
+        for (std::size_t caller = 0; caller < MAX_SYNCH_CALLERS; ++caller)
+        {
+            SynchWaitStats const& callerStats = stats[caller];
+            if (!callerStats.Acquired)
+                continue;
+
+            handler->PSendSysMessage("%s database, %s threads: " UI64FMTD " queries, average wait " UI64FMTD "us (max " UI64FMTD "us), " UI64FMTD " timeouts, " UI64FMTD " over budget.",
+                database, SynchConnectionQueue::GetCallerName(SynchQueryCaller(caller)), callerStats.Acquired, callerStats.GetAverageWait(), callerStats.MaxWait,
+                callerStats.Timeouts, callerStats.OverBudget);
+
+            std::string histogram;
+            for (std::size_t bucket = 0; bucket < SYNCH_WAIT_BUCKETS; ++bucket)
+            {
+                if (bucket)
+                    histogram += ", ";
+
+                if (uint32 limit = SynchConnectionQueue::GetBucketLimit(bucket))
+                    histogram += Acore::StringFormat("<%uus: " UI64FMTD, limit, callerStats.Buckets[bucket]);
+                else
+                    histogram += Acore::StringFormat(">=%uus: " UI64FMTD, SynchConnectionQueue::GetBucketLimit(bucket - 1), callerStats.Buckets[bucket]);
+            }
+
+            handler->PSendSysMessage("  %s", histogram.c_str());
+        }
+    }
+
+    static bool HandleServerSqlWaitCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        std::array<SynchWaitStats, MAX_SYNCH_CALLERS> stats;
+
+        LoginDatabase.GetSynchWaitStats(stats);
+        SendSynchWaitStats(handler, "Login", stats);
+
+        WorldDatabase.GetSynchWaitStats(stats);
+        SendSynchWaitStats(handler, "World", stats);
+
+        CharacterDatabase.GetSynchWaitStats(stats);
+        SendSynchWaitStats(handler, "Character", stats);
+
+        return true;
+    }
+
+    static bool HandleServerSqlWaitResetCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        LoginDatabase.ResetSynchWaitStats();
+        WorldDatabase.ResetSynchWaitStats();
+        CharacterDatabase.ResetSynchWaitStats();
+        handler->SendSysMessage("Synchronous connection wait statistics reset.");
+        return true;
+    }
+
     // Display the 'Message of the day' for the realm
     static bool HandleServerMotdCommand(ChatHandler* handler, char const* /*args*/)
     {
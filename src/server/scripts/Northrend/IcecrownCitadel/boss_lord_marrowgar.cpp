@@ -332,7 +332,7 @@ public:
         {
             events.ScheduleEvent(1, 450);
             events.ScheduleEvent(2, 12000);
-            me->m_positionZ = 42.5f;
+            me->Relocate(me->GetPositionX(), me->GetPositionY(), 42.5f);
         }
 
         void UpdateAI(uint32 diff) override
@@ -345,7 +345,7 @@ public:
                     break;
                 case 1:
                     {
-                        me->m_positionZ = 42.5f;
+                        me->Relocate(me->GetPositionX(), me->GetPositionY(), 42.5f);
                         me->DisableSpline();
                         me->CastSpell(me, SPELL_COLDFLAME_SUMMON, true);
                         float nx = me->GetPositionX() + 5.0f * cos(me->GetOrientation());
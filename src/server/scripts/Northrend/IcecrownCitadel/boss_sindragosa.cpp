@@ -742,7 +742,7 @@ public:
         void DamageTaken(Unit*, uint32& dmg, DamageEffectType, SpellSchoolMask) override
         {
             if (dmg >= me->GetHealth())
-                me->m_positionZ = me->GetPositionZ() - 5.0f;
+                me->Relocate(me->GetPositionX(), me->GetPositionY(), me->GetPositionZ() - 5.0f);
         }
 
         void JustDied(Unit* /*killer*/) override
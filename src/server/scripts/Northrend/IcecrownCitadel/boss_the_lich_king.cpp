@@ -818,7 +818,7 @@ public:
                     damage = me->GetHealth() - 1;
                     me->SetDisableGravity(false);
                     me->SendMonsterMove(me->GetPositionX() + 0.25f, me->GetPositionY(), 840.86f, 300, SPLINEFLAG_FALLING);
-                    me->m_positionZ = 840.86f;
+                    me->Relocate(me->GetPositionX(), me->GetPositionY(), 840.86f);
                     me->SetOrientation(0.0f);
                     if (Creature* frostmourne = me->FindNearestCreature(NPC_FROSTMOURNE_TRIGGER, 50.0f))
                         frostmourne->DespawnOrUnsummon(1);
@@ -871,7 +871,7 @@ public:
                     return;
                 case NPC_DEFILE:
                 case NPC_SHADOW_TRAP_TRIGGER:
-                    summon->m_positionZ = 840.86f;
+                    summon->Relocate(summon->GetPositionX(), summon->GetPositionY(), 840.86f);
                     summon->UpdatePosition(summon->GetPositionX(), summon->GetPositionY(), summon->GetPositionZ(), summon->GetOrientation(), true);
                     summon->StopMovingOnCurrentPos();
                     break;
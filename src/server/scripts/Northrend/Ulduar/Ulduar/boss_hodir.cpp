@@ -444,9 +444,9 @@ public:
                         for (std::list<Unit*>::const_iterator itr = targets.begin(); itr != targets.end(); ++itr)
                         {
                             float prevZ = (*itr)->GetPositionZ();
-                            (*itr)->m_positionZ = 432.7f;
+                            (*itr)->Relocate((*itr)->GetPositionX(), (*itr)->GetPositionY(), 432.7f);
                             (*itr)->CastSpell((*itr), SPELL_ICICLE_VISUAL_PACKED, true);
-                            (*itr)->m_positionZ = prevZ;
+                            (*itr)->Relocate((*itr)->GetPositionX(), (*itr)->GetPositionY(), prevZ);
                         }
 
                         me->CastSpell((Unit*)nullptr, SPELL_FLASH_FREEZE_CAST, false);
@@ -1921,7 +1921,7 @@ public:
         {
             summons.Summon(s);
             if (s->GetEntry() == NPC_BOMB_BOT)
-                s->m_positionZ = 364.34f;
+                s->Relocate(s->GetPositionX(), s->GetPositionY(), 364.34f);
         }
 
         void SummonedCreatureDespawn(Creature* s) override
@@ -278,8 +278,8 @@ public:
 
         void SetDest(SpellDestination& dest)
         {
-            std::list<TargetInfo> const* targetsInfo = GetSpell()->GetUniqueTargetInfo();
-            for (std::list<TargetInfo>::const_iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
+            Spell::TargetInfoList const* targetsInfo = GetSpell()->GetUniqueTargetInfo();
+            for (Spell::TargetInfoList::const_iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
                 if (Unit* target = ObjectAccessor::GetUnit(*GetCaster(), ihit->targetGUID))
                 {
                     dest.Relocate(*target);
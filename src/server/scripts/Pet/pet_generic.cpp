@@ -616,8 +616,8 @@ public:
         {
             if (GetHitUnit() != GetCaster())
             {
-                std::list<TargetInfo>* targetsInfo = GetSpell()->GetUniqueTargetInfo();
-                for (std::list<TargetInfo>::iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
+                Spell::TargetInfoList* targetsInfo = GetSpell()->GetUniqueTargetInfo();
+                for (Spell::TargetInfoList::iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
                     if (ihit->targetGUID == GetCaster()->GetGUID())
                         ihit->damage = -int32(GetHitDamage() * 0.25f);
             }
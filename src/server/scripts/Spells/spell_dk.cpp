@@ -444,8 +444,8 @@ public:
         {
             if (Unit* target = GetExplTargetUnit())
             {
-                std::list<TargetInfo> const* targetsInfo = GetSpell()->GetUniqueTargetInfo();
-                for (std::list<TargetInfo>::const_iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
+                Spell::TargetInfoList const* targetsInfo = GetSpell()->GetUniqueTargetInfo();
+                for (Spell::TargetInfoList::const_iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
                     if (ihit->missCondition == SPELL_MISS_NONE && ihit->targetGUID == target->GetGUID())
                         GetCaster()->CastSpell(target, 55095 /*SPELL_FROST_FEVER*/, true);
             }
@@ -629,8 +629,8 @@ public:
 
         void RecalculateDamage()
         {
-            std::list<TargetInfo>* targetsInfo = GetSpell()->GetUniqueTargetInfo();
-            for (std::list<TargetInfo>::iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
+            Spell::TargetInfoList* targetsInfo = GetSpell()->GetUniqueTargetInfo();
+            for (Spell::TargetInfoList::iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
                 if (ihit->targetGUID == GetCaster()->GetGUID())
                     ihit->crit = roll_chance_f(GetCaster()->GetFloatValue(PLAYER_CRIT_PERCENTAGE));
         }
@@ -20,16 +20,20 @@
 
 #include "MessageBuffer.h"
 #include "Log.h"
+#include <array>
 #include <atomic>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <type_traits>
+#include <vector>
 #include <boost/asio/ip/tcp.hpp>
 
 using boost::asio::ip::tcp;
 
 #define READ_BLOCK_SIZE 4096
+#define WRITE_GATHER_BUFFERS 16
+#define SPARE_SEND_BUFFERS 4
 #ifdef BOOST_ASIO_HAS_IOCP
 #define AC_SOCKET_USE_IOCP
 #endif
@@ -113,7 +117,17 @@ public:
 
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueue.emplace_back(std::move(buffer));
+
+#ifdef AC_SOCKET_USE_IOCP
+        AsyncProcessQueue();
+#endif
+    }
+
+    /// Queues data owned by someone else (usually shared with other sockets), it is written without being copied
+    void QueuePacket(std::shared_ptr<uint8 const> data, std::size_t size)
+    {
+        _writeQueue.emplace_back(std::move(data), size);
 
 #ifdef AC_SOCKET_USE_IOCP
         AsyncProcessQueue();
@@ -154,8 +168,9 @@ protected:
         _isWritingAsync = true;
 
 #ifdef AC_SOCKET_USE_IOCP
-        MessageBuffer& buffer = _writeQueue.front();
-        _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()), std::bind(&Socket<T>::WriteHandler,
+        std::array<boost::asio::const_buffer, WRITE_GATHER_BUFFERS> buffers;
+        GatherWriteBuffers(buffers);
+        _socket.async_write_some(buffers, std::bind(&Socket<T>::WriteHandler,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
 #else
         _socket.async_write_some(boost::asio::null_buffers(), std::bind(&Socket<T>::WriteHandlerWrapper,
@@ -164,6 +179,30 @@ protected:
         return false;
     }
 
+    /// Send buffer for the next writes, one already written out is reused if there is one
+    MessageBuffer AcquireSendBuffer(std::size_t size)
+    {
+        if (_spareSendBuffers.empty())
+            return MessageBuffer(size);
+
+        MessageBuffer buffer = std::move(_spareSendBuffers.back());
+        _spareSendBuffers.pop_back();
+        if (buffer.GetBufferSize() < size)
+            buffer.Resize(size);
+
+        return buffer;
+    }
+
+    /// Keeps an emptied send buffer for AcquireSendBuffer
+    void ReleaseSendBuffer(MessageBuffer&& buffer)
+    {
+        if (_spareSendBuffers.size() >= SPARE_SEND_BUFFERS || !buffer.GetBufferSize())
+            return;
+
+        buffer.Reset();
+        _spareSendBuffers.push_back(std::move(buffer));
+    }
+
     void SetNoDelay(bool enable)
     {
         boost::system::error_code err;
@@ -175,6 +214,69 @@ protected:
     }
 
 private:
+    /// Data waiting to be written, either owned by the socket or shared with other sockets
+    struct WriteBuffer
+    {
+        explicit WriteBuffer(MessageBuffer&& buffer) : Owned(std::move(buffer)), SharedSize(0), SharedOffset(0) { }
+        WriteBuffer(std::shared_ptr<uint8 const>&& data, std::size_t size) : Owned(0), Shared(std::move(data)), SharedSize(size), SharedOffset(0) { }
+
+        uint8 const* GetReadPointer() { return Shared ? Shared.get() + SharedOffset : Owned.GetReadPointer(); }
+        std::size_t GetActiveSize() const { return Shared ? SharedSize - SharedOffset : Owned.GetActiveSize(); }
+
+        void ReadCompleted(std::size_t bytes)
+        {
+            if (Shared)
+                SharedOffset += bytes;
+            else
+                Owned.ReadCompleted(bytes);
+        }
+
+        MessageBuffer Owned;
+        std::shared_ptr<uint8 const> Shared;
+        std::size_t SharedSize;
+        std::size_t SharedOffset;
+    };
+
+    /// Fills the scatter-gather list with the front of the write queue, unused entries stay empty
+    std::size_t GatherWriteBuffers(std::array<boost::asio::const_buffer, WRITE_GATHER_BUFFERS>& buffers)
+    {
+        std::size_t count = 0;
+        std::size_t bytes = 0;
+        for (WriteBuffer& queued : _writeQueue)
+        {
+            if (count == buffers.size())
+                break;
+
+            if (!queued.GetActiveSize())
+                continue;
+
+            buffers[count++] = boost::asio::const_buffer(queued.GetReadPointer(), queued.GetActiveSize());
+            bytes += queued.GetActiveSize();
+        }
+
+        return bytes;
+    }
+
+    /// Drops what was written from the front of the write queue
+    void WriteCompleted(std::size_t bytes)
+    {
+        while (!_writeQueue.empty())
+        {
+            WriteBuffer& front = _writeQueue.front();
+            std::size_t consumed = std::min(bytes, front.GetActiveSize());
+            front.ReadCompleted(consumed);
+            bytes -= consumed;
+
+            if (front.GetActiveSize())
+                break;
+
+            if (!front.Shared)
+                ReleaseSendBuffer(std::move(front.Owned));
+
+            _writeQueue.pop_front();
+        }
+    }
+
     void ReadHandlerInternal(boost::system::error_code error, size_t transferredBytes)
     {
         if (error)
@@ -193,10 +295,7 @@ private:
         if (!error)
         {
             _isWritingAsync = false;
-            _writeQueue.front().ReadCompleted(transferedBytes);
-
-            if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+            WriteCompleted(transferedBytes);
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
@@ -220,12 +319,11 @@ private:
         if (_writeQueue.empty())
             return false;
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        std::array<boost::asio::const_buffer, WRITE_GATHER_BUFFERS> buffers;
+        std::size_t bytesToSend = GatherWriteBuffers(buffers);
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        std::size_t bytesSent = _socket.write_some(buffers, error);
 
         if (error)
         {
@@ -234,7 +332,7 @@ private:
                 return AsyncProcessQueue();
             }
 
-            _writeQueue.pop();
+            _writeQueue.pop_front();
 
             if (_closing && _writeQueue.empty())
             {
@@ -245,7 +343,7 @@ private:
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
+            _writeQueue.pop_front();
 
             if (_closing && _writeQueue.empty())
             {
@@ -256,11 +354,11 @@ private:
         }
         else if (bytesSent < bytesToSend) // now n > 0
         {
-            queuedMessage.ReadCompleted(bytesSent);
+            WriteCompleted(bytesSent);
             return AsyncProcessQueue();
         }
 
-        _writeQueue.pop();
+        WriteCompleted(bytesSent);
 
         if (_closing && _writeQueue.empty())
         {
@@ -277,7 +375,8 @@ private:
     uint16 _remotePort;
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<WriteBuffer> _writeQueue;
+    std::vector<MessageBuffer> _spareSendBuffers;
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
@@ -212,7 +212,7 @@ int main(int argc, char** argv)
     Acore::Banner::Show("worldserver-daemon",
         [](std::string_view text)
         {
-            FMT_LOG_INFO("server.worldserver", text);
+            FMT_LOG_INFO("server.worldserver", "{}", text);
         },
         []()
         {
@@ -562,6 +562,8 @@ void WorldUpdateLoop()
     CharacterDatabase.WarnAboutSyncQueries(true);
     WorldDatabase.WarnAboutSyncQueries(true);
 
+    SynchConnectionQueue::SetCaller(SYNCH_CALLER_WORLD);
+
     ///- While we have not World::m_stopEvent, update the world
     while (!World::IsStopped())
     {
@@ -595,6 +597,8 @@ void WorldUpdateLoop()
     LoginDatabase.WarnAboutSyncQueries(false);
     CharacterDatabase.WarnAboutSyncQueries(false);
     WorldDatabase.WarnAboutSyncQueries(false);
+
+    SynchConnectionQueue::SetCaller(SYNCH_CALLER_OTHER);
 }
 
 void SignalHandler(boost::system::error_code const& error, int /*signalNumber*/)
@@ -0,0 +1,34 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BENCHMARK_H
+#define _BENCHMARK_H
+
+#include <chrono>
+
+// wall time of fn, the benchmarks report it with RecordProperty
+template<class Fn>
+int MeasureMicroseconds(Fn&& fn)
+{
+    using namespace std::chrono;
+
+    steady_clock::time_point start = steady_clock::now();
+    fn();
+    return int(duration_cast<microseconds>(steady_clock::now() - start).count());
+}
+
+#endif
@@ -0,0 +1,127 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AppenderFile.h"
+#include "AsyncLogWriter.h"
+#include "Benchmark.h"
+#include "LogMessage.h"
+#include "Logger.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr uint32 Threads = 4;
+    constexpr uint32 MessagesPerSecond = 100000;
+    constexpr uint32 MessagesPerThread = MessagesPerSecond / Threads;
+
+    // every thread logs at an even pace so all of them together send MessagesPerSecond for one second,
+    // returns how long each single call took
+    template<class Write>
+    std::vector<std::chrono::nanoseconds> MeasureCalls(Write const& write)
+    {
+        using namespace std::chrono;
+
+        std::vector<std::vector<nanoseconds>> latencies(Threads);
+        std::vector<std::thread> producers;
+        for (uint32 thread = 0; thread < Threads; ++thread)
+        {
+            producers.emplace_back([thread, &write, &latencies]()
+            {
+                std::vector<nanoseconds>& calls = latencies[thread];
+                calls.reserve(MessagesPerThread);
+
+                nanoseconds const interval = duration_cast<nanoseconds>(seconds(1)) / MessagesPerThread;
+                steady_clock::time_point next = steady_clock::now();
+                for (uint32 i = 0; i < MessagesPerThread; ++i)
+                {
+                    std::this_thread::sleep_until(next);
+                    next += interval;
+
+                    steady_clock::time_point start = steady_clock::now();
+                    write(std::make_unique<LogMessage>(LOG_LEVEL_INFO, "server", std::to_string(thread) + " " + std::to_string(i)));
+                    calls.push_back(steady_clock::now() - start);
+                }
+            });
+        }
+
+        for (std::thread& producer : producers)
+            producer.join();
+
+        std::vector<nanoseconds> calls;
+        for (std::vector<nanoseconds> const& thread : latencies)
+            calls.insert(calls.end(), thread.begin(), thread.end());
+
+        std::sort(calls.begin(), calls.end());
+        return calls;
+    }
+
+    void RecordLatencies(std::string const& name, std::vector<std::chrono::nanoseconds> const& calls)
+    {
+        auto percentile = [&calls](uint32 percent) { return int(calls[(calls.size() - 1) * percent / 100].count()); };
+
+        ::testing::Test::RecordProperty(name + "P50Nanoseconds", percentile(50));
+        ::testing::Test::RecordProperty(name + "P99Nanoseconds", percentile(99));
+        ::testing::Test::RecordProperty(name + "MaxNanoseconds", percentile(100));
+    }
+}
+
+// latency of one log call at 100k messages per second to a file appender, synchronous and through the writer
+TEST(AsyncLogWriterBenchmark, FileAppenderCallLatency)
+{
+    std::string path = (std::filesystem::temp_directory_path() / "AsyncLogWriterBenchmark.log").string();
+    std::vector<std::string_view> args = { "2", "3", "0", path, "w" };
+
+    {
+        AppenderFile appender(1, "File", LOG_LEVEL_TRACE, APPENDER_FLAGS_NONE, args);
+        Logger logger("server", LOG_LEVEL_TRACE);
+        logger.addAppender(appender.getId(), &appender);
+
+        RecordLatencies("Sync", MeasureCalls([&logger](std::unique_ptr<LogMessage>&& message)
+        {
+            logger.write(message.get());
+        }));
+
+        logger.delAppender(appender.getId());
+    }
+
+    {
+        // buffered like Log::StartAsyncWriter, the batch callback writes the buffer with one fwrite
+        AppenderFile appender(1, "File", LOG_LEVEL_TRACE, APPENDER_FLAGS_NONE, args);
+        appender.setBuffered(true);
+        Logger logger("server", LOG_LEVEL_TRACE);
+        logger.addAppender(appender.getId(), &appender);
+        AsyncLogWriter writer(16384, LOG_ASYNC_OVERFLOW_BLOCK, &logger, [&appender]() { appender.flush(); });
+
+        RecordLatencies("Async", MeasureCalls([&writer, &logger](std::unique_ptr<LogMessage>&& message)
+        {
+            writer.Enqueue(&logger, std::move(message));
+        }));
+
+        RecordProperty("AsyncFlushMicroseconds", MeasureMicroseconds([&writer]() { writer.Flush(); }));
+        writer.Stop();
+        logger.delAppender(appender.getId());
+    }
+
+    std::filesystem::remove(path);
+}
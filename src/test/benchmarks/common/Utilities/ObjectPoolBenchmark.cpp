@@ -0,0 +1,95 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "ObjectPool.h"
+#include "gtest/gtest.h"
+#include <deque>
+#include <random>
+#include <vector>
+
+namespace
+{
+    ObjectPool& GetBenchmarkPool()
+    {
+        static ObjectPool pool("Benchmark");
+        return pool;
+    }
+
+    // sizes roughly matching a spell, an aura, an aura effect and an aura application
+    constexpr std::size_t CombatObjectSizes[] = { 1400, 320, 120, 40 };
+}
+
+// Synthetic 40 player fight: every cast creates a spell with a target list, and half of the casts
+// apply an aura with effects that expires a few casts later
+TEST(ObjectPoolBenchmark, CombatAllocation)
+{
+    constexpr uint32 Players = 40;
+    constexpr uint32 CastsPerPlayer = 2500;
+
+    auto simulate = [&](auto allocate, auto deallocate)
+    {
+        std::mt19937 rng(7);
+        std::deque<std::pair<void*, std::size_t>> auras;
+        for (uint32 cast = 0; cast < Players * CastsPerPlayer; ++cast)
+        {
+            void* spell = allocate(CombatObjectSizes[0]);
+            std::vector<void*> targets;
+            for (uint32 target = rng() % 5 + 1; target > 0; --target)
+                targets.push_back(allocate(48));
+
+            if (rng() % 2)
+            {
+                auras.emplace_back(allocate(CombatObjectSizes[1]), CombatObjectSizes[1]);
+                for (uint32 effect = 0; effect < 3; ++effect)
+                    auras.emplace_back(allocate(CombatObjectSizes[2]), CombatObjectSizes[2]);
+                auras.emplace_back(allocate(CombatObjectSizes[3]), CombatObjectSizes[3]);
+            }
+
+            for (void* target : targets)
+                deallocate(target, 48);
+            deallocate(spell, CombatObjectSizes[0]);
+
+            while (auras.size() > Players * 5)
+            {
+                deallocate(auras.front().first, auras.front().second);
+                auras.pop_front();
+            }
+        }
+
+        for (auto const& aura : auras)
+            deallocate(aura.first, aura.second);
+    };
+
+    ObjectPool& pool = GetBenchmarkPool();
+    pool.ResetStats();
+
+    RecordProperty("HeapMicroseconds", MeasureMicroseconds([&]()
+    {
+        simulate([](std::size_t size) { return ::operator new(size); }, [](void* ptr, std::size_t /*size*/) { ::operator delete(ptr); });
+    }));
+
+    RecordProperty("PoolMicroseconds", MeasureMicroseconds([&]()
+    {
+        simulate([&](std::size_t size) { return pool.Allocate(size); }, [&](void* ptr, std::size_t size) { pool.Deallocate(ptr, size); });
+    }));
+
+    ObjectPoolStats stats = pool.GetStats();
+    EXPECT_EQ(stats.Live, 0);
+    EXPECT_GT(stats.GetReuseRate(), 90.0f);
+    RecordProperty("Allocations", int(stats.Allocations));
+}
@@ -0,0 +1,191 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "MySQLConnection.h"
+#include "MySQLPreparedStatement.h"
+#include "PreparedStatement.h"
+#include "Transaction.h"
+#include "gtest/gtest.h"
+#include <cstdlib>
+#include <memory>
+
+namespace
+{
+    enum BenchmarkStatements : uint32
+    {
+        BENCHMARK_INS_ROW,
+        BENCHMARK_REP_ITEM_INSTANCE,
+        BENCHMARK_REP_INVENTORY_ITEM,
+        MAX_BENCHMARK_STATEMENTS
+    };
+
+    class BenchmarkConnection : public MySQLConnection
+    {
+    public:
+        BenchmarkConnection(MySQLConnectionInfo& connInfo) : MySQLConnection(connInfo) { }
+
+        void DoPrepareStatements() override
+        {
+            m_stmts.resize(MAX_BENCHMARK_STATEMENTS);
+            PrepareStatement(BENCHMARK_INS_ROW, "INSERT INTO batched_statement_benchmark (id, value, name) VALUES (?, ?, ?)", CONNECTION_SYNCH);
+            PrepareStatement(BENCHMARK_REP_ITEM_INSTANCE, "REPLACE INTO batched_item_instance (guid, itemEntry, count, durability, enchantments) VALUES (?, ?, ?, ?, ?)", CONNECTION_SYNCH);
+            PrepareStatement(BENCHMARK_REP_INVENTORY_ITEM, "REPLACE INTO batched_inventory (guid, bag, slot, item) VALUES (?, ?, ?, ?)", CONNECTION_SYNCH);
+        }
+    };
+
+    class BenchmarkDatabase
+    {
+    public:
+        typedef BenchmarkStatements Statements;
+    };
+
+    typedef PreparedStatement<BenchmarkDatabase> BenchmarkStatement;
+    typedef std::shared_ptr<Transaction<BenchmarkDatabase>> BenchmarkTransaction;
+
+    class BatchedStatementBenchmark : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            char const* info = std::getenv("ACORE_TEST_DATABASE_INFO");
+            if (!info)
+                GTEST_SKIP() << "ACORE_TEST_DATABASE_INFO is not set";
+
+            _connectionInfo = std::make_unique<MySQLConnectionInfo>(info);
+            _connection = std::make_unique<BenchmarkConnection>(*_connectionInfo);
+            ASSERT_EQ(_connection->Open(), 0u);
+            ASSERT_TRUE(_connection->PrepareStatements());
+            _maxBatchedRows = MySQLConnection::GetMaxBatchedRows();
+        }
+
+        void TearDown() override
+        {
+            if (_connection)
+                MySQLConnection::SetMaxBatchedRows(_maxBatchedRows);
+        }
+
+        int Commit(BenchmarkTransaction const& transaction, uint32 maxBatchedRows)
+        {
+            MySQLConnection::SetMaxBatchedRows(maxBatchedRows);
+
+            int result = 0;
+            int elapsed = MeasureMicroseconds([&]() { result = _connection->ExecuteTransaction(transaction); });
+            EXPECT_EQ(result, 0);
+            return elapsed;
+        }
+
+        std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
+        std::unique_ptr<BenchmarkConnection> _connection;
+        uint32 _maxBatchedRows = 0;
+    };
+}
+
+// needs a scratch database: ACORE_TEST_DATABASE_INFO="127.0.0.1;3306;acore;acore;acore_test"
+TEST_F(BatchedStatementBenchmark, UniformInsert)
+{
+    ASSERT_TRUE(_connection->Execute("CREATE TEMPORARY TABLE batched_statement_benchmark (id INT UNSIGNED NOT NULL PRIMARY KEY, value INT UNSIGNED NOT NULL, name VARCHAR(32) NOT NULL)"));
+
+    uint32 const rows = 2000;
+
+    auto build = [&](uint32 firstId)
+    {
+        auto transaction = std::make_shared<Transaction<BenchmarkDatabase>>();
+        for (uint32 i = 0; i < rows; ++i)
+        {
+            auto stmt = new BenchmarkStatement(BENCHMARK_INS_ROW, 3);
+            stmt->setUInt32(0, firstId + i);
+            stmt->setUInt32(1, i * 7);
+            stmt->setString(2, "row");
+            transaction->Append(stmt);
+        }
+
+        return transaction;
+    };
+
+    int single = Commit(build(0), 1);
+    int batched = Commit(build(rows), 64);
+
+    RecordProperty("RowByRowMicroseconds", single);
+    RecordProperty("BatchedMicroseconds", batched);
+    EXPECT_LT(batched, single);
+}
+
+// the inventory part of a character save with 150 changed items, in the order Player::_SaveInventory used to
+// append the rows (inventory and item_instance row of each item after another) and in the one it uses now
+TEST_F(BatchedStatementBenchmark, InventorySave)
+{
+    ASSERT_TRUE(_connection->Execute("CREATE TEMPORARY TABLE batched_item_instance (guid INT UNSIGNED NOT NULL PRIMARY KEY, itemEntry INT UNSIGNED NOT NULL, "
+        "count INT UNSIGNED NOT NULL, durability INT UNSIGNED NOT NULL, enchantments TEXT NOT NULL)"));
+    ASSERT_TRUE(_connection->Execute("CREATE TEMPORARY TABLE batched_inventory (guid INT UNSIGNED NOT NULL, bag INT UNSIGNED NOT NULL, slot TINYINT UNSIGNED NOT NULL, "
+        "item INT UNSIGNED NOT NULL PRIMARY KEY, UNIQUE KEY (guid, bag, slot))"));
+
+    uint32 const items = 150;
+    uint32 const saves = 20;
+
+    auto itemInstance = [](uint32 item, uint32 save)
+    {
+        auto stmt = new BenchmarkStatement(BENCHMARK_REP_ITEM_INSTANCE, 5);
+        stmt->setUInt32(0, item);
+        stmt->setUInt32(1, 2589 + item % 40);
+        stmt->setUInt32(2, save % 20 + 1);
+        stmt->setUInt32(3, 100 - save);
+        stmt->setString(4, "0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 ");
+        return stmt;
+    };
+
+    auto inventoryItem = [](uint32 item, uint32 save)
+    {
+        auto stmt = new BenchmarkStatement(BENCHMARK_REP_INVENTORY_ITEM, 4);
+        stmt->setUInt32(0, 1);
+        stmt->setUInt32(1, item / 16);
+        stmt->setUInt8(2, uint8((item + save) % 16));
+        stmt->setUInt32(3, item);
+        return stmt;
+    };
+
+    auto build = [&](uint32 save, bool grouped)
+    {
+        auto transaction = std::make_shared<Transaction<BenchmarkDatabase>>();
+        for (uint32 item = 0; item < items; ++item)
+        {
+            if (!grouped)
+                transaction->Append(inventoryItem(item, save));
+
+            transaction->Append(itemInstance(item, save));
+        }
+
+        if (grouped)
+            for (uint32 item = 0; item < items; ++item)
+                transaction->Append(inventoryItem(item, save));
+
+        return transaction;
+    };
+
+    int rowByRow = 0, interleaved = 0, grouped = 0;
+    for (uint32 save = 0; save < saves; ++save)
+    {
+        rowByRow += Commit(build(save, false), 1);
+        interleaved += Commit(build(save, false), 64);
+        grouped += Commit(build(save, true), 64);
+    }
+
+    RecordProperty("RowByRowMicroseconds", rowByRow);
+    RecordProperty("InterleavedMicroseconds", interleaved);
+    RecordProperty("GroupedMicroseconds", grouped);
+    EXPECT_LT(grouped, interleaved);
+}
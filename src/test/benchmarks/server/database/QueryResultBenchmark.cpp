@@ -0,0 +1,103 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "Field.h"
+#include "MySQLConnection.h"
+#include "QueryResult.h"
+#include "gtest/gtest.h"
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+    class StreamConnection : public MySQLConnection
+    {
+    public:
+        StreamConnection(MySQLConnectionInfo& connInfo) : MySQLConnection(connInfo) { }
+
+        void DoPrepareStatements() override { }
+
+        using MySQLConnection::LockIfReady;
+    };
+}
+
+// stored against streamed ad hoc results of about the size of the creature table
+// needs a scratch database: ACORE_TEST_DATABASE_INFO="127.0.0.1;3306;acore;acore;acore_test"
+TEST(QueryResultBenchmark, StreamedLoad)
+{
+    char const* info = std::getenv("ACORE_TEST_DATABASE_INFO");
+    if (!info)
+        GTEST_SKIP() << "ACORE_TEST_DATABASE_INFO is not set";
+
+    MySQLConnectionInfo connectionInfo(info);
+    StreamConnection connection(connectionInfo);
+    ASSERT_EQ(connection.Open(), 0u);
+    ASSERT_TRUE(connection.Execute("CREATE TEMPORARY TABLE query_result_benchmark (id INT UNSIGNED NOT NULL PRIMARY KEY, map SMALLINT UNSIGNED NOT NULL, "
+        "position_x FLOAT NOT NULL, position_y FLOAT NOT NULL, name VARCHAR(32) NOT NULL)"));
+
+    // about the size of the creature table
+    uint32 const rows = 150000;
+    for (uint32 first = 0; first < rows; first += 1000)
+    {
+        std::string sql = "INSERT INTO query_result_benchmark VALUES ";
+        for (uint32 id = first; id < first + 1000; ++id)
+            sql += (id != first ? ", (" : "(") + std::to_string(id) + ", " + std::to_string(id % 600) + ", " + std::to_string(id * 0.5f) + ", -" + std::to_string(id * 0.25f) + ", 'spawn')";
+
+        ASSERT_TRUE(connection.Execute(sql.c_str()));
+    }
+
+    char const* select = "SELECT id, map, position_x, position_y, name FROM query_result_benchmark";
+
+    auto load = [&](ResultSet* result)
+    {
+        uint64 sum = 0;
+        uint32 count = 0;
+        int elapsed = MeasureMicroseconds([&]()
+        {
+            while (result->NextRow())
+            {
+                Field* fields = result->Fetch();
+                sum += fields[0].GetUInt32() + fields[1].GetUInt16() + fields[4].GetString().size();
+                ++count;
+            }
+        });
+
+        EXPECT_EQ(count, rows);
+        EXPECT_NE(sum, 0u);
+        delete result;
+        return elapsed;
+    };
+
+    ResultSet* stored = nullptr;
+    int storeTime = MeasureMicroseconds([&]() { stored = connection.Query(select); });
+    ASSERT_NE(stored, nullptr);
+    int storedReadTime = load(stored);
+
+    // the streamed result unlocks the connection once every row was read
+    ASSERT_TRUE(connection.LockIfReady());
+    ResultSet* streamed = nullptr;
+    int streamStartTime = MeasureMicroseconds([&]() { streamed = connection.StreamQuery(select); });
+    ASSERT_NE(streamed, nullptr);
+    int streamedReadTime = load(streamed);
+
+    RecordProperty("Rows", int(rows));
+    RecordProperty("StoredMicroseconds", storeTime + storedReadTime);
+    RecordProperty("StreamedMicroseconds", streamStartTime + streamedReadTime);
+    RecordProperty("StoreQueryMicroseconds", storeTime);
+    RecordProperty("StreamQueryMicroseconds", streamStartTime);
+}
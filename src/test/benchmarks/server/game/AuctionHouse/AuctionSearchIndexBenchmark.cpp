@@ -0,0 +1,185 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuctionHouseMgr.h"
+#include "AuctionSearchIndex.h"
+#include "Benchmark.h"
+#include "ItemTemplate.h"
+#include "gtest/gtest.h"
+#include <cwctype>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    std::wstring const Suffixes[] = { L"", L" of the Monkey", L" of the Eagle", L" of Healing" };
+
+    std::wstring BuildTestName(ItemTemplate const* proto, int32 randomPropertyId, LocaleConstant /*dbLocale*/, LocaleConstant /*dbcLocale*/)
+    {
+        std::wstring name(proto->Name1.begin(), proto->Name1.end());
+        name += Suffixes[randomPropertyId];
+        for (wchar_t& c : name)
+            c = wchar_t(std::towlower(c));
+        return name;
+    }
+
+    class TestAuctionHouse
+    {
+    public:
+        explicit TestAuctionHouse(uint32 auctionCount) : _rng(42)
+        {
+            char const* words[] = { "Linen", "Cloth", "Runecloth", "Bracers", "Robe", "Sword", "Axe", "Potion", "Elixir", "Ore", "Bar", "Gem" };
+
+            for (uint32 i = 0; i < 500; ++i)
+            {
+                auto proto = std::make_unique<ItemTemplate>();
+                proto->ItemId = i + 1;
+                proto->Class = _rng() % 16;
+                proto->SubClass = _rng() % 12;
+                proto->InventoryType = _rng() % 29;
+                proto->Quality = _rng() % 7;
+                proto->RequiredLevel = _rng() % 81;
+                proto->Name1 = std::string(words[_rng() % 12]) + " " + words[_rng() % 12];
+                _templates.push_back(std::move(proto));
+            }
+
+            for (uint32 i = 0; i < auctionCount; ++i)
+                Add();
+        }
+
+        void Add()
+        {
+            Auction auction;
+            auction.Entry = std::make_unique<AuctionEntry>();
+            auction.Entry->Id = uint32(_auctions.size() + 1);
+            auction.Proto = _templates[_rng() % _templates.size()].get();
+            auction.RandomPropertyId = int32(_rng() % 4);
+            Index.Insert(auction.Entry.get(), auction.Proto, auction.RandomPropertyId);
+            _auctions.push_back(std::move(auction));
+        }
+
+        // the scan BuildListAuctionItems did before the index
+        std::vector<AuctionEntry*> Scan(AuctionSearchFilter const& filter) const
+        {
+            std::vector<AuctionEntry*> result;
+            for (Auction const& auction : _auctions)
+            {
+                ItemTemplate const* proto = auction.Proto;
+                if (auction.Removed)
+                    continue;
+                if (filter.ItemClass != 0xffffffff && proto->Class != filter.ItemClass)
+                    continue;
+                if (filter.ItemSubClass != 0xffffffff && proto->SubClass != filter.ItemSubClass)
+                    continue;
+                if (filter.InventoryType != 0xffffffff && proto->InventoryType != filter.InventoryType)
+                    if (filter.InventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
+                        continue;
+                if (filter.Quality != 0xffffffff && proto->Quality < filter.Quality)
+                    continue;
+                if (filter.LevelMin != 0x00 && (proto->RequiredLevel < filter.LevelMin || (filter.LevelMax != 0x00 && proto->RequiredLevel > filter.LevelMax)))
+                    continue;
+                if (!filter.Name.empty() && BuildTestName(proto, auction.RandomPropertyId, LOCALE_enUS, LOCALE_enUS).find(filter.Name) == std::wstring::npos)
+                    continue;
+
+                result.push_back(auction.Entry.get());
+            }
+
+            return result;
+        }
+
+        AuctionSearchFilter RandomFilter()
+        {
+            std::wstring const names[] = { L"", L"cloth", L"ro", L"monkey", L"linen bar", L"of the", L"xyz", L"e" };
+
+            AuctionSearchFilter filter;
+            if (_rng() % 2)
+            {
+                filter.ItemClass = _rng() % 16;
+                if (_rng() % 2)
+                    filter.ItemSubClass = _rng() % 12;
+            }
+            if (_rng() % 4 == 0)
+                filter.InventoryType = _rng() % 2 ? uint32(INVTYPE_CHEST) : _rng() % 29;
+            if (_rng() % 3 == 0)
+                filter.Quality = _rng() % 7;
+            if (_rng() % 3 == 0)
+            {
+                filter.LevelMin = uint8(_rng() % 60 + 1);
+                filter.LevelMax = _rng() % 2 ? uint8(filter.LevelMin + _rng() % 20) : 0;
+            }
+            filter.Name = names[_rng() % 8];
+            return filter;
+        }
+
+        AuctionSearchIndex Index{ &BuildTestName };
+
+    private:
+        struct Auction
+        {
+            std::unique_ptr<AuctionEntry> Entry;
+            ItemTemplate const* Proto = nullptr;
+            int32 RandomPropertyId = 0;
+            bool Removed = false;
+        };
+
+        std::mt19937 _rng;
+        std::vector<std::unique_ptr<ItemTemplate>> _templates;
+        std::vector<Auction> _auctions;
+    };
+}
+
+// compares the index against the full scan on a large auction house
+TEST(AuctionSearchIndexBenchmark, Query)
+{
+    constexpr uint32 AuctionCount = 100000;
+    constexpr uint32 QueryCount = 200;
+
+    TestAuctionHouse house(AuctionCount);
+    std::vector<AuctionSearchFilter> filters;
+    for (uint32 i = 0; i < QueryCount; ++i)
+        filters.push_back(house.RandomFilter());
+
+    // the first name search builds the name index of the locale
+    std::vector<AuctionEntry*> found;
+    AuctionSearchFilter warmup;
+    warmup.Name = L"cloth";
+    RecordProperty("NameIndexMicroseconds", MeasureMicroseconds([&]()
+    {
+        house.Index.Search(warmup, found, []() { return false; });
+    }));
+
+    std::size_t indexedMatches = 0, scannedMatches = 0;
+
+    RecordProperty("IndexMicroseconds", MeasureMicroseconds([&]()
+    {
+        for (AuctionSearchFilter const& filter : filters)
+        {
+            found.clear();
+            house.Index.Search(filter, found, []() { return false; });
+            indexedMatches += found.size();
+        }
+    }));
+
+    RecordProperty("ScanMicroseconds", MeasureMicroseconds([&]()
+    {
+        for (AuctionSearchFilter const& filter : filters)
+            scannedMatches += house.Scan(filter).size();
+    }));
+
+    EXPECT_EQ(indexedMatches, scannedMatches);
+}
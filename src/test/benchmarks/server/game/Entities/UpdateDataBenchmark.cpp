@@ -0,0 +1,71 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "UpdateData.h"
+#include "WorldMock.h"
+#include "WorldPacket.h"
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+#include <zlib.h>
+
+using namespace testing;
+
+// the reused compression stream of UpdateData against a deflateInit and deflateEnd per packet
+TEST(UpdateDataBenchmark, Compress)
+{
+    NiceMock<WorldMock>* worldMock = new NiceMock<WorldMock>();
+    ON_CALL(*worldMock, getIntConfig(CONFIG_COMPRESSION)).WillByDefault(Return(1));
+    ON_CALL(*worldMock, getBoolConfig(CONFIG_COMPRESSION_OFFLOAD)).WillByDefault(Return(true));
+    sWorld.reset(worldMock);
+
+    // values blocks repeat a lot, random bytes over a small alphabet compress about as well
+    std::mt19937 rng(3);
+    std::vector<WorldPacket> packets;
+    for (uint32 i = 0; i < 20000; ++i)
+    {
+        uint32 size = 200 + rng() % 1000;
+        ByteBuffer block(size);
+        for (uint32 j = 0; j < size; ++j)
+            block << uint8(rng() % 16);
+
+        UpdateData data;
+        data.AddUpdateBlock(block);
+        packets.emplace_back();
+        data.BuildPacket(&packets.back());
+    }
+
+    RecordProperty("StreamPerPacketMicroseconds", MeasureMicroseconds([&]()
+    {
+        for (WorldPacket const& packet : packets)
+        {
+            uLongf size = compressBound(packet.size());
+            std::vector<uint8> compressed(size);
+            compress2(compressed.data(), &size, packet.contents(), packet.size(), 1);
+        }
+    }));
+
+    RecordProperty("ReusedStreamMicroseconds", MeasureMicroseconds([&]()
+    {
+        for (WorldPacket const& packet : packets)
+        {
+            WorldPacket compressed;
+            UpdateData::CompressPacket(packet, compressed);
+        }
+    }));
+}
@@ -0,0 +1,115 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Benchmark.h"
+#include "GridRangeFilter.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// compares the exact check of every object against the filter in batches of GRID_RANGE_FILTER_BATCH
+TEST(GridRangeFilterBenchmark, Filter)
+{
+    // the exact check reads the position from the object, padded to about the size of a WorldObject
+    struct Object
+    {
+        float X, Y, Z, Size;
+        uint32 PhaseMask;
+        uint8 Padding[512];
+    };
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coord(-66.0f, 66.0f);
+    std::uniform_real_distribution<float> size(0.0f, 3.0f);
+    std::uniform_int_distribution<uint32> phase(1, 3);
+
+    std::vector<float> x, y, z, sizes;
+    std::vector<uint32> phaseMasks;
+    std::vector<Object> objects(4096);
+    for (Object& object : objects)
+    {
+        object.X = coord(rng);
+        object.Y = coord(rng);
+        object.Z = coord(rng) / 10.0f;
+        object.Size = size(rng);
+        object.PhaseMask = phase(rng);
+
+        x.push_back(object.X);
+        y.push_back(object.Y);
+        z.push_back(object.Z);
+        sizes.push_back(object.Size);
+        phaseMasks.push_back(object.PhaseMask);
+    }
+
+    GridRangeQuery query;
+    query.Radius = 30.0f;
+    query.CheckPhase = true;
+    query.PhaseMask = 1;
+
+    auto exactCheck = [&query](Object const& object)
+    {
+        float dx = object.X - query.X;
+        float dy = object.Y - query.Y;
+        float dz = object.Z - query.Z;
+        float range = query.Radius + object.Size;
+        return (object.PhaseMask & query.PhaseMask) && dx * dx + dy * dy + dz * dz <= range * range;
+    };
+
+    auto filtered = [&](bool scalar)
+    {
+        uint32 found = 0;
+        uint32 candidates[GRID_RANGE_FILTER_BATCH];
+        for (uint32 begin = 0; begin < objects.size(); begin += GRID_RANGE_FILTER_BATCH)
+        {
+            uint32 count = std::min<uint32>(objects.size() - begin, GRID_RANGE_FILTER_BATCH);
+            uint32 candidateCount = (scalar ? Acore::FilterInRangeScalar : Acore::FilterInRange)(query, &x[begin], &y[begin],
+                &z[begin], &sizes[begin], &phaseMasks[begin], count, candidates);
+
+            for (uint32 i = 0; i < candidateCount; ++i)
+                found += exactCheck(objects[begin + candidates[i]]);
+        }
+
+        return found;
+    };
+
+    constexpr uint32 Passes = 1000;
+
+    uint32 exactFound = 0;
+    RecordProperty("ExactMicroseconds", MeasureMicroseconds([&]()
+    {
+        for (uint32 pass = 0; pass < Passes; ++pass)
+            for (Object const& object : objects)
+                exactFound += exactCheck(object);
+    }));
+
+    uint32 scalarFound = 0;
+    RecordProperty("ScalarFilterMicroseconds", MeasureMicroseconds([&]()
+    {
+        for (uint32 pass = 0; pass < Passes; ++pass)
+            scalarFound += filtered(true);
+    }));
+
+    uint32 vectorFound = 0;
+    RecordProperty("FilterMicroseconds", MeasureMicroseconds([&]()
+    {
+        for (uint32 pass = 0; pass < Passes; ++pass)
+            vectorFound += filtered(false);
+    }));
+
+    EXPECT_EQ(scalarFound, exactFound);
+    EXPECT_EQ(vectorFound, exactFound);
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "GridRefMgr.h"
+#include "GridReference.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // provides what the packed slots copy from a WorldObject, padded to about the size of one
+    struct GridTestObject
+    {
+        uint32 PhaseMask = 1;
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Z = 0.0f;
+        float Size = 0.0f;
+        GridReference<GridTestObject> Ref;
+        uint8 Padding[512];
+
+        uint32 GetPhaseMask() const { return PhaseMask; }
+        bool InSamePhase(uint32 phaseMask) const { return (PhaseMask & phaseMask) != 0; }
+        float GetPositionX() const { return X; }
+        float GetPositionY() const { return Y; }
+        float GetPositionZ() const { return Z; }
+        float GetObjectSize() const { return Size; }
+    };
+
+    typedef GridRefMgr<GridTestObject> TestCell;
+}
+
+// walks the cells with the phase test of a searcher through the list and the slots
+TEST(GridRefMgrBenchmark, SlotWalk)
+{
+    std::vector<TestCell> cells(64);
+    std::vector<GridTestObject> objects(20000);
+
+    // objects enter the cells in random order, the list nodes are spread over the whole array as on a live map
+    std::mt19937 rng(2);
+    std::vector<uint32> order(objects.size());
+    for (uint32 i = 0; i < order.size(); ++i)
+        order[i] = i;
+
+    std::shuffle(order.begin(), order.end(), rng);
+    for (uint32 index : order)
+    {
+        GridTestObject& object = objects[index];
+        object.PhaseMask = 1 << (rng() % 4);
+        object.Ref.link(&cells[rng() % cells.size()], &object);
+    }
+
+    uint32 listed = 0;
+    RecordProperty("ListMicroseconds", MeasureMicroseconds([&]()
+    {
+        for (uint32 pass = 0; pass < 100; ++pass)
+            for (TestCell& cell : cells)
+                for (GridReference<GridTestObject>* ref = cell.getFirst(); ref; ref = ref->next())
+                    listed += ref->GetSource()->InSamePhase(1);
+    }));
+
+    uint32 slotted = 0;
+    RecordProperty("SlotMicroseconds", MeasureMicroseconds([&]()
+    {
+        for (uint32 pass = 0; pass < 100; ++pass)
+            for (TestCell& cell : cells)
+                for (TestCell::slot_iterator itr = cell.slot_begin(); itr != cell.slot_end(); ++itr)
+                    slotted += itr.InSamePhase(1);
+    }));
+
+    EXPECT_EQ(slotted, listed);
+}
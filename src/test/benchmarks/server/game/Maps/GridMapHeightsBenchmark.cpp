@@ -0,0 +1,173 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Benchmark.h"
+#include "Map.h"
+#include "WorldMock.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+    uint32 Magic(char const* fourcc)
+    {
+        uint32 value;
+        memcpy(&value, fourcc, sizeof(value));
+        return value;
+    }
+
+    template<class T>
+    void Append(std::vector<uint8>& data, T const* values, std::size_t count)
+    {
+        uint8 const* bytes = reinterpret_cast<uint8 const*>(values);
+        data.insert(data.end(), bytes, bytes + count * sizeof(T));
+    }
+
+    // .map file of a single grid with random heights stored as T and a few holes
+    template<class T>
+    std::string WriteGridFile(uint32 heightFlags, uint32 seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> height(-200.0f, 800.0f);
+
+        std::vector<T> v9(129 * 129);
+        std::vector<T> v8(128 * 128);
+        auto randomHeight = [&]() -> T
+        {
+            if constexpr (std::is_same_v<T, float>)
+                return height(rng);
+            else
+                return T(rng());
+        };
+
+        for (T& value : v9)
+            value = randomHeight();
+        for (T& value : v8)
+            value = randomHeight();
+
+        std::vector<uint16> holes(16 * 16, 0);
+        for (uint32 i = 0; i < 20; ++i)
+            holes[rng() % holes.size()] = uint16(rng());
+
+        map_fileheader header = { };
+        header.mapMagic = Magic("MAPS");
+        header.versionMagic = 8;
+        header.heightMapOffset = sizeof(map_fileheader);
+        header.heightMapSize = uint32(sizeof(map_heightHeader) + (v9.size() + v8.size()) * sizeof(T));
+        header.holesOffset = header.heightMapOffset + header.heightMapSize;
+        header.holesSize = uint32(holes.size() * sizeof(uint16));
+
+        map_heightHeader heightHeader;
+        heightHeader.fourcc = Magic("MHGT");
+        heightHeader.flags = heightFlags;
+        heightHeader.gridHeight = -150.0f;
+        heightHeader.gridMaxHeight = 650.0f;
+
+        std::vector<uint8> data;
+        Append(data, &header, 1);
+        Append(data, &heightHeader, 1);
+        Append(data, v9.data(), v9.size());
+        Append(data, v8.data(), v8.size());
+        Append(data, holes.data(), holes.size());
+
+        std::string path = (std::filesystem::temp_directory_path() / ("GridMapHeightsBenchmark" + std::to_string(seed) + ".map")).string();
+        FILE* file = fopen(path.c_str(), "wb");
+        fwrite(data.data(), 1, data.size(), file);
+        fclose(file);
+        return path;
+    }
+
+    class GridMapHeightsBenchmark : public Test
+    {
+    protected:
+        void SetUp() override
+        {
+            worldMock = new NiceMock<WorldMock>();
+            SetMemoryMapped(false);
+            sWorld.reset(worldMock);
+        }
+
+        void SetMemoryMapped(bool enabled)
+        {
+            ON_CALL(*worldMock, getBoolConfig(CONFIG_MEMORY_MAPPED_MAP_FILES)).WillByDefault(Return(enabled));
+        }
+
+        WorldMock* worldMock;
+    };
+}
+
+// loads the same grids read into the heap and memory mapped
+TEST_F(GridMapHeightsBenchmark, MappedLoad)
+{
+    std::vector<std::string> paths;
+    for (uint32 i = 0; i < 64; ++i)
+        paths.push_back(WriteGridFile<float>(0, 100 + i));
+
+    auto loadAll = [&paths]()
+    {
+        std::vector<GridMap> grids(paths.size());
+        for (uint32 round = 0; round < 20; ++round)
+            for (std::size_t i = 0; i < paths.size(); ++i)
+                grids[i].loadData(const_cast<char*>(paths[i].c_str()));
+    };
+
+    RecordProperty("ReadMicroseconds", MeasureMicroseconds(loadAll));
+
+    SetMemoryMapped(true);
+    RecordProperty("MappedMicroseconds", MeasureMicroseconds(loadAll));
+
+    for (std::string const& path : paths)
+        std::filesystem::remove(path);
+}
+
+// compares the batch against per point lookups of random points
+TEST_F(GridMapHeightsBenchmark, Batch)
+{
+    std::string path = WriteGridFile<uint16>(MAP_HEIGHT_AS_INT16, 4);
+    GridMap grid;
+    ASSERT_TRUE(grid.loadData(const_cast<char*>(path.c_str())));
+
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<float> coord(-SIZE_OF_GRIDS + 0.01f, 0.0f);
+
+    std::vector<G3D::Vector3> points;
+    for (uint32 i = 0; i < 1000000; ++i)
+        points.emplace_back(coord(rng), coord(rng), 0.0f);
+
+    std::vector<float> heights(points.size());
+    RecordProperty("ScalarMicroseconds", MeasureMicroseconds([&]()
+    {
+        for (std::size_t i = 0; i < points.size(); ++i)
+            heights[i] = grid.getHeight(points[i].x, points[i].y);
+    }));
+
+    std::vector<float> batchHeights(points.size());
+    RecordProperty("BatchMicroseconds", MeasureMicroseconds([&]()
+    {
+        grid.getHeights(points.data(), batchHeights.data(), uint32(points.size()));
+    }));
+
+    EXPECT_EQ(batchHeights, heights);
+
+    grid.unloadData();
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,189 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Benchmark.h"
+#include "DBCStructure.h"
+#include "SpellAuraEffects.h"
+#include "SpellAuras.h"
+#include "SpellInfo.h"
+#include "Unit.h"
+#include "WorldMock.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+    // a unit that is never added to a map, only its aura containers are used
+    class AuraTestUnit : public Unit
+    {
+    public:
+        explicit AuraTestUnit(ObjectGuid::LowType guid) : Unit(false)
+        {
+            m_valuesCount = UNIT_END;
+            _InitValues();
+            Object::_Create(guid, 0, HighGuid::Unit);
+        }
+
+        ~AuraTestUnit() override
+        {
+            RemoveAllAuras();
+        }
+
+        [[nodiscard]] uint32 GetShieldBlockValue() const override { return 0; }
+        bool UpdateStats(Stats /*stat*/) override { return true; }
+        bool UpdateAllStats() override { return true; }
+        void UpdateResistances(uint32 /*school*/) override { }
+        void UpdateArmor() override { }
+        void UpdateMaxHealth() override { }
+        void UpdateMaxPower(Powers /*power*/) override { }
+        void UpdateAttackPowerAndDamage(bool /*ranged*/ = false) override { }
+        void CalculateMinMaxDamage(WeaponAttackType /*attType*/, bool /*normalized*/, bool /*addTotalPct*/, float& minDamage, float& maxDamage) override { minDamage = maxDamage = 0.0f; }
+        [[nodiscard]] bool CanFly() const override { return false; }
+        [[nodiscard]] bool CanEnterWater() const override { return false; }
+        void SetTarget(ObjectGuid /*guid*/ = ObjectGuid::Empty) override { }
+    };
+
+    // Applies auras with one SPELL_AURA_MOD_DAMAGE_PERCENT_TAKEN effect through the unit's aura application code.
+    // The effect has no immediate handler, the unit only registers it in its effect list.
+    class AuraEffectAggregateBenchmark : public Test
+    {
+    protected:
+        static constexpr AuraType TestAuraType = SPELL_AURA_MOD_DAMAGE_PERCENT_TAKEN;
+
+        void SetUp() override
+        {
+            sWorld.reset(new NiceMock<WorldMock>());
+        }
+
+        void TearDown() override
+        {
+            _units.clear();
+            _spells.clear();
+        }
+
+        AuraTestUnit* CreateUnit()
+        {
+            _units.push_back(std::make_unique<AuraTestUnit>(ObjectGuid::LowType(_units.size() + 1)));
+            return _units.back().get();
+        }
+
+        // the aura is owned and cast by owner, target is owner or another unit in range of its area aura
+        AuraEffect* ApplyAura(Unit* owner, int32 amount, Unit* target = nullptr)
+        {
+            SpellEntry entry{};
+            entry.Id = 90000 + uint32(_spells.size());
+            entry.Effect[EFFECT_0] = SPELL_EFFECT_APPLY_AURA;
+            entry.EffectApplyAuraName[EFFECT_0] = TestAuraType;
+            entry.EffectImplicitTargetA[EFFECT_0] = TARGET_UNIT_CASTER;
+            _spells.push_back(std::make_unique<SpellInfo>(&entry));
+
+            int32 baseAmount[MAX_SPELL_EFFECTS] = { amount, 0, 0 };
+            Aura* aura = Aura::Create(_spells.back().get(), 1 << EFFECT_0, owner, owner, baseAmount, nullptr, ObjectGuid::Empty);
+            if (!aura)
+                return nullptr;
+
+            for (Unit* applyTarget : { owner, target })
+            {
+                if (!applyTarget)
+                    continue;
+
+                AuraApplication* aurApp = applyTarget->_CreateAuraApplication(aura, 1 << EFFECT_0);
+                if (!aurApp)
+                    return nullptr;
+
+                applyTarget->_ApplyAura(aurApp, 1 << EFFECT_0);
+            }
+
+            return aura->GetEffect(EFFECT_0);
+        }
+
+    private:
+        std::vector<std::unique_ptr<SpellInfo>> _spells;
+        std::vector<std::unique_ptr<AuraTestUnit>> _units;
+    };
+}
+
+// Applies and removes 100 auras on a unit, querying its modifiers after every change like a StatSystem update would.
+// Compares Unit's cached aggregates with walking the unit's effect list on every query.
+TEST_F(AuraEffectAggregateBenchmark, ApplyRemove)
+{
+    constexpr uint32 AuraCount = 100;
+    constexpr uint32 QueriesPerChange = 50;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int32> amounts(-50, 50);
+    std::vector<int32> auraAmounts(AuraCount);
+    for (int32& amount : auraAmounts)
+        amount = amounts(rng);
+
+    auto applyAndRemove = [&](auto query)
+    {
+        AuraTestUnit* unit = CreateUnit();
+        int64 sum = 0;
+
+        std::vector<AuraEffect*> effects;
+        for (int32 amount : auraAmounts)
+        {
+            effects.push_back(ApplyAura(unit, amount));
+            for (uint32 i = 0; i < QueriesPerChange; ++i)
+                sum += query(unit);
+        }
+
+        for (AuraEffect* effect : effects)
+        {
+            effect->GetBase()->Remove();
+            for (uint32 i = 0; i < QueriesPerChange; ++i)
+                sum += query(unit);
+        }
+
+        return sum;
+    };
+
+    int64 uncachedSum = 0;
+    RecordProperty("UncachedMicroseconds", MeasureMicroseconds([&]()
+    {
+        uncachedSum = applyAndRemove([](Unit* unit)
+        {
+            int32 total = 0, maxPositive = 0, minNegative = 0;
+            for (AuraEffect const* effect : unit->GetAuraEffectsByType(TestAuraType))
+            {
+                total += effect->GetAmount();
+                maxPositive = std::max(maxPositive, effect->GetAmount());
+                minNegative = std::min(minNegative, effect->GetAmount());
+            }
+
+            return int64(total) + maxPositive + minNegative;
+        });
+    }));
+
+    int64 cachedSum = 0;
+    RecordProperty("CachedMicroseconds", MeasureMicroseconds([&]()
+    {
+        cachedSum = applyAndRemove([](Unit* unit)
+        {
+            return int64(unit->GetTotalAuraModifier(TestAuraType)) + unit->GetMaxPositiveAuraModifier(TestAuraType)
+                + unit->GetMaxNegativeAuraModifier(TestAuraType);
+        });
+    }));
+
+    RecordProperty("Queries", int(2 * AuraCount * QueriesPerChange));
+    EXPECT_EQ(cachedSum, uncachedSum);
+}
@@ -0,0 +1,170 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MMapPathCache.h"
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+namespace
+{
+    dtPolyRef MakePolyRef(uint32 tile, uint32 poly)
+    {
+        return (dtPolyRef(tile) << DT_POLY_BITS) | poly;
+    }
+}
+
+TEST(MMapPathCacheTest, StoresAndFindsCorridors)
+{
+    MMAP::PathCache cache;
+    cache.SetCapacity(4);
+
+    dtPolyRef corridor[] = { 10, 11, 12, 13 };
+    cache.Store(0, 10, 13, 1, 0, corridor, 4);
+
+    dtPolyRef path[8] = { };
+    uint32 pathLength = 0;
+    ASSERT_TRUE(cache.Find(0, 10, 13, 1, 0, path, pathLength, 8));
+    EXPECT_EQ(pathLength, 4u);
+    EXPECT_EQ(path[0], 10u);
+    EXPECT_EQ(path[3], 13u);
+
+    // other map, other filter, corridor longer than the output
+    EXPECT_FALSE(cache.Find(1, 10, 13, 1, 0, path, pathLength, 8));
+    EXPECT_FALSE(cache.Find(0, 10, 13, 3, 0, path, pathLength, 8));
+    EXPECT_FALSE(cache.Find(0, 10, 13, 1, 0, path, pathLength, 3));
+
+    MMAP::PathCacheStats stats;
+    cache.GetStats(stats);
+    EXPECT_EQ(stats.Hits, 1u);
+    EXPECT_EQ(stats.Misses, 3u);
+    EXPECT_EQ(stats.Size, 1u);
+}
+
+TEST(MMapPathCacheTest, EvictsLeastRecentlyUsed)
+{
+    // the LRU order is kept per shard
+    MMAP::PathCache cache(1);
+    cache.SetCapacity(2);
+
+    dtPolyRef corridor[] = { 1, 2 };
+    cache.Store(0, 1, 2, 1, 0, corridor, 2);
+    cache.Store(0, 3, 4, 1, 0, corridor, 2);
+
+    // touching the first corridor makes the second one the oldest
+    dtPolyRef path[2];
+    uint32 pathLength = 0;
+    ASSERT_TRUE(cache.Find(0, 1, 2, 1, 0, path, pathLength, 2));
+
+    cache.Store(0, 5, 6, 1, 0, corridor, 2);
+
+    EXPECT_TRUE(cache.Find(0, 1, 2, 1, 0, path, pathLength, 2));
+    EXPECT_FALSE(cache.Find(0, 3, 4, 1, 0, path, pathLength, 2));
+    EXPECT_TRUE(cache.Find(0, 5, 6, 1, 0, path, pathLength, 2));
+}
+
+TEST(MMapPathCacheTest, InvalidatesOnlyTheChangedMap)
+{
+    MMAP::PathCache cache;
+    cache.SetCapacity(1024);
+
+    dtPolyRef corridor[] = { 1, 2 };
+    cache.Store(0, 1, 2, 1, 0, corridor, 2);
+    cache.Store(0, 3, 4, 1, 0, corridor, 2);
+    cache.Store(530, 1, 2, 1, 0, corridor, 2);
+
+    cache.InvalidateMap(0);
+
+    dtPolyRef path[2];
+    uint32 pathLength = 0;
+    EXPECT_FALSE(cache.Find(0, 1, 2, 1, 0, path, pathLength, 2));
+    EXPECT_FALSE(cache.Find(0, 3, 4, 1, 0, path, pathLength, 2));
+    EXPECT_TRUE(cache.Find(530, 1, 2, 1, 0, path, pathLength, 2));
+
+    MMAP::PathCacheStats stats;
+    cache.GetStats(stats);
+    EXPECT_EQ(stats.Invalidated, 2u);
+    EXPECT_EQ(stats.Size, 1u);
+}
+
+TEST(MMapPathCacheTest, InvalidatesOnlyCorridorsCrossingTheTiles)
+{
+    MMAP::PathCache cache;
+    cache.SetCapacity(1024);
+
+    // tile 1 to tile 3 through tile 2, within tile 4, within tile 1 of another map
+    dtPolyRef through[] = { MakePolyRef(1, 5), MakePolyRef(2, 7), MakePolyRef(3, 9) };
+    dtPolyRef within[] = { MakePolyRef(4, 1), MakePolyRef(4, 2) };
+    cache.Store(0, through[0], through[2], 1, 0, through, 3);
+    cache.Store(0, within[0], within[1], 1, 0, within, 2);
+    cache.Store(1, through[0], through[2], 1, 0, through, 3);
+
+    EXPECT_EQ(MMAP::PathCache::GetTile(through[1]), 2u);
+
+    dtPolyRef path[4];
+    uint32 pathLength = 0;
+
+    cache.InvalidateTiles(0, { 5, 6 });
+    EXPECT_TRUE(cache.Find(0, through[0], through[2], 1, 0, path, pathLength, 4));
+    EXPECT_TRUE(cache.Find(0, within[0], within[1], 1, 0, path, pathLength, 4));
+
+    // only the middle of the corridor
+    cache.InvalidateTiles(0, { 2 });
+    EXPECT_FALSE(cache.Find(0, through[0], through[2], 1, 0, path, pathLength, 4));
+    EXPECT_TRUE(cache.Find(0, within[0], within[1], 1, 0, path, pathLength, 4));
+    EXPECT_TRUE(cache.Find(1, through[0], through[2], 1, 0, path, pathLength, 4));
+
+    MMAP::PathCacheStats stats;
+    cache.GetStats(stats);
+    EXPECT_EQ(stats.Invalidated, 1u);
+    EXPECT_EQ(stats.Size, 2u);
+}
+
+TEST(MMapPathCacheTest, ShardsShareTheCapacity)
+{
+    MMAP::PathCache cache(4);
+    cache.SetCapacity(64);
+
+    // pathfinder threads storing and finding at once
+    std::vector<std::thread> threads;
+    for (uint32 thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back([&cache, thread]()
+        {
+            for (uint32 i = 0; i < 2000; ++i)
+            {
+                dtPolyRef corridor[] = { MakePolyRef(thread, i), MakePolyRef(thread, i + 1) };
+                cache.Store(0, corridor[0], corridor[1], 1, 0, corridor, 2);
+
+                dtPolyRef path[2];
+                uint32 pathLength = 0;
+                if (cache.Find(0, corridor[0], corridor[1], 1, 0, path, pathLength, 2))
+                    EXPECT_EQ(path[1], corridor[1]);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    MMAP::PathCacheStats stats;
+    cache.GetStats(stats);
+    EXPECT_LE(stats.Size, 64u);
+    EXPECT_GT(stats.Size, 32u);
+    EXPECT_EQ(stats.Capacity, 64u);
+    EXPECT_EQ(stats.Hits + stats.Misses, 4u * 2000);
+}
@@ -0,0 +1,94 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Appender.h"
+#include "AsyncLogWriter.h"
+#include "LogMessage.h"
+#include "Logger.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // keeps the text of every message, only the writer thread calls it
+    class RecordingAppender : public Appender
+    {
+    public:
+        RecordingAppender() : Appender(1, "Recording", LOG_LEVEL_TRACE) { }
+
+        AppenderType getType() const override { return APPENDER_NONE; }
+
+        std::vector<std::string> Texts;
+
+    private:
+        void _write(LogMessage const* message) override { Texts.push_back(message->text); }
+    };
+
+    std::unique_ptr<LogMessage> MakeMessage(uint32 thread, uint32 index)
+    {
+        return std::make_unique<LogMessage>(LOG_LEVEL_INFO, "server", std::to_string(thread) + " " + std::to_string(index));
+    }
+
+    template<class Write>
+    void RunProducers(uint32 threads, Write const& write)
+    {
+        std::vector<std::thread> producers;
+        for (uint32 thread = 0; thread < threads; ++thread)
+            producers.emplace_back([thread, &write]() { write(thread); });
+
+        for (std::thread& producer : producers)
+            producer.join();
+    }
+}
+
+TEST(AsyncLogWriterTest, KeepsOrderOfEveryThread)
+{
+    constexpr uint32 Threads = 4;
+    constexpr uint32 MessagesPerThread = 10000;
+
+    RecordingAppender appender;
+    Logger logger("server", LOG_LEVEL_TRACE);
+    logger.addAppender(appender.getId(), &appender);
+
+    // a ring much smaller than the messages makes the producers wait for the writer
+    AsyncLogWriter writer(64, LOG_ASYNC_OVERFLOW_BLOCK, &logger, nullptr);
+    RunProducers(Threads, [&writer, &logger](uint32 thread)
+    {
+        for (uint32 i = 0; i < MessagesPerThread; ++i)
+            EXPECT_TRUE(writer.Enqueue(&logger, MakeMessage(thread, i)));
+    });
+
+    writer.Flush();
+
+    ASSERT_EQ(appender.Texts.size(), Threads * MessagesPerThread);
+    EXPECT_EQ(writer.GetDroppedCount(), 0u);
+
+    std::vector<uint32> next(Threads, 0);
+    for (std::string const& text : appender.Texts)
+    {
+        uint32 thread = std::stoul(text);
+        ASSERT_LT(thread, Threads);
+        EXPECT_EQ(text, std::to_string(thread) + " " + std::to_string(next[thread]));
+        ++next[thread];
+    }
+
+    writer.Stop();
+    logger.delAppender(appender.getId());
+}
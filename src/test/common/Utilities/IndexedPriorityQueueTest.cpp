@@ -0,0 +1,154 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IndexedPriorityQueue.h"
+#include "gtest/gtest.h"
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct ThreatEntry
+    {
+        uint32 Id = 0;
+        float Threat = 0.0f;
+        uint32 Order = 0;
+        bool SecondChoice = false;
+        uint32 HeapIndex = 0;
+    };
+
+    struct ThreatEntryOrder
+    {
+        bool operator()(ThreatEntry const* a, ThreatEntry const* b) const
+        {
+            if (a->Threat != b->Threat)
+                return a->Threat > b->Threat;
+            return a->Order < b->Order;
+        }
+    };
+
+    typedef Acore::IndexedPriorityQueue<ThreatEntry, ThreatEntryOrder, &ThreatEntry::HeapIndex> ThreatQueue;
+
+    // a list sorted with the same order before every selection
+    ThreatEntry const* SelectFromSortedList(std::list<ThreatEntry*> list)
+    {
+        list.sort(ThreatEntryOrder());
+        for (ThreatEntry const* entry : list)
+            if (!entry->SecondChoice)
+                return entry;
+        return list.empty() ? nullptr : list.front();
+    }
+
+    ThreatEntry const* SelectFromQueue(ThreatQueue const& queue)
+    {
+        if (ThreatEntry const* entry = queue.visitOrdered([](ThreatEntry const* entry) { return !entry->SecondChoice; }))
+            return entry;
+        return queue.top();
+    }
+}
+
+TEST(IndexedPriorityQueueTest, TopFollowsUpdatesAndRemovals)
+{
+    ThreatEntry entries[4];
+    ThreatQueue queue;
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        entries[i].Id = i;
+        entries[i].Threat = float(i * 10);
+        entries[i].Order = i;
+        queue.push(&entries[i]);
+    }
+
+    EXPECT_EQ(queue.top(), &entries[3]);
+
+    entries[0].Threat = 100.0f;
+    queue.update(&entries[0]);
+    EXPECT_EQ(queue.top(), &entries[0]);
+
+    queue.erase(&entries[0]);
+    EXPECT_FALSE(queue.contains(&entries[0]));
+    EXPECT_EQ(queue.top(), &entries[3]);
+    EXPECT_EQ(queue.size(), 3u);
+
+    // equal threat keeps the insertion order
+    entries[1].Threat = 30.0f;
+    queue.update(&entries[1]);
+    EXPECT_EQ(queue.top(), &entries[1]);
+
+    std::vector<uint32> visited;
+    queue.visitOrdered([&](ThreatEntry const* entry) { visited.push_back(entry->Id); return false; });
+    EXPECT_EQ(visited, (std::vector<uint32>{ 1, 3, 2 }));
+}
+
+// Replays randomized fights (attackers joining, leaving and gaining threat every hit) and checks
+// the selected entry matches the one picked by walking a list sorted with the same order
+TEST(IndexedPriorityQueueTest, MatchesSortedListSelection)
+{
+    std::mt19937 rng(1234);
+
+    for (uint32 fight = 0; fight < 20; ++fight)
+    {
+        std::vector<std::unique_ptr<ThreatEntry>> entries;
+        std::list<ThreatEntry*> list;
+        ThreatQueue queue;
+        uint32 nextOrder = 0;
+
+        for (uint32 event = 0; event < 2000; ++event)
+        {
+            uint32 action = rng() % 100;
+            if (action < 5 || list.empty())
+            {
+                entries.push_back(std::make_unique<ThreatEntry>());
+                ThreatEntry* entry = entries.back().get();
+                entry->Id = uint32(entries.size());
+                entry->Order = nextOrder++;
+                entry->Threat = float(rng() % 4) * 100.0f; // plenty of ties
+                list.push_back(entry);
+                queue.push(entry);
+            }
+            else if (action < 8 && list.size() > 1)
+            {
+                auto itr = std::next(list.begin(), rng() % list.size());
+                queue.erase(*itr);
+                list.erase(itr);
+            }
+            else
+            {
+                ThreatEntry* entry = *std::next(list.begin(), rng() % list.size());
+                if (action < 12)
+                    entry->SecondChoice = !entry->SecondChoice;
+                else if (action < 15)
+                    entry->Threat = 0.0f; // threat wipe
+                else
+                    entry->Threat += float(rng() % 2000) - 200.0f;
+                queue.update(entry);
+            }
+
+            ASSERT_EQ(queue.size(), list.size());
+            ASSERT_EQ(SelectFromQueue(queue), SelectFromSortedList(list));
+        }
+
+        std::list<ThreatEntry*> sorted = list;
+        sorted.sort(ThreatEntryOrder());
+        std::list<ThreatEntry*> visited;
+        queue.visitOrdered([&](ThreatEntry* entry) { visited.push_back(entry); return false; });
+        EXPECT_EQ(visited, sorted);
+    }
+}
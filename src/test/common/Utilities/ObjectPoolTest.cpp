@@ -0,0 +1,82 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ObjectPool.h"
+#include "gtest/gtest.h"
+#include <list>
+#include <thread>
+
+namespace
+{
+    ObjectPool& GetTestPool()
+    {
+        static ObjectPool pool("Test");
+        return pool;
+    }
+
+    ObjectPool& GetNodePool()
+    {
+        static ObjectPool pool("TestNodes");
+        return pool;
+    }
+}
+
+TEST(ObjectPoolTest, ReusesFreedBlocks)
+{
+    ObjectPool& pool = GetTestPool();
+    pool.ResetStats();
+
+    void* first = pool.Allocate(100);
+    pool.Deallocate(first, 100);
+
+    // same size class, served from the cache of this thread
+    void* second = pool.Allocate(112);
+    EXPECT_EQ(second, first);
+
+    ObjectPoolStats stats = pool.GetStats();
+    EXPECT_EQ(stats.Allocations, 2u);
+    EXPECT_EQ(stats.Reused, 1u);
+    EXPECT_EQ(stats.Live, 1);
+
+    // freed on another thread, the block joins the cache of that thread
+    std::thread([&]() { pool.Deallocate(second, 112); }).join();
+    EXPECT_EQ(pool.GetStats().Live, 0);
+}
+
+TEST(ObjectPoolTest, AllocatorBacksNodeContainers)
+{
+    ObjectPool& pool = GetNodePool();
+    pool.ResetStats();
+
+    {
+        std::list<int, ObjectPoolAllocator<int, &GetNodePool>> list;
+        for (int i = 0; i < 10; ++i)
+            list.push_back(i);
+        EXPECT_EQ(pool.GetStats().Live, 10);
+
+        // the free blocks are cached per thread and size class, earlier tests may have left some of this size
+        list.clear();
+        uint64 reused = pool.GetStats().Reused;
+        for (int i = 0; i < 10; ++i)
+            list.push_back(i);
+        EXPECT_EQ(pool.GetStats().Reused, reused + 10);
+    }
+
+    ObjectPoolStats stats = pool.GetStats();
+    EXPECT_EQ(stats.Live, 0);
+    EXPECT_EQ(stats.Allocations, 20u);
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BatchedStatement.h"
+#include "gtest/gtest.h"
+
+TEST(BatchedStatementTest, Insert)
+{
+    BatchedStatementTemplate stmt("INSERT INTO character_aura (guid, casterGuid, spell) VALUES (?, ?, ?)");
+
+    ASSERT_TRUE(stmt.IsBatchable());
+    EXPECT_EQ(stmt.GetRowParameterCount(), 3u);
+    EXPECT_EQ(stmt.GetQueryString(1), "INSERT INTO character_aura (guid, casterGuid, spell) VALUES (?, ?, ?)");
+    EXPECT_EQ(stmt.GetQueryString(3), "INSERT INTO character_aura (guid, casterGuid, spell) VALUES (?, ?, ?), (?, ?, ?), (?, ?, ?)");
+}
+
+TEST(BatchedStatementTest, InsertVariants)
+{
+    BatchedStatementTemplate replace("REPLACE INTO character_queststatus (guid, quest, status) VALUES (?, ?, ?)");
+    EXPECT_EQ(replace.GetQueryString(2), "REPLACE INTO character_queststatus (guid, quest, status) VALUES (?, ?, ?), (?, ?, ?)");
+
+    BatchedStatementTemplate ignore("insert ignore into mail_items values(?, ?, ?);");
+    EXPECT_EQ(ignore.GetQueryString(2), "insert ignore into mail_items values(?, ?, ?), (?, ?, ?)");
+
+    // literals stay part of every row, placeholders inside of them are not parameters
+    BatchedStatementTemplate literals("INSERT INTO log_money (sender, topic) VALUES (?, 'why?')");
+    ASSERT_TRUE(literals.IsBatchable());
+    EXPECT_EQ(literals.GetRowParameterCount(), 1u);
+    EXPECT_EQ(literals.GetQueryString(2), "INSERT INTO log_money (sender, topic) VALUES (?, 'why?'), (?, 'why?')");
+
+    BatchedStatementTemplate functions("INSERT INTO account_banned VALUES (?, UNIX_TIMESTAMP(), UNIX_TIMESTAMP() + ?, 1)");
+    EXPECT_EQ(functions.GetRowParameterCount(), 2u);
+    EXPECT_EQ(functions.GetQueryString(2), "INSERT INTO account_banned VALUES (?, UNIX_TIMESTAMP(), UNIX_TIMESTAMP() + ?, 1), (?, UNIX_TIMESTAMP(), UNIX_TIMESTAMP() + ?, 1)");
+}
+
+TEST(BatchedStatementTest, Delete)
+{
+    BatchedStatementTemplate single("DELETE FROM character_aura WHERE guid = ?");
+    ASSERT_TRUE(single.IsBatchable());
+    EXPECT_EQ(single.GetRowParameterCount(), 1u);
+    EXPECT_EQ(single.GetQueryString(1), "DELETE FROM character_aura WHERE guid IN (?)");
+    EXPECT_EQ(single.GetQueryString(3), "DELETE FROM character_aura WHERE guid IN (?, ?, ?)");
+
+    BatchedStatementTemplate multi("DELETE FROM character_spell WHERE guid = ? AND spell = ?");
+    ASSERT_TRUE(multi.IsBatchable());
+    EXPECT_EQ(multi.GetRowParameterCount(), 2u);
+    EXPECT_EQ(multi.GetQueryString(2), "DELETE FROM character_spell WHERE (guid, spell) IN ((?, ?), (?, ?))");
+}
+
+TEST(BatchedStatementTest, NotBatchable)
+{
+    EXPECT_FALSE(BatchedStatementTemplate("SELECT guid FROM characters WHERE account = ?").IsBatchable());
+    EXPECT_FALSE(BatchedStatementTemplate("UPDATE characters SET online = ? WHERE guid = ?").IsBatchable());
+    EXPECT_FALSE(BatchedStatementTemplate("INSERT INTO item_instance (guid, count) VALUES (?, ?) ON DUPLICATE KEY UPDATE count = ?").IsBatchable());
+    EXPECT_FALSE(BatchedStatementTemplate("INSERT INTO character_pet SELECT * FROM character_pet_declinedname WHERE owner = ?").IsBatchable());
+    EXPECT_FALSE(BatchedStatementTemplate("INSERT INTO worldstates (entry, value) VALUES (1, 2)").IsBatchable());
+    EXPECT_FALSE(BatchedStatementTemplate("DELETE FROM mail WHERE expire_time < ?").IsBatchable());
+    EXPECT_FALSE(BatchedStatementTemplate("DELETE FROM character_aura WHERE guid = ? OR spell = ?").IsBatchable());
+    EXPECT_FALSE(BatchedStatementTemplate("DELETE FROM corpse WHERE guid = ? LIMIT 1").IsBatchable());
+    EXPECT_FALSE(BatchedStatementTemplate("DELETE FROM groups").IsBatchable());
+}
+
+TEST(BatchedStatementTest, TemplatesAreShared)
+{
+    std::string const sql = "DELETE FROM character_inventory WHERE item = ?";
+
+    std::shared_ptr<BatchedStatementTemplate const> first = BatchedStatementTemplate::Get(sql);
+    ASSERT_TRUE(first->IsBatchable());
+    EXPECT_EQ(BatchedStatementTemplate::Get(sql), first);
+    EXPECT_NE(BatchedStatementTemplate::Get("DELETE FROM character_aura WHERE guid = ?"), first);
+}
@@ -0,0 +1,155 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Field.h"
+#include "MySQLConnection.h"
+#include "MySQLPreparedStatement.h"
+#include "PreparedStatement.h"
+#include "QueryResult.h"
+#include "gtest/gtest.h"
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    class TypesConnection : public MySQLConnection
+    {
+    public:
+        TypesConnection(MySQLConnectionInfo& connInfo) : MySQLConnection(connInfo) { }
+
+        // prepared once the table exists, Open doesn't prepare statements
+        void DoPrepareStatements() override
+        {
+            m_stmts.resize(1);
+            if (!Select.empty())
+                PrepareStatement(0, Select, CONNECTION_SYNCH);
+        }
+
+        std::string Select;
+    };
+}
+
+// one row of every value range, one of NULLs only, one of empty strings and one of values filling the column
+// needs a scratch database: ACORE_TEST_DATABASE_INFO="127.0.0.1;3306;acore;acore;acore_test"
+class PreparedResultSetTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        char const* info = std::getenv("ACORE_TEST_DATABASE_INFO");
+        if (!info)
+            GTEST_SKIP() << "ACORE_TEST_DATABASE_INFO is not set";
+
+        ConnectionInfo = std::make_unique<MySQLConnectionInfo>(info);
+        Connection = std::make_unique<TypesConnection>(*ConnectionInfo);
+        ASSERT_EQ(Connection->Open(), 0u);
+        ASSERT_TRUE(Connection->Execute("CREATE TEMPORARY TABLE query_result_types (id INT UNSIGNED NOT NULL PRIMARY KEY, "
+            "u8 TINYINT UNSIGNED, i8 TINYINT, u16 SMALLINT UNSIGNED, i16 SMALLINT, u32 INT UNSIGNED, i32 INT, "
+            "u64 BIGINT UNSIGNED, i64 BIGINT, f FLOAT, d DOUBLE, s VARCHAR(8), b VARBINARY(8))"));
+        ASSERT_TRUE(Connection->Execute("INSERT INTO query_result_types VALUES "
+            "(1, 255, -128, 65535, -32768, 4294967295, -2147483648, 18446744073709551615, -9223372036854775808, 1.5, -2.25, 'first', 0x00FF00), "
+            "(2, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL), "
+            "(3, 1, 2, 3, 4, 5, 6, 7, 8, 0.5, 0.125, '', ''), "
+            "(4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 'eightchr', 0x0102030405060708)"));
+
+        Connection->Select = "SELECT u8, i8, u16, i16, u32, i32, u64, i64, f, d, s, b FROM query_result_types ORDER BY id";
+        ASSERT_TRUE(Connection->PrepareStatements());
+
+        PreparedStatementBase stmt(0, 0);
+        Result.reset(Connection->Query(&stmt));
+        ASSERT_NE(Result, nullptr);
+        ASSERT_EQ(Result->GetRowCount(), 4u);
+        ASSERT_EQ(Result->GetFieldCount(), 12u);
+    }
+
+    std::unique_ptr<MySQLConnectionInfo> ConnectionInfo;
+    std::unique_ptr<TypesConnection> Connection;
+    std::unique_ptr<PreparedResultSet> Result;
+};
+
+TEST_F(PreparedResultSetTest, ReadsEveryColumnType)
+{
+    Field* fields = Result->Fetch();
+    EXPECT_EQ(fields[0].GetUInt8(), 255u);
+    EXPECT_EQ(fields[1].GetInt8(), -128);
+    EXPECT_EQ(fields[2].GetUInt16(), 65535u);
+    EXPECT_EQ(fields[3].GetInt16(), -32768);
+    EXPECT_EQ(fields[4].GetUInt32(), 4294967295u);
+    EXPECT_EQ(fields[5].GetInt32(), -2147483647 - 1);
+    EXPECT_EQ(fields[6].GetUInt64(), 18446744073709551615ull);
+    EXPECT_EQ(fields[7].GetInt64(), -9223372036854775807ll - 1);
+    EXPECT_EQ(fields[8].GetFloat(), 1.5f);
+    EXPECT_EQ(fields[9].GetDouble(), -2.25);
+    EXPECT_EQ(fields[10].GetString(), "first");
+    EXPECT_EQ(fields[11].GetBinary(), std::vector<uint8>({ 0x00, 0xFF, 0x00 }));
+
+    // the values of every column are stored one after another, each row reads its own
+    ASSERT_TRUE(Result->NextRow());
+    ASSERT_TRUE(Result->NextRow());
+    fields = Result->Fetch();
+    EXPECT_EQ(fields[0].GetUInt8(), 1u);
+    EXPECT_EQ(fields[1].GetInt8(), 2);
+    EXPECT_EQ(fields[2].GetUInt16(), 3u);
+    EXPECT_EQ(fields[3].GetInt16(), 4);
+    EXPECT_EQ(fields[4].GetUInt32(), 5u);
+    EXPECT_EQ(fields[5].GetInt32(), 6);
+    EXPECT_EQ(fields[6].GetUInt64(), 7u);
+    EXPECT_EQ(fields[7].GetInt64(), 8);
+    EXPECT_EQ(fields[8].GetFloat(), 0.5f);
+    EXPECT_EQ(fields[9].GetDouble(), 0.125);
+
+    ASSERT_TRUE(Result->NextRow());
+    EXPECT_FALSE(Result->NextRow());
+}
+
+TEST_F(PreparedResultSetTest, ReadsNullValues)
+{
+    for (uint32 i = 0; i < Result->GetFieldCount(); ++i)
+        EXPECT_FALSE((*Result)[i].IsNull()) << "column " << i;
+
+    ASSERT_TRUE(Result->NextRow());
+    for (uint32 i = 0; i < Result->GetFieldCount(); ++i)
+        EXPECT_TRUE((*Result)[i].IsNull()) << "column " << i;
+
+    // the NULL row in between doesn't shift the values after it
+    ASSERT_TRUE(Result->NextRow());
+    EXPECT_FALSE((*Result)[0].IsNull());
+    EXPECT_EQ((*Result)[0].GetUInt8(), 1u);
+}
+
+TEST_F(PreparedResultSetTest, ReadsStrings)
+{
+    EXPECT_EQ((*Result)[10].GetStringView(), "first");
+    EXPECT_STREQ((*Result)[10].GetCString(), "first");
+
+    ASSERT_TRUE(Result->NextRow());
+    EXPECT_EQ((*Result)[10].GetString(), "");
+
+    // empty values are not NULL
+    ASSERT_TRUE(Result->NextRow());
+    EXPECT_FALSE((*Result)[10].IsNull());
+    EXPECT_EQ((*Result)[10].GetString(), "");
+    EXPECT_FALSE((*Result)[11].IsNull());
+    EXPECT_TRUE((*Result)[11].GetBinary().empty());
+
+    // values filling the whole column width end where the next row begins
+    ASSERT_TRUE(Result->NextRow());
+    EXPECT_EQ((*Result)[10].GetString(), "eightchr");
+    EXPECT_EQ((*Result)[11].GetBinary(), std::vector<uint8>({ 1, 2, 3, 4, 5, 6, 7, 8 }));
+}
@@ -0,0 +1,182 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MySQLConnection.h"
+#include "MySQLPreparedStatement.h"
+#include "SynchConnectionQueue.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace
+{
+    // never opened, only its lock is used
+    class TestConnection : public MySQLConnection
+    {
+    public:
+        TestConnection(MySQLConnectionInfo& connInfo) : MySQLConnection(connInfo) { }
+
+        void DoPrepareStatements() override { }
+
+        using MySQLConnection::Unlock;
+    };
+
+    struct TestPool
+    {
+        TestPool(std::size_t connections) : ConnectionInfo("127.0.0.1;3306;acore;acore;acore_test"), Queue("acore_test")
+        {
+            for (std::size_t i = 0; i < connections; ++i)
+            {
+                Connections.push_back(std::make_unique<TestConnection>(ConnectionInfo));
+                Queue.AddConnection(Connections.back().get());
+            }
+        }
+
+        ~TestPool()
+        {
+            Queue.Clear();
+        }
+
+        TestConnection* Acquire()
+        {
+            return static_cast<TestConnection*>(Queue.Acquire());
+        }
+
+        // spins until count threads wait for a connection
+        void WaitForWaiting(std::size_t count)
+        {
+            while (Queue.GetWaitingCount() != count)
+                std::this_thread::yield();
+        }
+
+        MySQLConnectionInfo ConnectionInfo;
+        SynchConnectionQueue Queue;
+        std::vector<std::unique_ptr<TestConnection>> Connections;
+    };
+}
+
+TEST(SynchConnectionQueueTest, HandsOutFreeConnections)
+{
+    TestPool pool(2);
+
+    TestConnection* first = pool.Acquire();
+    TestConnection* second = pool.Acquire();
+    EXPECT_NE(first, second);
+
+    first->Unlock();
+    EXPECT_EQ(pool.Acquire(), first);
+
+    first->Unlock();
+    second->Unlock();
+}
+
+TEST(SynchConnectionQueueTest, BlocksUntilReleased)
+{
+    TestPool pool(1);
+
+    TestConnection* connection = pool.Acquire();
+
+    std::atomic<bool> acquired(false);
+    std::thread waiter([&]()
+    {
+        TestConnection* next = pool.Acquire();
+        acquired = true;
+        next->Unlock();
+    });
+
+    pool.WaitForWaiting(1);
+    EXPECT_FALSE(acquired);
+
+    connection->Unlock();
+    waiter.join();
+
+    EXPECT_TRUE(acquired);
+    EXPECT_EQ(pool.Queue.GetWaitingCount(), 0u);
+}
+
+TEST(SynchConnectionQueueTest, ServesInArrivalOrder)
+{
+    TestPool pool(1);
+    std::size_t const threadCount = 6;
+
+    TestConnection* connection = pool.Acquire();
+
+    std::mutex orderLock;
+    std::vector<std::size_t> order;
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back([&, i]()
+        {
+            TestConnection* next = pool.Acquire();
+            {
+                std::lock_guard<std::mutex> guard(orderLock);
+                order.push_back(i);
+            }
+            next->Unlock();
+        });
+
+        // the next thread arrives once this one waits
+        pool.WaitForWaiting(i + 1);
+    }
+
+    connection->Unlock();
+    for (std::thread& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(order.size(), threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i)
+        EXPECT_EQ(order[i], i);
+}
+
+TEST(SynchConnectionQueueTest, RecordsWaitTimePerCaller)
+{
+    TestPool pool(1);
+
+    TestConnection* connection = pool.Acquire();
+
+    std::thread waiter([&]()
+    {
+        SynchConnectionQueue::SetCaller(SYNCH_CALLER_MAP);
+        pool.Acquire()->Unlock();
+    });
+
+    pool.WaitForWaiting(1);
+    std::this_thread::sleep_for(2ms);
+    connection->Unlock();
+    waiter.join();
+
+    std::array<SynchWaitStats, MAX_SYNCH_CALLERS> stats;
+    pool.Queue.GetStats(stats);
+
+    EXPECT_EQ(stats[SYNCH_CALLER_OTHER].Acquired, 1u);
+    EXPECT_EQ(stats[SYNCH_CALLER_MAP].Acquired, 1u);
+    EXPECT_EQ(stats[SYNCH_CALLER_WORLD].Acquired, 0u);
+    EXPECT_GE(stats[SYNCH_CALLER_MAP].MaxWait, 2000u);
+
+    // waited 2 ms at least, past the buckets below 1 ms
+    uint64 longWaits = 0;
+    for (std::size_t bucket = 2; bucket < SYNCH_WAIT_BUCKETS; ++bucket)
+        longWaits += stats[SYNCH_CALLER_MAP].Buckets[bucket];
+
+    EXPECT_EQ(longWaits, 1u);
+
+    pool.Queue.ResetStats();
+    pool.Queue.GetStats(stats);
+    EXPECT_EQ(stats[SYNCH_CALLER_MAP].Acquired, 0u);
+}
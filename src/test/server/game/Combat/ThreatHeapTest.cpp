@@ -0,0 +1,324 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ThreatMgr.h"
+#include "gtest/gtest.h"
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct Target
+    {
+        uint32 Id = 0;
+        float Threat = 0.0f;
+        bool SecondChoice = false;
+        bool Attackable = true;
+        bool InMeleeRange = true;
+        uint32 HeapIndex = 0;
+        float SortedThreat = 0.0f;
+        int64 TieOrder = 0;
+
+        [[nodiscard]] float getThreat() const { return Threat; }
+    };
+
+    typedef Acore::ThreatHeap<Target, &Target::HeapIndex, &Target::SortedThreat, &Target::TieOrder> TargetHeap;
+
+    struct TargetChecks
+    {
+        bool IsSecondChoice(Target const* target) const { return target->SecondChoice; }
+        bool CanAttack(Target const* target) const { return target->Attackable; }
+        bool IsWithinMeleeRange(Target const* target) const { return target->InMeleeRange; }
+    };
+
+    // The container before the heap: new targets are appended to a list that is stable sorted by threat alone
+    // (Acore::ThreatOrderPred) only before a target is selected
+    class SortedList
+    {
+    public:
+        void Add(Target* target) { _list.push_back(target); }
+
+        void Remove(Target* target) { _list.remove(target); }
+
+        void Sort() { _list.sort([](Target const* a, Target const* b) { return a->getThreat() > b->getThreat(); }); }
+
+        [[nodiscard]] std::list<Target*> const& Get() const { return _list; }
+
+        // ThreatContainer::selectNextVictim walking the sorted list
+        Target* SelectNextVictim(Target* currentVictim) const
+        {
+            Target* currentRef = nullptr;
+            bool found = false;
+            bool noPriorityTargetFound = false;
+
+            std::list<Target*>::const_iterator lastRef = _list.end();
+            --lastRef;
+
+            for (std::list<Target*>::const_iterator iter = _list.begin(); iter != _list.end() && !found;)
+            {
+                currentRef = (*iter);
+
+                if (!noPriorityTargetFound && currentRef->SecondChoice)
+                {
+                    if (iter != lastRef)
+                    {
+                        ++iter;
+                        continue;
+                    }
+                    else
+                    {
+                        noPriorityTargetFound = true;
+                        iter = _list.begin();
+                        continue;
+                    }
+                }
+
+                if (currentRef->Attackable)
+                {
+                    if (currentVictim)
+                    {
+                        if (currentVictim == currentRef)
+                        {
+                            found = true;
+                            break;
+                        }
+
+                        if (currentRef->getThreat() > 1.3f * currentVictim->getThreat())
+                        {
+                            found = true;
+                            break;
+                        }
+                        else if (currentRef->getThreat() > 1.1f * currentVictim->getThreat())
+                        {
+                            if (currentRef->InMeleeRange)
+                            {
+                                found = true;
+                                break;
+                            }
+                        }
+                        else
+                        {
+                            currentRef = currentVictim;
+                            found = true;
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+                ++iter;
+            }
+
+            return found ? currentRef : nullptr;
+        }
+
+    private:
+        std::list<Target*> _list;
+    };
+
+    void ChangeThreat(Target* target, float threatChange, TargetHeap& heap)
+    {
+        target->Threat += threatChange;
+        heap.update(target);
+    }
+
+    std::list<Target*> HeapOrder(TargetHeap const& heap)
+    {
+        std::list<Target*> ordered;
+        heap.visitOrdered([&](Target* target) { ordered.push_back(target); return false; });
+        return ordered;
+    }
+}
+
+TEST(ThreatHeapTest, TiesKeepThePreviousOrder)
+{
+    Target a, b, c;
+    a.Threat = 100.0f;
+    b.Threat = 200.0f;
+    c.Threat = 200.0f;
+
+    TargetHeap heap;
+    heap.push(&a);
+    heap.push(&b);
+    heap.markSorted();
+
+    // a catches up with b while b drops and recovers, b was in front at the last sort and stays there
+    ChangeThreat(&a, 100.0f, heap);
+    ChangeThreat(&b, -50.0f, heap);
+    ChangeThreat(&b, 50.0f, heap);
+    heap.markSorted();
+    EXPECT_EQ(heap.top(), &b);
+    EXPECT_EQ(Acore::SelectNextVictim(heap, static_cast<Target*>(nullptr), TargetChecks()), &b);
+
+    // c joins with the same threat and goes last
+    heap.push(&c);
+    EXPECT_EQ(HeapOrder(heap), (std::list<Target*>{ &b, &a, &c }));
+    heap.markSorted();
+    EXPECT_EQ(HeapOrder(heap), (std::list<Target*>{ &b, &a, &c }));
+
+    // c drops below and rises back, it goes behind a and b
+    ChangeThreat(&c, -50.0f, heap);
+    heap.markSorted();
+    ChangeThreat(&c, 50.0f, heap);
+    heap.markSorted();
+    EXPECT_EQ(HeapOrder(heap), (std::list<Target*>{ &b, &a, &c }));
+
+    // a drops below and rises back, it goes behind b and c
+    ChangeThreat(&a, -50.0f, heap);
+    heap.markSorted();
+    ChangeThreat(&a, 50.0f, heap);
+    heap.markSorted();
+    EXPECT_EQ(HeapOrder(heap), (std::list<Target*>{ &b, &c, &a }));
+
+    // a rises above and falls back, it goes in front of b and c
+    ChangeThreat(&a, 50.0f, heap);
+    heap.markSorted();
+    ChangeThreat(&a, -50.0f, heap);
+    heap.markSorted();
+    EXPECT_EQ(HeapOrder(heap), (std::list<Target*>{ &a, &b, &c }));
+}
+
+TEST(ThreatHeapTest, SwitchRules)
+{
+    Target victim, other;
+    victim.Threat = 1000.0f;
+
+    TargetHeap heap;
+    heap.push(&victim);
+    heap.push(&other);
+
+    auto select = [&]() { return Acore::SelectNextVictim(heap, &victim, TargetChecks()); };
+    auto setThreat = [&](float threat)
+    {
+        other.Threat = threat;
+        heap.update(&other);
+        heap.markSorted();
+    };
+
+    // 110% is not enough, more than 110% is enough in melee range only
+    setThreat(1100.0f);
+    EXPECT_EQ(select(), &victim);
+    setThreat(1200.0f);
+    EXPECT_EQ(select(), &other);
+    other.InMeleeRange = false;
+    EXPECT_EQ(select(), &victim);
+
+    // 130% is not enough out of melee range, more than 130% is
+    setThreat(1300.0f);
+    EXPECT_EQ(select(), &victim);
+    setThreat(1400.0f);
+    EXPECT_EQ(select(), &other);
+
+    // second choice and unattackable targets are skipped
+    other.SecondChoice = true;
+    EXPECT_EQ(select(), &victim);
+    other.SecondChoice = false;
+    other.Attackable = false;
+    EXPECT_EQ(select(), &victim);
+
+    // without a current victim the highest attackable target is taken
+    other.Attackable = true;
+    setThreat(500.0f);
+    EXPECT_EQ(Acore::SelectNextVictim(heap, static_cast<Target*>(nullptr), TargetChecks()), &victim);
+
+    // only second choice targets left, the highest of them is taken
+    victim.SecondChoice = true;
+    other.SecondChoice = true;
+    EXPECT_EQ(Acore::SelectNextVictim(heap, static_cast<Target*>(nullptr), TargetChecks()), &victim);
+}
+
+// Replays randomized fights: targets join and leave, gain and lose threat in steps that make ties and cross the
+// 110%/130% limits, become second choice, unattackable or leave melee range. Now and then a victim is selected: the
+// order and the selected victim must match the list sorted right before, as ThreatContainer did before the heap.
+TEST(ThreatHeapTest, MatchesStableSortedList)
+{
+    std::mt19937 rng(1234);
+
+    for (uint32 fight = 0; fight < 50; ++fight)
+    {
+        std::vector<std::unique_ptr<Target>> targets;
+        std::vector<Target*> present;
+        TargetHeap heap;
+        SortedList list;
+        Target* currentVictim = nullptr;
+
+        for (uint32 event = 0; event < 2000; ++event)
+        {
+            uint32 action = rng() % 100;
+            if (action < 5 || present.empty())
+            {
+                targets.push_back(std::make_unique<Target>());
+                Target* target = targets.back().get();
+                target->Id = uint32(targets.size());
+                target->Threat = float(rng() % 5) * 100.0f;
+                target->InMeleeRange = rng() % 2;
+                present.push_back(target);
+                heap.push(target);
+                list.Add(target);
+            }
+            else if (action < 8 && present.size() > 1)
+            {
+                auto itr = std::next(present.begin(), rng() % present.size());
+                heap.erase(*itr);
+                list.Remove(*itr);
+                if (currentVictim == *itr)
+                    currentVictim = nullptr;
+                present.erase(itr);
+            }
+            else
+            {
+                Target* target = present[rng() % present.size()];
+                if (action < 11)
+                    target->SecondChoice = !target->SecondChoice;
+                else if (action < 13)
+                    target->Attackable = !target->Attackable;
+                else if (action < 16)
+                    target->InMeleeRange = !target->InMeleeRange;
+                else if (action < 18 && target->Threat != 0.0f)
+                    ChangeThreat(target, -target->Threat, heap); // threat wipe
+                else
+                {
+                    float threatChange = float(int32(rng() % 12) - 4) * 25.0f;
+                    if (threatChange != 0.0f)
+                        ChangeThreat(target, threatChange, heap);
+                }
+            }
+
+            // several changes may come between two selections
+            if (rng() % 4)
+                continue;
+
+            list.Sort();
+            heap.markSorted();
+            ASSERT_EQ(HeapOrder(heap), list.Get());
+
+            // ThreatContainer::selectNextVictim drops a current victim that can't be kept
+            if (currentVictim && (!currentVictim->Attackable || currentVictim->SecondChoice))
+                currentVictim = nullptr;
+
+            Target* selected = Acore::SelectNextVictim(heap, currentVictim, TargetChecks());
+            ASSERT_EQ(selected, list.SelectNextVictim(currentVictim));
+            currentVictim = selected;
+        }
+    }
+}
@@ -0,0 +1,116 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Opcodes.h"
+#include "UpdateData.h"
+#include "WorldMock.h"
+#include "WorldPacket.h"
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+#include <zlib.h>
+
+using namespace testing;
+
+namespace
+{
+    // values blocks repeat a lot, random bytes over a small alphabet compress about as well
+    ByteBuffer MakeBlock(std::mt19937& rng, uint32 size)
+    {
+        ByteBuffer block(size);
+        for (uint32 i = 0; i < size; ++i)
+            block << uint8(rng() % 16);
+
+        return block;
+    }
+
+    std::vector<uint8> Uncompress(WorldPacket const& compressed)
+    {
+        std::vector<uint8> data(compressed.read<uint32>(0));
+        uLongf size = data.size();
+        EXPECT_EQ(uncompress(data.data(), &size, compressed.contents() + sizeof(uint32), compressed.size() - sizeof(uint32)), Z_OK);
+        EXPECT_EQ(size, data.size());
+        return data;
+    }
+
+    class UpdateDataTest : public Test
+    {
+    protected:
+        void SetUp() override
+        {
+            worldMock = new NiceMock<WorldMock>();
+            SetCompression(1, false);
+            sWorld.reset(worldMock);
+        }
+
+        void SetCompression(uint32 level, bool offload)
+        {
+            ON_CALL(*worldMock, getIntConfig(CONFIG_COMPRESSION)).WillByDefault(Return(level));
+            ON_CALL(*worldMock, getBoolConfig(CONFIG_COMPRESSION_OFFLOAD)).WillByDefault(Return(offload));
+        }
+
+        WorldMock* worldMock;
+    };
+}
+
+TEST_F(UpdateDataTest, CompressedMatchesUncompressed)
+{
+    // the compression stream of the thread is reset between packets and recreated when the level changes
+    uint32 const levels[] = { 1, 4, 7, 9 };
+    std::mt19937 rng(1);
+    for (uint32 i = 0; i < 200; ++i)
+    {
+        uint32 level = levels[i / 50];
+        uint32 blocks = 1 + rng() % 8;
+        UpdateData data;
+        for (uint32 block = 0; block < blocks; ++block)
+            data.AddUpdateBlock(MakeBlock(rng, 200 + rng() % 2000));
+
+        SetCompression(level, true);
+        WorldPacket uncompressed;
+        ASSERT_TRUE(data.BuildPacket(&uncompressed));
+        ASSERT_EQ(uncompressed.GetOpcode(), SMSG_UPDATE_OBJECT);
+
+        SetCompression(level, false);
+        WorldPacket compressed;
+        ASSERT_TRUE(data.BuildPacket(&compressed));
+        ASSERT_EQ(compressed.GetOpcode(), SMSG_COMPRESSED_UPDATE_OBJECT);
+        EXPECT_LT(compressed.size(), uncompressed.size());
+
+        std::vector<uint8> original(uncompressed.contents(), uncompressed.contents() + uncompressed.size());
+        EXPECT_EQ(Uncompress(compressed), original) << "packet " << i << " level " << level;
+
+        // offloaded packets are compressed by the network thread into the same packet
+        WorldPacket offloaded;
+        ASSERT_TRUE(UpdateData::CompressPacket(uncompressed, offloaded));
+        EXPECT_EQ(Uncompress(offloaded), original) << "packet " << i << " level " << level;
+    }
+}
+
+TEST_F(UpdateDataTest, SmallPacketsStayUncompressed)
+{
+    std::mt19937 rng(2);
+    UpdateData data;
+    data.AddUpdateBlock(MakeBlock(rng, UPDATE_DATA_COMPRESSION_THRESHOLD / 2));
+
+    WorldPacket packet;
+    ASSERT_TRUE(data.BuildPacket(&packet));
+    EXPECT_EQ(packet.GetOpcode(), SMSG_UPDATE_OBJECT);
+
+    WorldPacket compressed;
+    EXPECT_FALSE(UpdateData::CompressPacket(packet, compressed));
+}
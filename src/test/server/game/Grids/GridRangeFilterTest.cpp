@@ -0,0 +1,197 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "GridRangeFilter.h"
+#include "GridRefMgr.h"
+#include "GridReference.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace
+{
+    struct PackedCell
+    {
+        std::vector<float> X, Y, Z, Sizes;
+        std::vector<uint32> PhaseMasks;
+
+        void Add(float x, float y, float z, float size, uint32 phaseMask)
+        {
+            X.push_back(x);
+            Y.push_back(y);
+            Z.push_back(z);
+            Sizes.push_back(size);
+            PhaseMasks.push_back(phaseMask);
+        }
+
+        std::vector<uint32> Filter(GridRangeQuery const& query, bool scalar = false) const
+        {
+            std::vector<uint32> candidates(X.size());
+            uint32 found = (scalar ? Acore::FilterInRangeScalar : Acore::FilterInRange)(query, X.data(), Y.data(), Z.data(),
+                Sizes.data(), PhaseMasks.data(), uint32(X.size()), candidates.data());
+            candidates.resize(found);
+            return candidates;
+        }
+    };
+
+    // provides what the packed slots copy from a WorldObject
+    struct GridTestObject
+    {
+        uint32 PhaseMask = 1;
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Z = 0.0f;
+        float Size = 0.0f;
+        GridReference<GridTestObject> Ref;
+
+        uint32 GetPhaseMask() const { return PhaseMask; }
+        bool InSamePhase(uint32 phaseMask) const { return (PhaseMask & phaseMask) != 0; }
+        float GetPositionX() const { return X; }
+        float GetPositionY() const { return Y; }
+        float GetPositionZ() const { return Z; }
+        float GetObjectSize() const { return Size; }
+    };
+}
+
+TEST(GridRangeFilterTest, RangeAndObjectSize)
+{
+    PackedCell cell;
+    cell.Add(5.0f, 0.0f, 0.0f, 0.0f, 1);    // inside
+    cell.Add(12.0f, 0.0f, 0.0f, 0.0f, 1);   // outside
+    cell.Add(12.0f, 0.0f, 0.0f, 3.0f, 1);   // inside thanks to its size
+    cell.Add(0.0f, 0.0f, 15.0f, 0.0f, 1);   // inside in 2d only
+    cell.Add(-7.0f, -7.0f, 0.0f, 0.0f, 1);  // inside
+
+    GridRangeQuery query;
+    query.Radius = 10.0f;
+
+    EXPECT_EQ(cell.Filter(query), std::vector<uint32>({ 0, 2, 4 }));
+
+    query.Z = 20.0f;
+    query.Is3D = false;
+    EXPECT_EQ(cell.Filter(query), std::vector<uint32>({ 0, 2, 3, 4 }));
+}
+
+TEST(GridRangeFilterTest, PhaseMask)
+{
+    PackedCell cell;
+    cell.Add(1.0f, 0.0f, 0.0f, 0.0f, 1);
+    cell.Add(1.0f, 0.0f, 0.0f, 0.0f, 2);
+    cell.Add(1.0f, 0.0f, 0.0f, 0.0f, 3);
+    cell.Add(1.0f, 0.0f, 0.0f, 0.0f, 0);
+
+    GridRangeQuery query;
+    query.Radius = 10.0f;
+    query.CheckPhase = true;
+    query.PhaseMask = 1;
+    EXPECT_EQ(cell.Filter(query), std::vector<uint32>({ 0, 2 }));
+
+    query.PhaseMask = 0;
+    EXPECT_EQ(cell.Filter(query), std::vector<uint32>({ 3 }));
+
+    query.CheckPhase = false;
+    EXPECT_EQ(cell.Filter(query), std::vector<uint32>({ 0, 1, 2, 3 }));
+}
+
+TEST(GridRangeFilterTest, MatchesScalar)
+{
+    // odd sizes so the vector loops always leave a remainder
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coord(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> size(0.0f, 5.0f);
+    std::uniform_int_distribution<uint32> phase(0, 7);
+
+    for (uint32 count : { 1u, 3u, 7u, 13u, 64u, 251u })
+    {
+        PackedCell cell;
+        for (uint32 i = 0; i < count; ++i)
+            cell.Add(coord(rng), coord(rng), coord(rng), size(rng), phase(rng));
+
+        GridRangeQuery query;
+        query.X = coord(rng);
+        query.Y = coord(rng);
+        query.Z = coord(rng);
+        query.Radius = 25.0f;
+        query.CheckPhase = true;
+        query.PhaseMask = 1;
+
+        EXPECT_EQ(cell.Filter(query), cell.Filter(query, true));
+
+        query.Is3D = false;
+        query.CheckPhase = false;
+        EXPECT_EQ(cell.Filter(query), cell.Filter(query, true));
+    }
+}
+
+TEST(GridRangeFilterTest, SlotsFollowPositionAndSize)
+{
+    GridRefMgr<GridTestObject> cell;
+    std::vector<std::unique_ptr<GridTestObject>> objects;
+    for (uint32 i = 0; i < 200; ++i)
+    {
+        objects.push_back(std::make_unique<GridTestObject>());
+        objects.back()->Ref.link(&cell, objects.back().get());
+    }
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> coord(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> size(0.0f, 5.0f);
+
+    GridRangeQuery query;
+    query.Radius = 20.0f;
+    query.CheckPhase = true;
+    query.PhaseMask = 1;
+
+    for (uint32 round = 0; round < 20; ++round)
+    {
+        for (uint32 i = 0; i < 100; ++i)
+        {
+            GridTestObject& object = *objects[rng() % objects.size()];
+            object.X = coord(rng);
+            object.Y = coord(rng);
+            object.Z = coord(rng);
+            object.Size = size(rng);
+            object.PhaseMask = 1 << (rng() % 2);
+            object.Ref.UpdateSlot();
+        }
+
+        // the candidates are the objects of the phase within the radius + their size, an object on the edge may be kept or not
+        std::set<GridTestObject*> visited;
+        cell.VisitSlotsInRange(query, [&visited](GridTestObject* object) { EXPECT_TRUE(visited.insert(object).second); });
+
+        for (std::unique_ptr<GridTestObject> const& object : objects)
+        {
+            float dist = std::sqrt(object->X * object->X + object->Y * object->Y + object->Z * object->Z) - object->Size;
+            if (dist > query.Radius + 0.2f || !object->InSamePhase(query.PhaseMask))
+                EXPECT_EQ(visited.count(object.get()), 0u);
+            else if (dist < query.Radius - 0.2f)
+                EXPECT_EQ(visited.count(object.get()), 1u);
+        }
+
+        uint32 inPhase = 0;
+        for (GridRefMgr<GridTestObject>::slot_iterator itr = cell.slot_begin(); itr != cell.slot_end(); ++itr)
+            inPhase += itr.InSamePhase(query.PhaseMask);
+
+        EXPECT_EQ(inPhase, uint32(std::count_if(objects.begin(), objects.end(), [&query](std::unique_ptr<GridTestObject> const& object)
+        {
+            return object->InSamePhase(query.PhaseMask);
+        })));
+    }
+}
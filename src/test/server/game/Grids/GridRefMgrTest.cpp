@@ -0,0 +1,115 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridRefMgr.h"
+#include "GridReference.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace
+{
+    // provides what the packed slots copy from a WorldObject, padded to about the size of one
+    struct GridTestObject
+    {
+        uint32 PhaseMask = 1;
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Z = 0.0f;
+        float Size = 0.0f;
+        GridReference<GridTestObject> Ref;
+        uint8 Padding[512];
+
+        uint32 GetPhaseMask() const { return PhaseMask; }
+        bool InSamePhase(uint32 phaseMask) const { return (PhaseMask & phaseMask) != 0; }
+        float GetPositionX() const { return X; }
+        float GetPositionY() const { return Y; }
+        float GetPositionZ() const { return Z; }
+        float GetObjectSize() const { return Size; }
+    };
+
+    typedef GridRefMgr<GridTestObject> TestCell;
+
+    void CheckSlots(TestCell& cell)
+    {
+        std::set<GridTestObject*> listed;
+        for (GridReference<GridTestObject>* ref = cell.getFirst(); ref; ref = ref->next())
+            listed.insert(ref->GetSource());
+
+        TestCell::SlotContainer const& slots = cell.GetSlots();
+        ASSERT_EQ(slots.size(), listed.size());
+        ASSERT_EQ(std::set<GridTestObject*>(slots.Objects.begin(), slots.Objects.end()), listed);
+
+        for (std::size_t i = 0; i < slots.size(); ++i)
+        {
+            GridTestObject const* object = slots.Objects[i];
+            EXPECT_EQ(slots.PhaseMasks[i], object->PhaseMask);
+        }
+    }
+}
+
+TEST(GridRefMgrTest, SlotsFollowTheList)
+{
+    std::vector<TestCell> cells(4);
+    std::vector<std::unique_ptr<GridTestObject>> objects;
+    for (uint32 i = 0; i < 300; ++i)
+        objects.push_back(std::make_unique<GridTestObject>());
+
+    std::mt19937 rng(1);
+    for (uint32 round = 0; round < 50; ++round)
+    {
+        for (uint32 i = 0; i < 200; ++i)
+        {
+            GridTestObject* object = objects[rng() % objects.size()].get();
+            switch (rng() % 3)
+            {
+                case 0:
+                    // enters a cell, leaving the previous one if any
+                    object->Ref.link(&cells[rng() % cells.size()], object);
+                    break;
+                case 1:
+                    if (object->Ref.isValid())
+                        object->Ref.unlink();
+                    break;
+                default:
+                    object->PhaseMask = 1 << (rng() % 4);
+                    object->Ref.UpdateSlot();
+                    break;
+            }
+        }
+
+        for (TestCell& cell : cells)
+            CheckSlots(cell);
+    }
+
+    // the slot iterator sees every object of the phase exactly once
+    for (TestCell& cell : cells)
+    {
+        uint32 listed = 0;
+        for (GridReference<GridTestObject>* ref = cell.getFirst(); ref; ref = ref->next())
+            listed += ref->GetSource()->InSamePhase(3);
+
+        uint32 slotted = 0;
+        for (TestCell::slot_iterator itr = cell.slot_begin(); itr != cell.slot_end(); ++itr)
+            slotted += itr.InSamePhase(3);
+
+        EXPECT_EQ(slotted, listed);
+    }
+}
@@ -0,0 +1,292 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CellImpl.h"
+#include "Creature.h"
+#include "DBCStores.h"
+#include "DBCfmt.h"
+#include "GridNotifiers.h"
+#include "GridNotifiersImpl.h"
+#include "Map.h"
+#include "Player.h"
+#include "WorldMock.h"
+#include "WorldSession.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // finds the creature slots of a cell
+    struct SlotFinder
+    {
+        CreatureMapType::SlotContainer const* Slots = nullptr;
+        void Visit(CreatureMapType& m) { Slots = &m.GetSlots(); }
+        template<class T> void Visit(GridRefMgr<T>&) { }
+    };
+
+    // a continent without map files
+    class VisibilityTestMap : public Map
+    {
+    public:
+        VisibilityTestMap() : Map(0, 0, REGULAR_DIFFICULTY) { }
+
+        ~VisibilityTestMap() override
+        {
+            UnloadAll();
+        }
+
+        void AddToCell(Creature* creature)
+        {
+            Cell cell(creature->GetPositionX(), creature->GetPositionY());
+            getNGrid(cell.GridX(), cell.GridY())->GetGridType(cell.CellX(), cell.CellY()).AddGridObject(creature);
+        }
+
+        CreatureMapType::SlotContainer const* GetCreatureSlots(float x, float y)
+        {
+            SlotFinder finder;
+            TypeContainerVisitor<SlotFinder, GridTypeMapContainer> visitor(finder);
+            Cell cell(x, y);
+            getNGrid(cell.GridX(), cell.GridY())->GetGridType(cell.CellX(), cell.CellY()).Visit(visitor);
+            return finder.Slots;
+        }
+    };
+
+    // found by ObjectAccessor like a creature added to the map, sends nothing to the client
+    class VisibilityTestCreature : public Creature
+    {
+    public:
+        VisibilityTestCreature(VisibilityTestMap& map, ObjectGuid::LowType guid, float x, float y) : Creature(false)
+        {
+            _InitValues();
+            Object::_Create(guid, 1, HighGuid::Unit);
+            Relocate(x, y, 0.0f);
+            SetMap(&map);
+            map.AddToCell(this);
+            map.AddToObjectsStore<Creature>(GetGUID(), this);
+            Object::AddToWorld();
+        }
+
+        ~VisibilityTestCreature() override
+        {
+            Object::RemoveFromWorld();
+            GetMap()->RemoveFromObjectsStore<Creature>(GetGUID());
+            RemoveFromGrid();
+            ResetMap();
+        }
+
+        void BuildCreateUpdateBlockForPlayer(UpdateData* /*data*/, Player* /*target*/) const override { }
+    };
+
+    // not added to a grid, so the two test players never see each other
+    class VisibilityTestPlayer : public Player
+    {
+    public:
+        VisibilityTestPlayer(WorldSession* session, VisibilityTestMap& map, ObjectGuid::LowType guid, float x, float y) : Player(session)
+        {
+            _InitValues();
+            Object::_Create(guid, 0, HighGuid::Player);
+            Relocate(x, y, 0.0f);
+            SetMap(&map);
+            Object::AddToWorld();
+        }
+
+        ~VisibilityTestPlayer() override
+        {
+            Object::RemoveFromWorld();
+            ResetMap();
+        }
+    };
+
+    // the two passes of Unit::ExecuteDelayedUnitRelocationEvent for a player without far sight
+    template<class Notifier>
+    void RelocationPasses(Player& player)
+    {
+        Notifier relocateNoLarge(player, false);
+        Cell::VisitAllObjects(&player, relocateNoLarge, player.GetSightRange() + VISIBILITY_INC_FOR_GOBJECTS);
+        relocateNoLarge.SendToSelf();
+
+        Notifier relocateLarge(player, true);
+        Cell::VisitAllObjects(&player, relocateLarge, MAX_VISIBILITY_DISTANCE);
+        relocateLarge.SendToSelf();
+    }
+
+    class RelocationNotifierTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            worldMock = new ::testing::NiceMock<WorldMock>();
+            ON_CALL(*worldMock, GetDataPath()).WillByDefault(::testing::ReturnRef(dataPath));
+            sWorld.reset(worldMock);
+
+            LoadContinentEntry();
+            map = std::make_unique<VisibilityTestMap>();
+        }
+
+        void TearDown() override
+        {
+            players.clear();
+            sessions.clear();
+            creatures.clear();
+            map.reset();
+        }
+
+        // a Map.dbc holding only map 0, every field of the record is 0: a continent without a name
+        static void LoadContinentEntry()
+        {
+            if (sMapStore.LookupEntry(0))
+                return;
+
+            uint32 const fieldCount = sizeof(MapEntryfmt) - 1;
+            uint32 const header[5] = { 0x43424457, 1, fieldCount, fieldCount * 4, 1 };
+            std::vector<char> const data(fieldCount * 4 + 1, 0);
+
+            std::string const path = ::testing::TempDir() + "Map.dbc";
+            std::ofstream file(path, std::ios::binary);
+            file.write(reinterpret_cast<char const*>(header), sizeof(header));
+            file.write(data.data(), data.size());
+            file.close();
+
+            ASSERT_TRUE(sMapStore.Load(path.c_str()));
+        }
+
+        // a creature every 15 yards over the 2 x 2 grids around the center of the map
+        void Populate()
+        {
+            for (float x = -SIZE_OF_GRIDS; x < SIZE_OF_GRIDS; x += 15.0f)
+                for (float y = -SIZE_OF_GRIDS; y < SIZE_OF_GRIDS; y += 15.0f)
+                    map->LoadGrid(x, y);
+
+            for (float x = -SIZE_OF_GRIDS + 5.0f; x < SIZE_OF_GRIDS; x += 15.0f)
+                for (float y = -SIZE_OF_GRIDS + 5.0f; y < SIZE_OF_GRIDS; y += 15.0f)
+                    creatures.push_back(std::make_unique<VisibilityTestCreature>(*map, creatures.size() + 1, x, y));
+        }
+
+        Player& AddPlayer(float x, float y)
+        {
+            sessions.push_back(std::make_unique<WorldSession>(sessions.size() + 1, "", nullptr, SEC_PLAYER, 2, 0, LOCALE_enUS, 0, false, false, 0));
+            players.push_back(std::make_unique<VisibilityTestPlayer>(sessions.back().get(), *map, players.size() + 1, x, y));
+            return *players.back();
+        }
+
+        std::string dataPath = "/nonexistent/";
+        ::testing::NiceMock<WorldMock>* worldMock = nullptr;
+        std::unique_ptr<VisibilityTestMap> map;
+        std::vector<std::unique_ptr<VisibilityTestCreature>> creatures;
+        std::vector<std::unique_ptr<WorldSession>> sessions;
+        std::vector<std::unique_ptr<VisibilityTestPlayer>> players;
+    };
+}
+
+TEST_F(RelocationNotifierTest, IncrementalPassMatchesFullPass)
+{
+    Populate();
+
+    // both walk the same way and see the same creatures move, only their relocation passes differ
+    Player& incremental = AddPlayer(0.0f, 0.0f);
+    Player& full = AddPlayer(0.0f, 0.0f);
+    ASSERT_TRUE(Acore::IncrementalRelocationNotifier::CanHandle(incremental));
+
+    RelocationPasses<Acore::PlayerRelocationNotifier>(incremental);
+    RelocationPasses<Acore::PlayerRelocationNotifier>(full);
+    ASSERT_FALSE(full.m_clientGUIDs.empty());
+    ASSERT_EQ(incremental.m_clientGUIDs, full.m_clientGUIDs);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> step(-5.0f, 5.0f);
+    std::vector<Position> spawns;
+    for (std::unique_ptr<VisibilityTestCreature> const& creature : creatures)
+        spawns.push_back(creature->GetPosition());
+
+    for (uint32 move = 0; move < 300; ++move)
+    {
+        // a creature wanders around its spawn point without leaving its cell and notifies the players itself, like CreatureRelocationNotifier
+        uint32 index = rng() % creatures.size();
+        VisibilityTestCreature& creature = *creatures[index];
+        Cell cell(creature.GetPositionX(), creature.GetPositionY());
+        creature.Relocate(spawns[index].GetPositionX() + step(rng), spawns[index].GetPositionY() + step(rng), 0.0f);
+        if (!(Cell(creature.GetPositionX(), creature.GetPositionY()).GetCellCoord() == cell.GetCellCoord()))
+            creature.Relocate(spawns[index]);
+
+        incremental.UpdateVisibilityOf(&creature);
+        full.UpdateVisibilityOf(&creature);
+
+        // the players take a step, stay in the populated grids
+        float x = std::max(-SIZE_OF_GRIDS + 100.0f, std::min(SIZE_OF_GRIDS - 100.0f, incremental.GetPositionX() + step(rng)));
+        float y = std::max(-SIZE_OF_GRIDS + 100.0f, std::min(SIZE_OF_GRIDS - 100.0f, incremental.GetPositionY() + step(rng)));
+        incremental.Relocate(x, y, 0.0f);
+        full.Relocate(x, y, 0.0f);
+
+        RelocationPasses<Acore::IncrementalRelocationNotifier>(incremental);
+        RelocationPasses<Acore::PlayerRelocationNotifier>(full);
+        ASSERT_EQ(incremental.m_clientGUIDs, full.m_clientGUIDs) << "after move " << move;
+    }
+}
+
+TEST_F(RelocationNotifierTest, SlotsFollowEveryPositionWrite)
+{
+    map->LoadGrid(10.0f, 10.0f);
+    creatures.push_back(std::make_unique<VisibilityTestCreature>(*map, 1, 10.0f, 10.0f));
+    VisibilityTestCreature& creature = *creatures.back();
+
+    // every write below stays in the creature's cell
+    auto expectSlot = [&](char const* write)
+    {
+        CreatureMapType::SlotContainer const* slots = map->GetCreatureSlots(creature.GetPositionX(), creature.GetPositionY());
+        ASSERT_NE(slots, nullptr);
+
+        auto itr = std::find(slots->Objects.begin(), slots->Objects.end(), &creature);
+        ASSERT_NE(itr, slots->Objects.end()) << write;
+        std::size_t slot = itr - slots->Objects.begin();
+        EXPECT_EQ(slots->PositionX[slot], creature.GetPositionX()) << write;
+        EXPECT_EQ(slots->PositionY[slot], creature.GetPositionY()) << write;
+        EXPECT_EQ(slots->PositionZ[slot], creature.GetPositionZ()) << write;
+        EXPECT_EQ(slots->Sizes[slot], creature.GetObjectSize()) << write;
+        EXPECT_EQ(slots->PhaseMasks[slot], creature.GetPhaseMask()) << write;
+    };
+
+    expectSlot("spawn");
+
+    creature.Relocate(12.0f, 11.0f, 1.0f);
+    expectSlot("Relocate");
+
+    Position& position = creature;
+    position.Relocate(14.0f, 13.0f, 2.0f);
+    expectSlot("Relocate through Position&");
+
+    position = Position(16.0f, 15.0f, 3.0f);
+    expectSlot("assignment through Position&");
+
+    creature.RelocatePolarOffset(0.5f, 2.0f, 1.0f);
+    expectSlot("RelocatePolarOffset");
+
+    creature.RelocateOffset(Position(1.0f, 1.0f, 1.0f));
+    expectSlot("RelocateOffset");
+
+    creature.SetFloatValue(OBJECT_FIELD_SCALE_X, 2.0f);
+    expectSlot("scale");
+
+    creature.SetFloatValue(UNIT_FIELD_COMBATREACH, 3.0f);
+    expectSlot("combat reach");
+
+    creature.SetPhaseMask(2, false);
+    expectSlot("SetPhaseMask");
+}
@@ -0,0 +1,208 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Map.h"
+#include "MappedFile.h"
+#include "WorldMock.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+    uint32 Magic(char const* fourcc)
+    {
+        uint32 value;
+        memcpy(&value, fourcc, sizeof(value));
+        return value;
+    }
+
+    template<class T>
+    void Append(std::vector<uint8>& data, T const* values, std::size_t count)
+    {
+        uint8 const* bytes = reinterpret_cast<uint8 const*>(values);
+        data.insert(data.end(), bytes, bytes + count * sizeof(T));
+    }
+
+    // .map file of a single grid with random heights stored as T and a few holes
+    template<class T>
+    std::string WriteGridFile(uint32 heightFlags, uint32 seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> height(-200.0f, 800.0f);
+
+        std::vector<T> v9(129 * 129);
+        std::vector<T> v8(128 * 128);
+        auto randomHeight = [&]() -> T
+        {
+            if constexpr (std::is_same_v<T, float>)
+                return height(rng);
+            else
+                return T(rng());
+        };
+
+        for (T& value : v9)
+            value = randomHeight();
+        for (T& value : v8)
+            value = randomHeight();
+
+        std::vector<uint16> holes(16 * 16, 0);
+        for (uint32 i = 0; i < 20; ++i)
+            holes[rng() % holes.size()] = uint16(rng());
+
+        map_fileheader header = { };
+        header.mapMagic = Magic("MAPS");
+        header.versionMagic = 8;
+        header.heightMapOffset = sizeof(map_fileheader);
+        header.heightMapSize = uint32(sizeof(map_heightHeader) + (v9.size() + v8.size()) * sizeof(T));
+        header.holesOffset = header.heightMapOffset + header.heightMapSize;
+        header.holesSize = uint32(holes.size() * sizeof(uint16));
+
+        map_heightHeader heightHeader;
+        heightHeader.fourcc = Magic("MHGT");
+        heightHeader.flags = heightFlags;
+        heightHeader.gridHeight = -150.0f;
+        heightHeader.gridMaxHeight = 650.0f;
+
+        std::vector<uint8> data;
+        Append(data, &header, 1);
+        Append(data, &heightHeader, 1);
+        Append(data, v9.data(), v9.size());
+        Append(data, v8.data(), v8.size());
+        Append(data, holes.data(), holes.size());
+
+        std::string path = (std::filesystem::temp_directory_path() / ("GridMapHeightsTest" + std::to_string(seed) + ".map")).string();
+        FILE* file = fopen(path.c_str(), "wb");
+        fwrite(data.data(), 1, data.size(), file);
+        fclose(file);
+        return path;
+    }
+
+    // every point of the batch must get the height the per point lookup returns
+    void CheckHeights(uint32 heightFlags, std::string const& path)
+    {
+        GridMap grid;
+        ASSERT_TRUE(grid.loadData(const_cast<char*>(path.c_str())));
+
+        // points of grid 32, 32, including cell borders and the far edge
+        std::mt19937 rng(heightFlags);
+        std::uniform_real_distribution<float> coord(-SIZE_OF_GRIDS + 0.01f, 0.0f);
+
+        std::vector<G3D::Vector3> points;
+        for (uint32 i = 0; i < 4099; ++i)
+            points.emplace_back(coord(rng), coord(rng), 0.0f);
+
+        float const cell = SIZE_OF_GRIDS / MAP_RESOLUTION;
+        for (uint32 i = 0; i < 64; ++i)
+            points.emplace_back(-cell * i, -cell * (i / 2), 0.0f);
+
+        std::vector<float> heights(points.size());
+        grid.getHeights(points.data(), heights.data(), uint32(points.size()));
+
+        uint32 holes = 0;
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            float expected = grid.getHeight(points[i].x, points[i].y);
+            if (expected == INVALID_HEIGHT)
+                ++holes;
+
+            EXPECT_FLOAT_EQ(heights[i], expected) << "point " << i << " (" << points[i].x << ", " << points[i].y << ")";
+        }
+
+        EXPECT_GT(holes, 0u);
+
+        grid.unloadData();
+        std::filesystem::remove(path);
+    }
+
+    class GridMapHeightsTest : public Test
+    {
+    protected:
+        void SetUp() override
+        {
+            worldMock = new NiceMock<WorldMock>();
+            SetMemoryMapped(false);
+            sWorld.reset(worldMock);
+        }
+
+        void SetMemoryMapped(bool enabled)
+        {
+            ON_CALL(*worldMock, getBoolConfig(CONFIG_MEMORY_MAPPED_MAP_FILES)).WillByDefault(Return(enabled));
+        }
+
+        WorldMock* worldMock;
+    };
+}
+
+TEST_F(GridMapHeightsTest, FloatHeights)
+{
+    CheckHeights(0, WriteGridFile<float>(0, 1));
+}
+
+TEST_F(GridMapHeightsTest, Uint16Heights)
+{
+    CheckHeights(MAP_HEIGHT_AS_INT16, WriteGridFile<uint16>(MAP_HEIGHT_AS_INT16, 2));
+}
+
+TEST_F(GridMapHeightsTest, Uint8Heights)
+{
+    CheckHeights(MAP_HEIGHT_AS_INT8, WriteGridFile<uint8>(MAP_HEIGHT_AS_INT8, 3));
+}
+
+TEST_F(GridMapHeightsTest, MappedMatchesRead)
+{
+    std::string path = WriteGridFile<float>(0, 5);
+
+    GridMap readGrid;
+    ASSERT_TRUE(readGrid.loadData(const_cast<char*>(path.c_str())));
+
+    SetMemoryMapped(true);
+    uint32 mappedFiles = MappedFile::GetMappedFileCount();
+    uint64 mappedSize = MappedFile::GetMappedSize();
+
+    // grids of the same file share its mapping
+    GridMap mappedGrid;
+    GridMap secondGrid;
+    ASSERT_TRUE(mappedGrid.loadData(const_cast<char*>(path.c_str())));
+    ASSERT_TRUE(secondGrid.loadData(const_cast<char*>(path.c_str())));
+    EXPECT_EQ(MappedFile::GetMappedFileCount(), mappedFiles + 1);
+    EXPECT_EQ(MappedFile::GetMappedSize(), mappedSize + std::filesystem::file_size(path));
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> coord(-SIZE_OF_GRIDS + 0.01f, 0.0f);
+    for (uint32 i = 0; i < 4096; ++i)
+    {
+        float x = coord(rng);
+        float y = coord(rng);
+        EXPECT_EQ(mappedGrid.getHeight(x, y), readGrid.getHeight(x, y)) << "point (" << x << ", " << y << ")";
+    }
+
+    mappedGrid.unloadData();
+    EXPECT_EQ(MappedFile::GetMappedFileCount(), mappedFiles + 1);
+
+    secondGrid.unloadData();
+    EXPECT_EQ(MappedFile::GetMappedFileCount(), mappedFiles);
+    EXPECT_EQ(MappedFile::GetMappedSize(), mappedSize);
+
+    readGrid.unloadData();
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,457 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Creature.h"
+#include "DBCStores.h"
+#include "DBCfmt.h"
+#include "GridDefines.h"
+#include "GridNotifiers.h"
+#include "Map.h"
+#include "MapRegionUpdater.h"
+#include "SynchConnectionQueue.h"
+#include "WorldMock.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TEST(MapRegionUpdaterTest, RunsEveryTaskOnce)
+{
+    MapRegionUpdater updater;
+    updater.Activate(3);
+
+    std::vector<std::atomic<uint32>> counters(500);
+    for (std::atomic<uint32>& counter : counters)
+        counter = 0;
+
+    std::vector<MapRegionUpdater::Task> tasks;
+    for (std::atomic<uint32>& counter : counters)
+        tasks.emplace_back([&counter]() { ++counter; });
+
+    for (uint32 pass = 0; pass < 100; ++pass)
+        updater.Execute(tasks);
+
+    for (std::atomic<uint32> const& counter : counters)
+        EXPECT_EQ(counter, 100u);
+
+    updater.Deactivate();
+}
+
+TEST(MapRegionUpdaterTest, TasksQueryAsMapThread)
+{
+    // the map threads' synchronous queries are accounted to the map, the helpers running their regions too
+    MapRegionUpdater updater;
+    updater.Activate(3);
+
+    SynchConnectionQueue::SetCaller(SYNCH_CALLER_MAP);
+
+    std::atomic<uint32> otherCallers(0);
+    std::vector<MapRegionUpdater::Task> tasks(16, [&otherCallers]()
+    {
+        if (SynchConnectionQueue::GetCaller() != SYNCH_CALLER_MAP)
+            ++otherCallers;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+
+    for (uint32 pass = 0; pass < 10; ++pass)
+        updater.Execute(tasks);
+
+    EXPECT_EQ(otherCallers, 0u);
+
+    SynchConnectionQueue::SetCaller(SYNCH_CALLER_OTHER);
+    updater.Deactivate();
+}
+
+TEST(MapRegionUpdaterTest, ConcurrentCallers)
+{
+    // several continents share the pool, every caller must only return once its own batch is done
+    MapRegionUpdater updater;
+    updater.Activate(2);
+
+    std::vector<std::thread> callers;
+    std::vector<uint32> results(4, 0);
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        callers.emplace_back([&updater, &results, i]()
+        {
+            for (uint32 pass = 0; pass < 200; ++pass)
+            {
+                std::atomic<uint32> done(0);
+                std::vector<MapRegionUpdater::Task> tasks(8, [&done]() { ++done; });
+                updater.Execute(tasks);
+                results[i] += done;
+            }
+        });
+    }
+
+    for (std::thread& caller : callers)
+        caller.join();
+
+    for (uint32 result : results)
+        EXPECT_EQ(result, 200u * 8u);
+
+    updater.Deactivate();
+}
+
+TEST(MapRegionUpdaterTest, InactiveRunsOnCaller)
+{
+    MapRegionUpdater updater;
+    EXPECT_FALSE(updater.IsActive());
+
+    uint32 done = 0;
+    std::vector<MapRegionUpdater::Task> tasks(10, [&done]() { ++done; });
+    updater.Execute(tasks);
+
+    EXPECT_EQ(done, 10u);
+}
+
+TEST(MapRegionUpdaterTest, ColorsNeverTouch)
+{
+    for (uint32 regionGridSize : { 1u, 3u, 4u, 64u })
+    {
+        uint32 regionsPerSide = (MAX_NUMBER_OF_GRIDS + regionGridSize - 1) / regionGridSize;
+        std::vector<uint32> colors(MapRegionUpdater::GetRegionCount(regionGridSize), MapRegionUpdater::REGION_COLORS);
+
+        std::vector<uint32> regionIds;
+        for (uint32 color = 0; color < MapRegionUpdater::REGION_COLORS; ++color)
+        {
+            MapRegionUpdater::GetRegionsOfColor(color, regionGridSize, regionIds);
+            for (uint32 regionId : regionIds)
+            {
+                ASSERT_LT(regionId, colors.size());
+                EXPECT_EQ(colors[regionId], MapRegionUpdater::REGION_COLORS) << "region " << regionId << " has two colors";
+                colors[regionId] = color;
+            }
+        }
+
+        for (uint32 regionX = 0; regionX < regionsPerSide; ++regionX)
+        {
+            for (uint32 regionY = 0; regionY < regionsPerSide; ++regionY)
+            {
+                uint32 regionId = regionX * regionsPerSide + regionY;
+                ASSERT_LT(colors[regionId], MapRegionUpdater::REGION_COLORS) << "region " << regionId << " has no color";
+                EXPECT_EQ(MapRegionUpdater::GetRegionId(regionX * regionGridSize, regionY * regionGridSize, regionGridSize), regionId);
+
+                // right, top, and both diagonals cover every pair of neighbours once
+                if (regionX + 1 < regionsPerSide)
+                {
+                    EXPECT_NE(colors[regionId], colors[regionId + regionsPerSide]);
+                }
+
+                if (regionY + 1 < regionsPerSide)
+                {
+                    EXPECT_NE(colors[regionId], colors[regionId + 1]);
+                }
+
+                if (regionX + 1 < regionsPerSide && regionY + 1 < regionsPerSide)
+                {
+                    EXPECT_NE(colors[regionId], colors[regionId + regionsPerSide + 1]);
+                }
+
+                if (regionX + 1 < regionsPerSide && regionY > 0)
+                {
+                    EXPECT_NE(colors[regionId], colors[regionId + regionsPerSide - 1]);
+                }
+            }
+        }
+    }
+}
+
+
+namespace
+{
+    // a continent without map files, its regions are updated through Map::UpdateRegions
+    class RegionTestMap : public Map
+    {
+    public:
+        RegionTestMap() : Map(0, 0, REGULAR_DIFFICULTY) { }
+
+        ~RegionTestMap() override
+        {
+            UnloadAll();
+        }
+
+        // the active cells of one Map::Update: loads their grids and updates them region by region
+        void UpdateCells(std::vector<Cell> const& cells, uint32 regionGridSize)
+        {
+            InitRegionCells(regionGridSize);
+            for (Cell const& cell : cells)
+                CollectRegionCell(cell, true, false);
+
+            UpdateRegions(0);
+        }
+
+        void AddToCell(Creature* creature)
+        {
+            Cell cell(creature->GetPositionX(), creature->GetPositionY());
+            getNGrid(cell.GridX(), cell.GridY())->GetGridType(cell.CellX(), cell.CellY()).AddGridObject(creature);
+        }
+    };
+
+    // only updated by the region it stands in, runs the test's code instead of the creature's
+    class RegionTestCreature : public Creature
+    {
+    public:
+        RegionTestCreature(RegionTestMap& map, ObjectGuid::LowType guid, float x, float y) : Creature(false), Updates(0)
+        {
+            _InitValues();
+            Object::_Create(guid, 1, HighGuid::Unit);
+            Relocate(x, y, 0.0f);
+            SetMap(&map);
+            map.AddToCell(this);
+            Object::AddToWorld();
+        }
+
+        ~RegionTestCreature() override
+        {
+            Object::RemoveFromWorld();
+            RemoveFromGrid();
+            ResetMap();
+        }
+
+        void Update(uint32 /*diff*/) override
+        {
+            ++Updates;
+            if (OnUpdate)
+                OnUpdate(*this);
+        }
+
+        [[nodiscard]] Cell GetCell() const { return Cell(GetPositionX(), GetPositionY()); }
+
+        std::function<void(RegionTestCreature&)> OnUpdate;
+        uint32 Updates;
+    };
+
+    class MapRegionsTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            worldMock = new ::testing::NiceMock<WorldMock>();
+            ON_CALL(*worldMock, GetDataPath()).WillByDefault(::testing::ReturnRef(dataPath));
+            sWorld.reset(worldMock);
+
+            LoadContinentEntry();
+
+            sMapRegionUpdater->Activate(4);
+            map = std::make_unique<RegionTestMap>();
+        }
+
+        void TearDown() override
+        {
+            creatures.clear();
+            map.reset();
+            sMapRegionUpdater->Deactivate();
+        }
+
+        // a Map.dbc holding only map 0, every field of the record is 0: a continent without a name
+        static void LoadContinentEntry()
+        {
+            if (sMapStore.LookupEntry(0))
+                return;
+
+            uint32 const fieldCount = sizeof(MapEntryfmt) - 1;
+            uint32 const header[5] = { 0x43424457, 1, fieldCount, fieldCount * 4, 1 };
+            std::vector<char> const data(fieldCount * 4 + 1, 0);
+
+            std::string const path = ::testing::TempDir() + "Map.dbc";
+            std::ofstream file(path, std::ios::binary);
+            file.write(reinterpret_cast<char const*>(header), sizeof(header));
+            file.write(data.data(), data.size());
+            file.close();
+
+            ASSERT_TRUE(sMapStore.Load(path.c_str()));
+        }
+
+        // a creature every 40 yards over the 4 x 4 grids around the center of the map
+        void Populate()
+        {
+            for (float x = -2 * SIZE_OF_GRIDS + 20.0f; x < 2 * SIZE_OF_GRIDS; x += 40.0f)
+            {
+                for (float y = -2 * SIZE_OF_GRIDS + 20.0f; y < 2 * SIZE_OF_GRIDS; y += 40.0f)
+                {
+                    Cell cell(x, y);
+                    if (std::find_if(cells.begin(), cells.end(), [&cell](Cell const& other) { return other.GetCellCoord() == cell.GetCellCoord(); }) == cells.end())
+                    {
+                        cells.push_back(cell);
+
+                        // loads the grid of the cell
+                        map->UpdateCells({ cell }, 1);
+                    }
+
+                    creatures.push_back(std::make_unique<RegionTestCreature>(*map, creatures.size() + 1, x, y));
+                }
+            }
+        }
+
+        std::string dataPath = "/nonexistent/";
+        ::testing::NiceMock<WorldMock>* worldMock = nullptr;
+        std::unique_ptr<RegionTestMap> map;
+        std::vector<std::unique_ptr<RegionTestCreature>> creatures;
+        std::vector<Cell> cells;
+    };
+}
+
+TEST_F(MapRegionsTest, NeighbourRegionsNeverRunTogether)
+{
+    Populate();
+
+    uint32 const regionsPerSide = MAX_NUMBER_OF_GRIDS;
+    std::vector<std::atomic<uint32>> busy(MapRegionUpdater::GetRegionCount(1));
+    for (std::atomic<uint32>& regionBusy : busy)
+        regionBusy = 0;
+
+    std::atomic<uint32> touching(0);
+    for (std::unique_ptr<RegionTestCreature>& creature : creatures)
+    {
+        creature->OnUpdate = [&](RegionTestCreature& self)
+        {
+            Cell cell = self.GetCell();
+            uint32 regionId = MapRegionUpdater::GetRegionId(cell.GridX(), cell.GridY(), 1);
+            ++busy[regionId];
+
+            for (uint32 x = cell.GridX() - 1; x <= cell.GridX() + 1; ++x)
+                for (uint32 y = cell.GridY() - 1; y <= cell.GridY() + 1; ++y)
+                    if ((x != cell.GridX() || y != cell.GridY()) && busy[x * regionsPerSide + y])
+                        ++touching;
+
+            std::this_thread::yield();
+            --busy[regionId];
+        };
+    }
+
+    for (uint32 tick = 1; tick <= 50; ++tick)
+    {
+        map->UpdateCells(cells, 1);
+
+        for (std::unique_ptr<RegionTestCreature> const& creature : creatures)
+            ASSERT_EQ(creature->Updates, tick) << "creature " << creature->GetGUID().ToString();
+    }
+
+    EXPECT_EQ(touching, 0u);
+    EXPECT_FALSE(map->IsUpdatingRegions());
+}
+
+TEST_F(MapRegionsTest, GuardsSharedContainers)
+{
+    Populate();
+
+    std::mutex generatedLock;
+    std::vector<ObjectGuid::LowType> generated;
+    for (std::unique_ptr<RegionTestCreature>& creature : creatures)
+    {
+        creature->OnUpdate = [&](RegionTestCreature& self)
+        {
+            ASSERT_TRUE(self.GetMap()->IsUpdatingRegions());
+
+            std::vector<ObjectGuid::LowType> guids;
+            for (uint32 i = 0; i < 20; ++i)
+                guids.push_back(self.GetMap()->GenerateLowGuid<HighGuid::DynamicObject>());
+
+            // guarded helpers called with the guards already held
+            {
+                auto guard = self.GetMap()->GetRegionGuard();
+                EXPECT_EQ(self.GetMap()->GetCreatureRespawnTime(self.GetGUID().GetCounter()), 0);
+
+                auto writeGuard = self.GetMap()->GetRegionWriteGuard();
+                auto readGuard = self.GetMap()->GetRegionReadGuard();
+                EXPECT_EQ(self.GetMap()->GetCreature(self.GetGUID()), nullptr);
+            }
+
+            {
+                auto readGuard = self.GetMap()->GetRegionReadGuard();
+                EXPECT_EQ(self.GetMap()->GetGameObject(self.GetGUID()), nullptr);
+            }
+
+            std::lock_guard<std::mutex> guard(generatedLock);
+            generated.insert(generated.end(), guids.begin(), guids.end());
+        };
+    }
+
+    for (uint32 tick = 0; tick < 5; ++tick)
+        map->UpdateCells(cells, 2);
+
+    std::sort(generated.begin(), generated.end());
+    EXPECT_EQ(generated.size(), creatures.size() * 20 * 5);
+    EXPECT_EQ(std::adjacent_find(generated.begin(), generated.end()), generated.end()) << "a guid was generated twice";
+}
+
+TEST_F(MapRegionsTest, GridLoadsWaitForTheRegions)
+{
+    Populate();
+
+    // a cell of grid 40, 40, far from every creature
+    float const farX = -8 * SIZE_OF_GRIDS - 20.0f;
+    float const farY = -8 * SIZE_OF_GRIDS - 20.0f;
+    Cell farCell(farX, farY);
+    ASSERT_FALSE(map->IsGridLoaded(farX, farY));
+
+    uint32 visits = 0;
+    creatures.front()->OnUpdate = [&](RegionTestCreature& self)
+    {
+        Acore::ObjectUpdater updater(0, false);
+        TypeContainerVisitor<Acore::ObjectUpdater, GridTypeMapContainer> visitor(updater);
+        self.GetMap()->Visit(farCell, visitor);
+        ++visits;
+
+        EXPECT_FALSE(self.GetMap()->IsGridLoaded(farX, farY));
+    };
+
+    map->UpdateCells(cells, 1);
+
+    EXPECT_EQ(visits, 1u);
+    EXPECT_TRUE(map->IsGridLoaded(farX, farY));
+}
+
+TEST_F(MapRegionsTest, TasksRunOnMapThread)
+{
+    Populate();
+
+    std::thread::id const mapThread = std::this_thread::get_id();
+    std::vector<uint32> ran;
+    uint32 queued = 0;
+    for (std::unique_ptr<RegionTestCreature>& creature : creatures)
+    {
+        creature->OnUpdate = [&](RegionTestCreature& self)
+        {
+            uint32 id = self.GetGUID().GetCounter();
+            self.GetMap()->RunOnMapThread([&, mapThread, id]()
+            {
+                EXPECT_EQ(std::this_thread::get_id(), mapThread);
+                EXPECT_FALSE(map->IsUpdatingRegions());
+                ran.push_back(id);
+            });
+        };
+    }
+
+    map->UpdateCells(cells, 1);
+
+    EXPECT_EQ(ran.size(), creatures.size());
+    std::sort(ran.begin(), ran.end());
+    EXPECT_EQ(std::adjacent_find(ran.begin(), ran.end()), ran.end());
+
+    // outside of the parallel part the task runs right away
+    map->RunOnMapThread([&queued]() { ++queued; });
+    EXPECT_EQ(queued, 1u);
+}
@@ -0,0 +1,155 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AsyncPathfinder.h"
+#include "MMapFactory.h"
+#include "MMapMgr.h"
+#include "Object.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // neither a unit nor on a map with a navmesh, enough to request searches
+    class PathTestObject : public WorldObject
+    {
+    public:
+        PathTestObject() : WorldObject(false)
+        {
+            m_valuesCount = OBJECT_END;
+            _InitValues();
+            WorldObject::_Create(1, HighGuid::DynamicObject, PHASEMASK_NORMAL);
+        }
+    };
+
+    // the worker took every request, a held navmesh lock keeps it waiting in the first search
+    void WaitForEmptyQueue(AsyncPathfinder& pathfinder)
+    {
+        AsyncPathfinderStats stats;
+        do
+        {
+            std::this_thread::yield();
+            pathfinder.GetStats(stats);
+        } while (stats.QueueSize);
+    }
+
+    void WaitUntilDone(PathRequest const& request)
+    {
+        while (!request.Done.load(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+}
+
+TEST(AsyncPathfinderTest, CanceledRequestsAreSkipped)
+{
+    AsyncPathfinder pathfinder;
+    pathfinder.Activate(1, 10);
+
+    auto owner = std::make_unique<PathTestObject>();
+    PathGenerator path(owner.get());
+
+    // like a tile load, the worker can't search meanwhile
+    std::unique_lock<std::shared_mutex> tileLoad(MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshLock());
+
+    std::shared_ptr<PathRequest> searched = pathfinder.Enqueue(path, 0);
+    ASSERT_TRUE(searched);
+    WaitForEmptyQueue(pathfinder);
+
+    // the generator cancels its request when it is destroyed or starts another path
+    std::shared_ptr<PathRequest> canceled = pathfinder.Enqueue(path, 0);
+    ASSERT_TRUE(canceled);
+    canceled->Canceled = true;
+
+    std::shared_ptr<PathRequest> last = pathfinder.Enqueue(path, 0);
+    ASSERT_TRUE(last);
+
+    // the searches run on copies, the owner may be gone before them
+    owner.reset();
+    tileLoad.unlock();
+
+    WaitUntilDone(*last);
+    EXPECT_TRUE(searched->Done);
+    EXPECT_FALSE(canceled->Done);
+
+    AsyncPathfinderStats stats;
+    pathfinder.GetStats(stats);
+    EXPECT_EQ(stats.QueueSize, 0u);
+    EXPECT_EQ(stats.Completed, 2u);
+    EXPECT_EQ(stats.Canceled, 1u);
+    EXPECT_EQ(stats.Synchronous, 0u);
+
+    pathfinder.Deactivate();
+}
+
+TEST(AsyncPathfinderTest, FullQueueSearchesSynchronously)
+{
+    uint32 const maxQueueSize = 8;
+    AsyncPathfinder pathfinder;
+    pathfinder.Activate(1, maxQueueSize);
+
+    PathTestObject owner;
+    PathGenerator path(&owner);
+
+    std::unique_lock<std::shared_mutex> tileLoad(MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshLock());
+
+    std::shared_ptr<PathRequest> first = pathfinder.Enqueue(path, 0);
+    ASSERT_TRUE(first);
+    WaitForEmptyQueue(pathfinder);
+
+    // maps updated at once fill the queue together, exactly maxQueueSize requests may get in
+    std::atomic<uint32> queued(0);
+    std::vector<std::shared_ptr<PathRequest>> requests(4 * 10);
+    std::vector<std::thread> callers;
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        callers.emplace_back([&, i]()
+        {
+            for (uint32 j = 0; j < 10; ++j)
+            {
+                requests[i * 10 + j] = pathfinder.Enqueue(path, 0);
+                if (requests[i * 10 + j])
+                    ++queued;
+            }
+        });
+    }
+
+    for (std::thread& caller : callers)
+        caller.join();
+
+    AsyncPathfinderStats stats;
+    pathfinder.GetStats(stats);
+    EXPECT_EQ(queued, maxQueueSize);
+    EXPECT_EQ(stats.QueueSize, maxQueueSize);
+    EXPECT_EQ(stats.Synchronous, 4u * 10 - maxQueueSize);
+
+    tileLoad.unlock();
+
+    for (std::shared_ptr<PathRequest> const& request : requests)
+        if (request)
+            WaitUntilDone(*request);
+
+    pathfinder.GetStats(stats);
+    EXPECT_EQ(stats.QueueSize, 0u);
+    EXPECT_EQ(stats.Completed, maxQueueSize + 1);
+
+    pathfinder.Deactivate();
+}
@@ -0,0 +1,276 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuraEffectAggregate.h"
+#include "DBCStructure.h"
+#include "SpellAuraEffects.h"
+#include "SpellAuras.h"
+#include "SpellInfo.h"
+#include "Unit.h"
+#include "WorldMock.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+    struct FakeAuraEffect
+    {
+        int32 Amount;
+
+        int32 GetAmount() const { return Amount; }
+    };
+
+    typedef std::list<FakeAuraEffect const*> FakeAuraEffectList;
+
+    AuraEffectAggregate ComputeUncached(FakeAuraEffectList const& effects)
+    {
+        AuraEffectAggregate aggregate;
+        for (FakeAuraEffect const* effect : effects)
+        {
+            aggregate.Total += effect->GetAmount();
+            aggregate.MaxPositive = std::max(aggregate.MaxPositive, effect->GetAmount());
+            aggregate.MinNegative = std::min(aggregate.MinNegative, effect->GetAmount());
+            AddPct(aggregate.Multiplier, effect->GetAmount());
+        }
+
+        return aggregate;
+    }
+
+    // a unit that is never added to a map, only its aura containers are used
+    class AuraTestUnit : public Unit
+    {
+    public:
+        explicit AuraTestUnit(ObjectGuid::LowType guid) : Unit(false)
+        {
+            m_valuesCount = UNIT_END;
+            _InitValues();
+            Object::_Create(guid, 0, HighGuid::Unit);
+        }
+
+        ~AuraTestUnit() override
+        {
+            RemoveAllAuras();
+        }
+
+        [[nodiscard]] uint32 GetShieldBlockValue() const override { return 0; }
+        bool UpdateStats(Stats /*stat*/) override { return true; }
+        bool UpdateAllStats() override { return true; }
+        void UpdateResistances(uint32 /*school*/) override { }
+        void UpdateArmor() override { }
+        void UpdateMaxHealth() override { }
+        void UpdateMaxPower(Powers /*power*/) override { }
+        void UpdateAttackPowerAndDamage(bool /*ranged*/ = false) override { }
+        void CalculateMinMaxDamage(WeaponAttackType /*attType*/, bool /*normalized*/, bool /*addTotalPct*/, float& minDamage, float& maxDamage) override { minDamage = maxDamage = 0.0f; }
+        [[nodiscard]] bool CanFly() const override { return false; }
+        [[nodiscard]] bool CanEnterWater() const override { return false; }
+        void SetTarget(ObjectGuid /*guid*/ = ObjectGuid::Empty) override { }
+    };
+
+    // Applies auras with one SPELL_AURA_MOD_DAMAGE_PERCENT_TAKEN effect through the unit's aura application code.
+    // The effect has no immediate handler, the unit only registers it in its effect list.
+    class AuraEffectAggregateUnitTest : public Test
+    {
+    protected:
+        static constexpr AuraType TestAuraType = SPELL_AURA_MOD_DAMAGE_PERCENT_TAKEN;
+
+        void SetUp() override
+        {
+            sWorld.reset(new NiceMock<WorldMock>());
+        }
+
+        void TearDown() override
+        {
+            _units.clear();
+            _spells.clear();
+        }
+
+        AuraTestUnit* CreateUnit()
+        {
+            _units.push_back(std::make_unique<AuraTestUnit>(ObjectGuid::LowType(_units.size() + 1)));
+            return _units.back().get();
+        }
+
+        // the aura is owned and cast by owner, target is owner or another unit in range of its area aura
+        AuraEffect* ApplyAura(Unit* owner, int32 amount, Unit* target = nullptr)
+        {
+            SpellEntry entry{};
+            entry.Id = 90000 + uint32(_spells.size());
+            entry.Effect[EFFECT_0] = SPELL_EFFECT_APPLY_AURA;
+            entry.EffectApplyAuraName[EFFECT_0] = TestAuraType;
+            entry.EffectImplicitTargetA[EFFECT_0] = TARGET_UNIT_CASTER;
+            _spells.push_back(std::make_unique<SpellInfo>(&entry));
+
+            int32 baseAmount[MAX_SPELL_EFFECTS] = { amount, 0, 0 };
+            Aura* aura = Aura::Create(_spells.back().get(), 1 << EFFECT_0, owner, owner, baseAmount, nullptr, ObjectGuid::Empty);
+            if (!aura)
+                return nullptr;
+
+            for (Unit* applyTarget : { owner, target })
+            {
+                if (!applyTarget)
+                    continue;
+
+                AuraApplication* aurApp = applyTarget->_CreateAuraApplication(aura, 1 << EFFECT_0);
+                if (!aurApp)
+                    return nullptr;
+
+                applyTarget->_ApplyAura(aurApp, 1 << EFFECT_0);
+            }
+
+            return aura->GetEffect(EFFECT_0);
+        }
+
+        static int32 UncachedTotal(Unit* unit)
+        {
+            int32 total = 0;
+            for (AuraEffect const* effect : unit->GetAuraEffectsByType(TestAuraType))
+                total += effect->GetAmount();
+            return total;
+        }
+
+    private:
+        std::vector<std::unique_ptr<SpellInfo>> _spells;
+        std::vector<std::unique_ptr<AuraTestUnit>> _units;
+    };
+}
+
+TEST(AuraEffectAggregateTest, MatchesUncachedAggregates)
+{
+    FakeAuraEffect effects[] = { { 10 }, { -20 }, { 5 }, { 0 }, { -3 }, { 30 } };
+    FakeAuraEffectList list;
+    for (FakeAuraEffect const& effect : effects)
+        list.push_back(&effect);
+
+    AuraEffectAggregate aggregate;
+    aggregate.Compute(list);
+
+    AuraEffectAggregate expected = ComputeUncached(list);
+    EXPECT_EQ(aggregate.Total, 22);
+    EXPECT_EQ(aggregate.MaxPositive, 30);
+    EXPECT_EQ(aggregate.MinNegative, -20);
+    EXPECT_EQ(aggregate.Multiplier, expected.Multiplier);
+
+    AuraEffectAggregate empty;
+    empty.Compute(FakeAuraEffectList());
+    EXPECT_EQ(empty.Total, 0);
+    EXPECT_EQ(empty.MaxPositive, 0);
+    EXPECT_EQ(empty.MinNegative, 0);
+    EXPECT_EQ(empty.Multiplier, 1.0f);
+}
+
+// Unit::_RegisterAuraEffect drops the cached aggregate when an effect is applied or removed
+TEST_F(AuraEffectAggregateUnitTest, RegisterInvalidates)
+{
+    AuraTestUnit* unit = CreateUnit();
+
+    std::vector<AuraEffect*> effects;
+    for (int32 amount : { 10, -20, 30, 5 })
+    {
+        effects.push_back(ApplyAura(unit, amount));
+        ASSERT_NE(effects.back(), nullptr);
+    }
+
+    EXPECT_EQ(unit->GetTotalAuraModifier(TestAuraType), 25);
+    EXPECT_EQ(unit->GetMaxPositiveAuraModifier(TestAuraType), 30);
+    EXPECT_EQ(unit->GetMaxNegativeAuraModifier(TestAuraType), -20);
+
+    ASSERT_NE(ApplyAura(unit, 40), nullptr);
+    EXPECT_EQ(unit->GetTotalAuraModifier(TestAuraType), 65);
+    EXPECT_EQ(unit->GetMaxPositiveAuraModifier(TestAuraType), 40);
+
+    effects[2]->GetBase()->Remove();
+    EXPECT_EQ(unit->GetTotalAuraModifier(TestAuraType), 35);
+    EXPECT_EQ(unit->GetMaxPositiveAuraModifier(TestAuraType), 40);
+
+    effects[1]->GetBase()->Remove();
+    EXPECT_EQ(unit->GetTotalAuraModifier(TestAuraType), 55);
+    EXPECT_EQ(unit->GetMaxNegativeAuraModifier(TestAuraType), 0);
+    EXPECT_EQ(unit->GetTotalAuraModifier(TestAuraType), UncachedTotal(unit));
+}
+
+// AuraEffect::SetAmount, ChangeAmount and SetEnabled change the amount of a registered effect in place
+TEST_F(AuraEffectAggregateUnitTest, AmountChangesInvalidate)
+{
+    AuraTestUnit* unit = CreateUnit();
+
+    std::vector<AuraEffect*> effects;
+    for (int32 amount : { 10, 20, 30, 40 })
+    {
+        effects.push_back(ApplyAura(unit, amount));
+        ASSERT_NE(effects.back(), nullptr);
+    }
+
+    EXPECT_EQ(unit->GetTotalAuraModifier(TestAuraType), 100);
+    EXPECT_FLOAT_EQ(unit->GetTotalAuraMultiplier(TestAuraType), 1.1f * 1.2f * 1.3f * 1.4f);
+
+    effects[0]->SetAmount(15);
+    EXPECT_EQ(unit->GetTotalAuraModifier(TestAuraType), 105);
+
+    effects[1]->ChangeAmount(-50);
+    EXPECT_EQ(unit->GetTotalAuraModifier(TestAuraType), 35);
+    EXPECT_EQ(unit->GetMaxNegativeAuraModifier(TestAuraType), -50);
+    EXPECT_FLOAT_EQ(unit->GetTotalAuraMultiplier(TestAuraType), 1.15f * 0.5f * 1.3f * 1.4f);
+
+    effects[3]->SetEnabled(false);
+    EXPECT_EQ(unit->GetTotalAuraModifier(TestAuraType), -5);
+    EXPECT_EQ(unit->GetMaxPositiveAuraModifier(TestAuraType), 30);
+
+    effects[3]->SetEnabled(true);
+    EXPECT_EQ(unit->GetTotalAuraModifier(TestAuraType), 35);
+    EXPECT_EQ(unit->GetTotalAuraModifier(TestAuraType), UncachedTotal(unit));
+}
+
+// An effect applied to several units invalidates the aggregates of each of them and of no other unit
+TEST_F(AuraEffectAggregateUnitTest, AmountChangesInvalidateEveryTarget)
+{
+    AuraTestUnit* owner = CreateUnit();
+    AuraTestUnit* target = CreateUnit();
+    AuraTestUnit* bystander = CreateUnit();
+
+    AuraEffect* shared = ApplyAura(owner, 10, target);
+    ASSERT_NE(shared, nullptr);
+    for (int32 amount : { 1, 2, 3 })
+    {
+        ASSERT_NE(ApplyAura(owner, amount), nullptr);
+        ASSERT_NE(ApplyAura(target, amount * 10), nullptr);
+    }
+
+    AuraEffect* other = nullptr;
+    for (int32 amount : { 100, 200, 300, 400 })
+    {
+        other = ApplyAura(bystander, amount);
+        ASSERT_NE(other, nullptr);
+    }
+
+    EXPECT_EQ(owner->GetTotalAuraModifier(TestAuraType), 16);
+    EXPECT_EQ(target->GetTotalAuraModifier(TestAuraType), 70);
+    EXPECT_EQ(bystander->GetTotalAuraModifier(TestAuraType), 1000);
+
+    shared->SetAmount(50);
+    EXPECT_EQ(owner->GetTotalAuraModifier(TestAuraType), 56);
+    EXPECT_EQ(target->GetTotalAuraModifier(TestAuraType), 110);
+    EXPECT_EQ(bystander->GetTotalAuraModifier(TestAuraType), 1000);
+
+    other->SetAmount(0);
+    EXPECT_EQ(owner->GetTotalAuraModifier(TestAuraType), 56);
+    EXPECT_EQ(bystander->GetTotalAuraModifier(TestAuraType), 600);
+}
@@ -0,0 +1,209 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IoContext.h"
+#include "Socket.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+namespace
+{
+    // only writes, the test reads what it sent on the other end of the connection
+    class WriteSocket : public Socket<WriteSocket>
+    {
+    public:
+        explicit WriteSocket(tcp::socket&& socket) : Socket(std::move(socket)) { }
+
+        void Start() override { }
+
+        using Socket::AcquireSendBuffer;
+
+    protected:
+        void ReadHandler() override { }
+    };
+
+    struct Connection
+    {
+        explicit Connection(boost::asio::io_context& ioContext) : Writer(ioContext), Reader(ioContext)
+        {
+            tcp::acceptor acceptor(ioContext, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+            Reader.connect(acceptor.local_endpoint());
+            acceptor.accept(Writer);
+
+            // same as AsyncAcceptor, a small send buffer makes the writes partial
+            Writer.non_blocking(true);
+            Writer.set_option(boost::asio::socket_base::send_buffer_size(8192));
+        }
+
+        tcp::socket Writer;
+        tcp::socket Reader;
+    };
+
+    // world packets: headers and small packets copied into the socket, large payloads shared by every recipient
+    struct Packet
+    {
+        std::vector<uint8> Owned;
+        std::shared_ptr<uint8 const> Shared;
+        std::size_t SharedSize;
+    };
+
+    std::vector<Packet> MakePackets(uint32 count, std::vector<uint8>& stream)
+    {
+        std::mt19937 rng(count);
+        std::uniform_int_distribution<uint32> smallSize(4, 300);
+        std::uniform_int_distribution<uint32> largeSize(512, 4096);
+
+        std::vector<std::shared_ptr<uint8 const>> payloads;
+        std::vector<std::size_t> payloadSizes;
+        for (uint32 i = 0; i < 16; ++i)
+        {
+            std::size_t size = largeSize(rng);
+            uint8* data = new uint8[size];
+            for (std::size_t j = 0; j < size; ++j)
+                data[j] = uint8(rng());
+
+            payloads.emplace_back(data, std::default_delete<uint8[]>());
+            payloadSizes.push_back(size);
+        }
+
+        std::vector<Packet> packets(count);
+        for (Packet& packet : packets)
+        {
+            packet.Owned.resize(smallSize(rng));
+            for (uint8& byte : packet.Owned)
+                byte = uint8(rng());
+
+            stream.insert(stream.end(), packet.Owned.begin(), packet.Owned.end());
+
+            packet.SharedSize = 0;
+            if (rng() % 3 == 0)
+            {
+                uint32 payload = rng() % payloads.size();
+                packet.Shared = payloads[payload];
+                packet.SharedSize = payloadSizes[payload];
+                stream.insert(stream.end(), packet.Shared.get(), packet.Shared.get() + packet.SharedSize);
+            }
+        }
+
+        return packets;
+    }
+
+    MessageBuffer ToMessageBuffer(uint8 const* data, std::size_t size)
+    {
+        MessageBuffer buffer(size);
+        buffer.Write(data, size);
+        return buffer;
+    }
+
+    // reads everything the writer sends until size bytes arrived or the reader is shut down
+    std::thread StartReading(tcp::socket& reader, std::vector<uint8>& received, std::size_t size, std::atomic<bool>& done)
+    {
+        return std::thread([&reader, &received, size, &done]()
+        {
+            received.resize(size);
+            boost::system::error_code error;
+            received.resize(boost::asio::read(reader, boost::asio::buffer(received), error));
+            done = true;
+        });
+    }
+
+    void StopReading(tcp::socket& reader, std::thread& thread)
+    {
+        boost::system::error_code error;
+        reader.shutdown(tcp::socket::shutdown_both, error);
+        thread.join();
+    }
+
+    // updates the socket like the network thread until the reader got everything
+    void UpdateUntilDone(boost::asio::io_context& ioContext, std::shared_ptr<WriteSocket> const& socket, std::atomic<bool> const& done)
+    {
+        // a stream that lost or kept some bytes never completes
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (!done && std::chrono::steady_clock::now() < deadline)
+        {
+            socket->Update();
+            ioContext.poll();
+            ioContext.restart();
+        }
+    }
+
+    // queues every packet like WorldSocket::SendPacket
+    void WriteGathered(boost::asio::io_context& ioContext, std::shared_ptr<WriteSocket> const& socket, std::vector<Packet> const& packets, std::atomic<bool> const& done)
+    {
+        for (Packet const& packet : packets)
+        {
+            socket->QueuePacket(ToMessageBuffer(packet.Owned.data(), packet.Owned.size()));
+            if (packet.Shared)
+                socket->QueuePacket(packet.Shared, packet.SharedSize);
+        }
+
+        UpdateUntilDone(ioContext, socket, done);
+    }
+}
+
+TEST(SocketTest, GatheredWritesKeepTheStream)
+{
+    Acore::Asio::IoContext ioContext;
+    Connection connection(ioContext);
+
+    std::vector<uint8> stream;
+    std::vector<Packet> packets = MakePackets(5000, stream);
+
+    std::vector<uint8> received;
+    std::atomic<bool> done(false);
+    std::thread reader = StartReading(connection.Reader, received, stream.size(), done);
+
+    std::shared_ptr<WriteSocket> socket = std::make_shared<WriteSocket>(std::move(connection.Writer));
+    WriteGathered(ioContext, socket, packets, done);
+    StopReading(connection.Reader, reader);
+
+    ASSERT_EQ(received.size(), stream.size());
+    EXPECT_EQ(memcmp(received.data(), stream.data(), stream.size()), 0);
+}
+
+TEST(SocketTest, WrittenBuffersAreReused)
+{
+    Acore::Asio::IoContext ioContext;
+    Connection connection(ioContext);
+
+    std::vector<uint8> stream(1000, 7);
+    std::vector<uint8> received;
+    std::atomic<bool> done(false);
+    std::thread reader = StartReading(connection.Reader, received, stream.size(), done);
+
+    std::shared_ptr<WriteSocket> socket = std::make_shared<WriteSocket>(std::move(connection.Writer));
+    MessageBuffer buffer = socket->AcquireSendBuffer(4096);
+    buffer.Write(stream.data(), stream.size());
+    uint8 const* storage = buffer.GetBasePointer();
+    socket->QueuePacket(std::move(buffer));
+
+    UpdateUntilDone(ioContext, socket, done);
+    StopReading(connection.Reader, reader);
+    ASSERT_EQ(received, stream);
+
+    MessageBuffer reused = socket->AcquireSendBuffer(4096);
+    EXPECT_EQ(reused.GetBasePointer(), storage);
+    EXPECT_EQ(reused.GetActiveSize(), 0u);
+    EXPECT_EQ(reused.GetRemainingSpace(), 4096u);
+}